@@ -25,6 +25,42 @@
 ** Author:   A.Gibson/587
 **
 ******************************************************************************/
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/* Called by SBN_Client_InitAsync with the status SBN_Client_Init would have 
+ * returned, from the thread that did the connect */
+typedef void (*SBN_Client_InitCallback_t)(int32 Status, void *CallbackArg);
+
+/* Called with LinkUp FALSE when the connection to SBN is lost and TRUE once 
+ * the client has reconnected, from the receive thread */
+typedef void (*SBN_Client_LinkCallback_t)(boolean LinkUp, void *CallbackArg);
+
+/* the MsSince fields of SBN_Client_LinkHealth_t for things not seen yet */
+#define SBN_CLIENT_HEALTH_NEVER  0xFFFFFFFF
+
+/* Health of the connection to SBN, see SBN_Client_GetLinkHealth.  The 
+ * heartbeat and TCP fields describe the current connection only. */
+typedef struct {
+    boolean LinkUp;               /* connected to SBN */
+    uint32  Reconnects;           /* times the connection was lost and remade */
+    uint32  MsSinceLastHeard;     /* since any frame arrived from SBN */
+    uint32  MsSinceLastHeartbeat; /* since a heartbeat arrived from SBN */
+    uint32  HeartbeatsReceived;
+    uint32  HeartbeatIntervalMs;  /* between the last two heartbeats */
+    uint32  HeartbeatJitterMs;    /* smoothed change in heartbeat interval */
+    uint32  HeartbeatsSent;       /* to SBN, over every connection */
+    uint32  HeartbeatSendErrors;
+    uint32  ZeroCopyLate;         /* zero copy sends not seen completing */
+    uint32  MsSinceTcpSample;     /* age of the TCP fields below */
+    uint32  TcpRttUs;             /* kernel's smoothed round trip time */
+    uint32  TcpRttVarUs;          /* and its variation */
+    uint32  TcpRetransmits;       /* segments retransmitted */
+    uint32  TcpLost;              /* segments currently thought lost */
+    uint32  TcpUnackedBytes;      /* queued to send or awaiting an ack */
+} SBN_Client_LinkHealth_t;
+
 /****************** Function Prototypes **********************/
 
 /** @defgroup SBNCLIENTAPIInitialization sbn_client Init API
@@ -44,7 +80,8 @@
 ** \par Assumptions, External Events, and Notes:
 **          There is a TCP/IP connection available to a cFE instance running
 **          SBN.  The port and IP of that instance is defined in 
-**          the sbn_client_defs.h file.
+**          the sbn_client_defs.h file, as is the connect timeout and how 
+**          often a refused or timed out connect is retried.
 **
 **
 ** \return Execution status
@@ -52,10 +89,120 @@
 ** \retval #SBN_CLIENT_BAD_SOCK_FD_EID  Connect to server failed
 ** \retval #SBN_CLIENT_HEART_THREAD_CREATE_EID  Heartbeat thread failed init  
 ** \retval #SBN_CLIENT_RECEIVE_THREAD_CREATE_EID  Receive thread failed init 
+** \retval #SBN_CLIENT_EVENT_LOOP_CREATE_EID  Event loop descriptors failed init 
 ** \retval #SBN_CLIENT_NO_STATUS_SET  Default setting, function has a problem 
 **
 */
 int32 SBN_Client_Init(void);
+
+/*****************************************************************************/
+/** 
+** \brief Initializes the client without waiting for the connection to SBN.
+**
+** \par Description
+**          Runs #SBN_Client_Init on its own thread and returns straight away,
+**          so the app can finish its own initialization while the client 
+**          connects.  When the connect has succeeded or failed, Callback is 
+**          called with the status #SBN_Client_Init returned and the ready fd
+**          becomes readable.  #SBN_Client_GetInitStatus gives the same status.
+**
+** \par Assumptions, External Events, and Notes:
+**          Pipes, subscriptions and messages may only be used once the 
+**          client is ready.  Callback runs on the client's init thread.  
+**          The ready fd belongs to the client and is closed by 
+**          #SBN_Client_Shutdown.
+**
+** \param[in]  Callback     Called when init finishes, may be NULL.
+**
+** \param[in]  CallbackArg  Passed to Callback.
+**
+** \param[out] ReadyFdPtr   Set to an fd to poll for reading that becomes 
+**                          readable when init finishes, may be NULL.
+**
+** \return Execution status
+** \retval #CFE_SUCCESS  The client is connecting
+** \retval #SBN_CLIENT_INIT_THREAD_CREATE_EID  Init thread failed to start
+**
+*/
+int32 SBN_Client_InitAsync(SBN_Client_InitCallback_t Callback, 
+                           void *CallbackArg, int *ReadyFdPtr);
+
+/*****************************************************************************/
+/** 
+** \brief Reports how an #SBN_Client_InitAsync went.
+**
+** \return #SBN_CLIENT_INIT_PENDING while still connecting, otherwise the 
+**         status #SBN_Client_Init returned
+**
+*/
+int32 SBN_Client_GetInitStatus(void);
+
+/*****************************************************************************/
+/** 
+** \brief Sets the function told about losing and regaining SBN.
+**
+** \par Description
+**          When the receive side sees the connection to SBN fail, the client
+**          reconnects with exponential backoff and jitter, keeping its pipes 
+**          and the messages in them, and sends SBN every subscription again.
+**          Callback is called as the connection is lost and again once it is
+**          back.  Messages sent while the connection is down are lost.
+**
+** \par Assumptions, External Events, and Notes:
+**          Callback runs on the receive thread, or the event loop thread, and
+**          must not block.  The backoff is set in sbn_client_defs.h, where 
+**          SBN_CLIENT_AUTO_RECONNECT can turn reconnecting off.
+**
+** \param[in]  Callback     Called on loss and recovery, NULL for none.
+**
+** \param[in]  CallbackArg  Passed to Callback.
+**
+*/
+void SBN_Client_SetLinkCallback(SBN_Client_LinkCallback_t Callback, 
+                                void *CallbackArg);
+
+/*****************************************************************************/
+/** 
+** \brief Reports the health of the connection to SBN.
+**
+** \par Description
+**          Gives when SBN was last heard from, how regularly its heartbeats 
+**          arrive, how the client's own heartbeats are going and the 
+**          kernel's round trip time, retransmit and send queue figures for 
+**          the connection.  A growing MsSinceLastHeard, heartbeat jitter, 
+**          retransmit count or unacknowledged byte count shows the link 
+**          degrading before the pipes back up.
+**
+** \par Assumptions, External Events, and Notes:
+**          The TCP fields are sampled with each heartbeat the client sends,
+**          every few seconds.
+**
+** \param[out] HealthPtr    Filled in with the link health.
+**
+** \return Execution status
+** \retval #CFE_SUCCESS  HealthPtr was filled in
+** \retval #CFE_SBN_CLIENT_BAD_ARGUMENT  HealthPtr is NULL
+**
+*/
+int32 SBN_Client_GetLinkHealth(SBN_Client_LinkHealth_t *HealthPtr);
+
+/*****************************************************************************/
+/** 
+** \brief Stops the client and disconnects from SBN.
+**
+** \par Description
+**          Stops the heartbeat and receive threads, or the event loop thread 
+**          when SBN_CLIENT_USE_EVENT_LOOP is set, and waits for them to exit
+**          before closing the connection.  A receive blocked part way through 
+**          a frame is ended by shutting down the socket.  The heartbeat thread
+**          can take up to a heartbeat period to exit; the event loop exits 
+**          immediately.  A reconnect in progress is given up.
+**
+** \par Assumptions, External Events, and Notes:
+**          No app thread may be using the client when this is called.
+**
+*/
+void SBN_Client_Shutdown(void);
 /**@}*/
 
 #endif /* _sbn_client_init_h_ */
@@ -0,0 +1,98 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_transport_h_
+#define _sbn_client_transport_h_
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/******************************************************************************
+**  Typedef:  CFE_SBN_Client_Transport_t
+**
+**  Purpose:
+**     How bytes get to and from SBN.  The protocol and pipe code only move
+**     SBN frames through these operations, each of which behaves as the
+**     socket call it is named after, on the descriptor Connect returned.
+**     Every operation is required but Cork.  Besides the built in ones
+**     below, an app may fill one in for a link of its own and pick it with
+**     #CFE_SBN_Client_SetTransport.  Zero copy sends are only made over
+**     #CFE_SBN_Client_TcpTransport.
+*/
+typedef struct {
+    const char *Name;
+    /* where Connect reaches SBN, as the client's log gives it */
+    const char *Address;
+    /* one connection attempt, returning the descriptor standing for the
+     * connection or a negative SERVER_*_ERROR */
+    int     (*Connect)(void);
+    /* takes up to Size bytes SBN sent into Data, as read() */
+    int     (*RecvInto)(int SockFd, unsigned char *Data, size_t Size);
+    /* waits at most TimeoutMs for bytes from SBN, as poll() for POLLIN */
+    int     (*PollIn)(int SockFd, int TimeoutMs);
+    /* sends what Msg describes, as sendmsg() that never raises SIGPIPE */
+    ssize_t (*SendV)(int SockFd, const struct msghdr *Msg, int Flags);
+    /* ends waits on the connection in other threads, as shutdown() */
+    void    (*Shutdown)(int SockFd);
+    void    (*Close)(int SockFd);
+    /* descriptor the event loop waits on to read, or -1 if there is none */
+    int     (*PollFd)(int SockFd);
+    /* holds back (On) or lets go of partial segments, NULL when the
+     * transport sends each write as it is; 0 or -1 as setsockopt() */
+    int     (*Cork)(int SockFd, int On);
+} CFE_SBN_Client_Transport_t;
+
+/* TCP to SBN_CLIENT_IP_ADDR and SBN_CLIENT_PORT */
+extern const CFE_SBN_Client_Transport_t CFE_SBN_Client_TcpTransport;
+/* Unix domain stream socket at SBN_CLIENT_UNIX_PATH */
+extern const CFE_SBN_Client_Transport_t CFE_SBN_Client_UnixTransport;
+/* shared memory rings in SBN_CLIENT_SHM_NAME, no descriptor to poll */
+extern const CFE_SBN_Client_Transport_t CFE_SBN_Client_ShmTransport;
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTTransport sbn_client transports
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief The transport the client reaches SBN over.
+**
+** \return The one set by #CFE_SBN_Client_SetTransport, otherwise the one
+**         SBN_CLIENT_TRANSPORT names
+**
+**/
+const CFE_SBN_Client_Transport_t *CFE_SBN_Client_GetTransport(void);
+
+/*****************************************************************************/
+/**
+** \brief Picks the transport the client reaches SBN over.
+**
+** \par Description
+**          Must not change while connected, so it belongs before
+**          SBN_Client_Init or after SBN_Client_Shutdown.  Lets one build
+**          compare transports.
+**
+** \param[in]  Transport    The transport, or NULL for the one
+**                          SBN_CLIENT_TRANSPORT names.
+**
+**/
+void CFE_SBN_Client_SetTransport(const CFE_SBN_Client_Transport_t *Transport);
+
+/**@}*/
+
+#endif /* _sbn_client_transport_h_ */
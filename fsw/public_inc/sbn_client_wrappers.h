@@ -15,7 +15,27 @@
 
 #include <sbn_interfaces.h>
 
+/* What happens to a message for a full pipe, see SBN_Client_CreatePipeEx */
+#define SBN_CLIENT_OVERFLOW_DROP_NEWEST  0 /* drop the new message */
+#define SBN_CLIENT_OVERFLOW_DROP_OLDEST  1 /* drop the oldest unread message */
+#define SBN_CLIENT_OVERFLOW_BLOCK        2 /* stop reading from SBN until the 
+                                            * app reads a message */
 
+/* What SendMsg does when the send queue is full, see 
+ * SBN_Client_SetSendQueuePolicy */
+#define SBN_CLIENT_SEND_QUEUE_BLOCK      0 /* wait for the writer to send */
+#define SBN_CLIENT_SEND_QUEUE_DROP       1 /* drop the message */
+#define SBN_CLIENT_SEND_QUEUE_EAGAIN     2 /* return an error at once */
+
+/* One subscription for SBN_Client_SubscribeBatch, as CFE_SB_SubscribeEx 
+ * takes it */
+typedef struct
+{
+    CFE_SB_MsgId_t  MsgId;
+    CFE_SB_PipeId_t PipeId;
+    CFE_SB_Qos_t    Quality;
+    uint16          MsgLim;
+} SBN_Client_Subscription_t;
 
 /****************** Function Prototypes **********************/
 
@@ -34,6 +54,69 @@
 **/
 int32  __wrap_CFE_SB_CreatePipe(CFE_SB_PipeId_t *, uint16, const char *);
 
+/*****************************************************************************/
+/** 
+** \brief Creates a software bus pipe with a chosen overflow policy.
+**
+** \par Description
+**          Same as CFE_SB_CreatePipe, which uses 
+**          #SBN_CLIENT_OVERFLOW_DROP_NEWEST, but OverflowPolicy sets what
+**          happens to a message received for the pipe when it already holds
+**          Depth messages.  #SBN_CLIENT_OVERFLOW_BLOCK holds up delivery to
+**          every pipe, and reading from SBN, until the app reads from this 
+**          one.
+**
+** \param[out] PipeIdPtr      The id of the created pipe.
+**
+** \param[in]  Depth          Maximum number of unread messages in the pipe.
+**
+** \param[in]  PipeName       Name of the pipe.
+**
+** \param[in]  OverflowPolicy One of the SBN_CLIENT_OVERFLOW_ policies.
+**
+** \return CFE_SUCCESS, or the same errors as CFE_SB_CreatePipe
+**
+**/
+int32  SBN_Client_CreatePipeEx(CFE_SB_PipeId_t *, uint16, const char *, 
+                               uint8);
+
+/*****************************************************************************/
+/** 
+** \brief Gets the number of messages and bytes a pipe dropped because it 
+**        was full.
+**
+** \param[in]  PipeId         The pipe.
+**
+** \param[out] DroppedMsgs    Number of messages dropped.
+**
+** \param[out] DroppedBytes   Number of bytes in the dropped messages.
+**
+** \return CFE_SUCCESS, or CFE_SB_BAD_ARGUMENT for an unknown pipe or a 
+**         NULL pointer
+**
+**/
+int32  SBN_Client_GetPipeDropCounts(CFE_SB_PipeId_t, uint32 *, uint32 *);
+
+/*****************************************************************************/
+/** 
+** \brief Gets how many messages of a subscription are waiting in its pipe
+**        and how many were dropped because its MsgLim were already waiting.
+**
+** \param[in]  MsgId          The subscribed message id.
+**
+** \param[in]  PipeId         The subscribing pipe.
+**
+** \param[out] MsgsWaiting    Number of its messages in the pipe.
+**
+** \param[out] MsgLimDrops    Number of its messages dropped by MsgLim.
+**
+** \return CFE_SUCCESS, or CFE_SB_BAD_ARGUMENT for an unknown pipe, a MsgId
+**         the pipe is not subscribed to or a NULL pointer
+**
+**/
+int32  SBN_Client_GetSubscriptionCounts(CFE_SB_MsgId_t, CFE_SB_PipeId_t, 
+                                        uint16 *, uint32 *);
+
 
 /*****************************************************************************/
 /** 
@@ -65,7 +148,12 @@ int32  __wrap_CFE_SB_Subscribe(CFE_SB_MsgId_t, CFE_SB_PipeId_t);
 ** \brief SBN_Client replacement for CFE_SB_SubscribeEx that 
 **
 ** \par Description see \ref CFEAPISBSubscription
-**          CFE_SB_SubscribeEx not yet implemented.
+**          \copybrief CFE_SB_SubscribeEx
+**          At most MsgLim messages with the MsgId wait in the pipe at once, 
+**          further ones are dropped and counted for the subscription, see
+**          #SBN_Client_GetSubscriptionCounts.  A MsgLim of 0 leaves only 
+**          the pipe depth as the limit.  CFE_SB_Subscribe uses 
+**          #SBN_CLIENT_DEFAULT_MSG_LIM.
 **
 **/
 int32  __wrap_CFE_SB_SubscribeEx(CFE_SB_MsgId_t, CFE_SB_PipeId_t, 
@@ -76,17 +164,39 @@ int32  __wrap_CFE_SB_SubscribeEx(CFE_SB_MsgId_t, CFE_SB_PipeId_t,
 ** \brief SBN_Client replacement for CFE_SB_SubscribeLocal that 
 **
 ** \par Description see \ref CFEAPISBSubscription
-**          CFE_SB_SubscribeLocal not yet implemented.
+**          \copybrief CFE_SB_SubscribeLocal
+**          As CFE_SB_SubscribeEx, but SBN is not told of the subscription.
 **
 **/
 int32  __wrap_CFE_SB_SubscribeLocal(CFE_SB_MsgId_t, CFE_SB_PipeId_t, uint16);
 
+/*****************************************************************************/
+/** 
+** \brief Makes many subscriptions, telling SBN of them in as few frames as 
+**        the protocol allows.
+**
+** \par Description
+**          Each entry is subscribed as CFE_SB_SubscribeEx would, but the 
+**          MsgIds SBN has to be told of are packed up to 
+**          SBN_MAX_SUBS_PER_PEER to a frame instead of one frame each.  Meant
+**          for apps that subscribe to many MsgIds at startup.  An entry that
+**          fails does not stop the others.
+**
+** \param[in]  Subs           The subscriptions to make.
+**
+** \param[in]  Count          Number of entries in Subs.
+**
+** \return CFE_SUCCESS, or the error of the first entry that failed
+**
+**/
+int32  SBN_Client_SubscribeBatch(const SBN_Client_Subscription_t *, uint16);
+
 /*****************************************************************************/
 /** 
 ** \brief SBN_Client replacement for CFE_SB_Unsubscribe that 
 **
 ** \par Description see \ref CFEAPISBSubscription
-**          CFE_SB_Unsubscribe not yet implemented.
+**          \copybrief CFE_SB_Unsubscribe
 **
 **/
 int32  __wrap_CFE_SB_Unsubscribe(CFE_SB_MsgId_t, CFE_SB_PipeId_t);
@@ -96,7 +206,7 @@ int32  __wrap_CFE_SB_Unsubscribe(CFE_SB_MsgId_t, CFE_SB_PipeId_t);
 ** \brief SBN_Client replacement for CFE_SB_UnsubscribeLocal that 
 **
 ** \par Description see \ref CFEAPISBSubscription
-**          CFE_SB_UnsubscribeLocal not yet implemented.
+**          \copybrief CFE_SB_UnsubscribeLocal
 **
 **/
 int32  __wrap_CFE_SB_UnsubscribeLocal(CFE_SB_MsgId_t, CFE_SB_PipeId_t);
@@ -116,6 +226,138 @@ int32  __wrap_CFE_SB_UnsubscribeLocal(CFE_SB_MsgId_t, CFE_SB_PipeId_t);
 **/
 uint32 __wrap_CFE_SB_SendMsg(CFE_SB_Msg_t *);
 
+/*****************************************************************************/
+/** 
+** \brief Sends several messages to SBN with one system call.
+**
+** \par Description
+**          Frames each message as CFE_SB_SendMsg would and sends them, in 
+**          order, together.  Batches larger than SBN_CLIENT_MAX_SEND_BATCH
+**          take one call per SBN_CLIENT_MAX_SEND_BATCH messages.  No message
+**          is sent if any of them is NULL or too big.  With the send queue
+**          running the batch, of at most SBN_CLIENT_SEND_QUEUE_DEPTH 
+**          messages, is queued whole or not at all: a full queue waits for
+**          room for all of it, drops all of it, or fails with none of it 
+**          queued, as the queue's full policy says.
+**
+** \param[in]  Msgs           The messages to send.
+**
+** \param[in]  Count          Number of messages in Msgs.
+**
+** \return CFE_SUCCESS, CFE_SB_BAD_ARGUMENT, CFE_SB_MSG_TOO_BIG, 
+**         CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR if the send queue had no room,
+**         or CFE_SB_BUF_ALOC_ERR if the connection to SBN failed part way
+**
+**/
+int32  SBN_Client_SendMsgBatch(CFE_SB_Msg_t *[], uint32);
+
+/*****************************************************************************/
+/** 
+** \brief Gets the number of messages not sent because nobody subscribes to
+**        them.
+**
+** \par Description
+**          SBN announces which MsgIds its side subscribes to, and once it 
+**          has CFE_SB_SendMsg, SBN_Client_SendMsgBatch and 
+**          CFE_SB_ZeroCopySend skip the rest, returning CFE_SUCCESS as 
+**          CFE_SB_SendMsg does for a message without subscribers.  Set 
+**          SBN_CLIENT_SKIP_UNWANTED_SENDS to 0 to send every message.
+**
+** \param[out] NoSubscribers  Messages skipped since the client started.
+**
+** \return CFE_SUCCESS, or CFE_SB_BAD_ARGUMENT for a NULL pointer
+**
+**/
+int32  SBN_Client_GetNoSubscribersCount(uint32 *);
+
+/*****************************************************************************/
+/** 
+** \brief Gets the number of sent messages the client's own pipes missed.
+**
+** \par Description
+**          CFE_SB_SendMsg, SBN_Client_SendMsgBatch and CFE_SB_ZeroCopySend 
+**          copy each message into the client's own subscribed pipes before 
+**          sending it to SBN.  That copy is best effort: when the buffer 
+**          pool is out of buffers the pipes miss the message, which still 
+**          goes to SBN, and the send returns what sending to SBN did, so a 
+**          caller retrying a failed send never sends SBN a message twice.  
+**          This counts those misses.
+**
+** \param[out] LocalDeliveryErrors  Messages missed since the client 
+**                                  started.
+**
+** \return CFE_SUCCESS, or CFE_SB_BAD_ARGUMENT for a NULL pointer
+**
+**/
+int32  SBN_Client_GetLocalDeliveryErrors(uint32 *);
+
+/*****************************************************************************/
+/** 
+** \brief Sets how the asynchronous send queue batches and handles overflow.
+**
+** \par Description
+**          Only used when the client is built with SBN_CLIENT_ASYNC_SEND,
+**          which has CFE_SB_SendMsg copy messages into a queue that a writer
+**          thread sends from.  Once a message is queued the writer waits up
+**          to LatencyBudgetUs for more, up to SBN_CLIENT_MAX_SEND_BATCH, to
+**          send in the same system call.  FullPolicy says what SendMsg does
+**          when the queue is full: #SBN_CLIENT_SEND_QUEUE_BLOCK waits for 
+**          room, #SBN_CLIENT_SEND_QUEUE_DROP drops the message and returns
+**          CFE_SUCCESS, #SBN_CLIENT_SEND_QUEUE_EAGAIN returns 
+**          CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR.
+**
+** \param[in]  FullPolicy      One of the SBN_CLIENT_SEND_QUEUE_ policies.
+**
+** \param[in]  LatencyBudgetUs Longest a message waits for others, 0 sends
+**                             each as soon as the writer sees it.
+**
+** \return CFE_SUCCESS, or CFE_SB_BAD_ARGUMENT for an unknown policy
+**
+**/
+int32  SBN_Client_SetSendQueuePolicy(uint8, uint32);
+
+/*****************************************************************************/
+/** 
+** \brief Gets the number of messages the send queue dropped or failed to 
+**        send.
+**
+** \param[out] DroppedMsgs    Messages dropped because the queue was full.
+**
+** \param[out] SendErrors     Queued messages the writer could not send.
+**
+** \return CFE_SUCCESS, or CFE_SB_BAD_ARGUMENT for a NULL pointer
+**
+**/
+int32  SBN_Client_GetSendQueueCounts(uint32 *, uint32 *);
+
+/*****************************************************************************/
+/** 
+** \brief Holds back sends to SBN until #SBN_Client_Uncork.
+**
+** \par Description
+**          Sets TCP_CORK on the connection to SBN so the messages of a burst
+**          go out in full segments instead of one segment each.  The kernel
+**          sends what it holds after 200ms even if never uncorked.  A new
+**          connection after a reconnect starts uncorked.  Does nothing when
+**          the client reaches SBN over a Unix domain socket or shared
+**          memory.
+**
+** \return CFE_SUCCESS, or SERVER_SOCKET_ERROR if the connection cannot be
+**         corked
+**
+**/
+int32  SBN_Client_Cork(void);
+
+/*****************************************************************************/
+/** 
+** \brief Sends anything held back by #SBN_Client_Cork.
+**
+** \return CFE_SUCCESS, or SERVER_SOCKET_ERROR if the connection cannot be
+**         uncorked
+**
+**/
+int32  SBN_Client_Uncork(void);
+
 /*****************************************************************************/
 /** 
 ** \brief SBN_Client replacement for CFE_SB_RcvMsg that 
@@ -128,10 +370,39 @@ int32  __wrap_CFE_SB_RcvMsg(CFE_SB_MsgPtr_t *, CFE_SB_PipeId_t, int32);
 
 /*****************************************************************************/
 /** 
-** \brief SBN_Client replacement for CFE_SB_ZeroCopySend that 
+** \brief SBN_Client replacement for CFE_SB_ZeroCopyGetPtr that gets a 
+**        message buffer to fill in place.
+**
+** \par Description see \ref CFEAPISBZeroCopy
+**          Buffers come from the client's message buffer pool with room 
+**          for the SBN header ahead of the message, so sending one copies
+**          nothing.  An app may hold SBN_CLIENT_MAX_ZERO_COPY_BUFFERS at 
+**          once.
+**
+**/
+CFE_SB_Msg_t *__wrap_CFE_SB_ZeroCopyGetPtr(uint16, CFE_SB_ZeroCopyHandle_t *);
+
+/*****************************************************************************/
+/** 
+** \brief SBN_Client replacement for CFE_SB_ZeroCopyReleasePtr that gives 
+**        back an unsent buffer.
+**
+** \par Description see \ref CFEAPISBZeroCopy
+**          \copybrief CFE_SB_ZeroCopyReleasePtr
+**
+**/
+int32 __wrap_CFE_SB_ZeroCopyReleasePtr(CFE_SB_Msg_t *, 
+                                       CFE_SB_ZeroCopyHandle_t);
+
+/*****************************************************************************/
+/** 
+** \brief SBN_Client replacement for CFE_SB_ZeroCopySend that sends a 
+**        buffer from CFE_SB_ZeroCopyGetPtr.
 **
-** \par Description 
-**          CFE_SB_ZeroCopySend not yet implemented.
+** \par Description see \ref CFEAPISBZeroCopy
+**          The SBN header is packed into the space kept for it and the
+**          buffer sent as it is, or handed to the send queue writer.  The
+**          buffer goes back to the pool once sent.
 **
 **/
 int32 __wrap_CFE_SB_ZeroCopySend(CFE_SB_Msg_t *, CFE_SB_ZeroCopyHandle_t);
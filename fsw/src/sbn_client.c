@@ -10,13 +10,17 @@
 ** See "NOSA GSC-18396-1.pdf"
 */
 
+#include <time.h>
+
 #include "sbn_client.h"
+#include "sbn_client_buffers.h"
+#include "sbn_client_health.h"
 #include "sbn_client_ingest.h"
+#include "sbn_client_routing.h"
 #include "sbn_client_utils.h"
 
 /* Global variables */
 CFE_SBN_Client_PipeD_t PipeTbl[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
-MsgId_to_pipes_t MsgId_Subscriptions[CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE];
 int sbn_client_sockfd = 0;
 int sbn_client_cpuId = 0;
 // TODO: Our use of sockfd is not uniform. Should pass to each function XOR use as global
@@ -25,13 +29,25 @@ int sbn_client_cpuId = 0;
 
 void CFE_SBN_Client_InitPipeTbl(void)
 {
-    uint8  i;
+    uint8              i;
+    pthread_condattr_t cond_attr;
+
+    /* RcvMsg timeouts are measured on the monotonic clock */
+    pthread_condattr_init(&cond_attr);
+    pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
 
     for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++){
+        pthread_mutex_init(&PipeTbl[i].Lock, NULL);
+        pthread_cond_init(&PipeTbl[i].MsgAvail, &cond_attr);
+        pthread_cond_init(&PipeTbl[i].SpaceAvail, NULL);
+        pthread_cond_init(&PipeTbl[i].NoProducers, NULL);
         invalidate_pipe(&PipeTbl[i]);
     }/* end for */
     
+    pthread_condattr_destroy(&cond_attr);
     
+    CFE_SBN_Client_InitRoutingTbl();
+    CFE_SBN_Client_InitBufferPool();
 }
 
 CFE_SB_PipeId_t CFE_SBN_Client_GetAvailPipeIdx(void)
@@ -51,48 +67,86 @@ CFE_SB_PipeId_t CFE_SBN_Client_GetAvailPipeIdx(void)
 }
 
 /**
- * \brief Sends a local subscription over the wire to a peer.
+ * \brief Sends local subscriptions over the wire to SBN, packing as many into
+ * each frame as the protocol allows.
  *
- * @param[in] SubType Whether this is a subscription or unsubscription.
- * @param[in] MsgID The CCSDS message ID being (un)subscribed.
- * @param[in] QoS The CCSDS quality of service being (un)subscribed.
- * @param[in] Peer The Peer interface
+ * @param[in] SubType Whether these are subscriptions or unsubscriptions.
+ * @param[in] MsgIds The CCSDS message IDs being (un)subscribed.
+ * @param[in] QoS The CCSDS quality of service of each, in step with MsgIds.
+ * @param[in] Count How many MsgIds there are.
  */
-void SendSubToSbn(int SubType, CFE_SB_MsgId_t MsgID,
-    CFE_SB_Qos_t QoS)
+void SendSubsToSbn(int SubType, const CFE_SB_MsgId_t *MsgIds,
+    const CFE_SB_Qos_t *QoS, uint16 Count)
 {
-    char Buf[SBN_PACKED_SUB_SZ] = {0};
+    char   Buf[SBN_PACKED_SUB_SZ] = {0};
     Pack_t Pack;
-    Pack_Init(&Pack, Buf, SBN_PACKED_SUB_SZ, 0);
-    Pack_UInt16(&Pack, 54);
-    Pack_UInt8(&Pack, SubType);
-    Pack_UInt32(&Pack, 2);
-    Pack_Data(&Pack, (void *)SBN_IDENT, (size_t)SBN_IDENT_LEN);
-    Pack_UInt16(&Pack, 1);
-
-    Pack_MsgID(&Pack, MsgID);
-    Pack_Data(&Pack, &QoS, sizeof(QoS)); /* 2 uint8's */
-    
-    size_t write_result = write_message(sbn_client_sockfd, Buf, Pack.BufUsed);
+    Pack_t Hdr;
+    uint16 FrameCount;
+    uint16 i;
     
-    if (write_result != Pack.BufUsed)
+    while (Count > 0)
     {
-      log_message("SBN_CLIENT: ERROR SendSubToSbn!!\n");
-    }
+        FrameCount = Count < SBN_MAX_SUBS_PER_PEER ? 
+                     Count : SBN_MAX_SUBS_PER_PEER;
+        
+        /* the body first, the header needs its size */
+        Pack_Init(&Pack, Buf + SBN_PACKED_HDR_SZ, 
+                  SBN_PACKED_SUB_SZ - SBN_PACKED_HDR_SZ, 0);
+        Pack_Data(&Pack, (void *)SBN_IDENT, (size_t)SBN_IDENT_LEN);
+        Pack_UInt16(&Pack, FrameCount);
+        
+        for(i = 0; i < FrameCount; i++)
+        {
+            Pack_MsgID(&Pack, MsgIds[i]);
+            Pack_Data(&Pack, (void *)&QoS[i], sizeof(QoS[i])); /* 2 uint8's */
+        }/* end for */
+        
+        Pack_Init(&Hdr, Buf, SBN_PACKED_HDR_SZ, 0);
+        Pack_UInt16(&Hdr, Pack.BufUsed);
+        Pack_UInt8(&Hdr, SubType);
+        Pack_UInt32(&Hdr, 2);
+        
+        size_t write_result = write_message(sbn_client_sockfd, Buf, 
+                                            SBN_PACKED_HDR_SZ + Pack.BufUsed);
+        
+        if (write_result != SBN_PACKED_HDR_SZ + Pack.BufUsed)
+        {
+          log_message("SBN_CLIENT: ERROR SendSubsToSbn!!\n");
+        }
+        
+        MsgIds += FrameCount;
+        QoS += FrameCount;
+        Count -= FrameCount;
+    }/* end while */
     
-}/* end SendLocalSubToPeer */
+}/* end SendSubsToSbn */
 
+/**
+ * \brief Sends a local subscription over the wire to SBN.
+ *
+ * @param[in] SubType Whether this is a subscription or unsubscription.
+ * @param[in] MsgID The CCSDS message ID being (un)subscribed.
+ * @param[in] QoS The CCSDS quality of service being (un)subscribed.
+ */
+void SendSubToSbn(int SubType, CFE_SB_MsgId_t MsgID,
+    CFE_SB_Qos_t QoS)
+{
+    SendSubsToSbn(SubType, &MsgID, &QoS, 1);
+}/* end SendSubToSbn */
 
 int32 recv_msg(int32 sockfd)
 {
     unsigned char sbn_hdr_buffer[SBN_PACKED_HDR_SZ];
-    unsigned char msg[CFE_SB_MAX_SB_MSG_SIZE];
     SBN_MsgSz_t MsgSz;
     SBN_MsgType_t MsgType;
     uint32 CpuID;
     
-    int status = CFE_SBN_CLIENT_ReadBytes(sockfd, sbn_hdr_buffer, 
-                                          SBN_PACKED_HDR_SZ);
+    int status;
+    
+    CFE_SBN_CLIENT_StartFrame();
+    
+    status = CFE_SBN_CLIENT_ReadBytes(sockfd, sbn_hdr_buffer, 
+                                      SBN_PACKED_HDR_SZ);
     
     if (status != CFE_SUCCESS)
     {
@@ -106,29 +160,32 @@ int32 recv_msg(int32 sockfd)
         Unpack_UInt16(&Unpack, &MsgSz);
         Unpack_UInt8(&Unpack, &MsgType);
         Unpack_UInt32(&Unpack, &CpuID);
+        
+        CFE_SBN_Client_HealthHeard(MsgType == SBN_HEARTBEAT_MSG, 
+                                   CFE_SBN_Client_MonotonicMs());
 
         //TODO: check cpuID to see if it is correct for this location?
 
+        /* Frames the client does not use are skipped over in the receive 
+         * buffer rather than copied out */
+
         switch(MsgType)
         {
             case SBN_NO_MSG:
-                status = CFE_SBN_CLIENT_ReadBytes(sockfd, msg, MsgSz);
+                status = CFE_SBN_CLIENT_DiscardBytes(sockfd, MsgSz);
                 break;
             case SBN_SUB_MSG:
-                status = CFE_SBN_CLIENT_ReadBytes(sockfd, msg, MsgSz);
-                break;
             case SBN_UNSUB_MSG:
-                status = CFE_SBN_CLIENT_ReadBytes(sockfd, msg, MsgSz);
+                status = ingest_sub_message(sockfd, MsgSz, MsgType);
                 break;
             case SBN_APP_MSG:
-                ingest_app_message(sockfd, MsgSz);
-                status = CFE_SUCCESS;
+                status = ingest_app_message(sockfd, MsgSz);
                 break;
             case SBN_PROTO_MSG:      
-                status = CFE_SBN_CLIENT_ReadBytes(sockfd, msg, MsgSz);
+                status = CFE_SBN_CLIENT_DiscardBytes(sockfd, MsgSz);
                 break;
             case SBN_HEARTBEAT_MSG:
-                status = CFE_SBN_CLIENT_ReadBytes(sockfd, msg, MsgSz);
+                status = CFE_SBN_CLIENT_DiscardBytes(sockfd, MsgSz);
                 break;
 
             default:
@@ -26,6 +26,8 @@
 
 #define CFE_SBN_CLIENT_NOT_IN_USE               0
 #define CFE_SBN_CLIENT_IN_USE                   1
+/* DeletePipe is tearing the pipe down, the slot is not free yet */
+#define CFE_SBN_CLIENT_CLOSING                  2
 #define CFE_SBN_CLIENT_UNUSED_QUEUE             0xFFFF
 #define CFE_SBN_CLIENT_BAD_ARGUMENT             CFE_SB_BAD_ARGUMENT
 #define CFE_SBN_CLIENT_INVALID_PIPE             0xFF
@@ -44,6 +46,14 @@
 #define CFE_SBN_CLIENT_PIPE_CR_ERR              ((int32)0xca001005)
 #define SBN_CLIENT_HEART_THREAD_CREATE_EID      1012
 #define SBN_CLIENT_RECEIVE_THREAD_CREATE_EID    1013
+#define CFE_SBN_CLIENT_PIPE_FULL_ERR            1014
+#define SBN_CLIENT_EVENT_LOOP_CREATE_EID        1015
+#define SBN_CLIENT_INIT_THREAD_CREATE_EID       1016
+#define SBN_CLIENT_INIT_PENDING                 1017
+#define CFE_SBN_CLIENT_READ_TIMEOUT_ERR         1018
+#define SBN_CLIENT_SEND_THREAD_CREATE_EID       1019
+#define CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR      1020
+#define CFE_SBN_CLIENT_MSG_LIM_ERR              1021
 
 #define CFE_SBN_CLIENT_INVALID_MSG_ID           0
 #define CFE_SBN_CLIENT_NO_PROTOCOL              0
@@ -52,6 +62,7 @@
 #define SERVER_INET_PTON_SRC_ERROR              -2
 #define SERVER_INET_PTON_INVALID_AF_ERROR       -3
 #define SERVER_CONNECT_ERROR                    -4
+#define SERVER_PATH_ERROR                       -5
 
 
 /*************************************************************************
@@ -62,6 +73,8 @@ void CFE_SBN_Client_InitPipeTbl(void);
 CFE_SB_PipeId_t CFE_SBN_Client_GetAvailPipeIdx(void);
 int32 recv_msg(int32);
 void SendSubToSbn(int, CFE_SB_MsgId_t, CFE_SB_Qos_t);
+void SendSubsToSbn(int, const CFE_SB_MsgId_t *, const CFE_SB_Qos_t *, uint16);
+void CFE_SBN_Client_ResendSubscriptions(void);
 
 #endif /* _sbn_client_h_ */
 
@@ -0,0 +1,187 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <stdlib.h>
+
+#include "sbn_client_buffers.h"
+
+/* A buffer is free when its UseCount is 0.  Buffers are taken by moving the
+ * UseCount from 0 to 1 with a compare and swap and returned by the release
+ * that drops it back to 0, so neither the receive thread nor the app threads
+ * releasing buffers in RcvMsg ever wait on each other.  A free buffer keeps
+ * its memory, so after start up messages reuse buffers of their size class
+ * instead of allocating. */
+static CFE_SBN_Client_BufferD_t BufferPool[CFE_SBN_CLIENT_MAX_BUFFERS];
+/* where the search for a free buffer starts, buffers are mostly released in
+ * the order they were taken so this is usually free */
+static uint32 next_buffer = 0;
+
+/* smallest power of two size class, from CFE_SBN_CLIENT_MIN_BUFFER_SIZE up,
+ * that holds Size bytes */
+static uint32 size_class(uint32 Size)
+{
+    uint32 class_size = CFE_SBN_CLIENT_MIN_BUFFER_SIZE;
+    
+    while (class_size < Size)
+    {
+        class_size <<= 1;
+    }
+    
+    if (class_size > CFE_SBN_CLIENT_MAX_MESSAGE_SIZE)
+    {
+        class_size = CFE_SBN_CLIENT_MAX_MESSAGE_SIZE;
+    }
+    
+    return class_size;
+}
+
+/* take_free_buffer takes the first free buffer from start on whose memory is
+ * ClassSize bytes, or any free buffer when ClassSize is 0 */
+static CFE_SBN_Client_BufferD_t *take_free_buffer(uint32 start, 
+                                                  uint32 ClassSize)
+{
+    uint32 i;
+
+    for(i = 0; i < CFE_SBN_CLIENT_MAX_BUFFERS; i++)
+    {
+        uint32 idx = (start + i) % CFE_SBN_CLIENT_MAX_BUFFERS;
+        CFE_SBN_Client_BufferD_t *buf = &BufferPool[idx];
+        uint16 unused = 0;
+
+        if (ClassSize != 0 && 
+            __atomic_load_n(&buf->Capacity, __ATOMIC_RELAXED) != ClassSize)
+        {
+            continue;
+        }
+
+        if (__atomic_compare_exchange_n(&buf->UseCount, &unused, 1, 0,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            __atomic_store_n(&next_buffer,
+                             (idx + 1) % CFE_SBN_CLIENT_MAX_BUFFERS,
+                             __ATOMIC_RELAXED);
+
+            return buf;
+        }
+
+    }
+
+    return NULL;
+}
+
+void CFE_SBN_Client_InitBufferPool(void)
+{
+    uint32 i;
+
+    for(i = 0; i < CFE_SBN_CLIENT_MAX_BUFFERS; i++)
+    {
+        free(BufferPool[i].Buffer);
+        BufferPool[i].MsgId    = CFE_SBN_CLIENT_INVALID_MSG_ID;
+        BufferPool[i].Size     = 0;
+        BufferPool[i].Buffer   = NULL;
+        __atomic_store_n(&BufferPool[i].Capacity, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&BufferPool[i].UseCount, 0, __ATOMIC_RELEASE);
+    }
+
+    __atomic_store_n(&next_buffer, 0, __ATOMIC_RELAXED);
+}
+
+CFE_SBN_Client_BufferD_t *CFE_SBN_Client_GetBuffer(CFE_SB_MsgId_t MsgId,
+                                                   uint32 Size)
+{
+    uint32 start, class_size;
+    CFE_SBN_Client_BufferD_t *buf;
+
+    if (Size > CFE_SBN_CLIENT_MAX_MESSAGE_SIZE)
+    {
+        return NULL;
+    }
+
+    start = __atomic_load_n(&next_buffer, __ATOMIC_RELAXED);
+    class_size = size_class(Size);
+
+    buf = take_free_buffer(start, class_size);
+
+    if (buf == NULL)
+    {
+        buf = take_free_buffer(start, 0);
+    }
+
+    if (buf == NULL)
+    {
+        return NULL;
+    }
+
+    if (buf->Capacity < Size)
+    {
+        free(buf->Buffer);
+        buf->Buffer = malloc(class_size);
+
+        if (buf->Buffer == NULL)
+        {
+            __atomic_store_n(&buf->Capacity, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&buf->UseCount, 0, __ATOMIC_RELEASE);
+            return NULL;
+        }
+
+        __atomic_store_n(&buf->Capacity, class_size, __ATOMIC_RELAXED);
+    }
+
+    buf->MsgId = MsgId;
+    buf->Size  = Size;
+
+    return buf;
+}
+
+void CFE_SBN_Client_RetainBuffer(CFE_SBN_Client_BufferD_t *BufDscPtr)
+{
+    __atomic_add_fetch(&BufDscPtr->UseCount, 1, __ATOMIC_RELAXED);
+}
+
+void CFE_SBN_Client_ReleaseBuffer(CFE_SBN_Client_BufferD_t *BufDscPtr)
+{
+    if (BufDscPtr == NULL)
+    {
+        return;
+    }
+
+    /* release so the next taker sees every reader finished with it */
+    __atomic_sub_fetch(&BufDscPtr->UseCount, 1, __ATOMIC_ACQ_REL);
+}
+
+boolean CFE_SBN_Client_IsTakenBuffer(CFE_SBN_Client_BufferD_t *BufDscPtr)
+{
+    uintptr_t offset = (uintptr_t)BufDscPtr - (uintptr_t)BufferPool;
+
+    if (BufDscPtr == NULL || offset >= sizeof(BufferPool) ||
+        offset % sizeof(BufferPool[0]) != 0)
+    {
+        return FALSE;
+    }
+
+    return __atomic_load_n(&BufDscPtr->UseCount, __ATOMIC_RELAXED) != 0;
+}
+
+uint32 CFE_SBN_Client_BuffersInUse(void)
+{
+    uint32 i, in_use = 0;
+
+    for(i = 0; i < CFE_SBN_CLIENT_MAX_BUFFERS; i++)
+    {
+        if (__atomic_load_n(&BufferPool[i].UseCount, __ATOMIC_RELAXED) != 0)
+        {
+            in_use++;
+        }
+    }
+
+    return in_use;
+}
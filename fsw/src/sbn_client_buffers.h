@@ -0,0 +1,105 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_buffers_h_
+#define _sbn_client_buffers_h_
+
+#include "sbn_interfaces.h"
+#include "sbn_client_utils.h"
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTBuffers sbn_client shared message buffers
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief Returns every message buffer to the pool.
+**
+** \par Description
+**          Called when the pipe table is initialized, no pipe may still hold
+**          a buffer descriptor.  Memory allocated for the buffers is freed.
+**
+**/
+void CFE_SBN_Client_InitBufferPool(void);
+
+/*****************************************************************************/
+/**
+** \brief Takes a message buffer from the pool.
+**
+** \par Description
+**          The returned buffer has a UseCount of 1, which belongs to the
+**          caller.  Each pipe the buffer is delivered to takes its own
+**          reference with #CFE_SBN_Client_RetainBuffer, so one copy of a
+**          message serves every subscribed pipe.  A free buffer already
+**          sized for Size is preferred, otherwise a free buffer is given
+**          memory for Size rounded up to its size class.
+**
+** \param[in]  MsgId        The message id of the message to be stored.
+**
+** \param[in]  Size         Size in bytes of the message to be stored.
+**
+** \return Buffer descriptor, or NULL when Size is too large, no buffer is
+**         free or its memory cannot be allocated
+**
+**/
+CFE_SBN_Client_BufferD_t *CFE_SBN_Client_GetBuffer(CFE_SB_MsgId_t MsgId,
+                                                   uint32 Size);
+
+/*****************************************************************************/
+/**
+** \brief Adds a reference to a message buffer.
+**
+** \param[in]  BufDscPtr    The buffer, which must already be referenced.
+**
+**/
+void CFE_SBN_Client_RetainBuffer(CFE_SBN_Client_BufferD_t *BufDscPtr);
+
+/*****************************************************************************/
+/**
+** \brief Drops a reference to a message buffer.
+**
+** \par Description
+**          The buffer returns to the pool when its last reference is dropped.
+**          A NULL BufDscPtr is ignored.
+**
+** \param[in]  BufDscPtr    The buffer.
+**
+**/
+void CFE_SBN_Client_ReleaseBuffer(CFE_SBN_Client_BufferD_t *BufDscPtr);
+
+/*****************************************************************************/
+/**
+** \brief Checks that a pointer is a buffer taken from the pool.
+**
+** \par Description
+**          Used to check buffer handles apps pass back to the client.
+**
+** \param[in]  BufDscPtr    The pointer to check.
+**
+** \return TRUE if BufDscPtr is a pool buffer with a UseCount above 0
+**
+**/
+boolean CFE_SBN_Client_IsTakenBuffer(CFE_SBN_Client_BufferD_t *BufDscPtr);
+
+/*****************************************************************************/
+/**
+** \brief Counts the buffers currently taken from the pool.
+**
+** \return Number of buffers with a UseCount above 0
+**
+**/
+uint32 CFE_SBN_Client_BuffersInUse(void);
+/**@}*/
+
+#endif /* _sbn_client_buffers_h_ */
@@ -18,11 +18,155 @@
 #define SBN_CLIENT_PORT    1234
 #define SBN_CLIENT_IP_ADDR "127.0.0.1"
 
-#define CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE   32
+/* How the client reaches SBN by default: TCP to IP_ADDR and PORT, or, when
+ * cFS runs on the same host, a Unix domain stream socket at UNIX_PATH, which
+ * skips the TCP/IP stack.  TCP keepalive and corking do not apply to a Unix
+ * socket, whose peer going away is seen at once.  CFE_SBN_Client_SetTransport
+ * picks another before SBN_Client_Init (see sbn_client_transport.h). */
+#define SBN_CLIENT_TRANSPORT_TCP   0
+#define SBN_CLIENT_TRANSPORT_UNIX  1
+#define SBN_CLIENT_TRANSPORT_SHM   2
+#ifndef SBN_CLIENT_TRANSPORT
+#define SBN_CLIENT_TRANSPORT       SBN_CLIENT_TRANSPORT_TCP
+#endif
+#define SBN_CLIENT_UNIX_PATH       "/tmp/sbn_client.sock"
+
+/* The shared memory transport: SBN's side creates the POSIX shared memory
+ * object SHM_NAME holding a byte ring of SHM_RING_SZ (a power of two) each 
+ * way, and frames are copied through them with no system call unless a side
+ * is asleep.  A side waiting on the other checks every SHM_CHECK_MS that the
+ * other is still there.  It has no descriptor to poll, so the event loop
+ * (SBN_CLIENT_USE_EVENT_LOOP) cannot run over it. */
+#define SBN_CLIENT_SHM_NAME        "/sbn_client"
+#define SBN_CLIENT_SHM_RING_SZ     (256 * 1024)
+#define SBN_CLIENT_SHM_CHECK_MS    100
+
+/* Connecting to SBN: each attempt waits at most CONNECT_TIMEOUT_MS for SBN to
+ * accept, and a refused or timed out attempt is retried up to 
+ * CONNECT_ATTEMPTS times in all.  The wait before a retry starts at 
+ * CONNECT_RETRY_MS and doubles up to CONNECT_MAX_RETRY_MS. */
+#define SBN_CLIENT_CONNECT_TIMEOUT_MS      1000
+#define SBN_CLIENT_CONNECT_ATTEMPTS        5
+#define SBN_CLIENT_CONNECT_RETRY_MS        100
+#define SBN_CLIENT_CONNECT_MAX_RETRY_MS    2000
+
+/* Dead connection detection: once the first byte of a frame has arrived the
+ * rest must follow within FRAME_DEADLINE_MS, with no gap longer than 
+ * STALL_TIMEOUT_MS, or the connection is reconnected.  Between frames the
+ * connection is checked by TCP keepalive probes, sent after KEEPALIVE_IDLE_S
+ * without traffic and every KEEPALIVE_INTVL_S after that, KEEPALIVE_CNT 
+ * unanswered probes ending the connection.  Data sent and not acknowledged 
+ * for as long also ends it. */
+#define SBN_CLIENT_FRAME_DEADLINE_MS       5000
+#define SBN_CLIENT_STALL_TIMEOUT_MS        1000
+#define SBN_CLIENT_KEEPALIVE_IDLE_S        5
+#define SBN_CLIENT_KEEPALIVE_INTVL_S       1
+#define SBN_CLIENT_KEEPALIVE_CNT           3
+
+/* SBN_Client_SendMsgBatch sends up to MAX_SEND_BATCH messages per syscall */
+#define SBN_CLIENT_MAX_SEND_BATCH          32
+
+/* Set SBN_CLIENT_ASYNC_SEND to 1 for SendMsg to queue messages for a writer
+ * thread instead of sending them itself.  The queue holds SEND_QUEUE_DEPTH
+ * messages, a power of two.  Once a message is queued the writer waits up to
+ * SEND_LATENCY_US for more to send with it, and what SendMsg does when the
+ * queue is full is SEND_QUEUE_FULL_POLICY, one of the SBN_CLIENT_SEND_QUEUE_
+ * policies; both can be changed with SBN_Client_SetSendQueuePolicy. */
+#ifndef SBN_CLIENT_ASYNC_SEND
+#define SBN_CLIENT_ASYNC_SEND              0
+#endif
+#define SBN_CLIENT_SEND_QUEUE_DEPTH        256
+#define SBN_CLIENT_SEND_LATENCY_US         200
+#define SBN_CLIENT_SEND_QUEUE_FULL_POLICY  SBN_CLIENT_SEND_QUEUE_BLOCK
+
+/* Messages of at least ZEROCOPY_MIN_SZ bytes (SBN header included) are sent
+ * with MSG_ZEROCOPY, the kernel sending straight from the app's message 
+ * instead of copying it.  SendMsg then waits, at most ZEROCOPY_WAIT_MS, for 
+ * the kernel to finish with the message, which only pays for large messages.
+ * Other sends go on meanwhile.  A message not seen finished in time is still
+ * sent, and counted in ZeroCopyLate of the link health.  0 turns zero copy 
+ * off. */
+#ifndef SBN_CLIENT_ZEROCOPY_MIN_SZ
+#define SBN_CLIENT_ZEROCOPY_MIN_SZ         0
+#endif
+#define SBN_CLIENT_ZEROCOPY_WAIT_MS        1000
+
+/* Reconnecting to SBN: after MAX_CONSECUTIVE_RECV_ERRORS the receive side 
+ * reconnects, waiting about RECONNECT_MIN_MS before the second attempt and
+ * doubling up to RECONNECT_MAX_MS, each wait randomly shortened by up to half
+ * so clients don't all come back at once.  Retries go on until connected or 
+ * the client is shut down.  Set SBN_CLIENT_AUTO_RECONNECT to 0 to stop the 
+ * client instead, as older versions did. */
+#ifndef SBN_CLIENT_AUTO_RECONNECT
+#define SBN_CLIENT_AUTO_RECONNECT          1
+#endif
+#define SBN_CLIENT_RECONNECT_MIN_MS        100
+#define SBN_CLIENT_RECONNECT_MAX_MS        5000
+
+/* Set to 1 to run heartbeats and receives from one epoll event loop thread
+ * instead of a heartbeat thread and a receive thread */
+#ifndef SBN_CLIENT_USE_EVENT_LOOP
+#define SBN_CLIENT_USE_EVENT_LOOP   0
+#endif
+
+/* Entries in the MsgId routing index, must be a power of two and should be 
+ * about twice the number of distinct MsgIds subscribed to */
+#define CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE   64
+
+/* Once SBN has announced what its side subscribes to, messages with MsgIds 
+ * nobody there wants are not sent; set SKIP_UNWANTED_SENDS to 0 to send 
+ * everything.  The announced MsgIds are kept in an index of 
+ * REMOTE_INTEREST_MAP_SIZE entries, a power of two that should be about 
+ * twice SBN_MAX_SUBS_PER_PEER; if it fills up nothing is skipped. */
+#ifndef SBN_CLIENT_SKIP_UNWANTED_SENDS
+#define SBN_CLIENT_SKIP_UNWANTED_SENDS              1
+#endif
+#define SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE         512
+
+/* Messages an app sends are also put straight into the client's own pipes 
+ * subscribed to them, SubscribeLocal ones included, without going through 
+ * SBN; set LOCAL_DELIVERY to 0 if SBN sends them back instead.  
+ * LOCAL_SENDERS is how many app threads are expected to send at once, each 
+ * needs a buffer while it delivers. */
+#ifndef SBN_CLIENT_LOCAL_DELIVERY
+#define SBN_CLIENT_LOCAL_DELIVERY                   1
+#endif
+#define SBN_CLIENT_LOCAL_SENDERS                    4
 #define SBN_HEARTBEAT_MSG                           0xA0
 #define CFE_SBN_CLIENT_MAX_MESSAGE_SIZE             CFE_SB_MAX_SB_MSG_SIZE
 #define CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE         4
 #define CFE_PLATFORM_SBN_CLIENT_MAX_PIPES           5 /* CFE_PLATFORM_SB_MAX_PIPES could be used */
 #define CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH      32
 
+/* MsgLim of a CFE_SB_Subscribe subscription, the most of its messages that 
+ * may wait in the pipe; SubscribeEx and SubscribeLocal take their own. */
+#define SBN_CLIENT_DEFAULT_MSG_LIM      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH
+
+/* Receive buffer for frames from SBN; one read() fills as much of it as the 
+ * socket has available. Message remainders of at least 
+ * SBN_CLIENT_RECV_DIRECT_READ_SZ bytes are read straight into their 
+ * destination instead of through the buffer. */
+#define SBN_CLIENT_RECV_BUF_SZ                      (64 * 1024)
+#define SBN_CLIENT_RECV_DIRECT_READ_SZ              (16 * 1024)
+
+/* Buffers apps may hold at once from CFE_SB_ZeroCopyGetPtr */
+#define SBN_CLIENT_MAX_ZERO_COPY_BUFFERS   8
+
+/* Shared message buffers. Every pipe can hold at most MAX_PIPE_DEPTH buffers 
+ * plus the one last handed to the app and the receive thread fills one more, 
+ * so the pool cannot run dry before the pipes overflow.  The send queue adds
+ * a buffer for each message it holds and each one its writer is sending, 
+ * zero copy sends add the buffers apps may hold and local delivery one for
+ * each app thread sending.  Buffer memory is 
+ * only allocated when a buffer is first used, in power of two size classes 
+ * starting at MIN_BUFFER_SIZE, so small messages take small buffers. */
+#define CFE_SBN_CLIENT_MAX_BUFFERS  \
+  (CFE_PLATFORM_SBN_CLIENT_MAX_PIPES * \
+   (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH + 1) + 1 + \
+   SBN_CLIENT_MAX_ZERO_COPY_BUFFERS + \
+   SBN_CLIENT_LOCAL_DELIVERY * SBN_CLIENT_LOCAL_SENDERS + \
+   SBN_CLIENT_ASYNC_SEND * \
+   (SBN_CLIENT_SEND_QUEUE_DEPTH + SBN_CLIENT_MAX_SEND_BATCH))
+#define CFE_SBN_CLIENT_MIN_BUFFER_SIZE              64
+
 #endif /* _sbn_client_defs_h_ */
\ No newline at end of file
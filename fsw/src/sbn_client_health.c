@@ -0,0 +1,248 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <linux/sockios.h>
+
+#include "sbn_client_health.h"
+
+#define NEVER_MS    0 /* a time of 0 means it has not happened */
+
+/* Link health is written by the receive thread (frames heard) and the
+ * heartbeat thread (heartbeats sent, TCP samples), and read by the app.
+ * last_heard_ms changes with every frame so it is atomic; the rest changes
+ * every few seconds and is kept under health_lock, read locked by the app. */
+static uint64          last_heard_ms = NEVER_MS;
+static pthread_rwlock_t health_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+static boolean link_up = FALSE;
+static uint32  reconnects = 0;
+
+/* heartbeat arrivals; jitter is the RFC 3550 estimator, kept times 16 so
+ * the 1/16 gain works in integers */
+static uint64  last_heartbeat_ms = NEVER_MS;
+static uint32  heartbeats_received = 0;
+static uint32  heartbeat_interval_ms = 0;
+static uint32  heartbeat_jitter_x16 = 0;
+
+static uint32  heartbeats_sent = 0;
+static uint32  heartbeat_send_errors = 0;
+
+static uint32  zerocopy_late = 0;
+
+static uint64  tcp_sample_ms = NEVER_MS;
+static uint32  tcp_rtt_us = 0;
+static uint32  tcp_rtt_var_us = 0;
+static uint32  tcp_retransmits = 0;
+static uint32  tcp_lost = 0;
+static uint32  tcp_unacked_bytes = 0;
+
+
+void CFE_SBN_Client_HealthReset(void)
+{
+    __atomic_store_n(&last_heard_ms, NEVER_MS, __ATOMIC_RELAXED);
+
+    pthread_rwlock_wrlock(&health_lock);
+
+    link_up = TRUE;
+    last_heartbeat_ms = NEVER_MS;
+    heartbeats_received = 0;
+    heartbeat_interval_ms = 0;
+    heartbeat_jitter_x16 = 0;
+    tcp_sample_ms = NEVER_MS;
+
+    pthread_rwlock_unlock(&health_lock);
+} /* end CFE_SBN_Client_HealthReset */
+
+
+void CFE_SBN_Client_HealthLinkState(boolean LinkUp)
+{
+
+    if (LinkUp)
+    {
+        CFE_SBN_Client_HealthReset();
+    } /* end if */
+
+    pthread_rwlock_wrlock(&health_lock);
+
+    if (LinkUp)
+    {
+        reconnects++;
+    } /* end if */
+
+    link_up = LinkUp;
+
+    pthread_rwlock_unlock(&health_lock);
+} /* end CFE_SBN_Client_HealthLinkState */
+
+
+void CFE_SBN_Client_HealthHeard(boolean IsHeartbeat, uint64 NowMs)
+{
+    uint32 interval_ms;
+    int32  change_ms;
+
+    __atomic_store_n(&last_heard_ms, NowMs, __ATOMIC_RELAXED);
+
+    if (!IsHeartbeat)
+    {
+        return;
+    } /* end if */
+
+    pthread_rwlock_wrlock(&health_lock);
+
+    if (last_heartbeat_ms != NEVER_MS)
+    {
+        interval_ms = (uint32)(NowMs - last_heartbeat_ms);
+
+        /* jitter needs two intervals to compare */
+        if (heartbeats_received > 1)
+        {
+            change_ms = (int32)(interval_ms - heartbeat_interval_ms);
+
+            if (change_ms < 0)
+            {
+                change_ms = -change_ms;
+            } /* end if */
+
+            heartbeat_jitter_x16 += change_ms -
+                                    ((heartbeat_jitter_x16 + 8) >> 4);
+        } /* end if */
+
+        heartbeat_interval_ms = interval_ms;
+    } /* end if */
+
+    last_heartbeat_ms = NowMs;
+    heartbeats_received++;
+
+    pthread_rwlock_unlock(&health_lock);
+} /* end CFE_SBN_Client_HealthHeard */
+
+
+void CFE_SBN_Client_HealthHeartbeatSent(int SendResult)
+{
+    pthread_rwlock_wrlock(&health_lock);
+
+    if (SendResult < 0)
+    {
+        heartbeat_send_errors++;
+    }
+    else
+    {
+        heartbeats_sent++;
+    } /* end if */
+
+    pthread_rwlock_unlock(&health_lock);
+} /* end CFE_SBN_Client_HealthHeartbeatSent */
+
+
+void CFE_SBN_Client_HealthZeroCopyLate(void)
+{
+    pthread_rwlock_wrlock(&health_lock);
+
+    zerocopy_late++;
+
+    pthread_rwlock_unlock(&health_lock);
+} /* end CFE_SBN_Client_HealthZeroCopyLate */
+
+
+void CFE_SBN_Client_HealthSampleTcp(int SockFd)
+{
+    struct tcp_info info;
+    socklen_t       info_len = sizeof(info);
+    int             queued_bytes = 0;
+
+    if (getsockopt(SockFd, IPPROTO_TCP, TCP_INFO, &info, &info_len) < 0)
+    {
+        return;
+    } /* end if */
+
+    /* bytes sent and not yet acknowledged, plus any not yet sent */
+    if (ioctl(SockFd, SIOCOUTQ, &queued_bytes) < 0)
+    {
+        queued_bytes = 0;
+    } /* end if */
+
+    pthread_rwlock_wrlock(&health_lock);
+
+    tcp_sample_ms = CFE_SBN_Client_MonotonicMs();
+    tcp_rtt_us = info.tcpi_rtt;
+    tcp_rtt_var_us = info.tcpi_rttvar;
+    tcp_retransmits = info.tcpi_total_retrans;
+    tcp_lost = info.tcpi_lost;
+    tcp_unacked_bytes = queued_bytes;
+
+    pthread_rwlock_unlock(&health_lock);
+} /* end CFE_SBN_Client_HealthSampleTcp */
+
+
+/* ms_since gives how long ago then_ms was, or SBN_CLIENT_HEALTH_NEVER */
+static uint32 ms_since(uint64 now_ms, uint64 then_ms)
+{
+
+    if (then_ms == NEVER_MS)
+    {
+        return SBN_CLIENT_HEALTH_NEVER;
+    } /* end if */
+
+    if (now_ms <= then_ms)
+    {
+        return 0;
+    } /* end if */
+
+    if (now_ms - then_ms >= SBN_CLIENT_HEALTH_NEVER)
+    {
+        return SBN_CLIENT_HEALTH_NEVER - 1;
+    } /* end if */
+
+    return (uint32)(now_ms - then_ms);
+} /* end ms_since */
+
+
+int32 SBN_Client_GetLinkHealth(SBN_Client_LinkHealth_t *HealthPtr)
+{
+    uint64 now_ms;
+
+    if (HealthPtr == NULL)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    } /* end if */
+
+    now_ms = CFE_SBN_Client_MonotonicMs();
+
+    HealthPtr->MsSinceLastHeard = ms_since(now_ms,
+      __atomic_load_n(&last_heard_ms, __ATOMIC_RELAXED));
+
+    pthread_rwlock_rdlock(&health_lock);
+
+    HealthPtr->LinkUp = link_up;
+    HealthPtr->Reconnects = reconnects;
+    HealthPtr->MsSinceLastHeartbeat = ms_since(now_ms, last_heartbeat_ms);
+    HealthPtr->HeartbeatsReceived = heartbeats_received;
+    HealthPtr->HeartbeatIntervalMs = heartbeat_interval_ms;
+    HealthPtr->HeartbeatJitterMs = heartbeat_jitter_x16 >> 4;
+    HealthPtr->HeartbeatsSent = heartbeats_sent;
+    HealthPtr->HeartbeatSendErrors = heartbeat_send_errors;
+    HealthPtr->ZeroCopyLate = zerocopy_late;
+    HealthPtr->MsSinceTcpSample = ms_since(now_ms, tcp_sample_ms);
+    HealthPtr->TcpRttUs = tcp_rtt_us;
+    HealthPtr->TcpRttVarUs = tcp_rtt_var_us;
+    HealthPtr->TcpRetransmits = tcp_retransmits;
+    HealthPtr->TcpLost = tcp_lost;
+    HealthPtr->TcpUnackedBytes = tcp_unacked_bytes;
+
+    pthread_rwlock_unlock(&health_lock);
+
+    return CFE_SUCCESS;
+} /* end SBN_Client_GetLinkHealth */
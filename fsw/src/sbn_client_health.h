@@ -0,0 +1,95 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_health_h_
+#define _sbn_client_health_h_
+
+#include "sbn_client_utils.h"
+#include "sbn_client_init.h"
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTHealth sbn_client link health
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief Starts link health over for a new connection to SBN.
+**
+** \par Description
+**          Clears everything measured about the previous connection and
+**          marks the link up.  Reconnect and heartbeat counts are kept.
+**
+**/
+void CFE_SBN_Client_HealthReset(void);
+
+/*****************************************************************************/
+/**
+** \brief Records the link to SBN going down or coming back.
+**
+** \param[in]  LinkUp       TRUE when connected again, FALSE when lost.
+**
+**/
+void CFE_SBN_Client_HealthLinkState(boolean LinkUp);
+
+/*****************************************************************************/
+/**
+** \brief Records a frame received from SBN.
+**
+** \par Description
+**          Every frame updates when SBN was last heard from.  Heartbeats
+**          also update the heartbeat inter-arrival time and its jitter.
+**
+** \param[in]  IsHeartbeat  TRUE if the frame was an SBN heartbeat.
+**
+** \param[in]  NowMs        When it arrived, from #CFE_SBN_Client_MonotonicMs.
+**
+**/
+void CFE_SBN_Client_HealthHeard(boolean IsHeartbeat, uint64 NowMs);
+
+/*****************************************************************************/
+/**
+** \brief Records the result of sending a heartbeat to SBN.
+**
+** \param[in]  SendResult   What send_heartbeat returned, negative on error.
+**
+**/
+void CFE_SBN_Client_HealthHeartbeatSent(int SendResult);
+
+/*****************************************************************************/
+/**
+** \brief Records a zero copy send the kernel was not seen finishing.
+**
+** \par Description
+**          The message was sent, but the kernel may still have been reading
+**          it when the app got it back.
+**
+**/
+void CFE_SBN_Client_HealthZeroCopyLate(void);
+
+/*****************************************************************************/
+/**
+** \brief Samples the kernel's view of the connection to SBN.
+**
+** \par Description
+**          Reads TCP_INFO and the send queue of the socket.  Sockets that are
+**          not TCP leave the previous sample in place.
+**
+** \param[in]  SockFd       The socket connected to SBN.
+**
+**/
+void CFE_SBN_Client_HealthSampleTcp(int SockFd);
+
+/**@}*/
+
+#endif /* _sbn_client_health_h_ */
@@ -10,28 +10,86 @@
 ** See "NOSA GSC-18396-1.pdf"
 */
 
-#include <pthread.h>
 #include <string.h>
 
+#include "sbn_client_buffers.h"
 #include "sbn_client_ingest.h"
+#include "sbn_client_interest.h"
+#include "sbn_client_routing.h"
 
-pthread_mutex_t receive_mutex      = PTHREAD_MUTEX_INITIALIZER;
-pthread_cond_t  received_condition = PTHREAD_COND_INITIALIZER;
+/* Only the CCSDS header is needed to determine the MsgId, so that much is
+ * read first and the rest of the message is read straight into the shared
+ * buffer that every subscribed pipe will reference. */
+#ifndef MESSAGE_FORMAT_IS_CCSDS_VER_2
+#define SBN_CLIENT_INGEST_HDR_SZ    sizeof(CCSDS_PriHdr_t)
+#else
+#define SBN_CLIENT_INGEST_HDR_SZ    sizeof(CCSDS_SpacePacket_t)
+#endif
 
-/* TODO: Using memcpy to move message into pipe. What about pointer passing?
- *    Can we only look to msgId then memcpy only that then read directly
- *    into pipe? This could speed things up... 
- * passing pointers will only work here if it is guaranteed that the message 
- * will not be destroyed.  SBN may not be able to provide that assurance */
+/* route_message adds buf to every pipe in route_pipes, of the Generation in
+ * route_gens, and drops the caller's reference to it.  Apps sending to their
+ * own pipes are FromApp, they never wait for room in a pipe. */
+static void route_message(CFE_SBN_Client_BufferD_t *buf, CFE_SB_MsgId_t MsgId,
+                          uint8 *route_pipes, uint32 *route_gens, 
+                          uint16 num_routes, 
+                          boolean FromApp)
+{
+    int32  status;
+    uint16 i;
+    
+    /* every subscribed pipe references the same buffer */
+    for(i = 0; i < num_routes; i++)
+    {
+        
+        if (FromApp)
+        {
+            status = CFE_SBN_Client_PipeEnqueueNoWait(
+                       &PipeTbl[route_pipes[i]], buf, route_gens[i]);
+        }
+        else
+        {
+            status = CFE_SBN_Client_PipeEnqueue(&PipeTbl[route_pipes[i]], 
+                                                buf, route_gens[i]);
+        }
+        
+        /* CFE_SBN_CLIENT_INVALID_PIPE means the pipe was deleted after the
+         * routes were looked up, a full pipe or subscription has counted 
+         * the drop */
+        if (status == CFE_SBN_CLIENT_PIPE_FULL_ERR)
+        {
+            log_message("SBN_CLIENT: ERROR pipe overflow");
+        }
+        else if (status == CFE_SBN_CLIENT_MSG_LIM_ERR)
+        {
+            log_message("SBN_CLIENT: ERROR MsgLim reached, MsgId 0x%04X", 
+                        MsgId);
+        }
+        
+    }
+    
+    /* the pipes hold their own references now */
+    CFE_SBN_Client_ReleaseBuffer(buf);
+}
 
-void ingest_app_message(int SockFd, SBN_MsgSz_t MsgSz)
+int32 ingest_app_message(int SockFd, SBN_MsgSz_t MsgSz)
 {
     int            status, i;
     boolean        at_least_1_pipe_is_in_use = FALSE;    
-    unsigned char  msg_buffer[CFE_SB_MAX_SB_MSG_SIZE];
+    unsigned char  msg_hdr[SBN_CLIENT_INGEST_HDR_SZ] = {0};
+    size_t         hdr_sz = SBN_CLIENT_INGEST_HDR_SZ;
+    unsigned char *msg_data = NULL;
+    uint8          route_pipes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32         route_gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint16         num_routes;
+    CFE_SBN_Client_BufferD_t *buf;
     CFE_SB_MsgId_t MsgId;
     
-    status = CFE_SBN_CLIENT_ReadBytes(SockFd, msg_buffer, MsgSz);
+    if (MsgSz < hdr_sz)
+    {
+        hdr_sz = MsgSz;
+    }
+    
+    status = CFE_SBN_CLIENT_ReadBytes(SockFd, msg_hdr, hdr_sz);
     
     if (status != CFE_SUCCESS)
     {
@@ -41,65 +99,158 @@ void ingest_app_message(int SockFd, SBN_MsgSz_t MsgSz)
           "CFE_SBN_CLIENT_ReadBytes returned a bad status = 0x%08X\n", status);
         log_message(error_message);
         
-        return;
+        return status;
     }
 
-    MsgId = CFE_SBN_Client_GetMsgId((CFE_SB_MsgPtr_t)msg_buffer);
+    MsgId = CFE_SBN_Client_GetMsgId((CFE_SB_MsgPtr_t)msg_hdr);
     
-    pthread_mutex_lock(&receive_mutex);
+    num_routes = CFE_SBN_Client_GetRoutes(MsgId, route_pipes, route_gens);
     
-    /* Put message into pipe */    
-    for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
-    {    
-        if (PipeTbl[i].InUse == CFE_SBN_CLIENT_IN_USE)
+    if (num_routes == 0)
+    {
+        /* only look at the pipe table to explain why nothing is subscribed */
+        for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
         {
-            int j;
-            
-            at_least_1_pipe_is_in_use = TRUE;
-            
-            for(j = 0; j < CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE; j++)
+            if (PipeTbl[i].InUse == CFE_SBN_CLIENT_IN_USE)
             {
-                if (PipeTbl[i].SubscribedMsgIds[j] == MsgId)
-                {
-                    if (PipeTbl[i].NumberOfMessages == CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)
-                    {
-                        /* TODO: handle error pipe overflow */
-                        log_message("SBN_CLIENT: ERROR pipe overflow");
-                        
-                        pthread_mutex_unlock(&receive_mutex);
-                        return;
-                    }
-                    else /* message is put into pipe */
-                    {    
-                        log_message("App message received: MsgId 0x%08X", MsgId);
-                        
-                        memcpy(PipeTbl[i].Messages[message_entry_point(PipeTbl[i])], msg_buffer, MsgSz);
-                        PipeTbl[i].NumberOfMessages++;
-                        
-                        pthread_mutex_unlock(&receive_mutex);
+                at_least_1_pipe_is_in_use = TRUE;
+            }
+        }
+        
+        if (at_least_1_pipe_is_in_use)
+        {
+            log_message("SBN_CLIENT: ERROR no subscription for this msgid");  
+        }
+        else
+        {
+            log_message("SBN_CLIENT: No pipes are in use");
+        }
+        
+        return CFE_SBN_CLIENT_DiscardBytes(SockFd, MsgSz - hdr_sz);
+    }
+    
+    buf = CFE_SBN_Client_GetBuffer(MsgId, MsgSz);
+    
+    if (buf == NULL)
+    {
+        log_message("SBN_CLIENT: ERROR no message buffer available");
+        return CFE_SBN_CLIENT_DiscardBytes(SockFd, MsgSz - hdr_sz);
+    }
+    
+    /* The buffer is not visible to any reader until it is placed in a pipe,
+     * so the payload is read straight into it. */
+    msg_data = (unsigned char *)buf->Buffer;
+    memcpy(msg_data, msg_hdr, hdr_sz);
+    status = CFE_SBN_CLIENT_ReadBytes(SockFd, msg_data + hdr_sz, 
+                                      MsgSz - hdr_sz);
+    
+    if (status != CFE_SUCCESS)
+    {
+        log_message("SBN_CLIENT: ERROR reading message payload, status = 0x%08X", 
+                    status);
+        CFE_SBN_Client_ReleaseBuffer(buf);
+        return status;
+    }
+    
+    log_message("App message received: MsgId 0x%08X", MsgId);
+    
+    route_message(buf, MsgId, route_pipes, route_gens, num_routes, FALSE);
+    
+    return CFE_SUCCESS;
+}
 
-                        /* only a received message should send signal */
-                        pthread_cond_signal(&received_condition);
-                        
-                        return;
-                    } /* end if */
-                    
-                }/* end if */
-                 
-            } /* end for */
-            
-        } /* end if */
-    
-    } /* end for */
-    
-    if (at_least_1_pipe_is_in_use)
+int32 deliver_local_message(CFE_SB_Msg_t *Msg)
+{
+    uint8          route_pipes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32         route_gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint16         num_routes, msg_size;
+    CFE_SBN_Client_BufferD_t *buf;
+    CFE_SB_MsgId_t MsgId;
+    
+    if (!SBN_CLIENT_LOCAL_DELIVERY)
+    {
+        return CFE_SUCCESS;
+    }
+    
+    MsgId = CFE_SBN_Client_GetMsgId(Msg);
+    num_routes = CFE_SBN_Client_GetRoutes(MsgId, route_pipes, route_gens);
+    
+    if (num_routes == 0)
+    {
+        return CFE_SUCCESS;
+    }
+    
+    msg_size = CFE_SBN_Client_GetTotalMsgLength(Msg);
+    buf = CFE_SBN_Client_GetBuffer(MsgId, msg_size);
+    
+    if (buf == NULL)
+    {
+        log_message("SBN_CLIENT: ERROR no message buffer available");
+        return CFE_SB_BUF_ALOC_ERR;
+    }
+    
+    /* the sender may reuse Msg at once, every pipe shares the one copy */
+    memcpy(buf->Buffer, Msg, msg_size);
+    
+    route_message(buf, MsgId, route_pipes, route_gens, num_routes, TRUE);
+    
+    return CFE_SUCCESS;
+}
+
+int32 ingest_sub_message(int SockFd, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType)
+{
+    int32          status;
+    unsigned char  frame[SBN_PACKED_SUB_SZ - SBN_PACKED_HDR_SZ] = {0};
+    char           ident[SBN_IDENT_LEN];
+    CFE_SB_MsgId_t msg_ids[SBN_MAX_SUBS_PER_PEER];
+    CFE_SB_Qos_t   qos;
+    SBN_SubCnt_t   sub_cnt;
+    Unpack_t       Unpack;
+    uint16         i;
+    
+    if (MsgSz > sizeof(frame))
+    {
+        log_message("SBN_CLIENT: ERROR subscription frame of %d bytes is too "
+                    "big", MsgSz);
+        CFE_SBN_Client_LoseRemoteInterest();
+        return CFE_SBN_CLIENT_DiscardBytes(SockFd, MsgSz);
+    }
+    
+    status = CFE_SBN_CLIENT_ReadBytes(SockFd, frame, MsgSz);
+    
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+    
+    Unpack_Init(&Unpack, frame, sizeof(frame));
+    Unpack_Data(&Unpack, ident, SBN_IDENT_LEN);
+    Unpack_UInt16(&Unpack, &sub_cnt);
+    
+    for(i = 0; i < sub_cnt && i < SBN_MAX_SUBS_PER_PEER; i++)
+    {
+        Unpack_MsgID(&Unpack, &msg_ids[i]);
+        Unpack_Data(&Unpack, &qos, sizeof(qos));
+    }
+    
+    /* a frame that does not hold what it says may have lost a 
+     * subscription, so no MsgId can be taken to be unwanted */
+    if (sub_cnt > SBN_MAX_SUBS_PER_PEER || Unpack.BufUsed != MsgSz)
+    {
+        log_message("SBN_CLIENT: ERROR malformed subscription frame, %d "
+                    "subscriptions in %d bytes", sub_cnt, MsgSz);
+        CFE_SBN_Client_LoseRemoteInterest();
+        return CFE_SUCCESS;
+    }
+    
+    if (MsgType == SBN_SUB_MSG)
     {
-        log_message("SBN_CLIENT: ERROR no subscription for this msgid");  
+        CFE_SBN_Client_AddRemoteInterest(msg_ids, sub_cnt);
     }
     else
     {
-        log_message("SBN_CLIENT: No pipes are in use");
+        CFE_SBN_Client_RemoveRemoteInterest(msg_ids, sub_cnt);
     }
     
-    pthread_mutex_unlock(&receive_mutex);
-}
\ No newline at end of file
+    return CFE_SUCCESS;
+}
@@ -34,9 +34,11 @@ extern CFE_SBN_Client_PipeD_t PipeTbl[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
  ** \brief Receive an app message and direct it into pipe.
  **
  ** \par Description
- **          This routine reads the given number of bytes from the given socket,
- **          which becomes the message.  The message is then copied into the
- **          correct pipe for the message's id.
+ **          This routine reads the CCSDS header of the message from the given
+ **          socket to find the message's id, then reads the remainder of the
+ **          message directly into a buffer from the shared pool.  The buffer
+ **          is added to every pipe subscribed to that id without copying.
+ **          Messages with no destination are discarded.
  **
  ** \par Assumptions, External Events, and Notes:
  **          The socket has been setup and receives app messages.
@@ -46,8 +48,60 @@ extern CFE_SBN_Client_PipeD_t PipeTbl[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
  **
  ** \param[in]  MsgSz        The number of bytes to read for the message.
  **
+ ** \return Execution status
+ ** \retval #CFE_SUCCESS  The whole message was read, delivered or not
+ ** \retval Any status of #CFE_SBN_CLIENT_ReadBytes  The connection failed 
+ **         part way through the message
+ **
+ **/
+int32 ingest_app_message(int SockFd, SBN_MsgSz_t MsgSz);
+ 
+ /*****************************************************************************/
+ /** 
+ ** \brief Deliver a message an app sends to the client's own pipes.
+ **
+ ** \par Description
+ **          This routine copies the message into one buffer from the shared 
+ **          pool and adds it to every pipe subscribed to its id, local 
+ **          subscriptions included, as if SBN had sent it.  A full pipe 
+ **          drops the message even with #SBN_CLIENT_OVERFLOW_BLOCK, as the 
+ **          sender may be the pipe's reader.  Does nothing when 
+ **          #SBN_CLIENT_LOCAL_DELIVERY is 0.
+ **
+ ** \param[in]  Msg          The message, which the caller may reuse once
+ **                          this returns.
+ **
+ ** \return Execution status
+ ** \retval #CFE_SUCCESS  Delivered, or no pipe is subscribed
+ ** \retval #CFE_SB_BUF_ALOC_ERR  No buffer was available for the copy
+ **
+ **/
+int32 deliver_local_message(CFE_SB_Msg_t *Msg);
+ 
+ /*****************************************************************************/
+ /** 
+ ** \brief Receive a subscription or unsubscription frame from SBN.
+ **
+ ** \par Description
+ **          This routine reads the MsgIds SBN's side has subscribed to or 
+ **          unsubscribed from and updates the remote interest SendMsg uses
+ **          to skip messages nobody there wants.  A frame that cannot be 
+ **          parsed stops any message being skipped until the next 
+ **          connection.
+ **
+ ** \param[in]  SockFd       A socket file descriptor connected to SBN.
+ **
+ ** \param[in]  MsgSz        The number of bytes to read for the frame.
+ **
+ ** \param[in]  MsgType      #SBN_SUB_MSG or #SBN_UNSUB_MSG.
+ **
+ ** \return Execution status
+ ** \retval #CFE_SUCCESS  The whole frame was read, used or not
+ ** \retval Any status of #CFE_SBN_CLIENT_ReadBytes  The connection failed 
+ **         part way through the frame
+ **
  **/
-void ingest_app_message(int SockFd, SBN_MsgSz_t MsgSz);
+int32 ingest_sub_message(int SockFd, SBN_MsgSz_t MsgSz, SBN_MsgType_t MsgType);
  
  /**@}*/
 #endif /* _sbn_client_ingest_h_ */
\ No newline at end of file
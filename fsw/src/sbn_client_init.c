@@ -11,9 +11,18 @@
 */
 
 #include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
 
 #include "sbn_client.h"
+#include "sbn_client_health.h"
+#include "sbn_client_init.h"
+#include "sbn_client_interest.h"
 #include "sbn_client_minders.h"
+#include "sbn_client_send_queue.h"
+#include "sbn_client_transport.h"
 #include "sbn_client_utils.h"
 
 
@@ -22,17 +31,138 @@ extern int sbn_client_cpuId;
 
 pthread_t receive_thread_id;
 pthread_t heart_thread_id;
+pthread_t init_thread_id;
 
+/* which threads SBN_Client_Shutdown has to join, the event loop runs as the 
+ * receive thread */
+static boolean heart_thread_started = FALSE;
+static boolean receive_thread_started = FALSE;
+static boolean init_thread_started = FALSE;
 
-int32 SBN_Client_Init(void)
+/* SBN_Client_InitAsync state: the result of the connect, the eventfd that 
+ * becomes readable once it is known and the caller's callback.  Shutdown 
+ * sets abort_connect to stop retrying. */
+static int32  init_status = SBN_CLIENT_INIT_PENDING;
+static int    init_ready_fd = -1;
+static SBN_Client_InitCallback_t init_callback = NULL;
+static void  *init_callback_arg = NULL;
+static boolean abort_connect = FALSE;
+
+
+/* start_minder_threads starts the heartbeat thread and the receive thread */
+static int32 start_minder_threads(void)
 {
-    int32 status = SBN_CLIENT_NO_STATUS_SET;
+    int32 status;
     int heart_thread_status = 0;
     int receive_thread_status = 0;
     
-    log_message("SBN_Client Connecting to %s, %d\n", SBN_CLIENT_IP_ADDR, SBN_CLIENT_PORT);
+    /* heartbeat thread establishes live connection */
+    heart_thread_status = pthread_create(&heart_thread_id, NULL, 
+        SBN_Client_HeartbeatMinder, NULL);
+        
+    status = check_pthread_create_status(heart_thread_status, 
+        SBN_CLIENT_HEART_THREAD_CREATE_EID);
+    
+    /* receive thread monitors for messages */
+    if (status == SBN_CLIENT_SUCCESS)
+    {    
+        heart_thread_started = TRUE;
+        
+        receive_thread_status = pthread_create(&receive_thread_id, NULL, 
+        SBN_Client_ReceiveMinder, NULL);
+    
+        status = check_pthread_create_status(receive_thread_status, 
+            SBN_CLIENT_RECEIVE_THREAD_CREATE_EID);
+    }/* end if */ 
+    
+    if (status == SBN_CLIENT_SUCCESS)
+    {
+        receive_thread_started = TRUE;
+    }/* end if */ 
+    
+    return status;
+}/* end start_minder_threads */
+
+/* start_event_loop starts one thread doing both heartbeats and receives */
+static int32 start_event_loop(void)
+{
+    int32 status;
+    int receive_thread_status = 0;
+    
+    status = SBN_Client_EventLoopOpen(sbn_client_sockfd);
+    
+    if (status == SBN_CLIENT_SUCCESS)
+    {
+        receive_thread_status = pthread_create(&receive_thread_id, NULL, 
+            SBN_Client_EventLoop, NULL);
+        
+        status = check_pthread_create_status(receive_thread_status, 
+            SBN_CLIENT_RECEIVE_THREAD_CREATE_EID);
+    }/* end if */ 
     
-    sbn_client_sockfd = connect_to_server(SBN_CLIENT_IP_ADDR, SBN_CLIENT_PORT);
+    if (status == SBN_CLIENT_SUCCESS)
+    {
+        receive_thread_started = TRUE;
+    }
+    else
+    {
+        SBN_Client_EventLoopClose();
+    }/* end if */ 
+    
+    return status;
+}/* end start_event_loop */
+
+
+/* connect_with_retry connects to SBN, retrying refused or timed out attempts
+ * on the schedule set in sbn_client_defs.h */
+static int connect_with_retry(void)
+{
+    int             sockfd = SERVER_CONNECT_ERROR;
+    int             attempt;
+    long            retry_ms = SBN_CLIENT_CONNECT_RETRY_MS;
+    struct timespec delay;
+    
+    for(attempt = 1; attempt <= SBN_CLIENT_CONNECT_ATTEMPTS; attempt++)
+    {
+        sockfd = CFE_SBN_Client_GetTransport()->Connect();
+        
+        /* socket and address errors will not go away by trying again */
+        if (sockfd != SERVER_CONNECT_ERROR || 
+            attempt == SBN_CLIENT_CONNECT_ATTEMPTS ||
+            __atomic_load_n(&abort_connect, __ATOMIC_ACQUIRE))
+        {
+            break;
+        }/* end if */ 
+        
+        log_message("SBN_CLIENT: connect attempt %d failed, retrying in %ld ms\n",
+                    attempt, retry_ms);
+        
+        delay.tv_sec = retry_ms / 1000;
+        delay.tv_nsec = (retry_ms % 1000) * 1000000;
+        nanosleep(&delay, NULL);
+        
+        retry_ms *= 2;
+        
+        if (retry_ms > SBN_CLIENT_CONNECT_MAX_RETRY_MS)
+        {
+            retry_ms = SBN_CLIENT_CONNECT_MAX_RETRY_MS;
+        }/* end if */ 
+        
+    }/* end for */ 
+    
+    return sockfd;
+}/* end connect_with_retry */
+
+
+int32 SBN_Client_Init(void)
+{
+    const CFE_SBN_Client_Transport_t *transport = CFE_SBN_Client_GetTransport();
+    int32 status = SBN_CLIENT_NO_STATUS_SET;
+    
+    log_message("SBN_Client Connecting to %s over %s\n", transport->Address, 
+                transport->Name);
+    
+    sbn_client_sockfd = connect_with_retry();
     sbn_client_cpuId = 2; /* TODO: hardcoded, but should be set by cFS SBN ??*/
 
     if (sbn_client_sockfd < 0)
@@ -44,22 +174,25 @@ int32 SBN_Client_Init(void)
     else
     {
         CFE_SBN_Client_InitPipeTbl();
-
-        /* heartbeat thread establishes live connection */
-        heart_thread_status = pthread_create(&heart_thread_id, NULL, 
-            SBN_Client_HeartbeatMinder, NULL);
-            
-        status = check_pthread_create_status(heart_thread_status, 
-            SBN_CLIENT_HEART_THREAD_CREATE_EID);
+        CFE_SBN_CLIENT_ResetRecvBuffer(sbn_client_sockfd);
+        CFE_SBN_Client_HealthReset();
+        CFE_SBN_Client_ResetRemoteInterest();
         
-        /* receive thread monitors for messages */
-        if (status == SBN_CLIENT_SUCCESS)
-        {    
-            receive_thread_status = pthread_create(&receive_thread_id, NULL, 
-            SBN_Client_ReceiveMinder, NULL);
+        __atomic_store_n(&continue_heartbeat, TRUE, __ATOMIC_RELEASE);
+        __atomic_store_n(&continue_receive_check, TRUE, __ATOMIC_RELEASE);
+
+        if (SBN_CLIENT_USE_EVENT_LOOP)
+        {
+            status = start_event_loop();
+        }
+        else
+        {
+            status = start_minder_threads();
+        }/* end if */ 
         
-            status = check_pthread_create_status(receive_thread_status, 
-                SBN_CLIENT_RECEIVE_THREAD_CREATE_EID);
+        if (SBN_CLIENT_ASYNC_SEND && status == SBN_CLIENT_SUCCESS)
+        {
+            status = CFE_SBN_Client_SendQueueOpen();
         }/* end if */ 
         
     }/* end if */ 
@@ -70,4 +203,143 @@ int32 SBN_Client_Init(void)
     }/* end if */ 
     
     return status;
-}/* end SBN_Client_Init */
\ No newline at end of file
+}/* end SBN_Client_Init */
+
+
+/* init_thread runs SBN_Client_Init for SBN_Client_InitAsync, then tells the 
+ * caller how it went */
+static void *init_thread(void *vargp)
+{
+    int32    status;
+    uint64_t ready = 1;
+    
+    status = SBN_Client_Init();
+    
+    __atomic_store_n(&init_status, status, __ATOMIC_RELEASE);
+    
+    if (init_callback != NULL)
+    {
+        (*init_callback)(status, init_callback_arg);
+    }/* end if */ 
+    
+    if (write(init_ready_fd, &ready, sizeof(ready)) < 0)
+    {
+        log_message("SBN_CLIENT: ERROR signalling init ready fd\n");
+    }/* end if */ 
+    
+    return NULL;
+}/* end init_thread */
+
+
+int32 SBN_Client_InitAsync(SBN_Client_InitCallback_t Callback, 
+                           void *CallbackArg, int *ReadyFdPtr)
+{
+    int32 status;
+    int init_thread_status = 0;
+    
+    init_ready_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    
+    if (init_ready_fd < 0)
+    {
+        log_message("SBN_CLIENT: ERROR creating init ready fd\n");
+        return SBN_CLIENT_INIT_THREAD_CREATE_EID;
+    }/* end if */ 
+    
+    __atomic_store_n(&init_status, SBN_CLIENT_INIT_PENDING, __ATOMIC_RELAXED);
+    __atomic_store_n(&abort_connect, FALSE, __ATOMIC_RELAXED);
+    init_callback = Callback;
+    init_callback_arg = CallbackArg;
+    
+    if (ReadyFdPtr != NULL)
+    {
+        *ReadyFdPtr = init_ready_fd;
+    }/* end if */ 
+    
+    init_thread_status = pthread_create(&init_thread_id, NULL, init_thread, 
+        NULL);
+    
+    status = check_pthread_create_status(init_thread_status, 
+        SBN_CLIENT_INIT_THREAD_CREATE_EID);
+    
+    if (status == SBN_CLIENT_SUCCESS)
+    {
+        init_thread_started = TRUE;
+    }
+    else
+    {
+        close(init_ready_fd);
+        init_ready_fd = -1;
+        
+        if (ReadyFdPtr != NULL)
+        {
+            *ReadyFdPtr = -1;
+        }/* end if */ 
+        
+    }/* end if */ 
+    
+    return status;
+}/* end SBN_Client_InitAsync */
+
+
+int32 SBN_Client_GetInitStatus(void)
+{
+    return __atomic_load_n(&init_status, __ATOMIC_ACQUIRE);
+}/* end SBN_Client_GetInitStatus */
+
+
+void SBN_Client_Shutdown(void)
+{
+    /* an async init finishes, or gives up retrying, before anything it 
+     * started is stopped */
+    if (init_thread_started)
+    {
+        __atomic_store_n(&abort_connect, TRUE, __ATOMIC_RELEASE);
+        pthread_join(init_thread_id, NULL);
+        init_thread_started = FALSE;
+    }/* end if */ 
+    
+    /* what apps queued to send goes out before the connection is shut */
+    CFE_SBN_Client_SendQueueClose();
+    
+    __atomic_store_n(&continue_heartbeat, FALSE, __ATOMIC_RELEASE);
+    __atomic_store_n(&continue_receive_check, FALSE, __ATOMIC_RELEASE);
+    
+    /* wakes the event loop when idle, and ends any read in progress so a 
+     * receive blocked mid frame returns */
+    SBN_Client_EventLoopStop();
+    
+    if (sbn_client_sockfd > 0)
+    {
+        CFE_SBN_Client_GetTransport()->Shutdown(sbn_client_sockfd);
+    }/* end if */ 
+    
+    if (receive_thread_started)
+    {
+        pthread_join(receive_thread_id, NULL);
+        receive_thread_started = FALSE;
+    }/* end if */ 
+    
+    /* the heartbeat thread notices within SECONDS_BETWEEN_HEARTBEATS */
+    if (heart_thread_started)
+    {
+        pthread_join(heart_thread_id, NULL);
+        heart_thread_started = FALSE;
+    }/* end if */ 
+    
+    SBN_Client_EventLoopClose();
+    
+    if (init_ready_fd >= 0)
+    {
+        close(init_ready_fd);
+        init_ready_fd = -1;
+    }/* end if */ 
+    
+    if (sbn_client_sockfd > 0)
+    {
+        CFE_SBN_Client_GetTransport()->Close(sbn_client_sockfd);
+    }/* end if */ 
+    
+    sbn_client_sockfd = 0;
+    CFE_SBN_Client_HealthLinkState(FALSE);
+    __atomic_store_n(&abort_connect, FALSE, __ATOMIC_RELEASE);
+}/* end SBN_Client_Shutdown */
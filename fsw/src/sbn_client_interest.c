@@ -0,0 +1,129 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <pthread.h>
+
+#include "sbn_client_interest.h"
+#include "sbn_client_msgid_set.h"
+
+#if (SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE & \
+     (SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE - 1)) != 0
+#error SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE must be a power of two
+#endif
+
+/* What is known of SBN's subscriptions: nothing yet, everything it has
+ * announced, or not everything, when nothing can be skipped until the next
+ * connection */
+#define INTEREST_UNKNOWN    0
+#define INTEREST_KNOWN      1
+#define INTEREST_LOST       2
+
+/* The set of MsgIds SBN's side subscribes to.  The receive thread writes it
+ * as SBN announces subscriptions and every SendMsg reads it, hence the
+ * rwlock. */
+static CFE_SB_MsgId_t   remote_msg_ids[SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE];
+static CFE_SBN_Client_MsgIdSet_t remote_interest = {
+    remote_msg_ids, sizeof(CFE_SB_MsgId_t),
+    SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE, 0
+};
+static uint8            interest_state = INTEREST_UNKNOWN;
+static pthread_rwlock_t interest_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+
+void CFE_SBN_Client_ResetRemoteInterest(void)
+{
+    pthread_rwlock_wrlock(&interest_lock);
+
+    CFE_SBN_Client_MsgIdSetClear(&remote_interest);
+    interest_state = INTEREST_UNKNOWN;
+
+    pthread_rwlock_unlock(&interest_lock);
+} /* end CFE_SBN_Client_ResetRemoteInterest */
+
+
+void CFE_SBN_Client_AddRemoteInterest(const CFE_SB_MsgId_t *MsgIds,
+                                      uint16 Count)
+{
+    uint16 i;
+
+    pthread_rwlock_wrlock(&interest_lock);
+
+    if (interest_state == INTEREST_UNKNOWN)
+    {
+        interest_state = INTEREST_KNOWN;
+    } /* end if */
+
+    for (i = 0; i < Count && interest_state == INTEREST_KNOWN; i++)
+    {
+
+        if (MsgIds[i] == CFE_SBN_CLIENT_INVALID_MSG_ID)
+        {
+            continue;
+        } /* end if */
+
+        if (CFE_SBN_Client_MsgIdSetInsert(&remote_interest, MsgIds[i]) == NULL)
+        {
+            log_message("SBN_CLIENT: ERROR remote interest index full, "
+                        "sending every MsgId");
+            interest_state = INTEREST_LOST;
+        } /* end if */
+
+    } /* end for */
+
+    pthread_rwlock_unlock(&interest_lock);
+} /* end CFE_SBN_Client_AddRemoteInterest */
+
+
+void CFE_SBN_Client_RemoveRemoteInterest(const CFE_SB_MsgId_t *MsgIds,
+                                         uint16 Count)
+{
+    uint16 i;
+
+    pthread_rwlock_wrlock(&interest_lock);
+
+    for (i = 0; i < Count; i++)
+    {
+        CFE_SBN_Client_MsgIdSetRemove(&remote_interest, MsgIds[i]);
+    } /* end for */
+
+    pthread_rwlock_unlock(&interest_lock);
+} /* end CFE_SBN_Client_RemoveRemoteInterest */
+
+
+void CFE_SBN_Client_LoseRemoteInterest(void)
+{
+    pthread_rwlock_wrlock(&interest_lock);
+
+    interest_state = INTEREST_LOST;
+
+    pthread_rwlock_unlock(&interest_lock);
+} /* end CFE_SBN_Client_LoseRemoteInterest */
+
+
+boolean CFE_SBN_Client_RemoteWants(CFE_SB_MsgId_t MsgId)
+{
+    boolean wanted;
+
+    if (!SBN_CLIENT_SKIP_UNWANTED_SENDS)
+    {
+        return TRUE;
+    } /* end if */
+
+    pthread_rwlock_rdlock(&interest_lock);
+
+    wanted = interest_state != INTEREST_KNOWN ||
+             CFE_SBN_Client_MsgIdSetFind(&remote_interest, MsgId) != NULL;
+
+    pthread_rwlock_unlock(&interest_lock);
+
+    return wanted;
+} /* end CFE_SBN_Client_RemoteWants */
@@ -0,0 +1,91 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_interest_h_
+#define _sbn_client_interest_h_
+
+#include "sbn_interfaces.h"
+#include "sbn_client_utils.h"
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTInterest sbn_client remote interest
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief Forgets what SBN's side subscribes to.
+**
+** \par Description
+**          Called for each new connection to SBN, which announces its
+**          subscriptions again.  Until it does every message is sent.
+**
+**/
+void CFE_SBN_Client_ResetRemoteInterest(void);
+
+/*****************************************************************************/
+/**
+** \brief Records MsgIds SBN announced its side subscribes to.
+**
+** \par Description
+**          Messages are only skipped once SBN has announced subscriptions,
+**          even an empty list of them.  If the index has no room for a
+**          MsgId nothing is skipped until the next connection.
+**
+** \param[in]  MsgIds       The MsgIds subscribed to.
+**
+** \param[in]  Count        Number of MsgIds.
+**
+**/
+void CFE_SBN_Client_AddRemoteInterest(const CFE_SB_MsgId_t *MsgIds,
+                                      uint16 Count);
+
+/*****************************************************************************/
+/**
+** \brief Records MsgIds SBN announced its side no longer subscribes to.
+**
+** \param[in]  MsgIds       The MsgIds unsubscribed from.
+**
+** \param[in]  Count        Number of MsgIds.
+**
+**/
+void CFE_SBN_Client_RemoveRemoteInterest(const CFE_SB_MsgId_t *MsgIds,
+                                         uint16 Count);
+
+/*****************************************************************************/
+/**
+** \brief Gives up on knowing what SBN's side subscribes to.
+**
+** \par Description
+**          Called when an announcement could not be read, so a subscription
+**          may have been missed.  Nothing is skipped until the next
+**          connection.
+**
+**/
+void CFE_SBN_Client_LoseRemoteInterest(void);
+
+/*****************************************************************************/
+/**
+** \brief Tells whether a message should be sent to SBN.
+**
+** \param[in]  MsgId        The MsgId of the message.
+**
+** \return FALSE only when SBN has announced its subscriptions and none is
+**         to MsgId
+**
+**/
+boolean CFE_SBN_Client_RemoteWants(CFE_SB_MsgId_t MsgId);
+
+/**@}*/
+
+#endif /* _sbn_client_interest_h_ */
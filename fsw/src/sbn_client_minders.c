@@ -11,27 +11,244 @@
 */
 
 #include <unistd.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 
 #include "sbn_client.h"
+#include "sbn_client_health.h"
+#include "sbn_client_init.h"
+#include "sbn_client_interest.h"
 #include "sbn_client_minders.h"
+#include "sbn_client_transport.h"
 #include "sbn_client_utils.h"
 
 #define SECONDS_BETWEEN_HEARTBEATS   3
+#define MAX_CONSECUTIVE_RECV_ERRORS  5
+#define RECONNECT_WAIT_SLICE_MS      100
 
 extern int sbn_client_sockfd;
 
+/* Cleared to stop the minders; read and written atomically because they are
+ * cleared from other threads than the ones looping on them. */
 boolean continue_heartbeat = TRUE;
 boolean continue_receive_check = TRUE;
 
+/* Event loop descriptors: the epoll set waits on the SBN socket, a timerfd
+ * for heartbeats and an eventfd SBN_Client_EventLoopStop writes to. */
+static int loop_epoll_fd = -1;
+static int loop_timer_fd = -1;
+static int loop_stop_fd  = -1;
+
+/* told when the connection to SBN is lost and when it is back */
+static SBN_Client_LinkCallback_t link_callback = NULL;
+static void *link_callback_arg = NULL;
+
+
+/* count_recv_status keeps the count of consecutive receive errors and returns
+ * TRUE once the connection cannot be alive: too many errors in a row, or a
+ * frame that timed out */
+static boolean count_recv_status(int32 status, int32 *consec_error_count)
+{
+    
+    if (status != CFE_SUCCESS)
+    {
+        log_message("Receive message returned error 0x%08X\n", status);
+        (*consec_error_count)++;
+    }
+    else
+    {
+        *consec_error_count = 0;
+    } /* end if */
+
+    /* a frame that stalled part way leaves no way to find the next one */
+    return (*consec_error_count == MAX_CONSECUTIVE_RECV_ERRORS ||
+            status == CFE_SBN_CLIENT_READ_TIMEOUT_ERR);
+    
+} /* end count_recv_status */
+
+
+void SBN_Client_SetLinkCallback(SBN_Client_LinkCallback_t Callback, 
+                                void *CallbackArg)
+{
+    link_callback_arg = CallbackArg;
+    link_callback = Callback;
+} /* end SBN_Client_SetLinkCallback */
+
+
+static void notify_link(boolean link_up)
+{
+    CFE_SBN_Client_HealthLinkState(link_up);
+    
+    if (link_callback != NULL)
+    {
+        (*link_callback)(link_up, link_callback_arg);
+    } /* end if */
+    
+} /* end notify_link */
+
+
+/* add_loop_fd adds a descriptor to the event loop's epoll set for reading */
+static int add_loop_fd(int fd)
+{
+    struct epoll_event event;
+    
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    
+    return epoll_ctl(loop_epoll_fd, EPOLL_CTL_ADD, fd, &event);
+} /* end add_loop_fd */
+
+
+/* backoff_wait sleeps for wait_ms, returning early when the minders are 
+ * stopped; the event loop's stop fd cuts the wait short at once, the 
+ * receive thread notices within RECONNECT_WAIT_SLICE_MS */
+static void backoff_wait(long wait_ms)
+{
+    struct pollfd stop;
+    long          slice_ms;
+    
+    stop.fd = loop_stop_fd; /* poll ignores it when it is -1 */
+    stop.events = POLLIN;
+    
+    while (wait_ms > 0 && 
+           __atomic_load_n(&continue_receive_check, __ATOMIC_ACQUIRE))
+    {
+        slice_ms = wait_ms < RECONNECT_WAIT_SLICE_MS ? 
+                   wait_ms : RECONNECT_WAIT_SLICE_MS;
+        
+        if (poll(&stop, 1, slice_ms) > 0)
+        {
+            break;
+        } /* end if */
+        
+        wait_ms -= slice_ms;
+    } /* end while */
+    
+} /* end backoff_wait */
+
+
+/* reconnect replaces a dead connection to SBN, retrying with exponential 
+ * backoff and jitter until connected or the minders are stopped.  The new 
+ * socket is dup2'ed onto sbn_client_sockfd so the heartbeat thread and 
+ * senders never see the descriptor change.  Pipes and the messages in them
+ * are kept; SBN is sent every subscription again. */
+static boolean reconnect(void)
+{
+    int          sockfd;
+    long         retry_ms = SBN_CLIENT_RECONNECT_MIN_MS;
+    unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)getpid();
+    
+    log_message("SBN_CLIENT: connection to SBN lost, reconnecting\n");
+    notify_link(FALSE);
+    
+    if (loop_epoll_fd >= 0)
+    {
+        epoll_ctl(loop_epoll_fd, EPOLL_CTL_DEL, 
+                  CFE_SBN_Client_GetTransport()->PollFd(sbn_client_sockfd), 
+                  NULL);
+    } /* end if */
+    
+    while (__atomic_load_n(&continue_receive_check, __ATOMIC_ACQUIRE))
+    {
+        sockfd = CFE_SBN_Client_GetTransport()->Connect();
+        
+        if (sockfd >= 0)
+        {
+            
+            if (sbn_client_sockfd <= 0)
+            {
+                sbn_client_sockfd = sockfd;
+                break;
+            } /* end if */
+            
+            if (dup2(sockfd, sbn_client_sockfd) >= 0)
+            {
+                close(sockfd);
+                break;
+            } /* end if */
+            
+            log_message("SBN_CLIENT: ERROR replacing socket: %s\n", 
+                        strerror(errno));
+            close(sockfd);
+        } /* end if */
+        
+        /* wait between half and all of retry_ms */
+        backoff_wait(retry_ms / 2 + rand_r(&seed) % (retry_ms / 2 + 1));
+        
+        retry_ms *= 2;
+        
+        if (retry_ms > SBN_CLIENT_RECONNECT_MAX_MS)
+        {
+            retry_ms = SBN_CLIENT_RECONNECT_MAX_MS;
+        } /* end if */
+        
+    } /* end while */
+    
+    if (!__atomic_load_n(&continue_receive_check, __ATOMIC_ACQUIRE))
+    {
+        return FALSE;
+    } /* end if */
+    
+    /* the rest of a frame from the old connection is never coming */
+    CFE_SBN_CLIENT_ResetRecvBuffer(sbn_client_sockfd);
+    
+    if (loop_epoll_fd >= 0 && 
+        add_loop_fd(CFE_SBN_Client_GetTransport()->PollFd(sbn_client_sockfd)) 
+          < 0)
+    {
+        log_message("SBN_CLIENT: ERROR watching new socket: %s\n", 
+                    strerror(errno));
+        return FALSE;
+    } /* end if */
+    
+    /* SBN announces its subscriptions again to the new connection */
+    CFE_SBN_Client_ResetRemoteInterest();
+    CFE_SBN_Client_ResendSubscriptions();
+    
+    log_message("SBN_CLIENT: reconnected to SBN\n");
+    notify_link(TRUE);
+    
+    return TRUE;
+} /* end reconnect */
+
+
+/* link_lost either reconnects or, when that is turned off or given up on, 
+ * stops the minders */
+static void link_lost(void)
+{
+    
+    if (!SBN_CLIENT_AUTO_RECONNECT || !reconnect())
+    {
+        __atomic_store_n(&continue_heartbeat, FALSE, __ATOMIC_RELEASE);
+        __atomic_store_n(&continue_receive_check, FALSE, __ATOMIC_RELEASE);
+    } /* end if */
+    
+} /* end link_lost */
+
+
+/* send_heartbeat_and_sample sends a heartbeat and, on the same schedule, 
+ * samples the connection for the link health */
+static void send_heartbeat_and_sample(int sockfd)
+{
+    CFE_SBN_Client_HealthHeartbeatSent(send_heartbeat(sockfd));
+    CFE_SBN_Client_HealthSampleTcp(sockfd);
+} /* end send_heartbeat_and_sample */
+
 
 void *SBN_Client_HeartbeatMinder(void *vargp)
 {
-    while(continue_heartbeat) /* TODO: check run state? */
+    while(__atomic_load_n(&continue_heartbeat, __ATOMIC_ACQUIRE)) /* TODO: check run state? */
     {
         
         if (sbn_client_sockfd != 0)
         {
-            send_heartbeat(sbn_client_sockfd);
+            send_heartbeat_and_sample(sbn_client_sockfd);
         } /* end if */
         
         sleep(SECONDS_BETWEEN_HEARTBEATS);
@@ -46,28 +263,168 @@ void *SBN_Client_ReceiveMinder(void *vargp)
     int32 status;
     int32 consec_error_count = 0;
     
-    while(continue_receive_check) /* TODO: check run state? */
+    while(__atomic_load_n(&continue_receive_check, __ATOMIC_ACQUIRE)) /* TODO: check run state? */
     {
         status = recv_msg(sbn_client_sockfd); /* TODO: pass message pointer? */
         /* On heartbeats, need to update known liveness state of SBN
         ** On other messages, need to make available for next CFE_SB_RcvMsg call */
         
-        if (status != CFE_SUCCESS)
-        {
-            log_message("Receive message returned error 0x%08X\n", status);
-            consec_error_count++;
-        }
-        else
+        if (count_recv_status(status, &consec_error_count))
         {
+            link_lost();
             consec_error_count = 0;
         } /* end if */
+        
+    } /* end while */
+    
+    return NULL;
+} /* end SBN_Client_ReceiveMinder */
+
+
+int32 SBN_Client_EventLoopOpen(int sockfd)
+{
+    /* the first heartbeat goes out straight away, as the heartbeat thread 
+     * does, then one every SECONDS_BETWEEN_HEARTBEATS */
+    struct itimerspec heartbeat_timer = {
+        { SECONDS_BETWEEN_HEARTBEATS, 0 }, /* it_interval */
+        { 0, 1 }                           /* it_value */
+    };
+    
+    loop_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    loop_timer_fd = timerfd_create(CLOCK_MONOTONIC, 
+                                   TFD_NONBLOCK | TFD_CLOEXEC);
+    loop_stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    
+    /* a transport with no descriptor to wait on fails here */
+    if (loop_epoll_fd < 0 || loop_timer_fd < 0 || loop_stop_fd < 0 ||
+        add_loop_fd(CFE_SBN_Client_GetTransport()->PollFd(sockfd)) < 0 ||
+        add_loop_fd(loop_timer_fd) < 0 ||
+        add_loop_fd(loop_stop_fd) < 0 ||
+        timerfd_settime(loop_timer_fd, 0, &heartbeat_timer, NULL) < 0)
+    {
+        log_message("SBN_CLIENT: ERROR creating event loop: %s\n", 
+                    strerror(errno));
+        SBN_Client_EventLoopClose();
+        return SBN_CLIENT_EVENT_LOOP_CREATE_EID;
+    } /* end if */
+    
+    return SBN_CLIENT_SUCCESS;
+} /* end SBN_Client_EventLoopOpen */
 
-        if (5 == consec_error_count) {
-            continue_heartbeat = FALSE;
-            continue_receive_check = FALSE;
-        }
+
+/* receive_frames handles the SBN socket becoming readable.  Frames already 
+ * in the receive buffer do not make the socket readable again, so they are
+ * handled here until the buffer is empty. */
+static void receive_frames(int32 *consec_error_count)
+{
+    int32 status;
+    
+    do
+    {
+        status = recv_msg(sbn_client_sockfd);
+        
+        if (count_recv_status(status, consec_error_count))
+        {
+            link_lost();
+            *consec_error_count = 0;
+            break;
+        } /* end if */
+        
+    } while (status == CFE_SUCCESS && CFE_SBN_CLIENT_RecvBufferedBytes() > 0 &&
+             __atomic_load_n(&continue_receive_check, __ATOMIC_ACQUIRE));
+    
+} /* end receive_frames */
+
+
+void *SBN_Client_EventLoop(void *vargp)
+{
+    struct epoll_event events[3]; /* socket, heartbeat timer and stop */
+    int32    consec_error_count = 0;
+    uint64_t count;
+    int      num_events, i;
+    
+    while(__atomic_load_n(&continue_heartbeat, __ATOMIC_ACQUIRE) &&
+          __atomic_load_n(&continue_receive_check, __ATOMIC_ACQUIRE))
+    {
+        num_events = epoll_wait(loop_epoll_fd, events, 3, -1);
+        
+        if (num_events < 0)
+        {
+            
+            if (errno == EINTR)
+            {
+                continue;
+            } /* end if */
+            
+            log_message("SBN_CLIENT: ERROR epoll_wait: %s\n", strerror(errno));
+            break;
+        } /* end if */
+        
+        for(i = 0; i < num_events; i++)
+        {
+            
+            if (events[i].data.fd == loop_stop_fd)
+            {
+                __atomic_store_n(&continue_heartbeat, FALSE, __ATOMIC_RELEASE);
+                __atomic_store_n(&continue_receive_check, FALSE, 
+                                 __ATOMIC_RELEASE);
+            }
+            else if (events[i].data.fd == loop_timer_fd)
+            {
+                /* expirations missed while busy are sent as one heartbeat */
+                if (read(loop_timer_fd, &count, sizeof(count)) > 0 &&
+                    sbn_client_sockfd != 0)
+                {
+                    send_heartbeat_and_sample(sbn_client_sockfd);
+                } /* end if */
+                
+            }
+            else if (__atomic_load_n(&continue_receive_check, 
+                                     __ATOMIC_ACQUIRE))
+            {
+                receive_frames(&consec_error_count);
+            } /* end if */
+            
+        } /* end for */
         
     } /* end while */
     
     return NULL;
-} /* end SBN_Client_ReceiveMinder */
\ No newline at end of file
+} /* end SBN_Client_EventLoop */
+
+
+void SBN_Client_EventLoopStop(void)
+{
+    uint64_t one = 1;
+    
+    if (loop_stop_fd >= 0 && write(loop_stop_fd, &one, sizeof(one)) < 0)
+    {
+        log_message("SBN_CLIENT: ERROR stopping event loop: %s\n", 
+                    strerror(errno));
+    } /* end if */
+    
+} /* end SBN_Client_EventLoopStop */
+
+
+void SBN_Client_EventLoopClose(void)
+{
+    
+    if (loop_epoll_fd >= 0)
+    {
+        close(loop_epoll_fd);
+    } /* end if */
+    
+    if (loop_timer_fd >= 0)
+    {
+        close(loop_timer_fd);
+    } /* end if */
+    
+    if (loop_stop_fd >= 0)
+    {
+        close(loop_stop_fd);
+    } /* end if */
+    
+    loop_epoll_fd = -1;
+    loop_timer_fd = -1;
+    loop_stop_fd  = -1;
+} /* end SBN_Client_EventLoopClose */
@@ -13,7 +13,20 @@
 #ifndef _sbn_client_minders_h_
 #define _sbn_client_minders_h_
 
+#include "sbn_client.h"
+
+/* cleared to stop the minders, access atomically */
+extern boolean continue_heartbeat;
+extern boolean continue_receive_check;
+
+/* heartbeat and receive threads */
 void *SBN_Client_HeartbeatMinder(void *);
 void *SBN_Client_ReceiveMinder(void *);
 
+/* single thread epoll event loop doing the work of both minders */
+int32 SBN_Client_EventLoopOpen(int);
+void *SBN_Client_EventLoop(void *);
+void SBN_Client_EventLoopStop(void);
+void SBN_Client_EventLoopClose(void);
+
 #endif /* _sbn_client_minders_h_ */
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <string.h>
+
+#include "sbn_client_msgid_set.h"
+
+
+static void *entry_at(CFE_SBN_Client_MsgIdSet_t *Set, uint32 Slot)
+{
+    return (uint8 *)Set->Entries + Slot * Set->EntrySize;
+} /* end entry_at */
+
+
+static CFE_SB_MsgId_t msg_id_at(CFE_SBN_Client_MsgIdSet_t *Set, uint32 Slot)
+{
+    return *(CFE_SB_MsgId_t *)entry_at(Set, Slot);
+} /* end msg_id_at */
+
+
+static uint32 msg_id_hash(CFE_SBN_Client_MsgIdSet_t *Set,
+                          CFE_SB_MsgId_t MsgId)
+{
+    /* Fibonacci hashing spreads the sequential MsgIds apps tend to use */
+    return (((uint32)MsgId * 2654435761u) >> 16) & (Set->Size - 1);
+} /* end msg_id_hash */
+
+
+/* find_slot returns the slot holding MsgId, or the empty slot that ends its
+ * probe sequence when MsgId is not in the set */
+static uint32 find_slot(CFE_SBN_Client_MsgIdSet_t *Set, CFE_SB_MsgId_t MsgId)
+{
+    uint32 slot = msg_id_hash(Set, MsgId);
+    uint32 probes;
+
+    for (probes = 0; probes < Set->Size; probes++)
+    {
+
+        if (msg_id_at(Set, slot) == CFE_SBN_CLIENT_INVALID_MSG_ID ||
+            msg_id_at(Set, slot) == MsgId)
+        {
+            break;
+        } /* end if */
+
+        slot = (slot + 1) & (Set->Size - 1);
+    } /* end for */
+
+    return slot;
+} /* end find_slot */
+
+
+void CFE_SBN_Client_MsgIdSetClear(CFE_SBN_Client_MsgIdSet_t *Set)
+{
+    memset(Set->Entries, 0, Set->Size * Set->EntrySize);
+    Set->Count = 0;
+} /* end CFE_SBN_Client_MsgIdSetClear */
+
+
+void *CFE_SBN_Client_MsgIdSetFind(CFE_SBN_Client_MsgIdSet_t *Set,
+                                  CFE_SB_MsgId_t MsgId)
+{
+    uint32 slot = find_slot(Set, MsgId);
+
+    if (MsgId == CFE_SBN_CLIENT_INVALID_MSG_ID ||
+        msg_id_at(Set, slot) != MsgId)
+    {
+        return NULL;
+    } /* end if */
+
+    return entry_at(Set, slot);
+} /* end CFE_SBN_Client_MsgIdSetFind */
+
+
+void *CFE_SBN_Client_MsgIdSetInsert(CFE_SBN_Client_MsgIdSet_t *Set,
+                                    CFE_SB_MsgId_t MsgId)
+{
+    uint32 slot;
+
+    if (MsgId == CFE_SBN_CLIENT_INVALID_MSG_ID)
+    {
+        return NULL;
+    } /* end if */
+
+    slot = find_slot(Set, MsgId);
+
+    if (msg_id_at(Set, slot) == MsgId)
+    {
+        return entry_at(Set, slot);
+    } /* end if */
+
+    /* the set always keeps one slot free so probes end */
+    if (Set->Count + 1 >= Set->Size)
+    {
+        return NULL;
+    } /* end if */
+
+    *(CFE_SB_MsgId_t *)entry_at(Set, slot) = MsgId;
+    Set->Count++;
+
+    return entry_at(Set, slot);
+} /* end CFE_SBN_Client_MsgIdSetInsert */
+
+
+boolean CFE_SBN_Client_MsgIdSetRemove(CFE_SBN_Client_MsgIdSet_t *Set,
+                                      CFE_SB_MsgId_t MsgId)
+{
+    uint32 mask = Set->Size - 1;
+    uint32 slot, next, home;
+
+    slot = find_slot(Set, MsgId);
+
+    if (MsgId == CFE_SBN_CLIENT_INVALID_MSG_ID ||
+        msg_id_at(Set, slot) != MsgId)
+    {
+        return FALSE;
+    } /* end if */
+
+    /* shift later entries of the probe sequence back so lookups never stop
+     * early at the emptied slot */
+    memset(entry_at(Set, slot), 0, Set->EntrySize);
+    Set->Count--;
+    next = (slot + 1) & mask;
+
+    while (msg_id_at(Set, next) != CFE_SBN_CLIENT_INVALID_MSG_ID)
+    {
+        home = msg_id_hash(Set, msg_id_at(Set, next));
+
+        /* entries whose home is cyclically in (slot, next] stay */
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            memcpy(entry_at(Set, slot), entry_at(Set, next), Set->EntrySize);
+            memset(entry_at(Set, next), 0, Set->EntrySize);
+            slot = next;
+        } /* end if */
+
+        next = (next + 1) & mask;
+    } /* end while */
+
+    return TRUE;
+} /* end CFE_SBN_Client_MsgIdSetRemove */
@@ -0,0 +1,118 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_msgid_set_h_
+#define _sbn_client_msgid_set_h_
+
+#include "sbn_interfaces.h"
+#include "sbn_client_utils.h"
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/******************************************************************************
+**  Typedef:  CFE_SBN_Client_MsgIdSet_t
+**
+**  Purpose:
+**     Open addressed (linear probing) hash set of MsgIds, over an array of
+**     Size entries of EntrySize bytes the owner provides.  Each entry starts
+**     with its CFE_SB_MsgId_t, CFE_SBN_CLIENT_INVALID_MSG_ID marking empty
+**     ones, and whatever follows is the owner's and moves with the MsgId.
+**     Size must be a power of two.  The set keeps no lock, its owner
+**     serializes changes and lookups.
+*/
+typedef struct {
+    void   *Entries;
+    size_t  EntrySize;
+    uint32  Size;
+    uint32  Count;
+} CFE_SBN_Client_MsgIdSet_t;
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTMsgIdSet sbn_client MsgId hash set
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief Empties the set.
+**
+** \par Description
+**          Zeroes every entry, so entries the set hands out start zeroed
+**          but for their MsgId.
+**
+** \param[in]  Set          The set.
+**
+**/
+void CFE_SBN_Client_MsgIdSetClear(CFE_SBN_Client_MsgIdSet_t *Set);
+
+/*****************************************************************************/
+/**
+** \brief Looks up the entry of a MsgId.
+**
+** \par Description
+**          A hash probe, so its cost does not depend on how many MsgIds
+**          the set holds.
+**
+** \param[in]  Set          The set.
+**
+** \param[in]  MsgId        The MsgId to look up.
+**
+** \return The MsgId's entry, or NULL if the set does not hold it
+**
+**/
+void *CFE_SBN_Client_MsgIdSetFind(CFE_SBN_Client_MsgIdSet_t *Set,
+                                  CFE_SB_MsgId_t MsgId);
+
+/*****************************************************************************/
+/**
+** \brief Adds a MsgId to the set.
+**
+** \par Description
+**          One entry is always left empty so probes end, a set of Size
+**          entries holds at most Size - 1 MsgIds.  Adding a MsgId the set
+**          holds returns its entry unchanged.
+**
+** \param[in]  Set          The set.
+**
+** \param[in]  MsgId        The MsgId to add.
+**
+** \return The MsgId's entry, or NULL if the set is full or MsgId is
+**         CFE_SBN_CLIENT_INVALID_MSG_ID
+**
+**/
+void *CFE_SBN_Client_MsgIdSetInsert(CFE_SBN_Client_MsgIdSet_t *Set,
+                                    CFE_SB_MsgId_t MsgId);
+
+/*****************************************************************************/
+/**
+** \brief Takes a MsgId out of the set.
+**
+** \par Description
+**          Moves later entries of its probe sequence back rather than
+**          leaving a marker, so entries handed out before may have moved.
+**
+** \param[in]  Set          The set.
+**
+** \param[in]  MsgId        The MsgId to remove.
+**
+** \return TRUE if the set held MsgId
+**
+**/
+boolean CFE_SBN_Client_MsgIdSetRemove(CFE_SBN_Client_MsgIdSet_t *Set,
+                                      CFE_SB_MsgId_t MsgId);
+
+/**@}*/
+
+#endif /* _sbn_client_msgid_set_h_ */
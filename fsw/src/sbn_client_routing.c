@@ -0,0 +1,174 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <pthread.h>
+
+#include "sbn_client_routing.h"
+#include "sbn_client_msgid_set.h"
+
+#if (CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE & \
+     (CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE - 1)) != 0
+#error CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE must be a power of two
+#endif
+
+/* Destination pipes of each MsgId subscribed to, kept in a MsgId set.
+ * Subscribe/Unsubscribe/DeletePipe write it from application threads and the
+ * receive thread reads it for every message, hence the rwlock. */
+extern CFE_SBN_Client_PipeD_t PipeTbl[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+
+static MsgId_to_pipes_t MsgId_Subscriptions[CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE];
+static CFE_SBN_Client_MsgIdSet_t routes = {
+    MsgId_Subscriptions, sizeof(MsgId_to_pipes_t), 
+    CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE, 0
+};
+static pthread_rwlock_t routing_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+void CFE_SBN_Client_InitRoutingTbl(void)
+{
+    pthread_rwlock_wrlock(&routing_lock);
+    CFE_SBN_Client_MsgIdSetClear(&routes);
+    pthread_rwlock_unlock(&routing_lock);
+}
+
+int32 CFE_SBN_Client_AddRoute(CFE_SB_MsgId_t MsgId, uint8 PipeIdx)
+{
+    int32             status = SBN_CLIENT_SUCCESS;
+    MsgId_to_pipes_t *route;
+    uint16            i;
+    
+    pthread_rwlock_wrlock(&routing_lock);
+    
+    route = CFE_SBN_Client_MsgIdSetInsert(&routes, MsgId);
+    
+    if (route == NULL)
+    {
+        status = CFE_SB_MAX_MSGS_MET;
+    }
+    else
+    {
+        for (i = 0; i < route->NumPipes; i++)
+        {
+            if (route->PipeIdx[i] == PipeIdx)
+            {
+                break;
+            }
+        }
+        
+        if (i == route->NumPipes)
+        {
+            route->PipeIdx[route->NumPipes++] = PipeIdx;
+        }
+    }
+    
+    pthread_rwlock_unlock(&routing_lock);
+    
+    return status;
+}
+
+void CFE_SBN_Client_RemoveRoute(CFE_SB_MsgId_t MsgId, uint8 PipeIdx)
+{
+    MsgId_to_pipes_t *route;
+    uint16            i;
+    
+    pthread_rwlock_wrlock(&routing_lock);
+    
+    route = CFE_SBN_Client_MsgIdSetFind(&routes, MsgId);
+    
+    for (i = 0; route != NULL && i < route->NumPipes; i++)
+    {
+        if (route->PipeIdx[i] == PipeIdx)
+        {
+            route->PipeIdx[i] = route->PipeIdx[route->NumPipes - 1];
+            route->NumPipes--;
+            
+            /* last destination gone */
+            if (route->NumPipes == 0)
+            {
+                CFE_SBN_Client_MsgIdSetRemove(&routes, MsgId);
+            }
+            
+            break;
+        } /* end if */
+        
+    } /* end for */
+    
+    pthread_rwlock_unlock(&routing_lock);
+}
+
+boolean CFE_SBN_Client_RetainSbnSub(CFE_SB_MsgId_t MsgId)
+{
+    MsgId_to_pipes_t *route;
+    boolean           first = FALSE;
+    
+    pthread_rwlock_wrlock(&routing_lock);
+    
+    route = CFE_SBN_Client_MsgIdSetFind(&routes, MsgId);
+    
+    if (route != NULL && route->SbnRefs < route->NumPipes)
+    {
+        first = (route->SbnRefs++ == 0);
+    }
+    
+    pthread_rwlock_unlock(&routing_lock);
+    
+    return first;
+}
+
+boolean CFE_SBN_Client_ReleaseSbnSub(CFE_SB_MsgId_t MsgId)
+{
+    MsgId_to_pipes_t *route;
+    boolean           last = FALSE;
+    
+    pthread_rwlock_wrlock(&routing_lock);
+    
+    route = CFE_SBN_Client_MsgIdSetFind(&routes, MsgId);
+    
+    if (route != NULL && route->SbnRefs != 0)
+    {
+        last = (--route->SbnRefs == 0);
+    }
+    
+    pthread_rwlock_unlock(&routing_lock);
+    
+    return last;
+}
+
+uint16 CFE_SBN_Client_GetRoutes(CFE_SB_MsgId_t MsgId, uint8 *PipeIdxs, 
+                                uint32 *Generations)
+{
+    MsgId_to_pipes_t *route;
+    uint16            num_pipes = 0;
+    uint16            i;
+    
+    pthread_rwlock_rdlock(&routing_lock);
+    
+    route = CFE_SBN_Client_MsgIdSetFind(&routes, MsgId);
+    
+    if (route != NULL)
+    {
+        num_pipes = route->NumPipes;
+        memcpy(PipeIdxs, route->PipeIdx, 
+               num_pipes * sizeof(route->PipeIdx[0]));
+    }
+    
+    /* DeletePipe removes a pipe's routes before moving its Generation on, 
+     * so while the route is here the Generation is the routed pipe's */
+    for (i = 0; i < num_pipes; i++)
+    {
+        Generations[i] = __atomic_load_n(&PipeTbl[PipeIdxs[i]].Generation, 
+                                         __ATOMIC_ACQUIRE);
+    }
+    
+    pthread_rwlock_unlock(&routing_lock);
+    
+    return num_pipes;
+}
@@ -0,0 +1,127 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_routing_h_
+#define _sbn_client_routing_h_
+
+#include "sbn_interfaces.h"
+#include "sbn_client_utils.h"
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTRouting sbn_client MsgId routing index
+ * @{
+ */
+
+/*****************************************************************************/
+/** 
+** \brief Clears the MsgId routing index.
+**
+** \par Description
+**          Marks every entry of the routing index unused.  Called when the 
+**          pipe table is initialized.
+**
+**/
+void CFE_SBN_Client_InitRoutingTbl(void);
+
+/*****************************************************************************/
+/** 
+** \brief Adds a pipe to the destinations of a MsgId.
+**
+** \par Description
+**          Records that messages with the given MsgId are delivered to the 
+**          pipe at the given pipe table index.  Adding a route that already
+**          exists has no effect.
+**
+** \param[in]  MsgId        The message id subscribed to.
+**
+** \param[in]  PipeIdx      Index of the subscribing pipe in the pipe table.
+**
+** \return Execution status
+** \retval #SBN_CLIENT_SUCCESS  The route exists
+** \retval #CFE_SB_MAX_MSGS_MET  The routing index has no room for the MsgId
+**
+**/
+int32 CFE_SBN_Client_AddRoute(CFE_SB_MsgId_t MsgId, uint8 PipeIdx);
+
+/*****************************************************************************/
+/** 
+** \brief Removes a pipe from the destinations of a MsgId.
+**
+** \par Description
+**          The MsgId entry is removed from the index once it has no 
+**          destination pipes left.  Removing a route that does not exist has
+**          no effect.
+**
+** \param[in]  MsgId        The message id unsubscribed from.
+**
+** \param[in]  PipeIdx      Index of the pipe in the pipe table.
+**
+**/
+void CFE_SBN_Client_RemoveRoute(CFE_SB_MsgId_t MsgId, uint8 PipeIdx);
+
+/*****************************************************************************/
+/** 
+** \brief Counts another pipe subscribed to a MsgId that SBN is told of.
+**
+** \par Description
+**          Called after the pipe's route is added, the count never exceeds
+**          the number of pipes routed.
+**
+** \param[in]  MsgId        The message id subscribed to.
+**
+** \return TRUE when this is the first such pipe and SBN must be sent a 
+**         subscription
+**
+**/
+boolean CFE_SBN_Client_RetainSbnSub(CFE_SB_MsgId_t MsgId);
+
+/*****************************************************************************/
+/** 
+** \brief Counts one pipe fewer subscribed to a MsgId that SBN is told of.
+**
+** \par Description
+**          Called before the pipe's route is removed.
+**
+** \param[in]  MsgId        The message id unsubscribed from.
+**
+** \return TRUE when that was the last such pipe and SBN must be sent an 
+**         unsubscription
+**
+**/
+boolean CFE_SBN_Client_ReleaseSbnSub(CFE_SB_MsgId_t MsgId);
+
+/*****************************************************************************/
+/** 
+** \brief Looks up the destination pipes of a MsgId.
+**
+** \par Description
+**          Copies the pipe table indexes of every pipe subscribed to the 
+**          MsgId into PipeIdxs.  The lookup is a hash probe, so its cost 
+**          does not depend on the number of pipes or subscriptions.
+**
+** \param[in]  MsgId        The message id to look up.
+**
+** \param[out] PipeIdxs     Receives the pipe indexes, must have room for 
+**                          CFE_PLATFORM_SBN_CLIENT_MAX_PIPES entries.
+**
+** \param[out] Generations  Receives each pipe's Generation, to hand to 
+**                          CFE_SBN_Client_PipeEnqueue, with the same room.
+**
+** \return Number of destination pipes written to PipeIdxs
+**
+**/
+uint16 CFE_SBN_Client_GetRoutes(CFE_SB_MsgId_t MsgId, uint8 *PipeIdxs, 
+                                uint32 *Generations);
+/**@}*/
+
+#endif /* _sbn_client_routing_h_ */
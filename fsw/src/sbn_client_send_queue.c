@@ -0,0 +1,606 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#define _GNU_SOURCE /* ppoll, the latency budget is finer than poll's ms */
+
+#include <pthread.h>
+#include <string.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+#include "sbn_client.h"
+#include "sbn_client_buffers.h"
+#include "sbn_client_send_queue.h"
+
+#define SEND_QUEUE_MASK          (SBN_CLIENT_SEND_QUEUE_DEPTH - 1)
+/* longest a producer waiting for space sleeps before looking again */
+#define SPACE_WAIT_SLICE_MS      1
+
+extern int sbn_client_sockfd;
+
+/* The queue is a bounded multi producer, single consumer ring of framed
+ * messages in pool buffers.  A producer claims a slot by moving
+ * enqueue_pos on with a compare and swap, then publishes its buffer by
+ * setting the slot's Seq to its position plus one.  The writer takes the
+ * slot at dequeue_pos once Seq says it is published and frees it for the
+ * producer one lap on by setting Seq to its position plus the depth.
+ * Producers never wait on each other or on the writer. */
+typedef struct {
+    uint32                    Seq;
+    CFE_SBN_Client_BufferD_t *Buf;
+} SendSlot_t;
+
+static SendSlot_t send_slots[SBN_CLIENT_SEND_QUEUE_DEPTH];
+static uint32     enqueue_pos = 0;
+static uint32     dequeue_pos = 0;
+
+/* The writer sleeps on wake_fd with wake_at set to the enqueue_pos it is
+ * waiting for, the producer that claims the slot before it writes wake_fd.
+ * Producers waiting for space sleep on space_fd, a semaphore eventfd the
+ * writer adds one to per waiting producer after sending. */
+static boolean    send_queue_running = FALSE;
+static boolean    writer_started = FALSE;
+static pthread_t  writer_thread_id;
+static int        wake_fd = -1;
+static int        space_fd = -1;
+static uint32     wake_at = 0;
+static uint32     producers_waiting = 0;
+
+static uint8      full_policy = SBN_CLIENT_SEND_QUEUE_FULL_POLICY;
+static uint32     latency_budget_us = SBN_CLIENT_SEND_LATENCY_US;
+
+static uint32     dropped_msgs = 0;
+static uint32     send_errors = 0;
+
+
+/* frames_claimed is how many slots producers have claimed and the writer
+ * has not taken, some may not be published yet */
+static uint32 frames_claimed(void)
+{
+    return __atomic_load_n(&enqueue_pos, __ATOMIC_SEQ_CST) - dequeue_pos;
+} /* end frames_claimed */
+
+/* claim_slots claims Count free slots in a row, starting at *Pos, or
+ * returns FALSE when there are not that many free */
+static boolean claim_slots(uint32 Count, uint32 *Pos)
+{
+    uint32 pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+    SendSlot_t *last;
+    int32 lap;
+
+    while (1)
+    {
+        /* the writer frees slots in order, so when the last is free for
+         * this lap the ones before it are too */
+        last = &send_slots[(pos + Count - 1) & SEND_QUEUE_MASK];
+        lap = (int32)(__atomic_load_n(&last->Seq, __ATOMIC_ACQUIRE) -
+                      (pos + Count - 1));
+
+        if (lap == 0)
+        {
+
+            /* a failed swap loads the position another producer moved to */
+            if (__atomic_compare_exchange_n(&enqueue_pos, &pos, pos + Count,
+                                            0, __ATOMIC_SEQ_CST,
+                                            __ATOMIC_RELAXED))
+            {
+                break;
+            } /* end if */
+
+        }
+        else if (lap < 0)
+        {
+            /* the writer has not taken this slot's last message */
+            return FALSE;
+        }
+        else
+        {
+            pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+        } /* end if */
+
+    } /* end while */
+
+    *Pos = pos;
+
+    return TRUE;
+} /* end claim_slots */
+
+/* publish hands the writer Buf in the slot claimed at Pos */
+static void publish(uint32 Pos, CFE_SBN_Client_BufferD_t *Buf)
+{
+    SendSlot_t *slot = &send_slots[Pos & SEND_QUEUE_MASK];
+
+    slot->Buf = Buf;
+    __atomic_store_n(&slot->Seq, Pos + 1, __ATOMIC_RELEASE);
+
+    /* after publishing, so a writer that missed the wake up sees the slot */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (Pos + 1 == __atomic_load_n(&wake_at, __ATOMIC_RELAXED))
+    {
+        uint64 one = 1;
+
+        if (write(wake_fd, &one, sizeof(one)) < 0)
+        {
+            /* already readable, the writer is awake either way */
+        } /* end if */
+
+    } /* end if */
+
+} /* end publish */
+
+/* enqueue puts Buf in the next free slot, or returns FALSE when full */
+static boolean enqueue(CFE_SBN_Client_BufferD_t *Buf)
+{
+    uint32 pos;
+
+    if (!claim_slots(1, &pos))
+    {
+        return FALSE;
+    } /* end if */
+
+    publish(pos, Buf);
+
+    return TRUE;
+} /* end enqueue */
+
+/* dequeue takes the message at the head of the queue, or returns NULL when
+ * none is published there yet */
+static CFE_SBN_Client_BufferD_t *dequeue(void)
+{
+    SendSlot_t *slot = &send_slots[dequeue_pos & SEND_QUEUE_MASK];
+    CFE_SBN_Client_BufferD_t *buf;
+
+    if (__atomic_load_n(&slot->Seq, __ATOMIC_ACQUIRE) != dequeue_pos + 1)
+    {
+        return NULL;
+    } /* end if */
+
+    buf = slot->Buf;
+    slot->Buf = NULL;
+    __atomic_store_n(&slot->Seq, dequeue_pos + SBN_CLIENT_SEND_QUEUE_DEPTH,
+                     __ATOMIC_RELEASE);
+    __atomic_add_fetch(&dequeue_pos, 1, __ATOMIC_SEQ_CST);
+
+    return buf;
+} /* end dequeue */
+
+/* wake_producers lets producers waiting for space look again */
+static void wake_producers(void)
+{
+    uint64 waiting = __atomic_load_n(&producers_waiting, __ATOMIC_SEQ_CST);
+
+    if (waiting > 0 && write(space_fd, &waiting, sizeof(waiting)) < 0)
+    {
+        /* they look again within SPACE_WAIT_SLICE_MS anyway */
+    } /* end if */
+
+} /* end wake_producers */
+
+/* wait_for_space waits a little for the writer to free a slot, returns
+ * FALSE if the queue was closed */
+static boolean wait_for_space(void)
+{
+    struct pollfd poll_fd = { space_fd, POLLIN, 0 };
+    uint64 count;
+
+    __atomic_add_fetch(&producers_waiting, 1, __ATOMIC_SEQ_CST);
+
+    if (poll(&poll_fd, 1, SPACE_WAIT_SLICE_MS) > 0 &&
+        read(space_fd, &count, sizeof(count)) < 0)
+    {
+        /* another producer took the wake up */
+    } /* end if */
+
+    __atomic_sub_fetch(&producers_waiting, 1, __ATOMIC_SEQ_CST);
+
+    return __atomic_load_n(&send_queue_running, __ATOMIC_ACQUIRE);
+} /* end wait_for_space */
+
+/* wait_for_wake sleeps the writer until the claim that takes enqueue_pos to
+ * target, or timeout (NULL for none) */
+static void wait_for_wake(uint32 target, const struct timespec *timeout)
+{
+    struct pollfd poll_fd = { wake_fd, POLLIN, 0 };
+    uint64 count;
+
+    __atomic_store_n(&wake_at, target, __ATOMIC_SEQ_CST);
+
+    /* a claim made before wake_at was set does not wake the writer */
+    if ((int32)(__atomic_load_n(&enqueue_pos, __ATOMIC_SEQ_CST) - target) < 0)
+    {
+        ppoll(&poll_fd, 1, timeout, NULL);
+    } /* end if */
+
+    __atomic_store_n(&wake_at, 0, __ATOMIC_SEQ_CST);
+
+    if (read(wake_fd, &count, sizeof(count)) < 0)
+    {
+        /* not written, a timeout or a claim before wake_at was set */
+    } /* end if */
+
+} /* end wait_for_wake */
+
+/* queue_full does what the full policy says for Count messages that do not 
+ * fit, returning TRUE to try again or FALSE with what to return in status */
+static boolean queue_full(uint32 Count, int32 *status)
+{
+
+    switch (__atomic_load_n(&full_policy, __ATOMIC_RELAXED))
+    {
+        case SBN_CLIENT_SEND_QUEUE_DROP:
+            __atomic_add_fetch(&dropped_msgs, Count, __ATOMIC_RELAXED);
+            *status = CFE_SUCCESS;
+            return FALSE;
+
+        case SBN_CLIENT_SEND_QUEUE_EAGAIN:
+            *status = CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR;
+            return FALSE;
+
+        default:
+            *status = CFE_SB_BUF_ALOC_ERR;
+            return wait_for_space();
+    } /* end switch */
+
+} /* end queue_full */
+
+/* frame_copy copies Msg into a pool buffer framed for SBN, or returns NULL
+ * when the pool has none left */
+static CFE_SBN_Client_BufferD_t *frame_copy(CFE_SB_Msg_t *Msg)
+{
+    uint16 msg_size = CFE_SBN_Client_GetTotalMsgLength(Msg);
+    CFE_SBN_Client_BufferD_t *buf;
+
+    buf = CFE_SBN_Client_GetBuffer(CFE_SBN_Client_GetMsgId(Msg),
+                                   msg_size + CFE_SBN_CLIENT_FRAME_MSG_OFFSET);
+
+    if (buf == NULL)
+    {
+        return NULL;
+    } /* end if */
+
+    CFE_SBN_Client_PackAppHeader(
+      (char *)buf->Buffer + CFE_SBN_CLIENT_FRAME_OFFSET, msg_size);
+    memcpy((char *)buf->Buffer + CFE_SBN_CLIENT_FRAME_MSG_OFFSET, Msg, 
+           msg_size);
+
+    return buf;
+} /* end frame_copy */
+
+static void release_frames(CFE_SBN_Client_BufferD_t *Frames[], uint32 Count)
+{
+    uint32 i;
+
+    for (i = 0; i < Count; i++)
+    {
+        CFE_SBN_Client_ReleaseBuffer(Frames[i]);
+    } /* end for */
+
+} /* end release_frames */
+
+static uint64 monotonic_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+} /* end monotonic_us */
+
+/* wait_for_frames waits for a message to be queued, then up to the latency
+ * budget for a full batch to gather */
+static void wait_for_frames(void)
+{
+    struct timespec remaining;
+    uint64 deadline_us, now_us;
+
+    while (frames_claimed() == 0 && CFE_SBN_Client_SendQueueRunning())
+    {
+        wait_for_wake(dequeue_pos + 1, NULL);
+    } /* end while */
+
+    deadline_us = monotonic_us() +
+                  __atomic_load_n(&latency_budget_us, __ATOMIC_RELAXED);
+
+    while (frames_claimed() < SBN_CLIENT_MAX_SEND_BATCH &&
+           CFE_SBN_Client_SendQueueRunning())
+    {
+        now_us = monotonic_us();
+
+        if (now_us >= deadline_us)
+        {
+            break;
+        } /* end if */
+
+        remaining.tv_sec = (deadline_us - now_us) / 1000000;
+        remaining.tv_nsec = ((deadline_us - now_us) % 1000000) * 1000;
+
+        wait_for_wake(dequeue_pos + SBN_CLIENT_MAX_SEND_BATCH, &remaining);
+    } /* end while */
+
+} /* end wait_for_frames */
+
+
+int32 CFE_SBN_Client_SendQueueOpen(void)
+{
+    int32 status;
+    uint32 i;
+
+    for (i = 0; i < SBN_CLIENT_SEND_QUEUE_DEPTH; i++)
+    {
+        send_slots[i].Seq = i;
+        send_slots[i].Buf = NULL;
+    } /* end for */
+
+    enqueue_pos = 0;
+    dequeue_pos = 0;
+    wake_at = 0;
+    producers_waiting = 0;
+
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    space_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC | EFD_SEMAPHORE);
+
+    if (wake_fd < 0 || space_fd < 0)
+    {
+        log_message("SBN_CLIENT: ERROR could not create send queue eventfds\n");
+        CFE_SBN_Client_SendQueueClose();
+        return SBN_CLIENT_SEND_THREAD_CREATE_EID;
+    } /* end if */
+
+    __atomic_store_n(&send_queue_running, TRUE, __ATOMIC_RELEASE);
+
+    status = check_pthread_create_status(
+      pthread_create(&writer_thread_id, NULL, CFE_SBN_Client_SendWriter, NULL),
+      SBN_CLIENT_SEND_THREAD_CREATE_EID);
+
+    if (status == SBN_CLIENT_SUCCESS)
+    {
+        writer_started = TRUE;
+    }
+    else
+    {
+        CFE_SBN_Client_SendQueueClose();
+    } /* end if */
+
+    return status;
+} /* end CFE_SBN_Client_SendQueueOpen */
+
+void CFE_SBN_Client_SendQueueClose(void)
+{
+    uint64 one = 1;
+
+    __atomic_store_n(&send_queue_running, FALSE, __ATOMIC_RELEASE);
+
+    if (wake_fd >= 0 && write(wake_fd, &one, sizeof(one)) < 0)
+    {
+        /* already readable, the writer is awake either way */
+    } /* end if */
+
+    if (writer_started)
+    {
+        pthread_join(writer_thread_id, NULL);
+        writer_started = FALSE;
+    } /* end if */
+
+    /* messages queued as the writer stopped */
+    if (wake_fd >= 0)
+    {
+        CFE_SBN_Client_SendQueueFlush();
+    } /* end if */
+
+    if (wake_fd >= 0)
+    {
+        close(wake_fd);
+        wake_fd = -1;
+    } /* end if */
+
+    if (space_fd >= 0)
+    {
+        close(space_fd);
+        space_fd = -1;
+    } /* end if */
+
+} /* end CFE_SBN_Client_SendQueueClose */
+
+boolean CFE_SBN_Client_SendQueueRunning(void)
+{
+    return __atomic_load_n(&send_queue_running, __ATOMIC_ACQUIRE);
+} /* end CFE_SBN_Client_SendQueueRunning */
+
+int32 CFE_SBN_Client_SendQueuePut(CFE_SB_Msg_t *Msg)
+{
+    CFE_SBN_Client_BufferD_t *buf;
+    int32 status;
+
+    /* the pool has a buffer for every slot, so no buffer means full */
+    while ((buf = frame_copy(Msg)) == NULL)
+    {
+
+        if (!queue_full(1, &status))
+        {
+            return status;
+        } /* end if */
+
+    } /* end while */
+
+    return CFE_SBN_Client_SendQueuePutFrame(buf);
+} /* end CFE_SBN_Client_SendQueuePut */
+
+int32 CFE_SBN_Client_SendQueuePutFrame(CFE_SBN_Client_BufferD_t *Frame)
+{
+    int32 status;
+
+    while (!enqueue(Frame))
+    {
+
+        if (!queue_full(1, &status))
+        {
+            CFE_SBN_Client_ReleaseBuffer(Frame);
+            return status;
+        } /* end if */
+
+    } /* end while */
+
+    return CFE_SUCCESS;
+} /* end CFE_SBN_Client_SendQueuePutFrame */
+
+int32 CFE_SBN_Client_SendQueuePutBatch(CFE_SB_Msg_t *Msgs[], uint32 Count)
+{
+    CFE_SBN_Client_BufferD_t *frames[SBN_CLIENT_SEND_QUEUE_DEPTH];
+    uint32 pos, i = 0;
+    int32 status;
+
+    if (Count > SBN_CLIENT_SEND_QUEUE_DEPTH)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    } /* end if */
+
+    while (i < Count)
+    {
+        frames[i] = frame_copy(Msgs[i]);
+
+        if (frames[i] != NULL)
+        {
+            i++;
+            continue;
+        } /* end if */
+
+        /* batches holding part of the pool while waiting for the rest could
+         * wait on each other forever, so start over */
+        release_frames(frames, i);
+        i = 0;
+
+        if (!queue_full(Count, &status))
+        {
+            return status;
+        } /* end if */
+
+    } /* end while */
+
+    /* the writer frees slots without needing these buffers, so they are 
+     * kept while waiting */
+    while (Count > 0 && !claim_slots(Count, &pos))
+    {
+
+        if (!queue_full(Count, &status))
+        {
+            release_frames(frames, Count);
+            return status;
+        } /* end if */
+
+    } /* end while */
+
+    for (i = 0; i < Count; i++)
+    {
+        publish(pos + i, frames[i]);
+    } /* end for */
+
+    return CFE_SUCCESS;
+} /* end CFE_SBN_Client_SendQueuePutBatch */
+
+uint32 CFE_SBN_Client_SendQueueFlush(void)
+{
+    CFE_SBN_Client_BufferD_t *frames[SBN_CLIENT_MAX_SEND_BATCH];
+    struct iovec iov[SBN_CLIENT_MAX_SEND_BATCH];
+    size_t total_size;
+    uint32 count, i, sent = 0;
+
+    do
+    {
+        total_size = 0;
+
+        for (count = 0; count < SBN_CLIENT_MAX_SEND_BATCH; count++)
+        {
+            frames[count] = dequeue();
+
+            if (frames[count] == NULL)
+            {
+                break;
+            } /* end if */
+
+            iov[count].iov_base = 
+              (char *)frames[count]->Buffer + CFE_SBN_CLIENT_FRAME_OFFSET;
+            iov[count].iov_len = 
+              frames[count]->Size - CFE_SBN_CLIENT_FRAME_OFFSET;
+            total_size += iov[count].iov_len;
+        } /* end for */
+
+        if (count == 0)
+        {
+            break;
+        } /* end if */
+
+        if (write_message_vec(sbn_client_sockfd, iov, count) == total_size)
+        {
+            sent += count;
+        }
+        else
+        {
+            __atomic_add_fetch(&send_errors, count, __ATOMIC_RELAXED);
+        } /* end if */
+
+        for (i = 0; i < count; i++)
+        {
+            CFE_SBN_Client_ReleaseBuffer(frames[i]);
+        } /* end for */
+
+        wake_producers();
+    } while (count == SBN_CLIENT_MAX_SEND_BATCH);
+
+    return sent;
+} /* end CFE_SBN_Client_SendQueueFlush */
+
+void *CFE_SBN_Client_SendWriter(void *vargp)
+{
+
+    while (CFE_SBN_Client_SendQueueRunning())
+    {
+        wait_for_frames();
+        CFE_SBN_Client_SendQueueFlush();
+    } /* end while */
+
+    CFE_SBN_Client_SendQueueFlush();
+
+    return NULL;
+} /* end CFE_SBN_Client_SendWriter */
+
+int32 SBN_Client_SetSendQueuePolicy(uint8 FullPolicy, uint32 LatencyBudgetUs)
+{
+
+    if (FullPolicy != SBN_CLIENT_SEND_QUEUE_BLOCK &&
+        FullPolicy != SBN_CLIENT_SEND_QUEUE_DROP &&
+        FullPolicy != SBN_CLIENT_SEND_QUEUE_EAGAIN)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    } /* end if */
+
+    __atomic_store_n(&full_policy, FullPolicy, __ATOMIC_RELAXED);
+    __atomic_store_n(&latency_budget_us, LatencyBudgetUs, __ATOMIC_RELAXED);
+
+    return CFE_SUCCESS;
+} /* end SBN_Client_SetSendQueuePolicy */
+
+int32 SBN_Client_GetSendQueueCounts(uint32 *DroppedMsgs, uint32 *SendErrors)
+{
+
+    if (DroppedMsgs == NULL || SendErrors == NULL)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    } /* end if */
+
+    *DroppedMsgs = __atomic_load_n(&dropped_msgs, __ATOMIC_RELAXED);
+    *SendErrors = __atomic_load_n(&send_errors, __ATOMIC_RELAXED);
+
+    return CFE_SUCCESS;
+} /* end SBN_Client_GetSendQueueCounts */
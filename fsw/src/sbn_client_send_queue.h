@@ -0,0 +1,149 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_send_queue_h_
+#define _sbn_client_send_queue_h_
+
+#include "sbn_client_utils.h"
+#include "sbn_client_wrappers.h"
+
+/* A message framed for SBN in a pool buffer: the message starts at 
+ * CFE_SBN_CLIENT_FRAME_MSG_OFFSET, aligned for the app's structures, with
+ * its SBN header packed right before it at CFE_SBN_CLIENT_FRAME_OFFSET.  
+ * The buffer's Size counts from the start of the buffer. */
+#define CFE_SBN_CLIENT_FRAME_MSG_OFFSET  ((SBN_PACKED_HDR_SZ + 7) & ~7)
+#define CFE_SBN_CLIENT_FRAME_OFFSET      \
+  (CFE_SBN_CLIENT_FRAME_MSG_OFFSET - SBN_PACKED_HDR_SZ)
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTSendQueue sbn_client asynchronous send queue
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief Empties the send queue and starts its writer thread.
+**
+** \par Description
+**          Called by SBN_Client_Init when #SBN_CLIENT_ASYNC_SEND is set,
+**          after the buffer pool is initialized.  Send queue counts and the
+**          policy set by #SBN_Client_SetSendQueuePolicy are kept.
+**
+** \return SBN_CLIENT_SUCCESS, or an error when the writer cannot be started
+**
+**/
+int32 CFE_SBN_Client_SendQueueOpen(void);
+
+/*****************************************************************************/
+/**
+** \brief Stops the writer thread once it has sent what is queued.
+**
+** \par Description
+**          Messages still queued when the writer has stopped are sent, or
+**          counted as send errors, before the queue is closed.  Does nothing
+**          if the queue is not open.
+**
+**/
+void CFE_SBN_Client_SendQueueClose(void);
+
+/*****************************************************************************/
+/**
+** \brief Tells whether SendMsg should queue messages.
+**
+** \return TRUE between #CFE_SBN_Client_SendQueueOpen and
+**         #CFE_SBN_Client_SendQueueClose
+**
+**/
+boolean CFE_SBN_Client_SendQueueRunning(void);
+
+/*****************************************************************************/
+/**
+** \brief Queues a copy of a message, framed for SBN, for the writer.
+**
+** \par Description
+**          Safe to call from any number of threads at once.  Messages from
+**          one thread are sent in the order queued.  A full queue is handled
+**          as the policy set by #SBN_Client_SetSendQueuePolicy says.
+**
+** \param[in]  Msg          The message, which the caller may reuse at once.
+**
+** \return CFE_SUCCESS when queued or dropped by policy,
+**         CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR when full and not waiting, or
+**         CFE_SB_BUF_ALOC_ERR when the queue closed while waiting
+**
+**/
+int32 CFE_SBN_Client_SendQueuePut(CFE_SB_Msg_t *Msg);
+
+/*****************************************************************************/
+/**
+** \brief Queues a message already framed for SBN in a pool buffer.
+**
+** \par Description
+**          Same as #CFE_SBN_Client_SendQueuePut without the copy.  The queue
+**          owns Frame from then on, releasing it once sent or if it is not
+**          queued.
+**
+** \param[in]  Frame        Buffer holding the framed message.
+**
+** \return As #CFE_SBN_Client_SendQueuePut
+**
+**/
+int32 CFE_SBN_Client_SendQueuePutFrame(CFE_SBN_Client_BufferD_t *Frame);
+
+/*****************************************************************************/
+/**
+** \brief Queues copies of several messages, all of them or none.
+**
+** \par Description
+**          Takes the buffers and slots for the whole batch before queueing
+**          any, so a full queue is handled as the policy set by
+**          #SBN_Client_SetSendQueuePolicy says for the batch as a whole: it
+**          waits for room for all of it, drops all of it, or returns an
+**          error with none of it queued.  The messages are queued in a row,
+**          in order.
+**
+** \param[in]  Msgs         The messages, which the caller may reuse at once.
+**
+** \param[in]  Count        Number of messages, at most 
+**                          #SBN_CLIENT_SEND_QUEUE_DEPTH.
+**
+** \return As #CFE_SBN_Client_SendQueuePut, or CFE_SBN_CLIENT_BAD_ARGUMENT 
+**         when the batch is larger than the queue
+**
+**/
+int32 CFE_SBN_Client_SendQueuePutBatch(CFE_SB_Msg_t *Msgs[], uint32 Count);
+
+/*****************************************************************************/
+/**
+** \brief Sends everything queued so far.
+**
+** \par Description
+**          Sends #SBN_CLIENT_MAX_SEND_BATCH messages per system call.  Only
+**          the writer thread, or the closing thread once the writer has
+**          stopped, may call this.
+**
+** \return Number of messages sent
+**
+**/
+uint32 CFE_SBN_Client_SendQueueFlush(void);
+
+/*****************************************************************************/
+/**
+** \brief The writer thread, sends queued messages until the queue is closed.
+**
+**/
+void *CFE_SBN_Client_SendWriter(void *);
+
+/**@}*/
+
+#endif /* _sbn_client_send_queue_h_ */
@@ -0,0 +1,456 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#include "sbn_client_shm.h"
+
+#if (SBN_CLIENT_SHM_RING_SZ & (SBN_CLIENT_SHM_RING_SZ - 1)) != 0
+#error SBN_CLIENT_SHM_RING_SZ must be a power of two
+#endif
+
+#define RING_MASK       (SBN_CLIENT_SHM_RING_SZ - 1)
+
+/* What a wait on the other side ended with */
+#define WAIT_MOVED      1
+#define WAIT_TIMED_OUT  0
+#define WAIT_CLOSED     -1
+
+/* The attached region.  Reads and writes hold shm_lock to read, keeping the
+ * region mapped while they use it; attaching and detaching hold it to write,
+ * setting shm_closing first so waits on the old region give up. */
+static CFE_SBN_Client_ShmRegion_t *shm_region = NULL;
+static int                         shm_closing = FALSE;
+static pthread_rwlock_t            shm_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+
+/* neither futex call is FUTEX_PRIVATE_FLAG, the other side is another
+ * process */
+static void shm_wake(uint32 *Word)
+{
+    syscall(SYS_futex, Word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+} /* end shm_wake */
+
+
+/* shm_sleep sleeps while *Word is Value, at most TimeoutMs.  Waking early or
+ * for no reason is fine, callers check again. */
+static void shm_sleep(uint32 *Word, uint32 Value, int TimeoutMs)
+{
+    struct timespec timeout;
+
+    timeout.tv_sec = TimeoutMs / 1000;
+    timeout.tv_nsec = (TimeoutMs % 1000) * 1000000L;
+
+    syscall(SYS_futex, Word, FUTEX_WAIT, Value, &timeout, NULL, 0);
+} /* end shm_sleep */
+
+
+/* peer_gone tells whether SBN's process has exited without closing */
+static boolean peer_gone(CFE_SBN_Client_ShmRegion_t *Region)
+{
+    pid_t peer_pid = __atomic_load_n(&Region->PeerPid, __ATOMIC_RELAXED);
+
+    return peer_pid > 0 && kill(peer_pid, 0) < 0 && errno == ESRCH;
+} /* end peer_gone */
+
+
+/* wait_for_index waits for SBN's side to move *Index on from Value, at most
+ * TimeoutMs or, when negative, until the link closes.  SBN's side is looked
+ * for every SBN_CLIENT_SHM_CHECK_MS. */
+static int wait_for_index(CFE_SBN_Client_ShmRegion_t *Region, uint32 *Index,
+                          uint32 *Waiting, uint32 Value, int TimeoutMs)
+{
+    uint64  deadline = CFE_SBN_Client_MonotonicMs() + TimeoutMs;
+    int64   remaining_ms;
+    int     wait_ms;
+    boolean waited = FALSE;
+
+    while (__atomic_load_n(Index, __ATOMIC_ACQUIRE) == Value)
+    {
+
+        if (__atomic_load_n(&shm_closing, __ATOMIC_ACQUIRE) ||
+            __atomic_load_n(&Region->PeerClosed, __ATOMIC_ACQUIRE) ||
+            (waited && peer_gone(Region)))
+        {
+            return WAIT_CLOSED;
+        } /* end if */
+
+        wait_ms = SBN_CLIENT_SHM_CHECK_MS;
+
+        if (TimeoutMs >= 0)
+        {
+            remaining_ms = (int64)(deadline - CFE_SBN_Client_MonotonicMs());
+
+            if (remaining_ms <= 0)
+            {
+                return WAIT_TIMED_OUT;
+            } /* end if */
+
+            if (remaining_ms < wait_ms)
+            {
+                wait_ms = (int)remaining_ms;
+            } /* end if */
+
+        } /* end if */
+
+        /* the other side moves the index before it looks at Waiting, so
+         * either it sees Waiting or the check here sees the index moved */
+        __atomic_store_n(Waiting, 1, __ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(Index, __ATOMIC_SEQ_CST) == Value)
+        {
+            shm_sleep(Index, Value, wait_ms);
+        } /* end if */
+
+        __atomic_store_n(Waiting, 0, __ATOMIC_RELAXED);
+        waited = TRUE;
+    } /* end while */
+
+    return WAIT_MOVED;
+} /* end wait_for_index */
+
+
+/* ring_copy_in copies Size bytes into Ring at Head, which must have room */
+static void ring_copy_in(CFE_SBN_Client_ShmRing_t *Ring, uint32 Head,
+                         const uint8 *Data, uint32 Size)
+{
+    uint32 offset = Head & RING_MASK;
+    uint32 first = SBN_CLIENT_SHM_RING_SZ - offset;
+
+    if (first > Size)
+    {
+        first = Size;
+    } /* end if */
+
+    memcpy(&Ring->Data[offset], Data, first);
+    memcpy(&Ring->Data[0], Data + first, Size - first);
+} /* end ring_copy_in */
+
+
+/* ring_publish hands the bytes written up to Head to the consumer, waking
+ * it only if it sleeps */
+static void ring_publish(CFE_SBN_Client_ShmRing_t *Ring, uint32 Head)
+{
+
+    if (Head == __atomic_load_n(&Ring->Head, __ATOMIC_RELAXED))
+    {
+        return;
+    } /* end if */
+
+    __atomic_store_n(&Ring->Head, Head, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&Ring->ReaderWaiting, __ATOMIC_SEQ_CST))
+    {
+        shm_wake(&Ring->Head);
+    } /* end if */
+
+} /* end ring_publish */
+
+
+static uint32 ring_room(CFE_SBN_Client_ShmRing_t *Ring, uint32 Head)
+{
+    return SBN_CLIENT_SHM_RING_SZ -
+           (Head - __atomic_load_n(&Ring->Tail, __ATOMIC_ACQUIRE));
+} /* end ring_room */
+
+
+uint32 CFE_SBN_Client_ShmRingWrite(CFE_SBN_Client_ShmRing_t *Ring,
+                                   const void *Data, uint32 Size)
+{
+    uint32 head = __atomic_load_n(&Ring->Head, __ATOMIC_RELAXED);
+    uint32 room = ring_room(Ring, head);
+
+    if (Size > room)
+    {
+        Size = room;
+    } /* end if */
+
+    ring_copy_in(Ring, head, (const uint8 *)Data, Size);
+    ring_publish(Ring, head + Size);
+
+    return Size;
+} /* end CFE_SBN_Client_ShmRingWrite */
+
+
+uint32 CFE_SBN_Client_ShmRingRead(CFE_SBN_Client_ShmRing_t *Ring,
+                                  void *Data, uint32 Size)
+{
+    uint32 tail = __atomic_load_n(&Ring->Tail, __ATOMIC_RELAXED);
+    uint32 available = __atomic_load_n(&Ring->Head, __ATOMIC_ACQUIRE) - tail;
+    uint32 offset = tail & RING_MASK;
+    uint32 first = SBN_CLIENT_SHM_RING_SZ - offset;
+
+    if (Size > available)
+    {
+        Size = available;
+    } /* end if */
+
+    if (Size == 0)
+    {
+        return 0;
+    } /* end if */
+
+    if (first > Size)
+    {
+        first = Size;
+    } /* end if */
+
+    memcpy(Data, &Ring->Data[offset], first);
+    memcpy((uint8 *)Data + first, &Ring->Data[0], Size - first);
+
+    /* as ring_publish, from the other end */
+    __atomic_store_n(&Ring->Tail, tail + Size, __ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&Ring->WriterWaiting, __ATOMIC_SEQ_CST))
+    {
+        shm_wake(&Ring->Tail);
+    } /* end if */
+
+    return Size;
+} /* end CFE_SBN_Client_ShmRingRead */
+
+
+int CFE_SBN_Client_ShmRead(unsigned char *Data, size_t Size)
+{
+    CFE_SBN_Client_ShmRing_t *ring;
+    int                       bytes_read = -1;
+
+    if (Size > SBN_CLIENT_SHM_RING_SZ)
+    {
+        Size = SBN_CLIENT_SHM_RING_SZ;
+    } /* end if */
+
+    pthread_rwlock_rdlock(&shm_lock);
+
+    if (shm_region != NULL)
+    {
+        ring = &shm_region->FromSbn;
+
+        do
+        {
+            bytes_read = CFE_SBN_Client_ShmRingRead(ring, Data, Size);
+        } while (bytes_read == 0 &&
+                 wait_for_index(shm_region, &ring->Head, &ring->ReaderWaiting,
+                                ring->Tail, -1) == WAIT_MOVED);
+
+    } /* end if */
+
+    pthread_rwlock_unlock(&shm_lock);
+
+    return bytes_read;
+} /* end CFE_SBN_Client_ShmRead */
+
+
+int CFE_SBN_Client_ShmPoll(int TimeoutMs)
+{
+    CFE_SBN_Client_ShmRing_t *ring;
+    int                       ready = 1;
+
+    pthread_rwlock_rdlock(&shm_lock);
+
+    /* with no region, the read that follows reports the error */
+    if (shm_region != NULL)
+    {
+        ring = &shm_region->FromSbn;
+
+        if (wait_for_index(shm_region, &ring->Head, &ring->ReaderWaiting,
+                           ring->Tail, TimeoutMs) == WAIT_TIMED_OUT)
+        {
+            ready = 0;
+        } /* end if */
+
+    } /* end if */
+
+    pthread_rwlock_unlock(&shm_lock);
+
+    return ready;
+} /* end CFE_SBN_Client_ShmPoll */
+
+
+size_t CFE_SBN_Client_ShmWritev(const struct iovec *iov, int iov_count)
+{
+    CFE_SBN_Client_ShmRing_t *ring;
+    size_t                    total_written = 0;
+    size_t                    piece_written = 0;
+    uint32                    head, room, size;
+    int                       piece = 0;
+
+    pthread_rwlock_rdlock(&shm_lock);
+
+    if (shm_region == NULL)
+    {
+        pthread_rwlock_unlock(&shm_lock);
+        return 0;
+    } /* end if */
+
+    ring = &shm_region->ToSbn;
+    head = __atomic_load_n(&ring->Head, __ATOMIC_RELAXED);
+
+    /* copies all that fits before publishing, so SBN's side is woken once
+     * per message when it keeps up */
+    while (piece < iov_count)
+    {
+        room = ring_room(ring, head);
+
+        if (room == 0)
+        {
+            ring_publish(ring, head);
+
+            if (wait_for_index(shm_region, &ring->Tail, &ring->WriterWaiting,
+                               head - SBN_CLIENT_SHM_RING_SZ, -1) != WAIT_MOVED)
+            {
+                break;
+            } /* end if */
+
+            continue;
+        } /* end if */
+
+        size = room;
+
+        if (size > iov[piece].iov_len - piece_written)
+        {
+            size = iov[piece].iov_len - piece_written;
+        } /* end if */
+
+        ring_copy_in(ring, head,
+                     (const uint8 *)iov[piece].iov_base + piece_written, size);
+        head += size;
+        piece_written += size;
+        total_written += size;
+
+        if (piece_written == iov[piece].iov_len)
+        {
+            piece++;
+            piece_written = 0;
+        } /* end if */
+
+    } /* end while */
+
+    ring_publish(ring, head);
+
+    pthread_rwlock_unlock(&shm_lock);
+
+    return total_written;
+} /* end CFE_SBN_Client_ShmWritev */
+
+
+void CFE_SBN_Client_ShmShutdown(void)
+{
+    __atomic_store_n(&shm_closing, TRUE, __ATOMIC_RELEASE);
+
+    pthread_rwlock_rdlock(&shm_lock);
+
+    if (shm_region != NULL)
+    {
+        shm_wake(&shm_region->FromSbn.Head);
+        shm_wake(&shm_region->ToSbn.Tail);
+    } /* end if */
+
+    pthread_rwlock_unlock(&shm_lock);
+} /* end CFE_SBN_Client_ShmShutdown */
+
+
+void CFE_SBN_Client_ShmClose(void)
+{
+    CFE_SBN_Client_ShmShutdown();
+
+    pthread_rwlock_wrlock(&shm_lock);
+
+    if (shm_region != NULL)
+    {
+        __atomic_store_n(&shm_region->ClientClosed, TRUE, __ATOMIC_SEQ_CST);
+        shm_wake(&shm_region->ToSbn.Head);
+        shm_wake(&shm_region->FromSbn.Tail);
+
+        munmap(shm_region, sizeof(*shm_region));
+        shm_region = NULL;
+    } /* end if */
+
+    pthread_rwlock_unlock(&shm_lock);
+} /* end CFE_SBN_Client_ShmClose */
+
+
+int connect_to_shm_server(const char *shm_name)
+{
+    CFE_SBN_Client_ShmRegion_t *region;
+    struct stat                 shm_stat;
+    uint32                      not_attached = FALSE;
+    int                         shm_fd;
+
+    /* a region once attached is never attached again, SBN's side makes a
+     * new one for the next connection */
+    CFE_SBN_Client_ShmClose();
+
+    shm_fd = shm_open(shm_name, O_RDWR, 0);
+
+    if (shm_fd < 0)
+    {
+        log_message("connect_to_shm_server shm_open err = %s\n",
+                    strerror(errno));
+        return SERVER_CONNECT_ERROR;
+    } /* end if */
+
+    if (fstat(shm_fd, &shm_stat) < 0 ||
+        shm_stat.st_size < (off_t)sizeof(*region))
+    {
+        log_message("connect_to_shm_server region %s is not ready\n",
+                    shm_name);
+        close(shm_fd);
+        return SERVER_CONNECT_ERROR;
+    } /* end if */
+
+    region = mmap(NULL, sizeof(*region), PROT_READ | PROT_WRITE, MAP_SHARED,
+                  shm_fd, 0);
+
+    if (region == MAP_FAILED)
+    {
+        log_message("connect_to_shm_server mmap err = %s\n", strerror(errno));
+        close(shm_fd);
+        return SERVER_CONNECT_ERROR;
+    } /* end if */
+
+    if (__atomic_load_n(&region->Magic, __ATOMIC_ACQUIRE) !=
+          CFE_SBN_CLIENT_SHM_MAGIC ||
+        region->Version != CFE_SBN_CLIENT_SHM_VERSION ||
+        region->RingSz != SBN_CLIENT_SHM_RING_SZ ||
+        __atomic_load_n(&region->PeerClosed, __ATOMIC_ACQUIRE) ||
+        !__atomic_compare_exchange_n(&region->ClientAttached, &not_attached,
+                                     TRUE, FALSE, __ATOMIC_SEQ_CST,
+                                     __ATOMIC_SEQ_CST))
+    {
+        log_message("connect_to_shm_server region %s is not open to a "
+                    "client\n", shm_name);
+        munmap(region, sizeof(*region));
+        close(shm_fd);
+        return SERVER_CONNECT_ERROR;
+    } /* end if */
+
+    __atomic_store_n(&region->ClientPid, getpid(), __ATOMIC_RELEASE);
+
+    pthread_rwlock_wrlock(&shm_lock);
+    shm_region = region;
+    __atomic_store_n(&shm_closing, FALSE, __ATOMIC_RELEASE);
+    pthread_rwlock_unlock(&shm_lock);
+
+    return shm_fd;
+} /* end connect_to_shm_server */
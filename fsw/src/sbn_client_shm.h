@@ -0,0 +1,205 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#ifndef _sbn_client_shm_h_
+#define _sbn_client_shm_h_
+
+#include <sys/uio.h>
+
+#include "sbn_client_utils.h"
+
+/* Magic marks a region SBN's side has finished setting up */
+#define CFE_SBN_CLIENT_SHM_MAGIC     0x53424E52
+#define CFE_SBN_CLIENT_SHM_VERSION   1
+
+/************************************************************************
+** Type Definitions
+*************************************************************************/
+
+/******************************************************************************
+**  Typedef:  CFE_SBN_Client_ShmRing_t
+**
+**  Purpose:
+**     One direction of the shared memory link, a byte ring with a single
+**     producer and a single consumer carrying SBN frames as TCP would.  Head
+**     and Tail count the bytes written and read, each written by one side
+**     only, and are kept on cache lines of their own.  A side about to sleep
+**     on the index the other side moves sets its Waiting flag first, so the
+**     other side only makes the futex call to wake it when it is asleep.
+*/
+typedef struct {
+    uint32 Head;
+    uint32 ReaderWaiting;
+    uint8  HeadPad[56];
+    uint32 Tail;
+    uint32 WriterWaiting;
+    uint8  TailPad[56];
+    uint8  Data[SBN_CLIENT_SHM_RING_SZ];
+} CFE_SBN_Client_ShmRing_t;
+
+/******************************************************************************
+**  Typedef:  CFE_SBN_Client_ShmRegion_t
+**
+**  Purpose:
+**     The shared memory object SBN's side creates for one connection, as a
+**     listening socket accepts one.  A client attaches by setting
+**     ClientAttached, so only one ever does, and a region either side has
+**     closed is not used again.
+*/
+typedef struct {
+    uint32                   Magic;
+    uint32                   Version;
+    uint32                   RingSz;
+    uint32                   ClientAttached;
+    uint32                   ClientClosed;
+    uint32                   PeerClosed;
+    int32                    ClientPid;
+    int32                    PeerPid;
+    uint8                    Pad[32];
+    CFE_SBN_Client_ShmRing_t ToSbn;
+    CFE_SBN_Client_ShmRing_t FromSbn;
+} CFE_SBN_Client_ShmRegion_t;
+
+/****************** Function Prototypes **********************/
+
+/** @defgroup SBNCLIENTShm sbn_client shared memory transport
+ * @{
+ */
+
+/*****************************************************************************/
+/**
+** \brief Makes one attempt to attach to SBN's shared memory region.
+**
+** \par Description
+**          Detaches from any region attached before.  A missing region is a
+**          failed attempt like a refused TCP connection, SBN may not be up
+**          yet.
+**
+** \param[in]  shm_name     Name of the POSIX shared memory object.
+**
+** \return The shared memory object's descriptor, which stands in for the
+**         socket, or SERVER_CONNECT_ERROR
+**
+**/
+int connect_to_shm_server(const char *shm_name);
+
+/*****************************************************************************/
+/**
+** \brief Takes bytes SBN sent, as read() on a socket.
+**
+** \par Description
+**          Waits until there is at least one byte.  Only the receiving
+**          thread may call this.
+**
+** \param[out] Data         Where the bytes go.
+**
+** \param[in]  Size         Most bytes to take.
+**
+** \return Number of bytes taken, 0 when the link is closed, or -1 when
+**         no region is attached
+**
+**/
+int CFE_SBN_Client_ShmRead(unsigned char *Data, size_t Size);
+
+/*****************************************************************************/
+/**
+** \brief Waits for bytes from SBN, as poll() on a socket.
+**
+** \param[in]  TimeoutMs    Longest wait.
+**
+** \return 1 when there are bytes or the link is closed, 0 on timeout
+**
+**/
+int CFE_SBN_Client_ShmPoll(int TimeoutMs);
+
+/*****************************************************************************/
+/**
+** \brief Copies iov_count pieces into the ring toward SBN.
+**
+** \par Description
+**          Waits for room as SBN takes bytes.  Callers serialize on the
+**          send lock, keeping one producer.
+**
+** \param[in]  iov          The pieces, not changed.
+**
+** \param[in]  iov_count    Number of pieces.
+**
+** \return Number of bytes written, short of the total only when the link
+**         closed
+**
+**/
+size_t CFE_SBN_Client_ShmWritev(const struct iovec *iov, int iov_count);
+
+/*****************************************************************************/
+/**
+** \brief Wakes and fails the client's waits on the region, as shutdown().
+**
+** \par Description
+**          Reads and writes fail from then until the next
+**          #connect_to_shm_server.
+**
+**/
+void CFE_SBN_Client_ShmShutdown(void);
+
+/*****************************************************************************/
+/**
+** \brief Detaches from the region, marking it closed for SBN's side.
+**
+** \par Description
+**          Does nothing when no region is attached.
+**
+**/
+void CFE_SBN_Client_ShmClose(void);
+
+/*****************************************************************************/
+/**
+** \brief Copies as many of Size bytes as there is room for into Ring.
+**
+** \par Description
+**          Wakes the consumer if it sleeps.  Either side may use this on
+**          the ring it produces into, and never waits.
+**
+** \param[in]  Ring         The ring.
+**
+** \param[in]  Data         The bytes.
+**
+** \param[in]  Size         Number of bytes.
+**
+** \return Number of bytes written
+**
+**/
+uint32 CFE_SBN_Client_ShmRingWrite(CFE_SBN_Client_ShmRing_t *Ring,
+                                   const void *Data, uint32 Size);
+
+/*****************************************************************************/
+/**
+** \brief Takes up to Size of the bytes in Ring.
+**
+** \par Description
+**          Wakes the producer if it sleeps.  Either side may use this on
+**          the ring it consumes from, and never waits.
+**
+** \param[in]  Ring         The ring.
+**
+** \param[out] Data         Where the bytes go.
+**
+** \param[in]  Size         Most bytes to take.
+**
+** \return Number of bytes taken
+**
+**/
+uint32 CFE_SBN_Client_ShmRingRead(CFE_SBN_Client_ShmRing_t *Ring,
+                                  void *Data, uint32 Size);
+
+/**@}*/
+
+#endif /* _sbn_client_shm_h_ */
@@ -0,0 +1,224 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "sbn_client_transport.h"
+#include "sbn_client_shm.h"
+#include "sbn_client_utils.h"
+
+/* turns the port number into a string for the TCP transport's Address */
+#define PORT_STRING(Port)    PORT_STRING_(Port)
+#define PORT_STRING_(Port)   #Port
+
+/* NULL until CFE_SBN_Client_SetTransport picks one */
+static const CFE_SBN_Client_Transport_t *transport = NULL;
+
+
+/* Operations shared by the socket transports */
+
+static int socket_recv_into(int SockFd, unsigned char *Data, size_t Size)
+{
+    return read(SockFd, Data, Size);
+} /* end socket_recv_into */
+
+
+static int socket_poll_in(int SockFd, int TimeoutMs)
+{
+    struct pollfd poll_fd = { SockFd, POLLIN, 0 };
+
+    return poll(&poll_fd, 1, TimeoutMs);
+} /* end socket_poll_in */
+
+
+static ssize_t socket_sendv(int SockFd, const struct msghdr *Msg, int Flags)
+{
+    /* a connection SBN has dropped must fail the send, not raise SIGPIPE */
+    return sendmsg(SockFd, Msg, Flags | MSG_NOSIGNAL);
+} /* end socket_sendv */
+
+
+static void socket_shutdown(int SockFd)
+{
+    shutdown(SockFd, SHUT_RDWR);
+} /* end socket_shutdown */
+
+
+static void socket_close(int SockFd)
+{
+    close(SockFd);
+} /* end socket_close */
+
+
+static int socket_poll_fd(int SockFd)
+{
+    return SockFd;
+} /* end socket_poll_fd */
+
+
+/* TCP */
+
+static int tcp_connect(void)
+{
+    return connect_to_server(SBN_CLIENT_IP_ADDR, SBN_CLIENT_PORT);
+} /* end tcp_connect */
+
+
+static int tcp_cork(int SockFd, int On)
+{
+    return setsockopt(SockFd, IPPROTO_TCP, TCP_CORK, &On, sizeof(On));
+} /* end tcp_cork */
+
+
+const CFE_SBN_Client_Transport_t CFE_SBN_Client_TcpTransport = {
+    "tcp",
+    SBN_CLIENT_IP_ADDR ":" PORT_STRING(SBN_CLIENT_PORT),
+    tcp_connect,
+    socket_recv_into,
+    socket_poll_in,
+    socket_sendv,
+    socket_shutdown,
+    socket_close,
+    socket_poll_fd,
+    tcp_cork
+};
+
+
+/* Unix domain socket, which has no segments to cork */
+
+static int unix_connect(void)
+{
+    return connect_to_unix_server(SBN_CLIENT_UNIX_PATH);
+} /* end unix_connect */
+
+
+const CFE_SBN_Client_Transport_t CFE_SBN_Client_UnixTransport = {
+    "unix",
+    SBN_CLIENT_UNIX_PATH,
+    unix_connect,
+    socket_recv_into,
+    socket_poll_in,
+    socket_sendv,
+    socket_shutdown,
+    socket_close,
+    socket_poll_fd,
+    NULL
+};
+
+
+/* Shared memory rings, the descriptor only keeps the region open */
+
+static int shm_connect(void)
+{
+    return connect_to_shm_server(SBN_CLIENT_SHM_NAME);
+} /* end shm_connect */
+
+
+static int shm_recv_into(int SockFd, unsigned char *Data, size_t Size)
+{
+    return CFE_SBN_Client_ShmRead(Data, Size);
+} /* end shm_recv_into */
+
+
+static int shm_poll_in(int SockFd, int TimeoutMs)
+{
+    return CFE_SBN_Client_ShmPoll(TimeoutMs);
+} /* end shm_poll_in */
+
+
+static ssize_t shm_sendv(int SockFd, const struct msghdr *Msg, int Flags)
+{
+    size_t total = 0;
+    size_t written;
+    size_t i;
+
+    for (i = 0; i < Msg->msg_iovlen; i++)
+    {
+        total += Msg->msg_iov[i].iov_len;
+    } /* end for */
+
+    written = CFE_SBN_Client_ShmWritev(Msg->msg_iov, Msg->msg_iovlen);
+
+    /* the ring takes everything unless the link has closed */
+    if (written < total)
+    {
+        errno = EPIPE;
+        return -1;
+    } /* end if */
+
+    return written;
+} /* end shm_sendv */
+
+
+static void shm_shutdown(int SockFd)
+{
+    CFE_SBN_Client_ShmShutdown();
+} /* end shm_shutdown */
+
+
+static void shm_close(int SockFd)
+{
+    close(SockFd);
+    CFE_SBN_Client_ShmClose();
+} /* end shm_close */
+
+
+static int shm_poll_fd(int SockFd)
+{
+    return -1;
+} /* end shm_poll_fd */
+
+
+const CFE_SBN_Client_Transport_t CFE_SBN_Client_ShmTransport = {
+    "shm",
+    SBN_CLIENT_SHM_NAME,
+    shm_connect,
+    shm_recv_into,
+    shm_poll_in,
+    shm_sendv,
+    shm_shutdown,
+    shm_close,
+    shm_poll_fd,
+    NULL
+};
+
+
+const CFE_SBN_Client_Transport_t *CFE_SBN_Client_GetTransport(void)
+{
+
+    if (transport != NULL)
+    {
+        return transport;
+    } /* end if */
+
+    if (SBN_CLIENT_TRANSPORT == SBN_CLIENT_TRANSPORT_UNIX)
+    {
+        return &CFE_SBN_Client_UnixTransport;
+    } /* end if */
+
+    if (SBN_CLIENT_TRANSPORT == SBN_CLIENT_TRANSPORT_SHM)
+    {
+        return &CFE_SBN_Client_ShmTransport;
+    } /* end if */
+
+    return &CFE_SBN_Client_TcpTransport;
+} /* end CFE_SBN_Client_GetTransport */
+
+
+void CFE_SBN_Client_SetTransport(const CFE_SBN_Client_Transport_t *Transport)
+{
+    transport = Transport;
+} /* end CFE_SBN_Client_SetTransport */
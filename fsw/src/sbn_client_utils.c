@@ -11,15 +11,59 @@
 */
 
 #include <unistd.h>
+#include <stdlib.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <time.h>
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <linux/errqueue.h>
 
 #include "sbn_client_utils.h"
+#include "sbn_client_buffers.h"
+#include "sbn_client_health.h"
+#include "sbn_client_wrappers.h"
+#include "sbn_client_transport.h"
 
 extern CFE_SBN_Client_PipeD_t PipeTbl[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+extern int sbn_client_cpuId;
 
 struct sockaddr_in server_address;
 
+/* older C libraries know nothing of zero copy sends */
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY     60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY    0x4000000
+#endif
+
+/* Zero copy sending on the SBN connection: enabled is set when 
+ * connect_to_server turned SO_ZEROCOPY on, next_id is the id the kernel 
+ * gives the next MSG_ZEROCOPY send on the connection and is kept under 
+ * send_lock.  done is one past the last send the kernel is finished with, 
+ * read off the error queue under zerocopy_lock by whichever sender is 
+ * waiting, so senders wait for their completions without send_lock. */
+static boolean         zerocopy_enabled = FALSE;
+static uint32          zerocopy_next_id = 0;
+static uint32          zerocopy_done = 0;
+static pthread_mutex_t zerocopy_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Every frame sent to SBN goes out whole under send_lock, so app threads, 
+ * the heartbeat and the send queue writer never interleave their frames. */
+static pthread_mutex_t send_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Receive buffer for the SBN connection.  Frames are parsed out of the bytes
+ * already buffered; the socket is only read again once it is empty, so a 
+ * single read() can satisfy many consecutive frames and any partial frame at
+ * the end carries over to the next read. */
+static SBN_Client_RecvBuf_t recv_buffer = { -1, 0, 0 };
+
 
 int32 check_pthread_create_status(int status, int32 errorId)
 {
@@ -57,50 +101,625 @@ int32 check_pthread_create_status(int status, int32 errorId)
     return thread_status;
 }
 
-/* message_entry_point determines which slot a new message enters the pipe.
- * the mod allows it to go around the bend easily, i.e. 2 + 4 % 5 = 1, 
- * slots 2,3,4,0 are taken so 1 is entry */
-int message_entry_point(CFE_SBN_Client_PipeD_t pipe)
+/* CFE_SBN_Client_AllocPipeRing gives an empty pipe a ring for Depth messages,
+ * the pipe must not already have one */
+int32 CFE_SBN_Client_AllocPipeRing(CFE_SBN_Client_PipeD_t *pipe, uint16 Depth)
+{
+    uint32 ring_size = 1;
+    
+    while (ring_size < Depth)
+    {
+        ring_size <<= 1;
+    }
+    
+    pipe->Messages = calloc(ring_size, sizeof(*pipe->Messages));
+    
+    if (pipe->Messages == NULL)
+    {
+        return CFE_SBN_CLIENT_PIPE_CR_ERR;
+    }
+    
+    pipe->QueueDepth = Depth;
+    pipe->RingMask   = ring_size - 1;
+    pipe->ReadIdx    = 0;
+    pipe->WriteIdx   = 0;
+    pipe->Writing    = 0;
+    
+    return SBN_CLIENT_SUCCESS;
+}
+
+/* CFE_SBN_Client_PipeMsgCount is the number of unread messages in the pipe */
+uint32 CFE_SBN_Client_PipeMsgCount(CFE_SBN_Client_PipeD_t *pipe)
+{
+    return __atomic_load_n(&pipe->WriteIdx, __ATOMIC_ACQUIRE) - 
+           __atomic_load_n(&pipe->ReadIdx, __ATOMIC_ACQUIRE);
+}
+
+static uint8 pipe_is_full(CFE_SBN_Client_PipeD_t *pipe, uint32 write_idx)
+{
+    return write_idx - __atomic_load_n(&pipe->ReadIdx, __ATOMIC_SEQ_CST) >= 
+           pipe->QueueDepth;
+}
+
+/* count_dropped may be called by any producer, readers of the counters 
+ * may see them a message behind */
+static void count_dropped(CFE_SBN_Client_PipeD_t *pipe, 
+                          CFE_SBN_Client_BufferD_t *buf)
+{
+    __atomic_add_fetch(&pipe->SendErrors, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&pipe->DroppedBytes, buf->Size, __ATOMIC_RELAXED);
+}
+
+/* message_left_pipe takes a message that has left the ring off its 
+ * subscription's MsgCount.  Messages still in the pipe when their MsgId was
+ * unsubscribed and subscribed again count against nothing, so MsgCount 
+ * stops at 0 rather than wrap. */
+static void message_left_pipe(CFE_SBN_Client_PipeD_t *pipe, 
+                              CFE_SBN_Client_BufferD_t *buf)
+{
+    uint8  sub_idx = CFE_SBN_Client_GetSubscriptionIdx(pipe, buf->MsgId);
+    uint16 count;
+    
+    if (sub_idx == CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE)
+    {
+        return;
+    }
+    
+    count = __atomic_load_n(&pipe->MsgCount[sub_idx], __ATOMIC_RELAXED);
+    
+    while (count != 0 && 
+           !__atomic_compare_exchange_n(&pipe->MsgCount[sub_idx], &count, 
+                                        count - 1, 0, __ATOMIC_RELAXED, 
+                                        __ATOMIC_RELAXED))
+    {
+        /* count was reloaded, try again */
+    }
+    
+}
+
+/* take_msg_lim_slot counts a message against its subscription's MsgLim 
+ * before it is added to the ring, failing when MsgLim of its messages are
+ * already waiting.  A MsgLim of 0 leaves only the pipe depth as the limit.
+ * Messages the pipe is not subscribed to are not limited. */
+static int32 take_msg_lim_slot(CFE_SBN_Client_PipeD_t *pipe, 
+                               CFE_SBN_Client_BufferD_t *buf)
+{
+    uint8 sub_idx = CFE_SBN_Client_GetSubscriptionIdx(pipe, buf->MsgId);
+    
+    if (sub_idx == CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE)
+    {
+        return SBN_CLIENT_SUCCESS;
+    }
+    
+    if (__atomic_add_fetch(&pipe->MsgCount[sub_idx], 1, __ATOMIC_RELAXED) > 
+        pipe->MsgLim[sub_idx] && pipe->MsgLim[sub_idx] != 0)
+    {
+        __atomic_sub_fetch(&pipe->MsgCount[sub_idx], 1, __ATOMIC_RELAXED);
+        __atomic_add_fetch(&pipe->MsgLimDrops[sub_idx], 1, __ATOMIC_RELAXED);
+        return CFE_SBN_CLIENT_MSG_LIM_ERR;
+    }
+    
+    return SBN_CLIENT_SUCCESS;
+}
+
+/* drop_oldest_message makes room in a full pipe by taking the oldest message
+ * from the reader.  The reader advances ReadIdx with a compare and swap too, 
+ * so exactly one of them gets each message.  The reader may have made room 
+ * since the pipe was seen full, then there is nothing to drop. */
+static void drop_oldest_message(CFE_SBN_Client_PipeD_t *pipe, 
+                                uint32 write_idx)
+{
+    uint32 read_idx = __atomic_load_n(&pipe->ReadIdx, __ATOMIC_ACQUIRE);
+    CFE_SBN_Client_BufferD_t *oldest;
+    
+    if (write_idx - read_idx < pipe->QueueDepth)
+    {
+        return;
+    }
+    
+    oldest = pipe->Messages[read_idx & pipe->RingMask];
+    
+    if (__atomic_compare_exchange_n(&pipe->ReadIdx, &read_idx, read_idx + 1, 
+                                    0, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE))
+    {
+        count_dropped(pipe, oldest);
+        message_left_pipe(pipe, oldest);
+        CFE_SBN_Client_ReleaseBuffer(oldest);
+    }
+    
+}
+
+/* wait_for_space blocks the producer until the reader makes room in the pipe
+ * or the pipe is deleted */
+static int32 wait_for_space(CFE_SBN_Client_PipeD_t *pipe, uint32 write_idx)
 {
-    return (pipe.ReadMessage + pipe.NumberOfMessages) % 
-        CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
+    int32 status = SBN_CLIENT_SUCCESS;
+    
+    pthread_mutex_lock(&pipe->Lock);
+    
+    /* sequentially consistent so either the reader sees this or the check
+     * below sees the space it made, likewise for DeletePipe and InUse */
+    __atomic_store_n(&pipe->WriterWaiting, 1, __ATOMIC_SEQ_CST);
+    
+    while (pipe_is_full(pipe, write_idx) && status == SBN_CLIENT_SUCCESS)
+    {
+        
+        if (__atomic_load_n(&pipe->InUse, __ATOMIC_SEQ_CST) != 
+            CFE_SBN_CLIENT_IN_USE)
+        {
+            status = CFE_SBN_CLIENT_INVALID_PIPE;
+        }
+        else
+        {
+            pthread_cond_wait(&pipe->SpaceAvail, &pipe->Lock);
+        }
+        
+    }
+    
+    __atomic_store_n(&pipe->WriterWaiting, 0, __ATOMIC_RELAXED);
+    
+    pthread_mutex_unlock(&pipe->Lock);
+    
+    return status;
+}
+
+/* start_writing waits for the producer ahead to finish with the ring.  
+ * Producers only hold Writing for a few stores unless a 
+ * SBN_CLIENT_OVERFLOW_BLOCK pipe is full, so they yield rather than sleep. 
+ * Gives up if the pipe is deleted meanwhile, and with NoWait if the 
+ * producer ahead is waiting for room, as the pipe is full. */
+static int32 start_writing(CFE_SBN_Client_PipeD_t *pipe, 
+                           CFE_SBN_Client_BufferD_t *buf, boolean NoWait)
+{
+    
+    while (__atomic_exchange_n(&pipe->Writing, 1, __ATOMIC_ACQUIRE) != 0)
+    {
+        
+        if (__atomic_load_n(&pipe->InUse, __ATOMIC_SEQ_CST) != 
+            CFE_SBN_CLIENT_IN_USE)
+        {
+            return CFE_SBN_CLIENT_INVALID_PIPE;
+        }
+        
+        if (NoWait && __atomic_load_n(&pipe->WriterWaiting, __ATOMIC_SEQ_CST))
+        {
+            count_dropped(pipe, buf);
+            return CFE_SBN_CLIENT_PIPE_FULL_ERR;
+        }
+        
+        sched_yield();
+    }
+    
+    return SBN_CLIENT_SUCCESS;
+}
+
+/* enqueue adds a reference to the buffer to the pipe, unless MsgLim 
+ * messages of its subscription are already waiting, making room in a full
+ * pipe as its OverflowPolicy says.  With NoWait a full 
+ * SBN_CLIENT_OVERFLOW_BLOCK pipe drops the message instead of waiting.  The 
+ * ring indexes only wrap through the mask, so WriteIdx - ReadIdx is the 
+ * number of messages even after the counters overflow.  Generation is the 
+ * pipe's when its route was looked up. */
+static int32 enqueue(CFE_SBN_Client_PipeD_t *pipe, 
+                     CFE_SBN_Client_BufferD_t *buf, uint32 Generation, 
+                     boolean NoWait)
+{
+    int32   status = SBN_CLIENT_SUCCESS;
+    uint32  write_idx = 0;
+    boolean writing = FALSE;
+    
+    /* announce the producer before checking InUse, DeletePipe does the 
+     * reverse so one of the two always sees the other */
+    __atomic_add_fetch(&pipe->Producers, 1, __ATOMIC_SEQ_CST);
+    
+    if (__atomic_load_n(&pipe->InUse, __ATOMIC_SEQ_CST) != 
+        CFE_SBN_CLIENT_IN_USE || 
+        __atomic_load_n(&pipe->Generation, __ATOMIC_ACQUIRE) != Generation)
+    {
+        status = CFE_SBN_CLIENT_INVALID_PIPE;
+    }
+    else if ((status = take_msg_lim_slot(pipe, buf)) == 
+             SBN_CLIENT_SUCCESS)
+    {
+        status = start_writing(pipe, buf, NoWait);
+        
+        if (status == SBN_CLIENT_SUCCESS)
+        {
+            writing = TRUE;
+            write_idx = pipe->WriteIdx;
+        }
+        
+        while (status == SBN_CLIENT_SUCCESS && pipe_is_full(pipe, write_idx))
+        {
+            
+            switch (pipe->OverflowPolicy)
+            {
+                case SBN_CLIENT_OVERFLOW_DROP_OLDEST:
+                    drop_oldest_message(pipe, write_idx);
+                    break;
+                case SBN_CLIENT_OVERFLOW_BLOCK:
+                    
+                    if (!NoWait)
+                    {
+                        status = wait_for_space(pipe, write_idx);
+                        break;
+                    }
+                    
+                    /* fall through, dropping the message as the newest */
+                default: /* SBN_CLIENT_OVERFLOW_DROP_NEWEST */
+                    count_dropped(pipe, buf);
+                    status = CFE_SBN_CLIENT_PIPE_FULL_ERR;
+            }
+            
+        }
+        
+        if (status == SBN_CLIENT_SUCCESS)
+        {
+            CFE_SBN_Client_RetainBuffer(buf);
+            pipe->Messages[write_idx & pipe->RingMask] = buf;
+            /* publishes the slot; sequentially consistent so either this 
+             * thread sees ReaderWaiting or the reader sees the message */
+            __atomic_store_n(&pipe->WriteIdx, write_idx + 1, __ATOMIC_SEQ_CST);
+            __atomic_store_n(&pipe->Writing, 0, __ATOMIC_RELEASE);
+            
+            if (__atomic_load_n(&pipe->ReaderWaiting, __ATOMIC_SEQ_CST))
+            {
+                /* the reader holds the lock until it is waiting on MsgAvail */
+                pthread_mutex_lock(&pipe->Lock);
+                pthread_cond_signal(&pipe->MsgAvail);
+                pthread_mutex_unlock(&pipe->Lock);
+            }
+            
+        }
+        else
+        {
+            
+            if (writing)
+            {
+                __atomic_store_n(&pipe->Writing, 0, __ATOMIC_RELEASE);
+            }
+            
+            /* the message was counted against MsgLim but not added */
+            message_left_pipe(pipe, buf);
+        }
+        
+    }
+    
+    /* the last producer out of a closing pipe lets DeletePipe go on, see
+     * CFE_SBN_Client_PipeWaitForProducers */
+    if (__atomic_sub_fetch(&pipe->Producers, 1, __ATOMIC_SEQ_CST) == 0 && 
+        __atomic_load_n(&pipe->InUse, __ATOMIC_SEQ_CST) == 
+        CFE_SBN_CLIENT_CLOSING)
+    {
+        pthread_mutex_lock(&pipe->Lock);
+        pthread_cond_signal(&pipe->NoProducers);
+        pthread_mutex_unlock(&pipe->Lock);
+    }
+    
+    return status;
+}
+
+/* CFE_SBN_Client_PipeEnqueue adds a message from SBN to the pipe, waiting 
+ * for room in a full SBN_CLIENT_OVERFLOW_BLOCK pipe */
+int32 CFE_SBN_Client_PipeEnqueue(CFE_SBN_Client_PipeD_t *pipe, 
+                                 CFE_SBN_Client_BufferD_t *buf, 
+                                 uint32 Generation)
+{
+    return enqueue(pipe, buf, Generation, FALSE);
+}
+
+/* CFE_SBN_Client_PipeEnqueueNoWait adds a message an app sent to the pipe.
+ * The app may be the pipe's reader, so it never waits for room. */
+int32 CFE_SBN_Client_PipeEnqueueNoWait(CFE_SBN_Client_PipeD_t *pipe, 
+                                       CFE_SBN_Client_BufferD_t *buf, 
+                                       uint32 Generation)
+{
+    return enqueue(pipe, buf, Generation, TRUE);
+}
+
+/* CFE_SBN_Client_PipeDequeue takes the oldest message from the pipe, the 
+ * caller owns the pipe's reference to it.  Returns NULL when empty. */
+CFE_SBN_Client_BufferD_t *CFE_SBN_Client_PipeDequeue(
+  CFE_SBN_Client_PipeD_t *pipe)
+{
+    uint32 read_idx = __atomic_load_n(&pipe->ReadIdx, __ATOMIC_ACQUIRE);
+    CFE_SBN_Client_BufferD_t *buf;
+    
+    /* a drop oldest producer may take the message first, then the next one 
+     * is tried; the slot is only read, so losing the race is harmless */
+    do
+    {
+        
+        if (__atomic_load_n(&pipe->WriteIdx, __ATOMIC_SEQ_CST) == read_idx)
+        {
+            return NULL;
+        }
+        
+        buf = pipe->Messages[read_idx & pipe->RingMask];
+    } while (!__atomic_compare_exchange_n(&pipe->ReadIdx, &read_idx, 
+                                          read_idx + 1, 0, __ATOMIC_SEQ_CST, 
+                                          __ATOMIC_ACQUIRE));
+    
+    message_left_pipe(pipe, buf);
+    
+    return buf;
+}
+
+/* CFE_SBN_Client_PipeWakeWriter wakes a producer blocked on the pipe being 
+ * full after the reader has taken a message.  The caller must not hold the 
+ * pipe Lock. */
+void CFE_SBN_Client_PipeWakeWriter(CFE_SBN_Client_PipeD_t *pipe)
+{
+    
+    if (__atomic_load_n(&pipe->WriterWaiting, __ATOMIC_SEQ_CST))
+    {
+        /* the producer holds the lock until it is waiting on SpaceAvail */
+        pthread_mutex_lock(&pipe->Lock);
+        pthread_cond_signal(&pipe->SpaceAvail);
+        pthread_mutex_unlock(&pipe->Lock);
+    }
+    
+}
+
+/* CFE_SBN_Client_PipeWaitForProducers waits for the producers adding to a 
+ * closing pipe to give up.  The pipe is no longer CFE_SBN_CLIENT_IN_USE, so
+ * no producer starts adding and the last one out signals NoProducers.  The
+ * caller must not hold the pipe Lock. */
+void CFE_SBN_Client_PipeWaitForProducers(CFE_SBN_Client_PipeD_t *pipe)
+{
+    
+    if (__atomic_load_n(&pipe->Producers, __ATOMIC_SEQ_CST) == 0)
+    {
+        return;
+    }
+    
+    pthread_mutex_lock(&pipe->Lock);
+    
+    while (__atomic_load_n(&pipe->Producers, __ATOMIC_SEQ_CST) != 0)
+    {
+        pthread_cond_wait(&pipe->NoProducers, &pipe->Lock);
+    }
+    
+    pthread_mutex_unlock(&pipe->Lock);
+}
+
+uint64 CFE_SBN_Client_MonotonicMs(void)
+{
+    struct timespec now;
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    
+    return (uint64)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+/* frame_progress notes bytes of the current frame being taken, starting the 
+ * frame's deadline with the first of them */
+static void frame_progress(void)
+{
+    
+    if (!recv_buffer.FrameStarted)
+    {
+        recv_buffer.FrameStarted = TRUE;
+        recv_buffer.FrameDeadlineMs = CFE_SBN_Client_MonotonicMs() + 
+                                      SBN_CLIENT_FRAME_DEADLINE_MS;
+    }
+    
+}
+
+/* wait_for_bytes bounds the wait for more of a frame that has started by
+ * SBN_CLIENT_STALL_TIMEOUT_MS and the frame's deadline.  Waits between frames
+ * are left to the blocking read and TCP keepalive. */
+static int wait_for_bytes(int sockfd)
+{
+    int64 timeout_ms;
+    int   ready;
+    
+    if (!recv_buffer.FrameStarted)
+    {
+        return CFE_SUCCESS;
+    }
+    
+    do
+    {
+        timeout_ms = (int64)(recv_buffer.FrameDeadlineMs - 
+                             CFE_SBN_Client_MonotonicMs());
+        
+        if (timeout_ms > SBN_CLIENT_STALL_TIMEOUT_MS)
+        {
+            timeout_ms = SBN_CLIENT_STALL_TIMEOUT_MS;
+        }
+        else if (timeout_ms < 0)
+        {
+            timeout_ms = 0;
+        }
+        
+        ready = CFE_SBN_Client_GetTransport()->PollIn(sockfd, 
+                                                      (int)timeout_ms);
+    } while (ready < 0 && errno == EINTR);
+    
+    if (ready == 0)
+    {
+        log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_READ_TIMEOUT_ERR, frame "
+                    "stalled\n");
+        return CFE_SBN_CLIENT_READ_TIMEOUT_ERR;
+    }
+    
+    /* poll errors are left for read() to report */
+    return CFE_SUCCESS;
+}
+
+/* CFE_SBN_CLIENT_FillRecvBuffer pulls as many bytes as the socket has 
+ * available (up to the size of the buffer) into the empty receive buffer */
+static int CFE_SBN_CLIENT_FillRecvBuffer(int sockfd)
+{
+    int bytes_received;
+    int status;
+    
+    recv_buffer.Head = 0;
+    recv_buffer.Tail = 0;
+    
+    status = wait_for_bytes(sockfd);
+    
+    if (status != CFE_SUCCESS)
+    {
+        return status;
+    }
+    
+    bytes_received = CFE_SBN_Client_GetTransport()->RecvInto(sockfd, 
+                       recv_buffer.Data, SBN_CLIENT_RECV_BUF_SZ);
+    
+    if (bytes_received < 0)
+    {
+        /* TODO:ERROR socket is dead somehow */       
+        log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_PIPE_BROKEN_ERR\n");
+        return CFE_SBN_CLIENT_PIPE_BROKEN_ERR;
+    }
+    else if (bytes_received == 0)
+    {
+        /* TODO:ERROR closed remotely */
+        log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_PIPE_CLOSED_ERR: %s\n", strerror(errno));
+        return CFE_SBN_CLIENT_PIPE_CLOSED_ERR;
+    }
+    
+    recv_buffer.Tail = bytes_received;
+    
+    return CFE_SUCCESS;
+}
+
+void CFE_SBN_CLIENT_ResetRecvBuffer(int sockfd)
+{
+    recv_buffer.SockFd = sockfd;
+    recv_buffer.Head = 0;
+    recv_buffer.Tail = 0;
+    recv_buffer.FrameStarted = FALSE;
+}
+
+/* CFE_SBN_CLIENT_StartFrame is called before parsing each frame, the frame's
+ * deadline starts when its first byte is taken */
+void CFE_SBN_CLIENT_StartFrame(void)
+{
+    recv_buffer.FrameStarted = FALSE;
+}
+
+size_t CFE_SBN_CLIENT_RecvBufferedBytes(void)
+{
+    return recv_buffer.Tail - recv_buffer.Head;
 }
 
 int CFE_SBN_CLIENT_ReadBytes(int sockfd, unsigned char *msg_buffer, 
                              size_t MsgSz)
 {
-    int bytes_received = 0;
-    int total_bytes_recd = 0;
+    int    bytes_received = 0;
+    size_t total_bytes_recd = 0;
+    size_t buffered;
+    int    status;
+    
+    if (recv_buffer.SockFd != sockfd)
+    {
+        CFE_SBN_CLIENT_ResetRecvBuffer(sockfd);
+    }
     
-    /* TODO:Some kind of timeout on this? */
     while (total_bytes_recd != MsgSz)
     {
-        bytes_received = read(sockfd, msg_buffer + total_bytes_recd, 
-                              MsgSz - total_bytes_recd);
+        buffered = CFE_SBN_CLIENT_RecvBufferedBytes();
         
-        if (bytes_received < 0)
+        if (buffered > 0)
         {
-            /* TODO:ERROR socket is dead somehow */       
-            log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_PIPE_BROKEN_ERR\n");
-            return CFE_SBN_CLIENT_PIPE_BROKEN_ERR;
+            /* serve as much as possible from bytes already received */
+            if (buffered > MsgSz - total_bytes_recd)
+            {
+                buffered = MsgSz - total_bytes_recd;
+            }
+            
+            memcpy(msg_buffer + total_bytes_recd, 
+                   recv_buffer.Data + recv_buffer.Head, buffered);
+            recv_buffer.Head += buffered;
+            total_bytes_recd += buffered;
+            frame_progress();
+        }
+        else if (MsgSz - total_bytes_recd >= SBN_CLIENT_RECV_DIRECT_READ_SZ)
+        {
+            /* large remainders skip the buffer and land in place */
+            status = wait_for_bytes(sockfd);
+            
+            if (status != CFE_SUCCESS)
+            {
+                return status;
+            }
+            
+            bytes_received = CFE_SBN_Client_GetTransport()->RecvInto(sockfd, 
+                               msg_buffer + total_bytes_recd, 
+                               MsgSz - total_bytes_recd);
+            
+            if (bytes_received < 0)
+            {
+                /* TODO:ERROR socket is dead somehow */       
+                log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_PIPE_BROKEN_ERR\n");
+                return CFE_SBN_CLIENT_PIPE_BROKEN_ERR;
+            }
+            else if (bytes_received == 0)
+            {
+                /* TODO:ERROR closed remotely */
+                log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_PIPE_CLOSED_ERR: %s\n", strerror(errno));
+                return CFE_SBN_CLIENT_PIPE_CLOSED_ERR;
+            }
+            
+            total_bytes_recd += bytes_received;
+            frame_progress();
+        }
+        else
+        {
+            status = CFE_SBN_CLIENT_FillRecvBuffer(sockfd);
+            
+            if (status != CFE_SUCCESS)
+            {
+                return status;
+            }
+            
+        } /* end if */
+        
+    } /* end while */
+    
+    return CFE_SUCCESS;
+}
+
+/* CFE_SBN_CLIENT_DiscardBytes consumes bytes that have no destination, 
+ * skipping over them in the receive buffer instead of copying them out */
+int CFE_SBN_CLIENT_DiscardBytes(int sockfd, size_t MsgSz)
+{
+    size_t buffered;
+    int    status;
+    
+    if (recv_buffer.SockFd != sockfd)
+    {
+        CFE_SBN_CLIENT_ResetRecvBuffer(sockfd);
+    }
+    
+    while (MsgSz > 0)
+    {
+        buffered = CFE_SBN_CLIENT_RecvBufferedBytes();
+        
+        if (buffered == 0)
+        {
+            status = CFE_SBN_CLIENT_FillRecvBuffer(sockfd);
+            
+            if (status != CFE_SUCCESS)
+            {
+                return status;
+            }
+            
+            buffered = CFE_SBN_CLIENT_RecvBufferedBytes();
         }
-        else if (bytes_received == 0)
+        
+        if (buffered > MsgSz)
         {
-            /* TODO:ERROR closed remotely */
-            log_message("SBN_CLIENT: ERROR CFE_SBN_CLIENT_PIPE_CLOSED_ERR: %s\n", strerror(errno));
-            return CFE_SBN_CLIENT_PIPE_CLOSED_ERR;
+            buffered = MsgSz;
         }
         
-        total_bytes_recd += bytes_received;
+        recv_buffer.Head += buffered;
+        MsgSz -= buffered;
+        frame_progress();
     }
-    // 
-    // log_message("CFE_SBN_CLIENT_ReadBytes THIS MESSAGE:");
-    // int i =0;
-    // for (i = 0; i < MsgSz; i++)
-    // {
-    //     printf("0x%02X ", msg_buffer[i]);
-    // }
-    // printf("\n");
     
     return CFE_SUCCESS;
 }
@@ -109,31 +728,230 @@ void invalidate_pipe(CFE_SBN_Client_PipeD_t *pipe)
 {
     int i;
     
-    pipe->InUse         = CFE_SBN_CLIENT_NOT_IN_USE;
     pipe->SysQueueId    = CFE_SBN_CLIENT_UNUSED_QUEUE;
     pipe->PipeId        = CFE_SBN_CLIENT_INVALID_PIPE;
-    /* SB always holds one message so Number of messages should always be a minimum of 1 */
-    pipe->NumberOfMessages = 1;
-    /* Message to be read will be incremented after receive is called */
-    /* Therefore initial next message is the last in the chain */
-    pipe->ReadMessage = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1;
     memset(&pipe->PipeName[0],0,OS_MAX_API_NAME);
     
+    /* drop the unread messages and the one the app last received */
+    while (pipe->ReadIdx != pipe->WriteIdx)
+    {
+        CFE_SBN_Client_ReleaseBuffer(
+          pipe->Messages[pipe->ReadIdx & pipe->RingMask]);
+        pipe->ReadIdx++;
+    }
+    
+    CFE_SBN_Client_ReleaseBuffer(pipe->CurrentBuff);
+    pipe->CurrentBuff = NULL;
+    pipe->ReadIdx = 0;
+    pipe->WriteIdx = 0;
+    pipe->Writing = 0;
+    free(pipe->Messages);
+    pipe->Messages = NULL;
+    pipe->QueueDepth = 0;
+    pipe->RingMask = 0;
+    
     for(i = 0; i < CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE; i++)
     {
         pipe->SubscribedMsgIds[i] = CFE_SBN_CLIENT_INVALID_MSG_ID;
+        pipe->MsgLim[i] = 0;
+        pipe->MsgCount[i] = 0;
+        pipe->MsgLimDrops[i] = 0;
+        pipe->SubscribedLocal[i] = FALSE;
+        pipe->SubscribedQoS[i].Priority = 0x00;
+        pipe->SubscribedQoS[i].Reliability = 0x00;
     }
     
+    /* routes looked up for the pipe torn down no longer match, and only 
+     * now may CreatePipe take the slot */
+    __atomic_add_fetch(&pipe->Generation, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&pipe->InUse, CFE_SBN_CLIENT_NOT_IN_USE, 
+                     __ATOMIC_SEQ_CST);
+}
+
+/* send_vec sends everything msg describes, carrying on after partial sends,
+ * and counts the sendmsg calls that sent something.  Returns the number of 
+ * bytes sent, short of the total only on error.  msg's iov is consumed. */
+static size_t send_vec(int sockfd, struct msghdr *msg, int flags, 
+                       uint32 *sends)
+{
+    ssize_t sent;
+    size_t  total_sent = 0;
+    
+    *sends = 0;
     
+    while (msg->msg_iovlen > 0)
+    {
+        sent = CFE_SBN_Client_GetTransport()->SendV(sockfd, msg, flags);
+        
+        if (sent < 0)
+        {
+            
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            break;
+        }
+        
+        total_sent += sent;
+        (*sends)++;
+        
+        /* step over the pieces sent whole, then trim one sent in part */
+        while (msg->msg_iovlen > 0 && (size_t)sent >= msg->msg_iov->iov_len)
+        {
+            sent -= msg->msg_iov->iov_len;
+            msg->msg_iov++;
+            msg->msg_iovlen--;
+        }
+        
+        if (msg->msg_iovlen > 0)
+        {
+            msg->msg_iov->iov_base = (char *)msg->msg_iov->iov_base + sent;
+            msg->msg_iov->iov_len -= sent;
+        }
+        
+    }
+    
+    return total_sent;
 }
 
+/* write_message_vec sends iov_count pieces as one message without copying 
+ * them together first.  Returns the number of bytes sent; iov is consumed. */
+size_t write_message_vec(int sockfd, struct iovec *iov, int iov_count)
+{
+    struct msghdr msg;
+    uint32        sends;
+    size_t        total_sent;
+    
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_count;
+    
+    pthread_mutex_lock(&send_lock);
+    total_sent = send_vec(sockfd, &msg, 0, &sends);
+    pthread_mutex_unlock(&send_lock);
+    
+    return total_sent;
+}
+
+/* write_message sends size bytes as one message.  Returns the number of 
+ * bytes sent, short of size only on error. */
 size_t write_message(int sockfd, char *buffer, size_t size)
 {
-  size_t result;
-  
-  result = write(sockfd, buffer, size);
-  
-  return result;
+    struct iovec iov = { buffer, size };
+    
+    return write_message_vec(sockfd, &iov, 1);
+}
+
+/* read_zerocopy_done reads zero copy completions off the socket's error 
+ * queue into zerocopy_done, waiting at most SBN_CLIENT_ZEROCOPY_WAIT_MS for 
+ * some.  Called under zerocopy_lock. */
+static int read_zerocopy_done(int sockfd)
+{
+    struct pollfd             poll_fd = { sockfd, 0, 0 }; /* POLLERR only */
+    char                      control[128];
+    struct msghdr             msg;
+    struct cmsghdr           *cmsg;
+    struct sock_extended_err *serr;
+    
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    
+    /* reading the error queue never blocks */
+    if (recvmsg(sockfd, &msg, MSG_ERRQUEUE) < 0)
+    {
+        
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            return CFE_SBN_CLIENT_PIPE_BROKEN_ERR;
+        }
+        
+        if (poll(&poll_fd, 1, SBN_CLIENT_ZEROCOPY_WAIT_MS) == 0)
+        {
+            return CFE_SBN_CLIENT_READ_TIMEOUT_ERR;
+        }
+        
+        return CFE_SUCCESS;
+    }
+    
+    for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; 
+         cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        serr = (struct sock_extended_err *)CMSG_DATA(cmsg);
+        
+        /* ee_info to ee_data is the range of sends completed */
+        if (serr->ee_origin == SO_EE_ORIGIN_ZEROCOPY && 
+            (int32)(serr->ee_data + 1 - zerocopy_done) > 0)
+        {
+            zerocopy_done = serr->ee_data + 1;
+        }
+        
+    }
+    
+    return CFE_SUCCESS;
+}
+
+/* wait_for_zerocopy waits until the kernel is finished with the send with 
+ * last_id, or SBN_CLIENT_ZEROCOPY_WAIT_MS passes without a completion */
+static int wait_for_zerocopy(int sockfd, uint32 last_id)
+{
+    int status = CFE_SUCCESS;
+    
+    pthread_mutex_lock(&zerocopy_lock);
+    
+    while ((int32)(zerocopy_done - last_id) <= 0 && status == CFE_SUCCESS)
+    {
+        status = read_zerocopy_done(sockfd);
+    }
+    
+    pthread_mutex_unlock(&zerocopy_lock);
+    
+    return status;
+}
+
+/* write_message_zerocopy is write_message_vec having the kernel send 
+ * straight from the caller's memory instead of copying it.  It returns once
+ * the kernel is done with the memory, so the caller may reuse it at once.  
+ * A completion not seen in time is counted in the link health, the bytes 
+ * were still sent.  Without SO_ZEROCOPY on a TCP connection it is 
+ * write_message_vec. */
+size_t write_message_zerocopy(int sockfd, struct iovec *iov, int iov_count)
+{
+    struct msghdr msg;
+    uint32        sends;
+    uint32        last_id;
+    size_t        total_sent;
+    
+    /* completions are read off the error queue of the descriptor the TCP 
+     * transport connects, which other transports need not have */
+    if (!zerocopy_enabled || 
+        CFE_SBN_Client_GetTransport() != &CFE_SBN_Client_TcpTransport)
+    {
+        return write_message_vec(sockfd, iov, iov_count);
+    }
+    
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = iov_count;
+    
+    /* send ids are counted per connection in the order sends are made */
+    pthread_mutex_lock(&send_lock);
+    
+    total_sent = send_vec(sockfd, &msg, MSG_ZEROCOPY, &sends);
+    zerocopy_next_id += sends;
+    last_id = zerocopy_next_id - 1;
+    
+    pthread_mutex_unlock(&send_lock);
+    
+    if (sends > 0 && wait_for_zerocopy(sockfd, last_id) != CFE_SUCCESS)
+    {
+        log_message("SBN_CLIENT: ERROR zero copy send not completed\n");
+        CFE_SBN_Client_HealthZeroCopyLate();
+    }
+    
+    return total_sent;
 }
     
 uint8 CFE_SBN_Client_GetPipeIdx(CFE_SB_PipeId_t PipeId)
@@ -179,6 +997,29 @@ uint8 CFE_SBN_Client_GetMessageSubscribeIndex(CFE_SB_PipeId_t PipeId)
     return CFE_SBN_CLIENT_MAX_MSG_IDS_MET;
 }
 
+/* CFE_SBN_Client_GetSubscriptionIdx finds the pipe's subscription to MsgId,
+ * returning CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE when there is none */
+uint8 CFE_SBN_Client_GetSubscriptionIdx(CFE_SBN_Client_PipeD_t *pipe, 
+                                        CFE_SB_MsgId_t MsgId)
+{
+    uint8 i;
+    
+    if (MsgId == CFE_SBN_CLIENT_INVALID_MSG_ID)
+    {
+        return CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
+    }
+    
+    for (i = 0; i < CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE; i++)
+    {
+        if (pipe->SubscribedMsgIds[i] == MsgId)
+        {
+            break;
+        }
+    }
+    
+    return i;
+}
+
 CFE_SB_MsgId_t CFE_SBN_Client_GetMsgId(CFE_SB_MsgPtr_t MsgPtr)
 {
     CFE_SB_MsgId_t MsgId = 0;
@@ -203,10 +1044,20 @@ return MsgId;
 
 }/* end CFE_SBN_Client_GetMsgId */
 
+void CFE_SBN_Client_PackAppHeader(char *Header, uint16 MsgSize)
+{
+    Pack_t Pack;
+    
+    Pack_Init(&Pack, Header, SBN_PACKED_HDR_SZ, 0);
+    
+    Pack_UInt16(&Pack, MsgSize);
+    Pack_UInt8(&Pack, SBN_APP_MSG);
+    Pack_UInt32(&Pack, sbn_client_cpuId);
+}/* end CFE_SBN_Client_PackAppHeader */
+
 // TODO: return value?
 int send_heartbeat(int sockfd)
 {
-    int retval;
     char sbn_header[SBN_PACKED_HDR_SZ] = {0};
     
     Pack_t Pack;
@@ -216,9 +1067,14 @@ int send_heartbeat(int sockfd)
     Pack_UInt8(&Pack, SBN_HEARTBEAT_MSG);
     Pack_UInt32(&Pack, 2);
     
-    retval = write(sockfd, sbn_header, sizeof(sbn_header));
+    /* a heartbeat sent in part is an error like one not sent at all */
+    if (write_message(sockfd, sbn_header, sizeof(sbn_header)) != 
+        sizeof(sbn_header))
+    {
+        return -1;
+    }
     
-    return retval;
+    return sizeof(sbn_header);
 }
 
 uint16 CFE_SBN_Client_GetTotalMsgLength(CFE_SB_MsgPtr_t MsgPtr)
@@ -226,14 +1082,109 @@ uint16 CFE_SBN_Client_GetTotalMsgLength(CFE_SB_MsgPtr_t MsgPtr)
     return CCSDS_RD_LEN(MsgPtr->Hdr);
 }/* end CFE_SBN_Client_GetTotalMsgLength */
 
-int connect_to_server(const char *server_ip, uint16_t server_port)
+/* wait_for_connect waits up to SBN_CLIENT_CONNECT_TIMEOUT_MS for a non 
+ * blocking connect in progress to finish.  Returns 0 when connected, or -1 
+ * with errno set to why it was not. */
+static int wait_for_connect(int sockfd)
 {
-    int sockfd, address_converted, connection;
-        
-    sleep(5);
+    struct pollfd poll_fd = { sockfd, POLLOUT, 0 };
+    int           so_error = 0;
+    socklen_t     so_error_len = sizeof(so_error);
+    int           ready;
+    
+    do
+    {
+        ready = poll(&poll_fd, 1, SBN_CLIENT_CONNECT_TIMEOUT_MS);
+    } while (ready < 0 && errno == EINTR);
+    
+    if (ready == 0)
+    {
+        errno = ETIMEDOUT;
+        return -1;
+    }
+    
+    if (ready < 0 || 
+        getsockopt(sockfd, SOL_SOCKET, SO_ERROR, &so_error, &so_error_len) < 0)
+    {
+        return -1;
+    }
+    
+    if (so_error != 0)
+    {
+        errno = so_error;
+        return -1;
+    }
+    
+    return 0;
+}
 
-    /* Create an ipv4 TCP socket */
-    sockfd = socket(AF_INET, SOCK_STREAM, CFE_SBN_CLIENT_NO_PROTOCOL);
+/* close_failed_socket closes the socket of a failed connect, leaving errno 
+ * as the failure set it */
+static void close_failed_socket(int sockfd)
+{
+    int connect_errno = errno;
+    
+    close(sockfd);
+    errno = connect_errno;
+}
+
+/* set_keepalive has TCP probe an idle connection so a half open one is found
+ * dead, and bounds how long sent data may go unacknowledged.  A socket that
+ * refuses the options still works, it just takes longer to find dead. */
+static void set_keepalive(int sockfd)
+{
+    int on = 1;
+    int idle_s = SBN_CLIENT_KEEPALIVE_IDLE_S;
+    int intvl_s = SBN_CLIENT_KEEPALIVE_INTVL_S;
+    int cnt = SBN_CLIENT_KEEPALIVE_CNT;
+    unsigned int user_timeout_ms = (SBN_CLIENT_KEEPALIVE_IDLE_S + 
+      SBN_CLIENT_KEEPALIVE_INTVL_S * SBN_CLIENT_KEEPALIVE_CNT) * 1000;
+    
+    if (setsockopt(sockfd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on)) < 0 ||
+        setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPIDLE, &idle_s, 
+                   sizeof(idle_s)) < 0 ||
+        setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPINTVL, &intvl_s, 
+                   sizeof(intvl_s)) < 0 ||
+        setsockopt(sockfd, IPPROTO_TCP, TCP_KEEPCNT, &cnt, sizeof(cnt)) < 0 ||
+        setsockopt(sockfd, IPPROTO_TCP, TCP_USER_TIMEOUT, &user_timeout_ms, 
+                   sizeof(user_timeout_ms)) < 0)
+    {
+        log_message("connect_to_server could not set keepalive: %s\n",
+                    strerror(errno));
+    }
+    
+}
+
+/* enable_zerocopy turns on zero copy sends for large messages when 
+ * SBN_CLIENT_ZEROCOPY_MIN_SZ asks for them and the kernel has them */
+static void enable_zerocopy(int sockfd)
+{
+    int on = 1;
+    
+    zerocopy_enabled = FALSE;
+    zerocopy_next_id = 0;
+    zerocopy_done = 0;
+    
+    if (SBN_CLIENT_ZEROCOPY_MIN_SZ == 0)
+    {
+        return;
+    }
+    
+    if (setsockopt(sockfd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) < 0)
+    {
+        log_message("connect_to_server could not enable zero copy: %s\n",
+                    strerror(errno));
+        return;
+    }
+    
+    zerocopy_enabled = TRUE;
+}
+
+/* open_socket makes a non blocking stream socket, so connect can time out */
+static int open_socket(int domain)
+{
+    int sockfd = socket(domain, SOCK_STREAM | SOCK_NONBLOCK, 
+                        CFE_SBN_CLIENT_NO_PROTOCOL);
 
     /* Socket error */
     if (sockfd < 0)
@@ -257,28 +1208,23 @@ int connect_to_server(const char *server_ip, uint16_t server_port)
         return SERVER_SOCKET_ERROR;
     }
     
-    memset(&server_address, '0', sizeof(server_address));
-
-    server_address.sin_family = AF_INET;
-    server_address.sin_port = htons(server_port);
+    return sockfd;
+}
 
-    address_converted = inet_pton(AF_INET, server_ip, &server_address.sin_addr);
+/* finish_connect connects the socket from open_socket to address, waiting 
+ * at most SBN_CLIENT_CONNECT_TIMEOUT_MS, and makes it blocking.  The socket
+ * is closed if the connection fails. */
+static int finish_connect(int sockfd, struct sockaddr *address, 
+                          socklen_t address_len)
+{
+    int connection, flags;
     
-    /* inet_pton can have two separate errors, a value of 1 is success. */
-    if (address_converted == 0)
-    {
-        perror("connect_to_server inet_pton 0 error");
-        return SERVER_INET_PTON_SRC_ERROR;
-    }
-
-    if (address_converted == -1)
+    connection = connect(sockfd, address, address_len);
+    
+    if (connection < 0 && errno == EINPROGRESS)
     {
-        perror("connect_to_server inet_pton -1 error");
-        return SERVER_INET_PTON_INVALID_AF_ERROR;
+        connection = wait_for_connect(sockfd);
     }
-
-    connection = connect(sockfd, (struct sockaddr *)&server_address,
-                         sizeof(server_address));
     
     /* Connect error */
     if (connection < 0)
@@ -299,6 +1245,7 @@ int connect_to_server(const char *server_ip, uint16_t server_port)
             case EINTR:
             case EISCONN:
             case ENETUNREACH:
+            case ENOENT:
             case ENOTSOCK:
             case EPROTOTYPE:
             case ETIMEDOUT:
@@ -310,8 +1257,104 @@ int connect_to_server(const char *server_ip, uint16_t server_port)
         }
         
         log_message("SERVER_CONNECT_ERROR: Connect failed error: %d\n", connection);
+        close_failed_socket(sockfd);
         return SERVER_CONNECT_ERROR;
     }
+    
+    /* the receive and send paths expect a blocking socket */
+    flags = fcntl(sockfd, F_GETFL);
+    
+    if (flags < 0 || fcntl(sockfd, F_SETFL, flags & ~O_NONBLOCK) < 0)
+    {
+        log_message("connect_to_server could not make socket blocking: %s\n",
+                    strerror(errno));
+    }
+    
+    return sockfd;
+}
+
+/* connect_to_server makes one TCP connection attempt, waiting at most
+ * SBN_CLIENT_CONNECT_TIMEOUT_MS for SBN to accept it. */
+int connect_to_server(const char *server_ip, uint16_t server_port)
+{
+    int sockfd, address_converted;
+
+    /* Create an ipv4 TCP socket */
+    sockfd = open_socket(AF_INET);
+
+    if (sockfd < 0)
+    {
+        return sockfd;
+    }
+    
+    memset(&server_address, '0', sizeof(server_address));
+
+    server_address.sin_family = AF_INET;
+    server_address.sin_port = htons(server_port);
+
+    address_converted = inet_pton(AF_INET, server_ip, &server_address.sin_addr);
+    
+    /* inet_pton can have two separate errors, a value of 1 is success. */
+    if (address_converted == 0)
+    {
+        perror("connect_to_server inet_pton 0 error");
+        close_failed_socket(sockfd);
+        return SERVER_INET_PTON_SRC_ERROR;
+    }
+
+    if (address_converted == -1)
+    {
+        perror("connect_to_server inet_pton -1 error");
+        close_failed_socket(sockfd);
+        return SERVER_INET_PTON_INVALID_AF_ERROR;
+    }
 
+    sockfd = finish_connect(sockfd, (struct sockaddr *)&server_address,
+                            sizeof(server_address));
+    
+    if (sockfd < 0)
+    {
+        return sockfd;
+    }
+    
+    set_keepalive(sockfd);
+    enable_zerocopy(sockfd);
+
+    return sockfd;
+}
+
+/* connect_to_unix_server makes one connection attempt to SBN listening on 
+ * the Unix domain stream socket at server_path.  A missing socket file is a
+ * failed attempt like a refused TCP connection, SBN may not be up yet. */
+int connect_to_unix_server(const char *server_path)
+{
+    struct sockaddr_un unix_address;
+    int sockfd;
+    
+    if (strlen(server_path) >= sizeof(unix_address.sun_path))
+    {
+        log_message("connect_to_unix_server path is too long: %s\n", 
+                    server_path);
+        return SERVER_PATH_ERROR;
+    }
+    
+    sockfd = open_socket(AF_UNIX);
+
+    if (sockfd < 0)
+    {
+        return sockfd;
+    }
+    
+    memset(&unix_address, 0, sizeof(unix_address));
+    unix_address.sun_family = AF_UNIX;
+    strcpy(unix_address.sun_path, server_path);
+    
+    sockfd = finish_connect(sockfd, (struct sockaddr *)&unix_address, 
+                            sizeof(unix_address));
+    
+    /* the kernel has no zero copy sends for Unix sockets */
+    zerocopy_enabled = FALSE;
+    zerocopy_next_id = 0;
+    
     return sockfd;
 }
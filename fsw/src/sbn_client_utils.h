@@ -14,7 +14,9 @@
 #define _sbn_client_utils_h_
 
 #include <stdint.h>
+#include <pthread.h>
 #include <stdarg.h>
+#include <sys/uio.h>
 
 #include "sbn_pack.h"
 #include "sbn_client.h"
@@ -26,19 +28,19 @@
 *************************************************************************/
 
 /******************************************************************************
-**  Typedef:  CFE_SB_BufferD_t
+**  Typedef:  CFE_SBN_Client_BufferD_t
 **
 **  Purpose:
 **     This structure defines a BUFFER DESCRIPTOR used to specify the MsgId
-**     and address of each packet buffer.
-**
-**     Note: Changing the size of this structure may require the memory pool
-**     block sizes to change.
+**     and address of each packet buffer.  Buffers come from the shared pool
+**     in sbn_client_buffers.c; UseCount is the number of pipes (plus the
+**     receive thread while it fills the buffer) referencing it.
 */
 typedef struct {
      CFE_SB_MsgId_t     MsgId;
      uint16             UseCount;
      uint32             Size;
+     uint32             Capacity;
      void*              Buffer;
      CFE_SB_SenderId_t  Sender;
 } CFE_SBN_Client_BufferD_t;
@@ -55,11 +57,55 @@ typedef struct {
     uint32            SysQueueId;
     uint32            LastSender;
     uint16            QueueDepth;
-    uint16            SendErrors;
-    uint32            NumberOfMessages;
-    uint32            ReadMessage;
-    unsigned char     Messages[CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH][CFE_SBN_CLIENT_MAX_MESSAGE_SIZE];
+    /* what the receive thread does with a message for a full pipe, one of
+     * the SBN_CLIENT_OVERFLOW_ policies.  SendErrors and DroppedBytes count
+     * the messages dropped because the pipe was full. */
+    uint8             OverflowPolicy;
+    uint32            SendErrors;
+    uint32            DroppedBytes;
+    /* Messages is a single consumer (the pipe's reader) ring holding up to 
+     * QueueDepth messages, allocated by CreatePipe and freed by DeletePipe. 
+     * It has RingMask + 1 slots, a power of two so the slot stays right when
+     * ReadIdx and WriteIdx, which count up forever, wrap.  The receive 
+     * thread and apps sending to their own subscriptions all produce, one 
+     * at a time: a producer owns WriteIdx while it holds Writing. */
+    uint32            ReadIdx;
+    uint32            WriteIdx;
+    uint32            Writing;
+    uint32            RingMask;
+    CFE_SBN_Client_BufferD_t **Messages;
+    /* message last returned by RcvMsg, held until the next RcvMsg */
+    CFE_SBN_Client_BufferD_t *CurrentBuff;
+    /* producers currently adding to the ring, DeletePipe waits on 
+     * NoProducers for 0.  Generation counts the pipes that have used this 
+     * slot, so a producer holding a route looked up before the pipe was 
+     * deleted cannot add to a pipe created in the slot since. */
+    uint32            Producers;
+    uint32            Generation;
     CFE_SB_MsgId_t    SubscribedMsgIds[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    /* per subscription, in step with SubscribedMsgIds: at most MsgLim of 
+     * its messages may wait in the pipe, MsgCount are waiting and 
+     * MsgLimDrops counts those dropped because MsgLim were already waiting.
+     * A MsgLim of 0 leaves only QueueDepth as the limit.
+     * MsgCount goes up when a producer adds a message and down when it 
+     * leaves the ring, so it is atomic. */
+    uint16            MsgLim[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    uint16            MsgCount[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    uint32            MsgLimDrops[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    /* set for a SubscribeLocal subscription, which SBN is never told of */
+    boolean           SubscribedLocal[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    /* the QoS SBN was told of, sent again when subscriptions are replayed */
+    CFE_SB_Qos_t      SubscribedQoS[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    /* Lock and MsgAvail are only used when the reader has to sleep on an 
+     * empty ring, ReaderWaiting tells the producer to signal MsgAvail.  
+     * SpaceAvail and WriterWaiting are the same for a producer blocked on a 
+     * full SBN_CLIENT_OVERFLOW_BLOCK pipe. */
+    uint32            ReaderWaiting;
+    uint32            WriterWaiting;
+    pthread_mutex_t   Lock;
+    pthread_cond_t    MsgAvail;
+    pthread_cond_t    SpaceAvail;
+    pthread_cond_t    NoProducers;
 } CFE_SBN_Client_PipeD_t;
 
 /* SBN header TODO: Header is hardcoded here; what is a better way to bring this in from SB? */
@@ -70,25 +116,63 @@ typedef struct
     uint32 SBN_ProcessorID;
 } SBN_Hdr_t;
 
-/* TODO: Doxygen comments */
+/* Bytes received from SBN that have not been parsed yet, Head is the first 
+ * unparsed byte and Tail is one past the last received byte.  FrameStarted
+ * is set once a byte of the frame being parsed has been taken, after which
+ * the frame has until FrameDeadlineMs (monotonic) to arrive. */
+typedef struct {
+    int               SockFd;
+    size_t            Head;
+    size_t            Tail;
+    uint8             FrameStarted;
+    uint64            FrameDeadlineMs;
+    unsigned char     Data[SBN_CLIENT_RECV_BUF_SZ];
+} SBN_Client_RecvBuf_t;
+
+/* Routing index entry, the pipe table indexes of every pipe subscribed to 
+ * MsgId, which comes first as CFE_SBN_Client_MsgIdSet_t entries need.  
+ * SbnRefs counts the pipes whose subscription SBN was told of, local ones 
+ * are routed but not counted.  SBN is subscribed to MsgId while SbnRefs is 
+ * not 0. */
 typedef struct {
-  int  msgId;
-  int  pipeIds[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+  CFE_SB_MsgId_t  MsgId;
+  uint16          NumPipes;
+  uint16          SbnRefs;
+  uint8           PipeIdx[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
 } MsgId_to_pipes_t;
 
 
 
 int32 check_pthread_create_status(int, int32);
-int message_entry_point(CFE_SBN_Client_PipeD_t);
+uint64 CFE_SBN_Client_MonotonicMs(void);
+int32 CFE_SBN_Client_AllocPipeRing(CFE_SBN_Client_PipeD_t *, uint16);
+uint32 CFE_SBN_Client_PipeMsgCount(CFE_SBN_Client_PipeD_t *);
+int32 CFE_SBN_Client_PipeEnqueue(CFE_SBN_Client_PipeD_t *, 
+                                 CFE_SBN_Client_BufferD_t *, uint32);
+int32 CFE_SBN_Client_PipeEnqueueNoWait(CFE_SBN_Client_PipeD_t *, 
+                                       CFE_SBN_Client_BufferD_t *, uint32);
+CFE_SBN_Client_BufferD_t *CFE_SBN_Client_PipeDequeue(CFE_SBN_Client_PipeD_t *);
+void CFE_SBN_Client_PipeWakeWriter(CFE_SBN_Client_PipeD_t *);
+void CFE_SBN_Client_PipeWaitForProducers(CFE_SBN_Client_PipeD_t *);
 int CFE_SBN_CLIENT_ReadBytes(int, unsigned char *, size_t);
+int CFE_SBN_CLIENT_DiscardBytes(int, size_t);
+void CFE_SBN_CLIENT_ResetRecvBuffer(int);
+void CFE_SBN_CLIENT_StartFrame(void);
+size_t CFE_SBN_CLIENT_RecvBufferedBytes(void);
 void invalidate_pipe(CFE_SBN_Client_PipeD_t *);
 size_t write_message(int, char *, size_t);
+size_t write_message_vec(int, struct iovec *, int);
+size_t write_message_zerocopy(int, struct iovec *, int);
 uint8 CFE_SBN_Client_GetPipeIdx(CFE_SB_PipeId_t);
 uint8 CFE_SBN_Client_GetMessageSubscribeIndex(CFE_SB_PipeId_t);
+uint8 CFE_SBN_Client_GetSubscriptionIdx(CFE_SBN_Client_PipeD_t *, 
+                                        CFE_SB_MsgId_t);
 CFE_SB_MsgId_t CFE_SBN_Client_GetMsgId(CFE_SB_MsgPtr_t);
 int send_heartbeat(int);
+void CFE_SBN_Client_PackAppHeader(char *, uint16);
 uint16 CFE_SBN_Client_GetTotalMsgLength(CFE_SB_MsgPtr_t);
 int connect_to_server(const char *, uint16_t);
+int connect_to_unix_server(const char *);
 
 #endif /* _sbn_client_utils_h_ */
 
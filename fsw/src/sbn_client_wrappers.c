@@ -14,18 +14,54 @@
 #include <math.h>
 #include <time.h>
 #include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
 
 #include "sbn_client.h"
+#include "sbn_client_buffers.h"
+#include "sbn_client_ingest.h"
+#include "sbn_client_interest.h"
 #include "sbn_client_utils.h"
+#include "sbn_client_routing.h"
+#include "sbn_client_send_queue.h"
+#include "sbn_client_transport.h"
 #include "sbn_client_wrappers.h"
 
 extern CFE_SBN_Client_PipeD_t PipeTbl[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
 extern int sbn_client_sockfd;
 extern int sbn_client_cpuId;
-extern pthread_mutex_t receive_mutex;
-extern pthread_cond_t  received_condition;
+
+/* buffers apps hold from CFE_SB_ZeroCopyGetPtr, at most 
+ * SBN_CLIENT_MAX_ZERO_COPY_BUFFERS */
+static uint32 zero_copy_buffers_held = 0;
+
+/* messages not sent because nobody on SBN's side subscribes to them */
+static uint32 no_subscribers_count = 0;
+
+/* messages sent that the client's own subscribed pipes did not get, for 
+ * want of a buffer to copy them into */
+static uint32 local_delivery_errors = 0;
+
+/* Subscribe, Unsubscribe and DeletePipe change subscriptions and tell SBN 
+ * under subscription_lock (write locked), so the subscription and 
+ * unsubscription frames for a MsgId go out in the order the counts 
+ * changed.  ResendSubscriptions replays them under it too. */
+static pthread_rwlock_t subscription_lock = PTHREAD_RWLOCK_INITIALIZER;
+
+/* CreatePipe and DeletePipe take and free pipe table slots under 
+ * pipe_tbl_lock (write locked), so a slot being torn down is never handed
+ * to a new pipe and two deletes of one pipe never both tear it down.  Taken
+ * before subscription_lock. */
+static pthread_rwlock_t pipe_tbl_lock = PTHREAD_RWLOCK_INITIALIZER;
 
 int32 __wrap_CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+    return SBN_Client_CreatePipeEx(PipeIdPtr, Depth, PipeName, 
+                                   SBN_CLIENT_OVERFLOW_DROP_NEWEST);
+} /* end __wrap_CFE_SB_CreatePipe */
+
+int32 SBN_Client_CreatePipeEx(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, 
+                              const char *PipeName, uint8 OverflowPolicy)
 {
     uint8 i;
     int32 status = CFE_SBN_CLIENT_MAX_PIPES_MET;
@@ -46,79 +82,180 @@ int32 __wrap_CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const c
     }/* end if */
     
     /* verify input parameters are valid */
-    if((PipeIdPtr == NULL)||(Depth > CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)||(Depth == 0))
+    if((PipeIdPtr == NULL)||(Depth > CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)||(Depth == 0)||
+       (OverflowPolicy > SBN_CLIENT_OVERFLOW_BLOCK))
     {
         status = CFE_SBN_CLIENT_BAD_ARGUMENT;
     }
     else
     {
+        pthread_rwlock_wrlock(&pipe_tbl_lock);
         
         for(i = 0; i<CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
         {
           
-            if (PipeTbl[i].InUse != CFE_SBN_CLIENT_IN_USE)
+            if (PipeTbl[i].InUse == CFE_SBN_CLIENT_NOT_IN_USE)
             {
                 // TODO:Initialize pipe
-                PipeTbl[i].InUse = CFE_SBN_CLIENT_IN_USE;
+                status = CFE_SBN_Client_AllocPipeRing(&PipeTbl[i], Depth);
+                
+                if (status != SBN_CLIENT_SUCCESS)
+                {
+                    break;
+                }
+                
                 //PipeTbl[i].SysQueueId = ?
                 PipeTbl[i].PipeId = i;
-                //PipeTbl[i].QueueDepth = ?
                 //PipeTbl[i].AppId = ?
+                PipeTbl[i].OverflowPolicy = OverflowPolicy;
                 PipeTbl[i].SendErrors = 0;
+                PipeTbl[i].DroppedBytes = 0;
                 //strcpy(&CFE_SB.PipeTbl[PipeTblIdx].AppName[0],&AppName[0]); TODO: is App name required? will cfs proxy handle it?
                 strncpy(&PipeTbl[i].PipeName[0], PipeName, OS_MAX_API_NAME); //TODO: Use different value for size?
-                //TODO: init Messages to empty?
+                /* the receive thread may deliver as soon as InUse is seen, 
+                 * so the ring has to be in place first */
+                __atomic_store_n(&PipeTbl[i].InUse, CFE_SBN_CLIENT_IN_USE, 
+                                 __ATOMIC_SEQ_CST);
 
                 *PipeIdPtr = i;
 
-                status = SBN_CLIENT_SUCCESS;
                 break;
             }/* end if */
             
         }/* end for */
         
+        pthread_rwlock_unlock(&pipe_tbl_lock);
     }/* end if */
         
     return status;
-} /* end __wrap_CFE_SB_CreatePipe */
+} /* end SBN_Client_CreatePipeEx */
+
+int32 SBN_Client_GetPipeDropCounts(CFE_SB_PipeId_t PipeId, 
+                                   uint32 *DroppedMsgs, uint32 *DroppedBytes)
+{
+    uint8 pipe_idx = CFE_SBN_Client_GetPipeIdx(PipeId);
+    
+    if (pipe_idx == CFE_SBN_CLIENT_INVALID_PIPE || DroppedMsgs == NULL || 
+        DroppedBytes == NULL)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+    
+    *DroppedMsgs = __atomic_load_n(&PipeTbl[pipe_idx].SendErrors, 
+                                   __ATOMIC_RELAXED);
+    *DroppedBytes = __atomic_load_n(&PipeTbl[pipe_idx].DroppedBytes, 
+                                    __ATOMIC_RELAXED);
+    
+    return SBN_CLIENT_SUCCESS;
+} /* end SBN_Client_GetPipeDropCounts */
+
+/* unsubscribe removes a pipe's subscription, returning TRUE if no pipe it 
+ * told SBN of is left, when the caller has to tell SBN.  The caller holds 
+ * subscription_lock. */
+static boolean unsubscribe(uint8 PipeIdx, uint8 MsgIdIdx)
+{
+    CFE_SB_MsgId_t MsgId = PipeTbl[PipeIdx].SubscribedMsgIds[MsgIdIdx];
+    boolean        last = FALSE;
+    
+    PipeTbl[PipeIdx].SubscribedMsgIds[MsgIdIdx] = 
+      CFE_SBN_CLIENT_INVALID_MSG_ID;
+    
+    /* the route holds the count, so release before removing it */
+    if (!PipeTbl[PipeIdx].SubscribedLocal[MsgIdIdx])
+    {
+        last = CFE_SBN_Client_ReleaseSbnSub(MsgId);
+    }
+    
+    CFE_SBN_Client_RemoveRoute(MsgId, PipeIdx);
+    
+    return last;
+} /* end unsubscribe */
 
 int32 __wrap_CFE_SB_DeletePipe(CFE_SB_PipeId_t PipeId)
 {
   
     uint8 i;
+    int32 status = -2;
 
+    pthread_rwlock_wrlock(&pipe_tbl_lock);
+    
     for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
     {
         if (PipeTbl[i].PipeId == PipeId)
         {
             if (PipeTbl[i].InUse == CFE_SBN_CLIENT_IN_USE)
             {
+                int            j;
+                CFE_SB_MsgId_t MsgId;
+                CFE_SB_MsgId_t unsubs[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+                CFE_SB_Qos_t   unsub_qos[CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+                uint16         num_unsubs = 0;
+                
+                pthread_rwlock_wrlock(&subscription_lock);
+                
+                for(j = 0; j < CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE; j++)
+                {
+                    MsgId = PipeTbl[i].SubscribedMsgIds[j];
+                    
+                    if (MsgId != CFE_SBN_CLIENT_INVALID_MSG_ID && 
+                        unsubscribe(i, j))
+                    {
+                        unsubs[num_unsubs] = MsgId;
+                        unsub_qos[num_unsubs].Priority = 0x00;
+                        unsub_qos[num_unsubs].Reliability = 0x00;
+                        num_unsubs++;
+                    }
+                }
+                
+                /* SBN hears of the whole pipe going in one frame */
+                SendSubsToSbn(SBN_UNSUB_MSG, unsubs, unsub_qos, num_unsubs);
+                
+                pthread_rwlock_unlock(&subscription_lock);
+                
+                /* stop producers adding messages before the ring is 
+                 * emptied, see CFE_SBN_Client_PipeEnqueue; the slot stays 
+                 * taken until invalidate_pipe is done with it */
+                __atomic_store_n(&PipeTbl[i].InUse, CFE_SBN_CLIENT_CLOSING,
+                                 __ATOMIC_SEQ_CST);
+                /* a producer blocked on the full pipe gives up once woken */
+                CFE_SBN_Client_PipeWakeWriter(&PipeTbl[i]);
+                CFE_SBN_Client_PipeWaitForProducers(&PipeTbl[i]);
+                
                 invalidate_pipe(&PipeTbl[i]);
-                return CFE_SUCCESS;
+                status = CFE_SUCCESS;
             }
             else
             {
                 //TODO:error
-                return -1;
+                status = -1;
             }
             
+            break;
         }
         
     }
     
-    //TODO: if we get here no pipes matched, error
+    pthread_rwlock_unlock(&pipe_tbl_lock);
     
-    return -2;
+    //TODO: if no pipes matched, error
+    
+    return status;
 } /* end __wrap_CFE_SB_DeletePipe */
 
-int32 __wrap_CFE_SB_Subscribe(CFE_SB_MsgId_t  MsgId, CFE_SB_PipeId_t PipeId)
+/* add_subscription routes MsgId to the pipe with its own MsgLim.  TellSbn
+ * is set when Announce is set and no other pipe has already told SBN of the
+ * MsgId, when the caller has to tell SBN.  The caller holds 
+ * subscription_lock. */
+static int32 add_subscription(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, 
+                              CFE_SB_Qos_t Quality, uint16 MsgLim, 
+                              boolean Announce, boolean *TellSbn)
 {
+    int32 status = CFE_SUCCESS;
     uint8 PipeIdx;
     uint8 MsgIdIdx;
-    CFE_SB_Qos_t QoS;
-  
-    /* take semaphore to prevent a task switch during this call NOTE:is this necessary for sbn_client?*/
   
+    *TellSbn = FALSE;
+    
     /* get task id for events NOTE: probably not necessary for sbn_client*/
   
     /* get the callers Application Id  NOTE: we already have this locally*/
@@ -138,93 +275,533 @@ int32 __wrap_CFE_SB_Subscribe(CFE_SB_MsgId_t  MsgId, CFE_SB_PipeId_t PipeId)
   
     /* Convert the API MsgId into the SB internal representation MsgKey NOTE: not sure what this does yet*/
   
-    /* check for duplicate subscription */  
-  
-    /* check for multiple subscriptions to same pipe? TODO: not sure how this is done */
-  
-    /* Get the index to the first available element in the routing table NOTE:how does routing table work? do I need it?*/
-  
+    /* a duplicate subscription keeps the first one, as CFE_SB does */
+    if (CFE_SBN_Client_GetSubscriptionIdx(&PipeTbl[PipeIdx], MsgId) != 
+        CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE)
+    {
+        log_message("SBN_CLIENT: pipe %d already subscribed to MsgId 0x%04X",
+                    PipeId, MsgId);
+        return CFE_SUCCESS;
+    }
+    
     MsgIdIdx = CFE_SBN_Client_GetMessageSubscribeIndex(PipeId);
-    //printf("MsgIdIdx = %d\n", MsgIdIdx);
+    
     if (MsgIdIdx == CFE_SBN_CLIENT_MAX_MSG_IDS_MET)
     {
         //TODO:Error here
-        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+        status = CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+    else
+    {
+        /* the limit is in place before the receive thread can see the 
+         * MsgId */
+        PipeTbl[PipeIdx].MsgLim[MsgIdIdx] = MsgLim;
+        __atomic_store_n(&PipeTbl[PipeIdx].MsgCount[MsgIdIdx], 0, 
+                         __ATOMIC_RELAXED);
+        __atomic_store_n(&PipeTbl[PipeIdx].MsgLimDrops[MsgIdIdx], 0, 
+                         __ATOMIC_RELAXED);
+        PipeTbl[PipeIdx].SubscribedLocal[MsgIdIdx] = !Announce;
+        PipeTbl[PipeIdx].SubscribedQoS[MsgIdIdx] = Quality;
+        
+        if (CFE_SBN_Client_AddRoute(MsgId, PipeIdx) != SBN_CLIENT_SUCCESS)
+        {
+            log_message("SBN_CLIENT: ERROR routing index full, MsgId 0x%04X", 
+                        MsgId);
+            status = CFE_SB_MAX_MSGS_MET;
+        }
+        else
+        {
+            PipeTbl[PipeIdx].SubscribedMsgIds[MsgIdIdx] = MsgId;
+            
+            *TellSbn = Announce && CFE_SBN_Client_RetainSbnSub(MsgId);
+        }
+        
+    }
+    
+    return status;
+} /* end add_subscription */
+
+/* subscribe makes one subscription, telling SBN of it if needed */
+static int32 subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId, 
+                       CFE_SB_Qos_t Quality, uint16 MsgLim, boolean Announce)
+{
+    int32   status;
+    boolean tell_sbn;
+    
+    pthread_rwlock_wrlock(&subscription_lock);
+    
+    status = add_subscription(MsgId, PipeId, Quality, MsgLim, Announce, 
+                              &tell_sbn);
+    
+    if (tell_sbn)
+    {
+        SendSubToSbn(SBN_SUB_MSG, MsgId, Quality);
     }
     
-    PipeTbl[PipeIdx].SubscribedMsgIds[MsgIdIdx] = MsgId;
+    pthread_rwlock_unlock(&subscription_lock);
+    
+    return status;
+} /* end subscribe */
+
+int32 __wrap_CFE_SB_Subscribe(CFE_SB_MsgId_t  MsgId, CFE_SB_PipeId_t PipeId)
+{
+    CFE_SB_Qos_t QoS;
     
     QoS.Priority = 0x00;
     QoS.Reliability = 0x00;
     
-    SendSubToSbn(SBN_SUB_MSG, MsgId, QoS);
-    
-    return CFE_SUCCESS;
+    return subscribe(MsgId, PipeId, QoS, SBN_CLIENT_DEFAULT_MSG_LIM, TRUE);
 } /* end __wrap_CFE_SB_Subscribe */
 
 int32 __wrap_CFE_SB_SubscribeEx(CFE_SB_MsgId_t  MsgId, CFE_SB_PipeId_t PipeId, 
                                 CFE_SB_Qos_t Quality, uint16 MsgLim)
 {
-    printf ("SBN_CLIENT: ERROR CFE_SB_SubscribeEx not yet implemented\n");
-    return -1;
-} /* end __wrap_CFE_SB_Subscribe */
+    return subscribe(MsgId, PipeId, Quality, MsgLim, TRUE);
+} /* end __wrap_CFE_SB_SubscribeEx */
 
 int32 __wrap_CFE_SB_SubscribeLocal(CFE_SB_MsgId_t  MsgId, 
                                    CFE_SB_PipeId_t PipeId, 
                                    uint16 MsgLim)
 {
-    printf ("SBN_CLIENT: ERROR CFE_SB_SubscribeLocal not yet implemented\n");
-    return -1;
+    CFE_SB_Qos_t QoS;
+    
+    QoS.Priority = 0x00;
+    QoS.Reliability = 0x00;
+    
+    /* local subscriptions are not announced to SBN */
+    return subscribe(MsgId, PipeId, QoS, MsgLim, FALSE);
 } /* end __wrap_CFE_SB_SubscribeLocal */
 
+int32 SBN_Client_SubscribeBatch(const SBN_Client_Subscription_t *Subs, 
+                                uint16 Count)
+{
+    int32          status = CFE_SUCCESS;
+    int32          sub_status;
+    boolean        tell_sbn;
+    CFE_SB_MsgId_t subs[SBN_MAX_SUBS_PER_PEER];
+    CFE_SB_Qos_t   sub_qos[SBN_MAX_SUBS_PER_PEER];
+    uint16         num_subs = 0;
+    uint16         i;
+    
+    if (Subs == NULL && Count > 0)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+    
+    pthread_rwlock_wrlock(&subscription_lock);
+    
+    for(i = 0; i < Count; i++)
+    {
+        sub_status = add_subscription(Subs[i].MsgId, Subs[i].PipeId, 
+                                      Subs[i].Quality, Subs[i].MsgLim, TRUE,
+                                      &tell_sbn);
+        
+        if (sub_status != CFE_SUCCESS && status == CFE_SUCCESS)
+        {
+            status = sub_status;
+        }
+        
+        if (tell_sbn)
+        {
+            subs[num_subs] = Subs[i].MsgId;
+            sub_qos[num_subs] = Subs[i].Quality;
+            num_subs++;
+        }
+        
+        if (num_subs == SBN_MAX_SUBS_PER_PEER)
+        {
+            SendSubsToSbn(SBN_SUB_MSG, subs, sub_qos, num_subs);
+            num_subs = 0;
+        }
+        
+    }
+    
+    SendSubsToSbn(SBN_SUB_MSG, subs, sub_qos, num_subs);
+    
+    pthread_rwlock_unlock(&subscription_lock);
+    
+    return status;
+} /* end SBN_Client_SubscribeBatch */
+
 int32 __wrap_CFE_SB_Unsubscribe(CFE_SB_MsgId_t  MsgId, CFE_SB_PipeId_t PipeId)
 {
-    printf ("SBN_CLIENT: ERROR CFE_SB_Unsubscribe not yet implemented\n");
-    return -1;
+    uint8        PipeIdx;
+    uint8        MsgIdIdx;
+    CFE_SB_Qos_t QoS;
+    
+    PipeIdx = CFE_SBN_Client_GetPipeIdx(PipeId);
+  
+    if (PipeIdx == CFE_SBN_CLIENT_INVALID_PIPE)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+    
+    pthread_rwlock_wrlock(&subscription_lock);
+    
+    MsgIdIdx = CFE_SBN_Client_GetSubscriptionIdx(&PipeTbl[PipeIdx], MsgId);
+    
+    if (MsgIdIdx != CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE && 
+        unsubscribe(PipeIdx, MsgIdIdx))
+    {
+        QoS.Priority = 0x00;
+        QoS.Reliability = 0x00;
+        
+        SendSubToSbn(SBN_UNSUB_MSG, MsgId, QoS);
+    }
+    
+    pthread_rwlock_unlock(&subscription_lock);
+    
+    return CFE_SUCCESS;
 } /* end __wrap_CFE_SB_Unsubscribe */
 
 int32 __wrap_CFE_SB_UnsubscribeLocal(CFE_SB_MsgId_t  MsgId, 
                                      CFE_SB_PipeId_t PipeId)
 {
-    printf ("SBN_CLIENT: ERROR CFE_SB_UnsubscribeLocal not yet implemented\n");
-    return -1;
+    /* a local subscription was never counted for SBN */
+    return __wrap_CFE_SB_Unsubscribe(MsgId, PipeId);
 } /* end __wrap_CFE_SB_UnsubscribeLocal */
 
-uint32 __wrap_CFE_SB_SendMsg(CFE_SB_Msg_t *msg)
+int32 SBN_Client_GetSubscriptionCounts(CFE_SB_MsgId_t MsgId, 
+                                       CFE_SB_PipeId_t PipeId, 
+                                       uint16 *MsgsWaiting, 
+                                       uint32 *MsgLimDrops)
+{
+    uint8 pipe_idx = CFE_SBN_Client_GetPipeIdx(PipeId);
+    uint8 sub_idx;
+    
+    if (pipe_idx == CFE_SBN_CLIENT_INVALID_PIPE || MsgsWaiting == NULL || 
+        MsgLimDrops == NULL)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+    
+    sub_idx = CFE_SBN_Client_GetSubscriptionIdx(&PipeTbl[pipe_idx], MsgId);
+    
+    if (sub_idx == CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+    
+    *MsgsWaiting = __atomic_load_n(&PipeTbl[pipe_idx].MsgCount[sub_idx], 
+                                   __ATOMIC_RELAXED);
+    *MsgLimDrops = __atomic_load_n(&PipeTbl[pipe_idx].MsgLimDrops[sub_idx], 
+                                   __ATOMIC_RELAXED);
+    
+    return SBN_CLIENT_SUCCESS;
+} /* end SBN_Client_GetSubscriptionCounts */
+
+/* CFE_SBN_Client_ResendSubscriptions sends every subscription in the pipe 
+ * table to SBN again, each MsgId once however many pipes are subscribed to 
+ * it, in as few frames as possible.  Local subscriptions are left out.  Used
+ * after reconnecting, when SBN has forgotten the client's subscriptions.  
+ * The table is read and the frames sent under subscription_lock, so an 
+ * unsubscription made meanwhile reaches SBN after the replay, not before. */
+void CFE_SBN_Client_ResendSubscriptions(void)
+{
+    CFE_SB_MsgId_t sent[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES * 
+                        CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    CFE_SB_Qos_t   sent_qos[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES * 
+                            CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE];
+    uint16         num_sent = 0;
+    uint16         k;
+    uint8          i, j;
+    CFE_SB_MsgId_t MsgId;
+    
+    pthread_rwlock_wrlock(&subscription_lock);
+    
+    for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
+    {
+        
+        if (PipeTbl[i].InUse != CFE_SBN_CLIENT_IN_USE)
+        {
+            continue;
+        }/* end if */
+        
+        for(j = 0; j < CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE; j++)
+        {
+            MsgId = PipeTbl[i].SubscribedMsgIds[j];
+            
+            if (PipeTbl[i].SubscribedLocal[j])
+            {
+                continue;
+            }/* end if */
+            
+            for(k = 0; k < num_sent && sent[k] != MsgId; k++);
+            
+            if (MsgId != CFE_SBN_CLIENT_INVALID_MSG_ID && k == num_sent)
+            {
+                sent[num_sent] = MsgId;
+                sent_qos[num_sent] = PipeTbl[i].SubscribedQoS[j];
+                num_sent++;
+            }/* end if */
+            
+        }/* end for */
+        
+    }/* end for */
+    
+    SendSubsToSbn(SBN_SUB_MSG, sent, sent_qos, num_sent);
+    
+    pthread_rwlock_unlock(&subscription_lock);
+} /* end CFE_SBN_Client_ResendSubscriptions */
+
+/* frame_message packs the SBN header for msg into sbn_header and points 
+ * iov[0] and iov[1] at the header and msg, returning the framed size */
+static size_t frame_message(CFE_SB_Msg_t *msg, char *sbn_header, 
+                            struct iovec *iov)
 {
-    char *buffer;
     uint16 msg_size = CFE_SBN_Client_GetTotalMsgLength(msg);
 
-    size_t write_result, total_size = msg_size + SBN_PACKED_HDR_SZ;
-    Pack_t Pack;
+    CFE_SBN_Client_PackAppHeader(sbn_header, msg_size);
+
+    /* the header and the app's message go out together, neither copied */
+    iov[0].iov_base = sbn_header;
+    iov[0].iov_len = SBN_PACKED_HDR_SZ;
+    iov[1].iov_base = msg;
+    iov[1].iov_len = msg_size;
+
+    return msg_size + SBN_PACKED_HDR_SZ;
+} /* end frame_message */
+
+/* send_frames sends total_size bytes of framed messages in one go */
+static uint32 send_frames(struct iovec *iov, int iov_count, size_t total_size)
+{
+    size_t write_result;
+
+    if (SBN_CLIENT_ZEROCOPY_MIN_SZ > 0 && 
+        total_size >= SBN_CLIENT_ZEROCOPY_MIN_SZ)
+    {
+        write_result = write_message_zerocopy(sbn_client_sockfd, iov, 
+                                              iov_count);
+    }
+    else
+    {
+        write_result = write_message_vec(sbn_client_sockfd, iov, iov_count);
+    }
+
+    if (write_result != total_size)
+    {
+        // TODO: This isn't an allocation error, but must return an error that CFE_SB_SendMsg would return, is there a better choice here?
+        return CFE_SB_BUF_ALOC_ERR;
+    }
+
+    return CFE_SUCCESS;
+} /* end send_frames */
+
+/* unwanted tells whether msg can go unsent, counting it if so */
+static boolean unwanted(CFE_SB_Msg_t *msg)
+{
 
-    if (total_size > CFE_SB_MAX_SB_MSG_SIZE)
+    if (CFE_SBN_Client_RemoteWants(CFE_SBN_Client_GetMsgId(msg)))
+    {
+        return FALSE;
+    }
+
+    __atomic_add_fetch(&no_subscribers_count, 1, __ATOMIC_RELAXED);
+
+    return TRUE;
+} /* end unwanted */
+
+/* deliver_locally copies msg into the client's own pipes subscribed to it.  
+ * That is best effort, counted when it fails: the message goes to SBN all 
+ * the same, and failing the send would have a caller that retries send SBN 
+ * a second copy. */
+static void deliver_locally(CFE_SB_Msg_t *msg)
+{
+
+    if (deliver_local_message(msg) != CFE_SUCCESS)
+    {
+        __atomic_add_fetch(&local_delivery_errors, 1, __ATOMIC_RELAXED);
+    }
+
+} /* end deliver_locally */
+
+uint32 __wrap_CFE_SB_SendMsg(CFE_SB_Msg_t *msg)
+{
+    char sbn_header[SBN_PACKED_HDR_SZ];
+    struct iovec iov[2];
+    size_t total_size;
+    int32 status;
+
+    if (CFE_SBN_Client_GetTotalMsgLength(msg) + SBN_PACKED_HDR_SZ > 
+        CFE_SB_MAX_SB_MSG_SIZE)
     {
         return CFE_SB_MSG_TOO_BIG;
     }
 
-    buffer = malloc(total_size);
+    /* the client's own pipes need no round trip through SBN */
+    deliver_locally(msg);
+
+    /* as with SB, a message nobody subscribes to is not an error */
+    if (unwanted(msg))
+    {
+        return CFE_SUCCESS;
+    }
+
+    if (CFE_SBN_Client_SendQueueRunning())
+    {
+        status = CFE_SBN_Client_SendQueuePut(msg);
+    }
+    else
+    {
+        total_size = frame_message(msg, sbn_header, iov);
+        status = send_frames(iov, 2, total_size);
+    }
+
+    return status;
+} /* end __wrap_CFE_SB_SendMsg */
 
-    Pack_Init(&Pack, buffer, total_size, 0);
+int32 SBN_Client_SendMsgBatch(CFE_SB_Msg_t *Msgs[], uint32 Count)
+{
+    char sbn_headers[SBN_CLIENT_MAX_SEND_BATCH][SBN_PACKED_HDR_SZ];
+    struct iovec iov[SBN_CLIENT_MAX_SEND_BATCH * 2];
+    CFE_SB_Msg_t *wanted[SBN_CLIENT_SEND_QUEUE_DEPTH];
+    boolean queued = CFE_SBN_Client_SendQueueRunning();
+    size_t total_size;
+    uint32 i, batched;
+    int32 status;
 
-    Pack_UInt16(&Pack, msg_size);
-    Pack_UInt8(&Pack, SBN_APP_MSG);
-    Pack_UInt32(&Pack, sbn_client_cpuId);
+    /* a queued batch goes in whole, so it must fit the queue */
+    if (Msgs == NULL || Count == 0 || 
+        (queued && Count > SBN_CLIENT_SEND_QUEUE_DEPTH))
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
 
-    memcpy(buffer + SBN_PACKED_HDR_SZ, msg, msg_size);
+    /* refuse the whole batch rather than send part of it */
+    for (i = 0; i < Count; i++)
+    {
 
-    write_result = write_message(sbn_client_sockfd, buffer, total_size);
+        if (Msgs[i] == NULL)
+        {
+            return CFE_SBN_CLIENT_BAD_ARGUMENT;
+        }
 
-    if (write_result != total_size)
+        if (CFE_SBN_Client_GetTotalMsgLength(Msgs[i]) + SBN_PACKED_HDR_SZ > 
+            CFE_SB_MAX_SB_MSG_SIZE)
+        {
+            return CFE_SB_MSG_TOO_BIG;
+        }
+
+    } /* end for */
+
+    /* the client's own pipes get the whole batch before SBN does */
+    for (i = 0; i < Count; i++)
     {
-        // TODO: This isn't an allocation error, but must return an error that CFE_SB_SendMsg would return, is there a better choice here?
-        return CFE_SB_BUF_ALOC_ERR;
+        deliver_locally(Msgs[i]);
+    } /* end for */
+
+    /* the writer batches queued messages itself */
+    if (queued)
+    {
+        batched = 0;
+
+        for (i = 0; i < Count; i++)
+        {
+
+            if (!unwanted(Msgs[i]))
+            {
+                wanted[batched++] = Msgs[i];
+            }
+
+        } /* end for */
+
+        return CFE_SBN_Client_SendQueuePutBatch(wanted, batched);
     }
 
-    free(buffer);
+    i = 0;
+
+    while (i < Count)
+    {
+        total_size = 0;
+
+        for (batched = 0; batched < SBN_CLIENT_MAX_SEND_BATCH && i < Count; 
+             i++)
+        {
+
+            if (unwanted(Msgs[i]))
+            {
+                continue;
+            }
+
+            total_size += frame_message(Msgs[i], sbn_headers[batched], 
+                                        &iov[batched * 2]);
+            batched++;
+        } /* end for */
+
+        if (batched == 0)
+        {
+            break;
+        }
+
+        status = send_frames(iov, batched * 2, total_size);
+
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+
+    } /* end while */
 
     return CFE_SUCCESS;
-} /* end __wrap_CFE_SB_SendMsg */
+} /* end SBN_Client_SendMsgBatch */
+
+int32 SBN_Client_GetNoSubscribersCount(uint32 *NoSubscribers)
+{
+
+    if (NoSubscribers == NULL)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+
+    *NoSubscribers = __atomic_load_n(&no_subscribers_count, __ATOMIC_RELAXED);
+
+    return CFE_SUCCESS;
+} /* end SBN_Client_GetNoSubscribersCount */
+
+int32 SBN_Client_GetLocalDeliveryErrors(uint32 *LocalDeliveryErrors)
+{
+
+    if (LocalDeliveryErrors == NULL)
+    {
+        return CFE_SBN_CLIENT_BAD_ARGUMENT;
+    }
+
+    *LocalDeliveryErrors = __atomic_load_n(&local_delivery_errors, 
+                                           __ATOMIC_RELAXED);
+
+    return CFE_SUCCESS;
+} /* end SBN_Client_GetLocalDeliveryErrors */
+
+/* set_cork holds back (On) or lets go of (not On) partial TCP segments */
+static int32 set_cork(int On)
+{
+    const CFE_SBN_Client_Transport_t *transport = CFE_SBN_Client_GetTransport();
+
+    /* a transport without segments to fill sends each write as it is */
+    if (transport->Cork == NULL)
+    {
+        return CFE_SUCCESS;
+    }
+
+    if ((*transport->Cork)(sbn_client_sockfd, On) < 0)
+    {
+        log_message("SBN_CLIENT: ERROR could not %s connection to SBN: %s\n",
+                    On ? "cork" : "uncork", strerror(errno));
+        return SERVER_SOCKET_ERROR;
+    }
+
+    return CFE_SUCCESS;
+} /* end set_cork */
+
+int32 SBN_Client_Cork(void)
+{
+    return set_cork(1);
+} /* end SBN_Client_Cork */
+
+int32 SBN_Client_Uncork(void)
+{
+    return set_cork(0);
+} /* end SBN_Client_Uncork */
 
 int32 __wrap_CFE_SB_RcvMsg(CFE_SB_MsgPtr_t *BufPtr, CFE_SB_PipeId_t PipeId, 
                            int32 TimeOut)
@@ -262,53 +839,65 @@ int32 __wrap_CFE_SB_RcvMsg(CFE_SB_MsgPtr_t *BufPtr, CFE_SB_PipeId_t PipeId,
         int lock_mutex_status = 0;
         int wait_mutex_status = 0;
         int unlock_mutex_status = 0;
+        struct timespec future_timeout;
         CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_idx];
+        CFE_SBN_Client_BufferD_t *buf;
     
-        lock_mutex_status = pthread_mutex_lock(&receive_mutex);
+        /* the ring is lock free, the lock is only needed to sleep on it */
+        buf = CFE_SBN_Client_PipeDequeue(pipe);
         
-        /* Number of messages must be 2 or more otherwise no new messages are
-         * in the pipe */
-        if (pipe->NumberOfMessages < 2 && lock_mutex_status == 0)
+        if (buf == NULL && TimeOut == CFE_SB_POLL)
         {
-            
-            if (TimeOut == CFE_SB_POLL)
-            {
-                status = CFE_SB_NO_MESSAGE;
-            }
-            else if (TimeOut == CFE_SB_PEND_FOREVER)
+            status = CFE_SB_NO_MESSAGE;
+        }
+        else if (buf == NULL)
+        {
+            /* set future time for timeout check to entry time + timeout 
+             * milliseconds */
+            future_timeout.tv_sec = enter_time.tv_sec;
+            future_timeout.tv_nsec = enter_time.tv_nsec + (TimeOut * pow(10, 6));
+      
+            /* when nsec greater than 1 second perform update to seconds and 
+             * nanoseconds */
+            if (future_timeout.tv_nsec >= pow(10, 9))
             {
-                wait_mutex_status = pthread_cond_wait(&received_condition, 
-                                                      &receive_mutex);
+              future_timeout.tv_sec += future_timeout.tv_nsec / pow(10, 9);
+              future_timeout.tv_nsec = future_timeout.tv_nsec % (long) pow(10, 9);
             }
-            else /* Timout set to value */
+            
+            lock_mutex_status = pthread_mutex_lock(&pipe->Lock);
+            
+            if (lock_mutex_status == 0)
             {
-                struct timespec future_timeout;
-          
-                /* set future time for timeout check to entry time + timeout 
-                 * milliseconds */
-                future_timeout.tv_sec = enter_time.tv_sec;
-                future_timeout.tv_nsec = enter_time.tv_nsec + (TimeOut * pow(10, 6));
-          
-                /* when nsec greater than 1 second perform update to seconds and 
-                 * nanoseconds */
-                if (future_timeout.tv_nsec >= pow(10, 9))
+                /* sequentially consistent so either the producer sees this or
+                 * the dequeue below sees its message */
+                __atomic_store_n(&pipe->ReaderWaiting, 1, __ATOMIC_SEQ_CST);
+                
+                /* wake ups can be spurious, so the pipe is checked again 
+                 * after each one */
+                while ((buf = CFE_SBN_Client_PipeDequeue(pipe)) == NULL && 
+                       wait_mutex_status == 0)
                 {
-                  future_timeout.tv_sec += future_timeout.tv_nsec / pow(10, 9);
-                  future_timeout.tv_nsec = future_timeout.tv_nsec % (long) pow(10, 9);
-                }
-          
-                wait_mutex_status = pthread_cond_timedwait(&received_condition, 
-                                                           &receive_mutex, 
-                                                           &future_timeout);
-                  
+                    
+                    if (TimeOut == CFE_SB_PEND_FOREVER)
+                    {
+                        wait_mutex_status = pthread_cond_wait(&pipe->MsgAvail, 
+                                                              &pipe->Lock);
+                    }
+                    else /* Timout set to value */
+                    {
+                        wait_mutex_status = pthread_cond_timedwait(
+                          &pipe->MsgAvail, &pipe->Lock, &future_timeout);
+                    } /* end if */
+                    
+                } /* end while */
+                
+                __atomic_store_n(&pipe->ReaderWaiting, 0, __ATOMIC_RELAXED);
+                
+                unlock_mutex_status = pthread_mutex_unlock(&pipe->Lock);
             } /* end if */
             
-        } /* end if */
-        
-        if (lock_mutex_status == 0)
-        {
-            
-            if (wait_mutex_status != 0)
+            if (buf == NULL)
             {
                 
                 switch (wait_mutex_status)
@@ -321,35 +910,28 @@ int32 __wrap_CFE_SB_RcvMsg(CFE_SB_MsgPtr_t *BufPtr, CFE_SB_PipeId_t PipeId,
                 }
                 
             }
-        
-            if (status == CFE_SUCCESS)
-            {
-                /* must progress to next message in pipe because currently 
-                 * pointed to message is the last message that was read */
-                uint32 next_msg = (pipe->ReadMessage + 1) % 
-                  CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-                pipe->ReadMessage = next_msg;
-        
-                *BufPtr = (CFE_SB_MsgPtr_t)(&(pipe->Messages[next_msg]));
-        
-                pipe->NumberOfMessages -= 1;
-                status = CFE_SUCCESS;
-            } /* end if */
             
-            unlock_mutex_status = pthread_mutex_unlock(&receive_mutex);
-
-            if (unlock_mutex_status != 0)
+            if (lock_mutex_status != 0 || unlock_mutex_status != 0)
             {
-              status = CFE_SB_PIPE_RD_ERR;
+                status = CFE_SB_PIPE_RD_ERR;
             } /* end if */
             
-        }
-        else
+        } /* end if */
+        
+        if (buf != NULL)
         {
-            status = CFE_SB_PIPE_RD_ERR;
+            /* like SB, the previously received message stays valid only
+             * until the next receive on the pipe */
+            CFE_SBN_Client_ReleaseBuffer(pipe->CurrentBuff);
+            pipe->CurrentBuff = buf;
+            CFE_SBN_Client_PipeWakeWriter(pipe);
         } /* end if */
     
-        if (status != CFE_SUCCESS)
+        if (status == CFE_SUCCESS)
+        {
+            *BufPtr = (CFE_SB_MsgPtr_t)buf->Buffer;
+        }
+        else
         {
             *BufPtr = NULL;
         } /* end if */
@@ -359,10 +941,128 @@ int32 __wrap_CFE_SB_RcvMsg(CFE_SB_MsgPtr_t *BufPtr, CFE_SB_PipeId_t PipeId,
     return status;
 } /* end __wrap_CFE_SB_RcvMsg */
 
+/* zero_copy_buffer gives the pool buffer behind a zero copy handle, or NULL
+ * when the handle is not one handed out for MsgPtr */
+static CFE_SBN_Client_BufferD_t *zero_copy_buffer(CFE_SB_Msg_t *MsgPtr,
+                                     CFE_SB_ZeroCopyHandle_t BufferHandle)
+{
+    CFE_SBN_Client_BufferD_t *buf = (CFE_SBN_Client_BufferD_t *)BufferHandle;
+
+    if (MsgPtr == NULL || !CFE_SBN_Client_IsTakenBuffer(buf) ||
+        (char *)MsgPtr != 
+          (char *)buf->Buffer + CFE_SBN_CLIENT_FRAME_MSG_OFFSET)
+    {
+        return NULL;
+    }
+
+    return buf;
+} /* end zero_copy_buffer */
+
+CFE_SB_Msg_t *__wrap_CFE_SB_ZeroCopyGetPtr(uint16 MsgSize,
+                                           CFE_SB_ZeroCopyHandle_t *BufferHandle)
+{
+    CFE_SBN_Client_BufferD_t *buf;
+
+    if (BufferHandle == NULL || 
+        MsgSize + SBN_PACKED_HDR_SZ > CFE_SB_MAX_SB_MSG_SIZE)
+    {
+        return NULL;
+    }
+
+    /* apps only get their share of the pool, the rest is for receiving */
+    if (__atomic_add_fetch(&zero_copy_buffers_held, 1, __ATOMIC_RELAXED) > 
+        SBN_CLIENT_MAX_ZERO_COPY_BUFFERS)
+    {
+        __atomic_sub_fetch(&zero_copy_buffers_held, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    buf = CFE_SBN_Client_GetBuffer(CFE_SBN_CLIENT_INVALID_MSG_ID, 
+                                   MsgSize + CFE_SBN_CLIENT_FRAME_MSG_OFFSET);
+
+    if (buf == NULL)
+    {
+        __atomic_sub_fetch(&zero_copy_buffers_held, 1, __ATOMIC_RELAXED);
+        return NULL;
+    }
+
+    *BufferHandle = (CFE_SB_ZeroCopyHandle_t)buf;
+
+    return (CFE_SB_Msg_t *)((char *)buf->Buffer + 
+                            CFE_SBN_CLIENT_FRAME_MSG_OFFSET);
+} /* end __wrap_CFE_SB_ZeroCopyGetPtr */
+
+int32 __wrap_CFE_SB_ZeroCopyReleasePtr(CFE_SB_Msg_t *Ptr2Release,
+                                       CFE_SB_ZeroCopyHandle_t BufferHandle)
+{
+    CFE_SBN_Client_BufferD_t *buf = zero_copy_buffer(Ptr2Release, 
+                                                     BufferHandle);
+
+    if (buf == NULL)
+    {
+        return CFE_SB_BUFFER_INVALID;
+    }
+
+    __atomic_sub_fetch(&zero_copy_buffers_held, 1, __ATOMIC_RELAXED);
+    CFE_SBN_Client_ReleaseBuffer(buf);
+
+    return CFE_SUCCESS;
+} /* end __wrap_CFE_SB_ZeroCopyReleasePtr */
+
 int32 __wrap_CFE_SB_ZeroCopySend(CFE_SB_Msg_t *MsgPtr, 
                                  CFE_SB_ZeroCopyHandle_t BufferHandle)
 {
-    printf ("SBN_CLIENT: ERROR CFE_SB_ZeroCopySend not yet implemented\n");
-    return -1;
+    CFE_SBN_Client_BufferD_t *buf = zero_copy_buffer(MsgPtr, BufferHandle);
+    struct iovec iov;
+    uint16 msg_size;
+    int32 status;
+
+    if (buf == NULL)
+    {
+        return CFE_SB_BUFFER_INVALID;
+    }
+
+    msg_size = CFE_SBN_Client_GetTotalMsgLength(MsgPtr);
+
+    /* the message may not have grown past the size asked for */
+    if (msg_size + CFE_SBN_CLIENT_FRAME_MSG_OFFSET > buf->Size)
+    {
+        return CFE_SB_MSG_TOO_BIG;
+    }
+
+    __atomic_sub_fetch(&zero_copy_buffers_held, 1, __ATOMIC_RELAXED);
+
+    /* the pipes read messages from the start of a buffer, so they get a 
+     * copy; the frame for SBN is still sent without one */
+    deliver_locally(MsgPtr);
+
+    if (unwanted(MsgPtr))
+    {
+        CFE_SBN_Client_ReleaseBuffer(buf);
+        return CFE_SUCCESS;
+    }
+
+    /* the header goes in the space left for it, so the frame is whole */
+    CFE_SBN_Client_PackAppHeader(
+      (char *)buf->Buffer + CFE_SBN_CLIENT_FRAME_OFFSET, msg_size);
+    buf->Size = msg_size + CFE_SBN_CLIENT_FRAME_MSG_OFFSET;
+
+    if (CFE_SBN_Client_SendQueueRunning())
+    {
+        status = CFE_SBN_Client_SendQueuePutFrame(buf);
+    }
+    else
+    {
+        iov.iov_base = (char *)buf->Buffer + CFE_SBN_CLIENT_FRAME_OFFSET;
+        iov.iov_len = msg_size + SBN_PACKED_HDR_SZ;
+
+        status = send_frames(&iov, 1, iov.iov_len);
+
+        /* sent, or for a zero copy send done with, so the buffer can go 
+         * back */
+        CFE_SBN_Client_ReleaseBuffer(buf);
+    }
+
+    return status;
 } /* end __wrap_CFE_SB_ZeroCopySend */
 
@@ -202,15 +202,135 @@ size_t Any_Message_Size(void)
     return random_val;
 }
 
+void Put_Message_In_Pipe(CFE_SBN_Client_PipeD_t *pipe, unsigned char *msg, 
+                         size_t msgSize)
+{
+    CFE_SBN_Client_BufferD_t *buf = 
+      CFE_SBN_Client_GetBuffer(CFE_SBN_CLIENT_INVALID_MSG_ID, msgSize);
+    
+    memcpy(buf->Buffer, msg, msgSize);
+    pipe->Messages[pipe->WriteIdx & pipe->RingMask] = buf;
+    pipe->WriteIdx++;
+}
+
+unsigned char *Pipe_Message_Data(CFE_SBN_Client_PipeD_t *pipe, uint32 slot)
+{
+    return (unsigned char *)pipe->Messages[slot]->Buffer;
+}
+
+/* Stand_In_Sbn_Listen plays SBN's side of a Unix domain socket connection,
+ * listening at path, and returns the listening socket or -1 */
+int Stand_In_Sbn_Listen(const char *path)
+{
+    struct sockaddr_un address;
+    int listen_fd = __real_socket(AF_UNIX, SOCK_STREAM, 0);
+    
+    if (listen_fd < 0)
+    {
+        return -1;
+    }
+    
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    unlink(path);
+    
+    if (bind(listen_fd, (struct sockaddr *)&address, sizeof(address)) < 0 ||
+        listen(listen_fd, 1) < 0)
+    {
+        close(listen_fd);
+        return -1;
+    }
+    
+    return listen_fd;
+}
+
+/* Stand_In_Sbn_Close stops listening and removes the socket file */
+void Stand_In_Sbn_Close(int listen_fd, const char *path)
+{
+    close(listen_fd);
+    unlink(path);
+}
+
+/* Stand_In_Shm_Peer_Create plays SBN's side of the shared memory transport,
+ * making a fresh region named name as SBN does for each connection, and 
+ * returns it or NULL.  Tests move bytes through its rings with 
+ * CFE_SBN_Client_ShmRingWrite and CFE_SBN_Client_ShmRingRead. */
+CFE_SBN_Client_ShmRegion_t *Stand_In_Shm_Peer_Create(const char *name)
+{
+    CFE_SBN_Client_ShmRegion_t *region;
+    int shm_fd;
+    
+    shm_unlink(name);
+    shm_fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    
+    if (shm_fd < 0)
+    {
+        return NULL;
+    }
+    
+    if (ftruncate(shm_fd, sizeof(*region)) < 0)
+    {
+        close(shm_fd);
+        shm_unlink(name);
+        return NULL;
+    }
+    
+    region = mmap(NULL, sizeof(*region), PROT_READ | PROT_WRITE, MAP_SHARED,
+                  shm_fd, 0);
+    close(shm_fd);
+    
+    if (region == MAP_FAILED)
+    {
+        shm_unlink(name);
+        return NULL;
+    }
+    
+    region->Version = CFE_SBN_CLIENT_SHM_VERSION;
+    region->RingSz = SBN_CLIENT_SHM_RING_SZ;
+    region->PeerPid = getpid();
+    __atomic_store_n(&region->Magic, CFE_SBN_CLIENT_SHM_MAGIC, 
+                     __ATOMIC_RELEASE);
+    
+    return region;
+}
+
+/* Stand_In_Shm_Peer_Destroy unmaps and removes the region */
+void Stand_In_Shm_Peer_Destroy(CFE_SBN_Client_ShmRegion_t *region, 
+                               const char *name)
+{
+    
+    if (region != NULL)
+    {
+        munmap(region, sizeof(*region));
+    }
+    
+    shm_unlink(name);
+}
+
 
 
 void SBN_Client_Setup(void)
 {
+    int i;
+
     /* SBN_Client resets */
     sbn_client_sockfd = 0;
     sbn_client_cpuId = 0;
 
     memset(PipeTbl, 0, sizeof(PipeTbl));
+    
+    /* tests use pipes without creating them, so every pipe gets a ring */
+    for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
+    {
+        CFE_SBN_Client_AllocPipeRing(&PipeTbl[i], 
+          CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH);
+    }
+    
+    CFE_SBN_CLIENT_ResetRecvBuffer(-1);
+    CFE_SBN_Client_InitRoutingTbl();
+    CFE_SBN_Client_ResetRemoteInterest();
+    CFE_SBN_Client_InitBufferPool();
 
     /* Global UT CFE resets -- 
     * NOTE: not sure if these are required for sbn_client */
@@ -221,6 +341,15 @@ void SBN_Client_Setup(void)
 
 void SBN_Client_Teardown(void)
 {
+    int i;
+    
+    for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
+    {
+        free(PipeTbl[i].Messages);
+        PipeTbl[i].Messages = NULL;
+    }
+    
+    CFE_SBN_Client_SetTransport(NULL);
     SBN_CLient_Wrapped_Functions_Teardown();
 } /* end SBN_Client_Teardown */
 
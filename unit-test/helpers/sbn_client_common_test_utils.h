@@ -42,6 +42,12 @@ uint32 Any_Pipe_Message_Location(void);
 unsigned char Any_unsigned_char(void);
 unsigned char * Any_Pipe_Message(size_t length);
 size_t Any_Message_Size(void);
+void Put_Message_In_Pipe(CFE_SBN_Client_PipeD_t *, unsigned char *, size_t);
+unsigned char *Pipe_Message_Data(CFE_SBN_Client_PipeD_t *, uint32);
+int Stand_In_Sbn_Listen(const char *);
+void Stand_In_Sbn_Close(int, const char *);
+CFE_SBN_Client_ShmRegion_t *Stand_In_Shm_Peer_Create(const char *);
+void Stand_In_Shm_Peer_Destroy(CFE_SBN_Client_ShmRegion_t *, const char *);
 
 
 
@@ -18,6 +18,10 @@
 
 boolean use_wrap_CFE_SBN_CLIENT_ReadBytes = FALSE;
 unsigned char *wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = NULL;
+size_t wrap_CFE_SBN_CLIENT_ReadBytes_msg_offset = 0;
+uint8 wrap_CFE_SBN_CLIENT_ReadBytes_call_number = 0;
+int wrap_CFE_SBN_CLIENT_ReadBytes_errors_on_call_number = INT_MIN;
+int wrap_CFE_SBN_CLIENT_ReadBytes_error_value = INT_MIN;
 int wrap_CFE_SBN_CLIENT_ReadBytes_return_value = INT_MIN;
 boolean wrap_pthread_mutex_lock_should_be_called = FALSE;
 boolean wrap_pthread_mutex_lock_was_called = FALSE;
@@ -31,6 +35,8 @@ boolean use_wrap_pthread_cond_wait = FALSE;
 int wrap_pthread_cond_wait_return_value = INT_MIN;
 boolean wrap_pthread_cond_signal_should_be_called = FALSE;
 boolean wrap_pthread_cond_signal_was_called = FALSE;
+pthread_cond_t *wrap_pthread_cond_signal_cond = NULL;
+void (*wrap_pthread_cond_wait_call_func)(void) = NULL;
 boolean use_wrap_CFE_SBN_Client_GetMsgId = FALSE;
 CFE_SB_MsgId_t wrap_CFE_SBN_Client_GetMsgId_return_value = 0xFFFF;
 boolean wrap_pthread_cond_timedwait_should_be_called = FALSE;
@@ -41,11 +47,14 @@ boolean use_wrap_CFE_SBN_Client_GetPipeIdx = FALSE;
 uint8 wrap_CFE_SBN_Client_GetPipeIdx_return_value = UCHAR_MAX;
 boolean use_wrap_connect_to_server = FALSE;
 int wrap_connect_to_server_return_value = INT_MIN;
+uint8 connect_to_server_call_number = 0;
+int wrap_connect_to_server_succeeds_on_call_number = 0;
 int wrap_exit_expected_status = INT_MIN;  
 boolean use_wrap_CFE_SBN_Client_InitPipeTbl = FALSE;
 int pthread_create_errors_on_call_number = INT_MIN;
 uint8 pthread_create_call_number = 0;
 int pthread_create_error_value = INT_MIN;
+uint8 pthread_join_call_number = 0;
 boolean use_wrap_check_pthread_create_status = FALSE;
 boolean wrap_check_pthread_create_status_fail_call = FALSE;
 uint8 check_pthread_create_status_call_number = 0;
@@ -59,11 +68,15 @@ int     wrap_recv_msg_return_value = SBN_CLIENT_SUCCESS;
 uint8   recv_msg_call_number = 0;
 uint8   recv_msg_discontiue_on_call_number = 0;
 const char *perror_expected_string = "";
+boolean use_real_socket = FALSE;
 int wrap_socket_return_value;
 uint16_t wrap_htons_return_value;
 int wrap_inet_pton_return_value;
+boolean use_real_connect = FALSE;
 int wrap_connect_return_value;
 size_t wrap_read_return_value;
+unsigned char *wrap_read_data = NULL;
+uint8 wrap_read_call_number = 0;
 
 
 /* function pointers */
@@ -81,13 +94,24 @@ int __wrap_CFE_SBN_CLIENT_ReadBytes(int sockfd, unsigned char *msg_buffer,
 {
     int result;
     
+    wrap_CFE_SBN_CLIENT_ReadBytes_call_number += 1;
+    
     if (use_wrap_CFE_SBN_CLIENT_ReadBytes)
     {
         if (wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer != NULL)
         {
-            memcpy(msg_buffer, wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer, MsgSz);
+            /* successive reads consume the buffer like a socket would */
+            memcpy(msg_buffer, wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer + 
+              wrap_CFE_SBN_CLIENT_ReadBytes_msg_offset, MsgSz);
+            wrap_CFE_SBN_CLIENT_ReadBytes_msg_offset += MsgSz;
         }
         result = wrap_CFE_SBN_CLIENT_ReadBytes_return_value;
+        
+        if (wrap_CFE_SBN_CLIENT_ReadBytes_call_number == 
+            wrap_CFE_SBN_CLIENT_ReadBytes_errors_on_call_number)
+        {
+            result = wrap_CFE_SBN_CLIENT_ReadBytes_error_value;
+        }
     }
     else
     {
@@ -132,6 +156,7 @@ int __wrap_pthread_mutex_unlock(pthread_mutex_t *mutex)
 int __wrap_pthread_cond_signal(pthread_cond_t *cond)
 {
     wrap_pthread_cond_signal_was_called = TRUE;
+    wrap_pthread_cond_signal_cond = cond;
     
     if (!wrap_pthread_cond_signal_should_be_called)
     {
@@ -148,6 +173,12 @@ int __wrap_pthread_cond_wait(pthread_cond_t * cond, pthread_mutex_t * mutex)
     
     wrap_pthread_cond_wait_was_called = TRUE;
     
+    /* stands in for the message a real wake up would follow */
+    if (wrap_pthread_cond_wait_call_func != NULL)
+    {
+        (*wrap_pthread_cond_wait_call_func)();
+    }
+    
     if (!wrap_pthread_cond_wait_should_be_called)
     {
         UtAssert_Failed(
@@ -173,6 +204,11 @@ int __wrap_pthread_cond_timedwait(pthread_cond_t * cond,
     
     wrap_pthread_cond_timedwait_was_called = TRUE;
     
+    if (wrap_pthread_cond_wait_call_func != NULL)
+    {
+        (*wrap_pthread_cond_wait_call_func)();
+    }
+    
     if (!wrap_pthread_cond_timedwait_should_be_called)
     {
         UtAssert_Failed(
@@ -222,10 +258,21 @@ uint8 __wrap_CFE_SBN_Client_GetPipeIdx(CFE_SB_PipeId_t PipeId)
 int __wrap_connect_to_server(const char *server_ip, uint16_t server_port)
 {
     int result = INT_MIN;
+    
+    connect_to_server_call_number += 1;
 
     if (use_wrap_connect_to_server)
     {
-        result = wrap_connect_to_server_return_value;
+        /* earlier calls are refused, as if SBN was not up yet */
+        if (connect_to_server_call_number < 
+            wrap_connect_to_server_succeeds_on_call_number)
+        {
+            result = SERVER_CONNECT_ERROR;
+        }
+        else
+        {
+            result = wrap_connect_to_server_return_value;
+        }
     }
     else
     {
@@ -272,6 +319,15 @@ int __wrap_pthread_create(pthread_t *thread, const pthread_attr_t *attr,
     return result;
 }
 
+/* no thread is ever created by the pthread_create wrapper, so there is never
+ * one to join */
+int __wrap_pthread_join(pthread_t thread, void **retval)
+{
+    pthread_join_call_number += 1;
+    
+    return 0;
+}
+
 int32 __wrap_check_pthread_create_status(int status, int32 errorId)
 {
     int32 result = INT_MIN;
@@ -367,6 +423,11 @@ void __wrap_perror(const char *str)
 
 int __wrap_socket(int domain, int type, int protocol)
 {
+  if (use_real_socket)
+  {
+    return __real_socket(domain, type, protocol);
+  }
+  
   return wrap_socket_return_value;
 }
 
@@ -382,13 +443,25 @@ int __wrap_inet_pton(int af, const char *src, void *dst)
 
 int __wrap_connect(int sbn_client_sockfd, const struct sockaddr *addr, socklen_t addrlen)
 {
+  if (use_real_connect)
+  {
+    return __real_connect(sbn_client_sockfd, addr, addrlen);
+  }
+  
   return wrap_connect_return_value;
 }
 
 size_t __wrap_read(int fd, void* buf, size_t cnt)
 {
+    wrap_read_call_number += 1;
+    
     if (wrap_read_return_value != INT_MIN)
     {
+        if (wrap_read_data != NULL && wrap_read_return_value <= cnt)
+        {
+            memcpy(buf, wrap_read_data, wrap_read_return_value);
+        }
+        
         return wrap_read_return_value;
     }
     else
@@ -421,6 +494,10 @@ void SBN_CLient_Wrapped_Functions_Teardown(void)
     /* SBN_CLient_Wrapped_Functions_Teardown resets all variables */
     use_wrap_CFE_SBN_CLIENT_ReadBytes = FALSE;
     wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = NULL;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_offset = 0;
+    wrap_CFE_SBN_CLIENT_ReadBytes_call_number = 0;
+    wrap_CFE_SBN_CLIENT_ReadBytes_errors_on_call_number = INT_MIN;
+    wrap_CFE_SBN_CLIENT_ReadBytes_error_value = INT_MIN;
     wrap_CFE_SBN_CLIENT_ReadBytes_return_value = INT_MIN;
     wrap_pthread_mutex_lock_should_be_called = FALSE;
     wrap_pthread_mutex_lock_was_called = FALSE;
@@ -434,6 +511,8 @@ void SBN_CLient_Wrapped_Functions_Teardown(void)
     wrap_pthread_cond_wait_return_value = INT_MIN;
     wrap_pthread_cond_signal_should_be_called = FALSE;
     wrap_pthread_cond_signal_was_called = FALSE;
+    wrap_pthread_cond_signal_cond = NULL;
+    wrap_pthread_cond_wait_call_func = NULL;
     use_wrap_CFE_SBN_Client_GetMsgId = FALSE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = 0xFFFF;
     wrap_pthread_cond_timedwait_should_be_called = FALSE;
@@ -444,11 +523,14 @@ void SBN_CLient_Wrapped_Functions_Teardown(void)
     wrap_CFE_SBN_Client_GetPipeIdx_return_value = UCHAR_MAX;
     use_wrap_connect_to_server = FALSE;
     wrap_connect_to_server_return_value = INT_MIN;
+    connect_to_server_call_number = 0;
+    wrap_connect_to_server_succeeds_on_call_number = 0;
     wrap_exit_expected_status = INT_MIN;
     use_wrap_CFE_SBN_Client_InitPipeTbl = FALSE;
     pthread_create_errors_on_call_number = INT_MIN;
     pthread_create_call_number = 0;
     pthread_create_error_value = INT_MIN;
+    pthread_join_call_number = 0;
     use_wrap_check_pthread_create_status = FALSE;
     wrap_check_pthread_create_status_fail_call = FALSE;
     check_pthread_create_status_call_number = 0;
@@ -462,6 +544,10 @@ void SBN_CLient_Wrapped_Functions_Teardown(void)
     recv_msg_call_number = 0;
     recv_msg_discontiue_on_call_number = 0;
     perror_expected_string = "";
+    wrap_read_data = NULL;
+    wrap_read_call_number = 0;
+    use_real_socket = FALSE;
+    use_real_connect = FALSE;
         
     
     /* function pointers */
@@ -30,6 +30,8 @@ int   __real_send_heartbeat(int);
 int32 __real_recv_msg(int32);
 void   __real_perror(const char *s);
 size_t __real_read(int fd, void* buf, size_t cnt);
+int __real_socket(int, int, int);
+int __real_connect(int, const struct sockaddr *, socklen_t);
 
 int __wrap_CFE_SBN_CLIENT_ReadBytes(int, unsigned char *, size_t);
 int __wrap_pthread_mutex_lock(pthread_mutex_t *);
@@ -44,6 +46,7 @@ int __wrap_connect_to_server(const char *, uint16_t);
 void __wrap_exit(int);
 int __wrap_pthread_create(pthread_t *, const pthread_attr_t *,
   void *(*) (void *), void *);
+int __wrap_pthread_join(pthread_t, void **);
 int   __wrap_send_heartbeat(int);
 int32 __wrap_recv_msg(int32);
 void __wrap_perror(const char *s);
@@ -61,6 +64,10 @@ void wrap_log_message_set_continue_recv_check_false(void);
 
 extern boolean use_wrap_CFE_SBN_CLIENT_ReadBytes;
 extern unsigned char *wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer;
+extern size_t wrap_CFE_SBN_CLIENT_ReadBytes_msg_offset;
+extern uint8 wrap_CFE_SBN_CLIENT_ReadBytes_call_number;
+extern int wrap_CFE_SBN_CLIENT_ReadBytes_errors_on_call_number;
+extern int wrap_CFE_SBN_CLIENT_ReadBytes_error_value;
 extern int wrap_CFE_SBN_CLIENT_ReadBytes_return_value;
 extern boolean wrap_pthread_mutex_lock_should_be_called;
 extern boolean wrap_pthread_mutex_lock_was_called;
@@ -70,6 +77,7 @@ extern boolean wrap_pthread_mutex_unlock_was_called;
 extern int wrap_pthread_mutex_unlock_return_value;
 extern boolean wrap_pthread_cond_signal_should_be_called;
 extern boolean wrap_pthread_cond_signal_was_called;
+extern pthread_cond_t *wrap_pthread_cond_signal_cond;
 extern boolean wrap_pthread_cond_wait_should_be_called;
 extern boolean wrap_pthread_cond_wait_was_called;
 extern boolean use_wrap_pthread_cond_wait;
@@ -84,11 +92,14 @@ extern boolean use_wrap_CFE_SBN_Client_GetPipeIdx;
 extern uint8 wrap_CFE_SBN_Client_GetPipeIdx_return_value;
 extern boolean use_wrap_connect_to_server;
 extern int wrap_connect_to_server_return_value;
+extern uint8 connect_to_server_call_number;
+extern int wrap_connect_to_server_succeeds_on_call_number;
 extern int wrap_exit_expected_status;  
 extern boolean use_wrap_CFE_SBN_Client_InitPipeTbl;
 extern int pthread_create_errors_on_call_number;
 extern uint8 pthread_create_call_number;
 extern int pthread_create_error_value;
+extern uint8 pthread_join_call_number;
 extern boolean use_wrap_check_pthread_create_status;
 extern boolean wrap_check_pthread_create_status_fail_call;
 extern uint8 check_pthread_create_status_call_number;
@@ -104,16 +115,21 @@ extern uint8   recv_msg_discontiue_on_call_number;
 extern const char *log_message_expected_string;
 extern boolean log_message_was_called;
 extern const char *perror_expected_string;
+extern boolean use_real_socket;
 extern int wrap_socket_return_value;
 extern uint16_t wrap_htons_return_value;
 extern int wrap_inet_pton_return_value;
+extern boolean use_real_connect;
 extern int wrap_connect_return_value;
 extern size_t wrap_read_return_value;
+extern unsigned char *wrap_read_data;
+extern uint8 wrap_read_call_number;
 
 /* function pointers */
 
 extern void (*wrap_log_message_call_func)(void);
 extern void (*wrap_sleep_call_func)(void);
+extern void (*wrap_pthread_cond_wait_call_func)(void);
 
 void SBN_CLient_Wrapped_Functions_Setup(void);
 void SBN_CLient_Wrapped_Functions_Teardown(void);
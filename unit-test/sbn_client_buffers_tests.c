@@ -0,0 +1,242 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/*******************************************************************************
+**
+**  SBN_Client_Buffers_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Buffers_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+} /* end SBN_Client_Buffers_Tests_Setup */
+
+void SBN_Client_Buffers_Tests_Teardown(void)
+{
+    SBN_Client_Teardown();
+} /* end SBN_Client_Buffers_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_GetBuffer Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_GetBuffer_ReturnsBufferReferencedOnce(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    uint32 size = Any_Message_Size();
+
+    /* Act */
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(msg_id, size);
+
+    /* Assert */
+    UtAssert_True(buf != NULL, "CFE_SBN_Client_GetBuffer returned a buffer");
+    UtAssert_True(buf->UseCount == 1,
+      "UseCount should be 1 and was %d", buf->UseCount);
+    UtAssert_True(buf->MsgId == msg_id && buf->Size == size,
+      "buffer should record MsgId 0x%04X and Size %d", msg_id, size);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1,
+      "Buffers in use should be 1 and were %d",
+      CFE_SBN_Client_BuffersInUse());
+} /* end Test_CFE_SBN_Client_GetBuffer_ReturnsBufferReferencedOnce */
+
+void Test_CFE_SBN_Client_GetBuffer_FailsWhenSizeIsTooLarge(void)
+{
+    /* Arrange */
+    uint32 size = CFE_SBN_CLIENT_MAX_MESSAGE_SIZE + 1;
+
+    /* Act */
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, size);
+
+    /* Assert */
+    UtAssert_True(buf == NULL, "CFE_SBN_Client_GetBuffer should return NULL");
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0,
+      "Buffers in use should be 0 and were %d",
+      CFE_SBN_Client_BuffersInUse());
+} /* end Test_CFE_SBN_Client_GetBuffer_FailsWhenSizeIsTooLarge */
+
+void Test_CFE_SBN_Client_GetBuffer_FailsWhenPoolIsEmpty(void)
+{
+    /* Arrange */
+    int i;
+
+    for(i = 0; i < CFE_SBN_CLIENT_MAX_BUFFERS; i++)
+    {
+        CFE_SBN_Client_GetBuffer(0x1800, 8);
+    }
+
+    /* Act */
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+
+    /* Assert */
+    UtAssert_True(buf == NULL, "CFE_SBN_Client_GetBuffer should return NULL");
+} /* end Test_CFE_SBN_Client_GetBuffer_FailsWhenPoolIsEmpty */
+
+void Test_CFE_SBN_Client_GetBuffer_SizesBufferToSizeClass(void)
+{
+    /* Arrange */
+    uint32 size = CFE_SBN_CLIENT_MIN_BUFFER_SIZE + 1;
+
+    /* Act */
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, size);
+
+    /* Assert */
+    UtAssert_True(buf->Capacity == CFE_SBN_CLIENT_MIN_BUFFER_SIZE * 2,
+      "Capacity should be %d and was %d", CFE_SBN_CLIENT_MIN_BUFFER_SIZE * 2,
+      buf->Capacity);
+} /* end Test_CFE_SBN_Client_GetBuffer_SizesBufferToSizeClass */
+
+void Test_CFE_SBN_Client_GetBuffer_ReusesFreeBufferOfSameSizeClass(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_BufferD_t *small = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    CFE_SBN_Client_BufferD_t *large = CFE_SBN_Client_GetBuffer(0x1801,
+      CFE_SBN_CLIENT_MIN_BUFFER_SIZE * 4);
+    void *large_mem = large->Buffer;
+
+    CFE_SBN_Client_ReleaseBuffer(small);
+    CFE_SBN_Client_ReleaseBuffer(large);
+
+    /* Act */
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1802,
+      CFE_SBN_CLIENT_MIN_BUFFER_SIZE * 3);
+
+    /* Assert */
+    UtAssert_True(buf == large && buf->Buffer == large_mem,
+      "the free buffer of the same size class should be reused");
+} /* end Test_CFE_SBN_Client_GetBuffer_ReusesFreeBufferOfSameSizeClass */
+
+/* end CFE_SBN_Client_GetBuffer Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_ReleaseBuffer Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_ReleaseBuffer_KeepsBufferWhileReferenced(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+
+    CFE_SBN_Client_RetainBuffer(buf);
+
+    /* Act */
+    CFE_SBN_Client_ReleaseBuffer(buf);
+
+    /* Assert */
+    UtAssert_True(buf->UseCount == 1,
+      "UseCount should be 1 and was %d", buf->UseCount);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1,
+      "Buffers in use should be 1 and were %d",
+      CFE_SBN_Client_BuffersInUse());
+} /* end Test_CFE_SBN_Client_ReleaseBuffer_KeepsBufferWhileReferenced */
+
+void Test_CFE_SBN_Client_ReleaseBuffer_ReturnsBufferAfterLastReference(void)
+{
+    /* Arrange */
+    int i;
+
+    /* empty the pool so only the released buffer can be taken again */
+    for(i = 0; i < CFE_SBN_CLIENT_MAX_BUFFERS - 1; i++)
+    {
+        CFE_SBN_Client_GetBuffer(0x1800, 8);
+    }
+
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1801, 8);
+
+    CFE_SBN_Client_RetainBuffer(buf);
+    CFE_SBN_Client_ReleaseBuffer(buf);
+
+    /* Act */
+    CFE_SBN_Client_ReleaseBuffer(buf);
+
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_GetBuffer(0x1802, 8) == buf,
+      "the released buffer should be taken again");
+} /* end Test_CFE_SBN_Client_ReleaseBuffer_ReturnsBufferAfterLastReference */
+
+void Test_CFE_SBN_Client_ReleaseBuffer_IgnoresNull(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_GetBuffer(0x1800, 8);
+
+    /* Act */
+    CFE_SBN_Client_ReleaseBuffer(NULL);
+
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1,
+      "Buffers in use should be 1 and were %d",
+      CFE_SBN_Client_BuffersInUse());
+} /* end Test_CFE_SBN_Client_ReleaseBuffer_IgnoresNull */
+
+/* end CFE_SBN_Client_ReleaseBuffer Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_CFE_SBN_Client_GetBuffer_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_GetBuffer_ReturnsBufferReferencedOnce,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_GetBuffer_ReturnsBufferReferencedOnce");
+    UtTest_Add(Test_CFE_SBN_Client_GetBuffer_FailsWhenSizeIsTooLarge,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_GetBuffer_FailsWhenSizeIsTooLarge");
+    UtTest_Add(Test_CFE_SBN_Client_GetBuffer_FailsWhenPoolIsEmpty,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_GetBuffer_FailsWhenPoolIsEmpty");
+    UtTest_Add(Test_CFE_SBN_Client_GetBuffer_SizesBufferToSizeClass,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_GetBuffer_SizesBufferToSizeClass");
+    UtTest_Add(Test_CFE_SBN_Client_GetBuffer_ReusesFreeBufferOfSameSizeClass,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_GetBuffer_ReusesFreeBufferOfSameSizeClass");
+} /* end add_CFE_SBN_Client_GetBuffer_tests */
+
+void add_CFE_SBN_Client_ReleaseBuffer_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_ReleaseBuffer_KeepsBufferWhileReferenced,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_ReleaseBuffer_KeepsBufferWhileReferenced");
+    UtTest_Add(Test_CFE_SBN_Client_ReleaseBuffer_ReturnsBufferAfterLastReference,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_ReleaseBuffer_ReturnsBufferAfterLastReference");
+    UtTest_Add(Test_CFE_SBN_Client_ReleaseBuffer_IgnoresNull,
+      SBN_Client_Buffers_Tests_Setup, SBN_Client_Buffers_Tests_Teardown,
+      "Test_CFE_SBN_Client_ReleaseBuffer_IgnoresNull");
+} /* end add_CFE_SBN_Client_ReleaseBuffer_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_CFE_SBN_Client_GetBuffer_tests();
+
+    add_CFE_SBN_Client_ReleaseBuffer_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
@@ -0,0 +1,333 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/*******************************************************************************
+**
+**  SBN_Client_Health_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Health_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+    CFE_SBN_Client_HealthReset();
+} /* end SBN_Client_Health_Tests_Setup */
+
+void SBN_Client_Health_Tests_Teardown(void)
+{
+    SBN_Client_Teardown();
+} /* end SBN_Client_Health_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  SBN_Client_GetLinkHealth Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_GetLinkHealth_FailsWithNullPointer(void)
+{
+    /* Arrange */
+    int32 result;
+
+    /* Act */
+    result = SBN_Client_GetLinkHealth(NULL);
+
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT,
+      "SBN_Client_GetLinkHealth should return %d and returned %d",
+      CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test_SBN_Client_GetLinkHealth_FailsWithNullPointer */
+
+void Test_SBN_Client_GetLinkHealth_ReportsNothingHeardAfterReset(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t health;
+    int32 result;
+
+    /* Act */
+    result = SBN_Client_GetLinkHealth(&health);
+
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS,
+      "SBN_Client_GetLinkHealth should return CFE_SUCCESS and returned %d",
+      result);
+    UtAssert_True(health.LinkUp == TRUE, "link should be up after a reset");
+    UtAssert_True(health.MsSinceLastHeard == SBN_CLIENT_HEALTH_NEVER,
+      "MsSinceLastHeard should be SBN_CLIENT_HEALTH_NEVER and was %u",
+      health.MsSinceLastHeard);
+    UtAssert_True(health.MsSinceLastHeartbeat == SBN_CLIENT_HEALTH_NEVER,
+      "MsSinceLastHeartbeat should be SBN_CLIENT_HEALTH_NEVER and was %u",
+      health.MsSinceLastHeartbeat);
+    UtAssert_True(health.HeartbeatsReceived == 0,
+      "HeartbeatsReceived should be 0 and was %u",
+      health.HeartbeatsReceived);
+    UtAssert_True(health.MsSinceTcpSample == SBN_CLIENT_HEALTH_NEVER,
+      "MsSinceTcpSample should be SBN_CLIENT_HEALTH_NEVER and was %u",
+      health.MsSinceTcpSample);
+} /* end Test_SBN_Client_GetLinkHealth_ReportsNothingHeardAfterReset */
+
+/* end SBN_Client_GetLinkHealth Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_HealthHeard Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_HealthHeard_AnyFrameUpdatesLastHeard(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t health;
+    uint64 now_ms = CFE_SBN_Client_MonotonicMs();
+
+    /* Act */
+    CFE_SBN_Client_HealthHeard(FALSE, now_ms - 250);
+
+    /* Assert */
+    SBN_Client_GetLinkHealth(&health);
+
+    UtAssert_True(health.MsSinceLastHeard >= 250 &&
+      health.MsSinceLastHeard < 1250,
+      "MsSinceLastHeard should be about 250 and was %u",
+      health.MsSinceLastHeard);
+    UtAssert_True(health.MsSinceLastHeartbeat == SBN_CLIENT_HEALTH_NEVER,
+      "a frame that is not a heartbeat should not count as one");
+} /* end Test_CFE_SBN_Client_HealthHeard_AnyFrameUpdatesLastHeard */
+
+void Test_CFE_SBN_Client_HealthHeard_MeasuresHeartbeatIntervalAndJitter(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t health;
+    uint64 start_ms = CFE_SBN_Client_MonotonicMs() - 20000;
+
+    /* Act */
+    CFE_SBN_Client_HealthHeard(TRUE, start_ms);
+    CFE_SBN_Client_HealthHeard(TRUE, start_ms + 3000);
+    CFE_SBN_Client_HealthHeard(TRUE, start_ms + 6000);
+    /* 1600 ms late, the interval changed by 1600 ms */
+    CFE_SBN_Client_HealthHeard(TRUE, start_ms + 10600);
+
+    /* Assert */
+    SBN_Client_GetLinkHealth(&health);
+
+    UtAssert_True(health.HeartbeatsReceived == 4,
+      "HeartbeatsReceived should be 4 and was %u", health.HeartbeatsReceived);
+    UtAssert_True(health.HeartbeatIntervalMs == 4600,
+      "HeartbeatIntervalMs should be 4600 and was %u",
+      health.HeartbeatIntervalMs);
+    UtAssert_True(health.HeartbeatJitterMs == 100,
+      "HeartbeatJitterMs should be 1600 / 16 and was %u",
+      health.HeartbeatJitterMs);
+} /* end Test_CFE_SBN_Client_HealthHeard_MeasuresHeartbeatIntervalAndJitter */
+
+/* end CFE_SBN_Client_HealthHeard Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_HealthHeartbeatSent Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_HealthHeartbeatSent_CountsSendsAndErrors(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t before, after;
+
+    SBN_Client_GetLinkHealth(&before);
+
+    /* Act */
+    CFE_SBN_Client_HealthHeartbeatSent(SBN_PACKED_HDR_SZ);
+    CFE_SBN_Client_HealthHeartbeatSent(SBN_PACKED_HDR_SZ);
+    CFE_SBN_Client_HealthHeartbeatSent(-1);
+
+    /* Assert */
+    SBN_Client_GetLinkHealth(&after);
+
+    UtAssert_True(after.HeartbeatsSent - before.HeartbeatsSent == 2,
+      "2 more heartbeats should be sent, %u were",
+      after.HeartbeatsSent - before.HeartbeatsSent);
+    UtAssert_True(after.HeartbeatSendErrors - before.HeartbeatSendErrors == 1,
+      "1 more heartbeat send error should be counted, %u were",
+      after.HeartbeatSendErrors - before.HeartbeatSendErrors);
+} /* end Test_CFE_SBN_Client_HealthHeartbeatSent_CountsSendsAndErrors */
+
+/* end CFE_SBN_Client_HealthHeartbeatSent Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_HealthZeroCopyLate Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_HealthZeroCopyLate_CountsLateSends(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t before, after;
+
+    SBN_Client_GetLinkHealth(&before);
+
+    /* Act */
+    CFE_SBN_Client_HealthZeroCopyLate();
+
+    /* Assert */
+    SBN_Client_GetLinkHealth(&after);
+
+    UtAssert_True(after.ZeroCopyLate - before.ZeroCopyLate == 1,
+      "1 more late zero copy send should be counted, %u were",
+      after.ZeroCopyLate - before.ZeroCopyLate);
+} /* end Test_CFE_SBN_Client_HealthZeroCopyLate_CountsLateSends */
+
+/* end CFE_SBN_Client_HealthZeroCopyLate Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_HealthLinkState Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_HealthLinkState_CountsReconnects(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t before, down, up;
+
+    SBN_Client_GetLinkHealth(&before);
+    CFE_SBN_Client_HealthHeard(TRUE, CFE_SBN_Client_MonotonicMs());
+
+    /* Act */
+    CFE_SBN_Client_HealthLinkState(FALSE);
+    SBN_Client_GetLinkHealth(&down);
+    CFE_SBN_Client_HealthLinkState(TRUE);
+    SBN_Client_GetLinkHealth(&up);
+
+    /* Assert */
+    UtAssert_True(down.LinkUp == FALSE && up.LinkUp == TRUE,
+      "link should be reported down then up");
+    UtAssert_True(up.Reconnects - before.Reconnects == 1,
+      "1 more reconnect should be counted, %u were",
+      up.Reconnects - before.Reconnects);
+    UtAssert_True(up.HeartbeatsReceived == 0,
+      "heartbeats from the old connection should be forgotten");
+} /* end Test_CFE_SBN_Client_HealthLinkState_CountsReconnects */
+
+/* end CFE_SBN_Client_HealthLinkState Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_HealthSampleTcp Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_HealthSampleTcp_IgnoresSocketThatIsNotTcp(void)
+{
+    /* Arrange */
+    SBN_Client_LinkHealth_t health;
+    int fds[2];
+
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+
+    /* Act */
+    CFE_SBN_Client_HealthSampleTcp(fds[0]);
+
+    /* Assert */
+    SBN_Client_GetLinkHealth(&health);
+
+    UtAssert_True(health.MsSinceTcpSample == SBN_CLIENT_HEALTH_NEVER,
+      "MsSinceTcpSample should be SBN_CLIENT_HEALTH_NEVER and was %u",
+      health.MsSinceTcpSample);
+
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_CFE_SBN_Client_HealthSampleTcp_IgnoresSocketThatIsNotTcp */
+
+/* end CFE_SBN_Client_HealthSampleTcp Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_SBN_Client_GetLinkHealth_tests(void)
+{
+    UtTest_Add(Test_SBN_Client_GetLinkHealth_FailsWithNullPointer,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_SBN_Client_GetLinkHealth_FailsWithNullPointer");
+    UtTest_Add(Test_SBN_Client_GetLinkHealth_ReportsNothingHeardAfterReset,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_SBN_Client_GetLinkHealth_ReportsNothingHeardAfterReset");
+} /* end add_SBN_Client_GetLinkHealth_tests */
+
+void add_CFE_SBN_Client_HealthHeard_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_HealthHeard_AnyFrameUpdatesLastHeard,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_CFE_SBN_Client_HealthHeard_AnyFrameUpdatesLastHeard");
+    UtTest_Add(
+      Test_CFE_SBN_Client_HealthHeard_MeasuresHeartbeatIntervalAndJitter,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_CFE_SBN_Client_HealthHeard_MeasuresHeartbeatIntervalAndJitter");
+} /* end add_CFE_SBN_Client_HealthHeard_tests */
+
+void add_CFE_SBN_Client_HealthHeartbeatSent_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_HealthHeartbeatSent_CountsSendsAndErrors,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_CFE_SBN_Client_HealthHeartbeatSent_CountsSendsAndErrors");
+} /* end add_CFE_SBN_Client_HealthHeartbeatSent_tests */
+
+void add_CFE_SBN_Client_HealthZeroCopyLate_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_HealthZeroCopyLate_CountsLateSends,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_CFE_SBN_Client_HealthZeroCopyLate_CountsLateSends");
+} /* end add_CFE_SBN_Client_HealthZeroCopyLate_tests */
+
+void add_CFE_SBN_Client_HealthLinkState_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_HealthLinkState_CountsReconnects,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_CFE_SBN_Client_HealthLinkState_CountsReconnects");
+} /* end add_CFE_SBN_Client_HealthLinkState_tests */
+
+void add_CFE_SBN_Client_HealthSampleTcp_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_HealthSampleTcp_IgnoresSocketThatIsNotTcp,
+      SBN_Client_Health_Tests_Setup, SBN_Client_Health_Tests_Teardown,
+      "Test_CFE_SBN_Client_HealthSampleTcp_IgnoresSocketThatIsNotTcp");
+} /* end add_CFE_SBN_Client_HealthSampleTcp_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_SBN_Client_GetLinkHealth_tests();
+
+    add_CFE_SBN_Client_HealthHeard_tests();
+
+    add_CFE_SBN_Client_HealthHeartbeatSent_tests();
+
+    add_CFE_SBN_Client_HealthZeroCopyLate_tests();
+
+    add_CFE_SBN_Client_HealthLinkState_tests();
+
+    add_CFE_SBN_Client_HealthSampleTcp_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
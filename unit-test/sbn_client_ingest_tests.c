@@ -52,9 +52,12 @@ void Test_ingest_app_message_ReadBytesFails(void)
     log_message_expected_string = err_msg;
     
     /* Act */
-    ingest_app_message(sockfd, msgSize);
+    int32 result = ingest_app_message(sockfd, msgSize);
     
     /* Assert */
+    UtAssert_True(result == wrap_CFE_SBN_CLIENT_ReadBytes_return_value,
+      "ingest_app_message should return the ReadBytes status 0x%08X and "
+      "returned 0x%08X", wrap_CFE_SBN_CLIENT_ReadBytes_return_value, result);
     UtAssert_True(wrap_pthread_mutex_lock_was_called == FALSE,
       "pthread_mutex_lock should not have been called");
     UtAssert_True(wrap_pthread_mutex_unlock_was_called == FALSE,
@@ -71,8 +74,8 @@ void Test_ingest_app_message_FailsWhenNoPipesInUse(void)
     int msgSize = sizeof(msg);
     int sockfd = Any_int();
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_mutex_lock_should_be_called = FALSE;
+    wrap_pthread_mutex_unlock_should_be_called = FALSE;
     wrap_pthread_cond_signal_should_be_called = FALSE;
     use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
@@ -86,9 +89,9 @@ void Test_ingest_app_message_FailsWhenNoPipesInUse(void)
     ingest_app_message(sockfd, msgSize);
 
     /* Assert */
-    UtAssert_True(wrap_pthread_mutex_lock_was_called == TRUE,
+    UtAssert_True(wrap_pthread_mutex_lock_was_called == FALSE,
       "pthread_mutex_lock should not have been called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called == TRUE,
+    UtAssert_True(wrap_pthread_mutex_unlock_was_called == FALSE,
       "pthread_mutex_unlock should not have been called");
     UtAssert_True(wrap_pthread_cond_signal_was_called == FALSE,
       "pthread_cond_signal should not have been called");
@@ -101,13 +104,12 @@ void Test_ingest_app_message_FailsOverflowWhenNumberOfMessagesIsFull(void)
     int msgSize = sizeof(msg);
     int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
     int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    int read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    int num_msg = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    int msg_slot = read_msg + num_msg;
+    uint32 read_idx = rand();
+    uint32 write_idx = read_idx + CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
     int sockfd = Any_int();
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_mutex_lock_should_be_called = FALSE;
+    wrap_pthread_mutex_unlock_should_be_called = FALSE;
     wrap_pthread_cond_signal_should_be_called = FALSE;
     use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
@@ -118,30 +120,23 @@ void Test_ingest_app_message_FailsOverflowWhenNumberOfMessagesIsFull(void)
     PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
     PipeTbl[pipe_assigned].PipeId = pipe_assigned;
     PipeTbl[pipe_assigned].SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    PipeTbl[pipe_assigned].NumberOfMessages = num_msg;
-    PipeTbl[pipe_assigned].ReadMessage = read_msg;
-    
-    if (msg_slot >= CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)
-    {
-        msg_slot = msg_slot - CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    } 
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], pipe_assigned);
+    PipeTbl[pipe_assigned].ReadIdx = read_idx;
+    PipeTbl[pipe_assigned].WriteIdx = write_idx;
     
     /* Act */ 
     ingest_app_message(sockfd, msgSize);
     
     /* Assert */
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg, 
-      "PipeTbl[%d].NumberOfMessages %d should not increase and was %d", 
-      pipe_assigned, num_msg, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == read_msg, 
-      "PipeTbl[%d].ReadMessage should not have changed from %d and was %d", 
-      pipe_assigned, read_msg, PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called == TRUE,
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called == TRUE,
-      "pthread_mutex_unlock was called");
-    UtAssert_True(wrap_pthread_cond_signal_was_called == FALSE,
-      "pthread_cond_signal should not have been called");
+    UtAssert_True(PipeTbl[pipe_assigned].WriteIdx == write_idx, 
+      "PipeTbl[%d].WriteIdx %u should not increase and was %u", 
+      pipe_assigned, write_idx, PipeTbl[pipe_assigned].WriteIdx);
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx, 
+      "PipeTbl[%d].ReadIdx should not have changed from %u and was %u", 
+      pipe_assigned, read_idx, PipeTbl[pipe_assigned].ReadIdx);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "the message buffer should be returned to the pool, %d in use", 
+      CFE_SBN_Client_BuffersInUse());
 }
 
 void Test_ingest_app_message_FailsWhenNoPipeLookingForMessageId(void)
@@ -151,19 +146,14 @@ void Test_ingest_app_message_FailsWhenNoPipeLookingForMessageId(void)
     int msgSize = sizeof(msg);
     int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;  
     int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    int read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    int num_msg = 0;
-    int msg_slot= read_msg + num_msg;
+    uint32 read_idx = rand();
     int sockfd = Any_int();
     char err_msg[60] = "SBN_CLIENT: ERROR no subscription for this msgid";
     
-    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
-    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = Any_int32_Except(CFE_SUCCESS);
-    
     log_message_expected_string = err_msg;
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_mutex_lock_should_be_called = FALSE;
+    wrap_pthread_mutex_unlock_should_be_called = FALSE;
     wrap_pthread_cond_signal_should_be_called = FALSE;
     use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
@@ -174,48 +164,43 @@ void Test_ingest_app_message_FailsWhenNoPipeLookingForMessageId(void)
     PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
     PipeTbl[pipe_assigned].PipeId = pipe_assigned;
     PipeTbl[pipe_assigned].SubscribedMsgIds[msg_id_slot] = 0x0000;
-    PipeTbl[pipe_assigned].NumberOfMessages = num_msg;
-    PipeTbl[pipe_assigned].ReadMessage = read_msg;
-    
-    if (msg_slot >= CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)
-    {
-        msg_slot = msg_slot - CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    } 
+    PipeTbl[pipe_assigned].ReadIdx = read_idx;
+    PipeTbl[pipe_assigned].WriteIdx = read_idx;
     
     /* Act */ 
     ingest_app_message(sockfd, msgSize);
     
     /* Assert */
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == 0, 
-      "PipeTbl[%d].NumberOfMessages should = %d and was %d ", pipe_assigned, 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == read_msg, 
-      "PipeTbl[%d].ReadMessage should not have changed from %d and was %d", 
-      pipe_assigned, read_msg, PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called == TRUE,
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called == TRUE,
-      "pthread_mutex_unlock was called");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]) == 0, 
+      "PipeTbl[%d] should have no messages and had %u", pipe_assigned, 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]));
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx, 
+      "PipeTbl[%d].ReadIdx should not have changed from %u and was %u", 
+      pipe_assigned, read_idx, PipeTbl[pipe_assigned].ReadIdx);
+    UtAssert_True(wrap_pthread_mutex_lock_was_called == FALSE,
+      "pthread_mutex_lock should not have been called");
     UtAssert_True(wrap_pthread_cond_signal_was_called == FALSE,
       "pthread_cond_signal should not have been called");
 }
 
-void Test_ingest_app_message_SuccessAllSlotsAvailable(void)
+/* Test_ingest_app_message_AddsMessage checks a message is added to a pipe 
+ * that already holds num_msg unread messages */
+void Test_ingest_app_message_AddsMessage(uint32 num_msg)
 {
     /* Arrange */
     unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
     int msgSize = sizeof(msg);
     int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
     int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    int read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    int num_msg = 0;
-    int msg_slot = read_msg + num_msg;
+    uint32 read_idx = rand();
+    uint32 write_idx = read_idx + num_msg;
+    int msg_slot = write_idx % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
     int sockfd = Any_int();
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-    wrap_pthread_cond_signal_should_be_called = TRUE;
+    /* the reader is not waiting, so the pipe is not locked */
+    wrap_pthread_mutex_lock_should_be_called = FALSE;
+    wrap_pthread_mutex_unlock_should_be_called = FALSE;
+    wrap_pthread_cond_signal_should_be_called = FALSE;
     use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
     use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
@@ -225,13 +210,9 @@ void Test_ingest_app_message_SuccessAllSlotsAvailable(void)
     PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
     PipeTbl[pipe_assigned].PipeId = pipe_assigned;
     PipeTbl[pipe_assigned].SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    PipeTbl[pipe_assigned].NumberOfMessages = num_msg;
-    PipeTbl[pipe_assigned].ReadMessage = read_msg;
-    
-    if (msg_slot >= CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)
-    {
-        msg_slot = msg_slot - CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    } 
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], pipe_assigned);
+    PipeTbl[pipe_assigned].ReadIdx = read_idx;
+    PipeTbl[pipe_assigned].WriteIdx = write_idx;
     
     /* Act */ 
     ingest_app_message(sockfd, msgSize);
@@ -241,41 +222,53 @@ void Test_ingest_app_message_SuccessAllSlotsAvailable(void)
     
     for(i = 0; i < msgSize; i++)
     {
-        UtAssert_True(PipeTbl[pipe_assigned].Messages[msg_slot][i] == msg[i], 
+        UtAssert_True(
+          Pipe_Message_Data(&PipeTbl[pipe_assigned], msg_slot)[i] == msg[i], 
           "PipeTbl[%d].Messages[%d][%d] should = %d and was %d", 
           pipe_assigned, msg_slot, i, msg[i], 
-          PipeTbl[pipe_assigned].Messages[msg_slot][i]);
+          Pipe_Message_Data(&PipeTbl[pipe_assigned], msg_slot)[i]);
     }
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg + 1, 
-      "PipeTbl[%d].NumberOfMessages should increase by 1 to %d and was %d", 
-      pipe_assigned, num_msg + 1, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == read_msg, 
-      "PipeTbl[%d].ReadMessage should not have changed from %d and was %d", 
-      pipe_assigned, read_msg, PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called == TRUE,
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called == TRUE,
-      "pthread_mutex_unlock was called");
-    UtAssert_True(wrap_pthread_cond_signal_was_called == TRUE,
-      "pthread_cond_signal was called");
+    UtAssert_True(PipeTbl[pipe_assigned].WriteIdx == write_idx + 1, 
+      "PipeTbl[%d].WriteIdx should increase by 1 to %u and was %u", 
+      pipe_assigned, write_idx + 1, PipeTbl[pipe_assigned].WriteIdx);
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx, 
+      "PipeTbl[%d].ReadIdx should not have changed from %u and was %u", 
+      pipe_assigned, read_idx, PipeTbl[pipe_assigned].ReadIdx);
+    UtAssert_True(wrap_pthread_mutex_lock_was_called == FALSE,
+      "pthread_mutex_lock should not have been called");
+    UtAssert_True(wrap_pthread_cond_signal_was_called == FALSE,
+      "pthread_cond_signal should not have been called");
+}
+
+void Test_ingest_app_message_SuccessAllSlotsAvailable(void)
+{
+    Test_ingest_app_message_AddsMessage(0);
 }
 
 void Test_ingest_app_message_SuccessAnyNumberOfSlotsAvailable(void)
+{
+    /* from 1 to CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 2 */
+    Test_ingest_app_message_AddsMessage(
+      (rand() % (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 2)) + 1);
+}
+
+void Test_ingest_app_message_SuccessWhenOnlyOneSlotLeft(void)
+{
+    Test_ingest_app_message_AddsMessage(
+      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1);
+}
+
+void Test_ingest_app_message_ReadsPayloadDirectlyAfterHeader(void)
 {
     /* Arrange */
-    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
+    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0xAB, 0xCD};
     int msgSize = sizeof(msg);
     int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
     int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    int read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    /* from 1 to CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH */
-    int num_msg = (rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1) + 1; 
-    int msg_slot = read_msg + num_msg;
+    uint32 write_idx = rand();
+    int msg_slot = write_idx % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
     int sockfd = Any_int();
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-    wrap_pthread_cond_signal_should_be_called = TRUE;
     use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
     use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
@@ -285,106 +278,329 @@ void Test_ingest_app_message_SuccessAnyNumberOfSlotsAvailable(void)
     PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
     PipeTbl[pipe_assigned].PipeId = pipe_assigned;
     PipeTbl[pipe_assigned].SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    PipeTbl[pipe_assigned].NumberOfMessages = num_msg;
-    PipeTbl[pipe_assigned].ReadMessage = read_msg;
-    
-    if (msg_slot >= CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)
-    {
-        msg_slot = msg_slot - CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    } 
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], pipe_assigned);
+    PipeTbl[pipe_assigned].ReadIdx = write_idx;
+    PipeTbl[pipe_assigned].WriteIdx = write_idx;
     
     /* Act */ 
     ingest_app_message(sockfd, msgSize);
     
     /* Assert */
-    int i;
-    
-    for(i = 0; i < msgSize; i++)
-    {
-        UtAssert_True(PipeTbl[pipe_assigned].Messages[msg_slot][i] == msg[i], 
-          "PipeTbl[%d].Messages[%d][%d] should = %d and was %d", 
-          pipe_assigned, msg_slot, i, msg[i], 
-          PipeTbl[pipe_assigned].Messages[msg_slot][i]);
-    }
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg + 1, 
-      "PipeTbl[%d].NumberOfMessages should increase by 1 to %d and was %d", 
-      pipe_assigned, num_msg + 1, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == read_msg, 
-      "PipeTbl[%d].ReadMessage should not have changed from %d and was %d", 
-      pipe_assigned, read_msg, PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called == TRUE,
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called == TRUE,
-      "pthread_mutex_unlock was called");
-    UtAssert_True(wrap_pthread_cond_signal_was_called == TRUE,
-      "pthread_cond_signal was called");
+    UtAssert_True(wrap_CFE_SBN_CLIENT_ReadBytes_call_number == 2, 
+      "CFE_SBN_CLIENT_ReadBytes should be called twice (header, payload) "
+      "and was called %d times", wrap_CFE_SBN_CLIENT_ReadBytes_call_number);
+    UtAssert_True(memcmp(Pipe_Message_Data(&PipeTbl[pipe_assigned], msg_slot), 
+      msg, msgSize) == 0, 
+      "PipeTbl[%d].Messages[%d] should hold the whole message", 
+      pipe_assigned, msg_slot);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]) == 1, 
+      "PipeTbl[%d] should have 1 message and had %u", pipe_assigned, 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]));
 }
 
-void Test_ingest_app_message_SuccessWhenOnlyOneSlotLeft(void)
+void Test_ingest_app_message_PayloadReadFailsDoesNotAddMessage(void)
 {
     /* Arrange */
     unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
     int msgSize = sizeof(msg);
-    int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;  
+    int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
     int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    int read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    int num_msg = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1; /* 1 slot left */
-    int msg_slot= read_msg + num_msg;
     int sockfd = Any_int();
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-    wrap_pthread_cond_signal_should_be_called = TRUE;
+    wrap_pthread_cond_signal_should_be_called = FALSE;
     use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
     wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
     use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
     wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
     wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = msg;
+    wrap_CFE_SBN_CLIENT_ReadBytes_errors_on_call_number = SECOND_CALL;
+    wrap_CFE_SBN_CLIENT_ReadBytes_error_value = CFE_SBN_CLIENT_PIPE_CLOSED_ERR;
     
     PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
     PipeTbl[pipe_assigned].PipeId = pipe_assigned;
     PipeTbl[pipe_assigned].SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    PipeTbl[pipe_assigned].NumberOfMessages = num_msg;
-    PipeTbl[pipe_assigned].ReadMessage = read_msg;
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], pipe_assigned);
     
-    if (msg_slot >= CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH)
-    {
-        msg_slot = msg_slot - CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    } 
+    /* Act */ 
+    ingest_app_message(sockfd, msgSize);
+    
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]) == 0, 
+      "PipeTbl[%d] should have no messages and had %u", pipe_assigned, 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]));
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "the message buffer should be returned to the pool, %d in use", 
+      CFE_SBN_Client_BuffersInUse());
+}
+
+void Test_ingest_app_message_DeliversOneBufferToEverySubscribedPipe(void)
+{
+    /* Arrange */
+    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0xAB, 0xCD};
+    int msgSize = sizeof(msg);
+    int first_pipe = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int second_pipe = (first_pipe + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int sockfd = Any_int();
+    
+    use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
+    wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = msg;
+    
+    PipeTbl[first_pipe].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[second_pipe].InUse = CFE_SBN_CLIENT_IN_USE;
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], first_pipe);
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], second_pipe);
     
     /* Act */ 
     ingest_app_message(sockfd, msgSize);
     
     /* Assert */
-    int i;
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[first_pipe]) == 1 && 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[second_pipe]) == 1, 
+      "both pipes should have received the message");
+    UtAssert_True(PipeTbl[first_pipe].Messages[0] == 
+      PipeTbl[second_pipe].Messages[0], 
+      "both pipes should reference the same message buffer");
+    UtAssert_True(memcmp(Pipe_Message_Data(&PipeTbl[first_pipe], 0), 
+      msg, msgSize) == 0, "the shared buffer should hold the whole message");
+    UtAssert_True(PipeTbl[first_pipe].Messages[0]->UseCount == 2, 
+      "the shared buffer UseCount should be 2 and was %d", 
+      PipeTbl[first_pipe].Messages[0]->UseCount);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1, 
+      "one buffer should be in use and %d were", 
+      CFE_SBN_Client_BuffersInUse());
+}
+
+void Test_ingest_app_message_FullPipeDoesNotStopDeliveryToOtherPipes(void)
+{
+    /* Arrange */
+    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0xAB, 0xCD};
+    int msgSize = sizeof(msg);
+    int full_pipe = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int other_pipe = (full_pipe + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int sockfd = Any_int();
     
-    for(i = 0; i < msgSize; i++)
-    {
-        UtAssert_True(PipeTbl[pipe_assigned].Messages[msg_slot][i] == msg[i], 
-          "PipeTbl[%d].Messages[%d][%d] should = %d and was %d ", 
-          pipe_assigned, msg_slot, i, msg[i], 
-          PipeTbl[pipe_assigned].Messages[msg_slot][i]);
-    }  
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, 
-      "PipeTbl[%d].NumberOfMessages should = %d and was %d ", pipe_assigned, 
+    use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
+    wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = msg;
+    
+    PipeTbl[full_pipe].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[full_pipe].WriteIdx = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
+    PipeTbl[other_pipe].InUse = CFE_SBN_CLIENT_IN_USE;
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], full_pipe);
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], other_pipe);
+    
+    /* Act */ 
+    ingest_app_message(sockfd, msgSize);
+    
+    /* Assert */
+    UtAssert_True(PipeTbl[full_pipe].WriteIdx == 
       CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == read_msg, 
-      "PipeTbl[%d].ReadMessage should not have changed from %d and was %d", 
-      pipe_assigned, read_msg, PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called == TRUE,
-      "pthread_mutex_lock was called");
+      "the full pipe should not have changed");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[other_pipe]) == 1, 
+      "PipeTbl[%d] should have 1 message and had %u", other_pipe, 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[other_pipe]));
+}
+
+void Test_ingest_app_message_WakesOnlyTheWaitingReader(void)
+{
+    /* Arrange */
+    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
+    int msgSize = sizeof(msg);
+    int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int other_pipe = (pipe_assigned + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int sockfd = Any_int();
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_signal_should_be_called = TRUE;
+    use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
+    wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = msg;
+    
+    PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_assigned].ReaderWaiting = 1;
+    PipeTbl[other_pipe].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[other_pipe].ReaderWaiting = 1;
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], pipe_assigned);
+    
+    /* Act */ 
+    ingest_app_message(sockfd, msgSize);
+    
+    /* Assert */
+    UtAssert_True(wrap_pthread_cond_signal_cond == 
+      &PipeTbl[pipe_assigned].MsgAvail, 
+      "pthread_cond_signal should be called on PipeTbl[%d].MsgAvail", 
+      pipe_assigned);
     UtAssert_True(wrap_pthread_mutex_unlock_was_called == TRUE,
       "pthread_mutex_unlock was called");
-    UtAssert_True(wrap_pthread_cond_signal_was_called == TRUE,
-      "pthread_cond_signal was called");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[other_pipe]) == 0, 
+      "PipeTbl[%d] should have no messages and had %u", other_pipe, 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[other_pipe]));
+}
+
+void Test_ingest_app_message_SkipsPipeDeletedAfterRouteLookup(void)
+{
+    /* Arrange */
+    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
+    int msgSize = sizeof(msg);
+    int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int sockfd = Any_int();
+    
+    use_wrap_CFE_SBN_Client_GetMsgId = TRUE;
+    wrap_CFE_SBN_Client_GetMsgId_return_value = msg[0] << 8 | msg[1];
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = msg;
+    
+    /* route still present, pipe already invalidated */
+    PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+    CFE_SBN_Client_AddRoute(msg[0] << 8 | msg[1], pipe_assigned);
+    
+    /* Act */ 
+    ingest_app_message(sockfd, msgSize);
+    
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]) == 0, 
+      "PipeTbl[%d] should have no messages and had %u", pipe_assigned, 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_assigned]));
+    UtAssert_True(PipeTbl[pipe_assigned].Producers == 0, 
+      "PipeTbl[%d].Producers should be back to 0", pipe_assigned);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "the message buffer should be returned to the pool, %d in use", 
+      CFE_SBN_Client_BuffersInUse());
 }
 
-//void Test_ingest_app_message_SuccessCausesPipeNumberOfMessagesToIncreaseBy1
-//void Test_ingest_app_message_FailsWhenNoPipesInUse
 /* end ingest_app_message Tests */
 
+/*******************************************************************************
+**
+**  ingest_sub_message Tests
+**
+*******************************************************************************/
+
+/* Pack_Sub_Frame packs the body of a subscription frame for Count MsgIds 
+ * into frame, returning its size */
+size_t Pack_Sub_Frame(unsigned char *frame, CFE_SB_MsgId_t *MsgIds, 
+                      uint16 Count)
+{
+    Pack_t       Pack;
+    CFE_SB_Qos_t qos = {0, 0};
+    uint16       i;
+    
+    Pack_Init(&Pack, frame, SBN_PACKED_SUB_SZ - SBN_PACKED_HDR_SZ, 0);
+    Pack_Data(&Pack, (void *)SBN_IDENT, SBN_IDENT_LEN);
+    Pack_UInt16(&Pack, Count);
+    
+    for(i = 0; i < Count; i++)
+    {
+        Pack_MsgID(&Pack, MsgIds[i]);
+        Pack_Data(&Pack, &qos, sizeof(qos));
+    }
+    
+    return Pack.BufUsed;
+}
+
+void Test_ingest_sub_message_SubAddsRemoteInterest(void)
+{
+    /* Arrange */
+    unsigned char frame[SBN_PACKED_SUB_SZ] = {0};
+    CFE_SB_MsgId_t msg_ids[2] = {0x1800, 0x1801};
+    size_t frame_size = Pack_Sub_Frame(frame, msg_ids, 2);
+    int sockfd = Any_int();
+    
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = frame;
+    
+    /* Act */ 
+    int32 result = ingest_sub_message(sockfd, frame_size, SBN_SUB_MSG);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "ingest_sub_message should return %d and returned %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(CFE_SBN_Client_RemoteWants(0x1800) && 
+      CFE_SBN_Client_RemoteWants(0x1801), 
+      "the MsgIds in the frame should be wanted");
+    UtAssert_True(CFE_SBN_Client_RemoteWants(0x1802) == FALSE, 
+      "a MsgId not in the frame should not be wanted");
+}
+
+void Test_ingest_sub_message_UnsubRemovesRemoteInterest(void)
+{
+    /* Arrange */
+    unsigned char frame[SBN_PACKED_SUB_SZ] = {0};
+    CFE_SB_MsgId_t msg_ids[2] = {0x1800, 0x1801};
+    size_t frame_size = Pack_Sub_Frame(frame, &msg_ids[1], 1);
+    int sockfd = Any_int();
+    
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = frame;
+    
+    CFE_SBN_Client_AddRemoteInterest(msg_ids, 2);
+    
+    /* Act */ 
+    ingest_sub_message(sockfd, frame_size, SBN_UNSUB_MSG);
+    
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_RemoteWants(0x1800), 
+      "MsgId 0x1800 should still be wanted");
+    UtAssert_True(CFE_SBN_Client_RemoteWants(0x1801) == FALSE, 
+      "MsgId 0x1801 should no longer be wanted");
+}
+
+void Test_ingest_sub_message_MalformedFrameWantsEverything(void)
+{
+    /* Arrange */
+    unsigned char frame[SBN_PACKED_SUB_SZ] = {0};
+    CFE_SB_MsgId_t msg_ids[2] = {0x1800, 0x1801};
+    size_t frame_size = Pack_Sub_Frame(frame, msg_ids, 2);
+    int sockfd = Any_int();
+    
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = CFE_SUCCESS;
+    wrap_CFE_SBN_CLIENT_ReadBytes_msg_buffer = frame;
+    
+    CFE_SBN_Client_AddRemoteInterest(msg_ids, 1);
+    
+    /* Act */ 
+    int32 result = ingest_sub_message(sockfd, frame_size - 1, SBN_SUB_MSG);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "ingest_sub_message should return %d and returned %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(CFE_SBN_Client_RemoteWants(0x1802), 
+      "every MsgId should be wanted after a frame that could not be read");
+}
+
+void Test_ingest_sub_message_ReadBytesFails(void)
+{
+    /* Arrange */
+    int sockfd = Any_int();
+    
+    use_wrap_CFE_SBN_CLIENT_ReadBytes = TRUE;
+    wrap_CFE_SBN_CLIENT_ReadBytes_return_value = Any_int32_Except(CFE_SUCCESS);
+    
+    /* Act */ 
+    int32 result = ingest_sub_message(sockfd, SBN_IDENT_LEN + 2, SBN_SUB_MSG);
+    
+    /* Assert */
+    UtAssert_True(result == wrap_CFE_SBN_CLIENT_ReadBytes_return_value,
+      "ingest_sub_message should return the ReadBytes status 0x%08X and "
+      "returned 0x%08X", wrap_CFE_SBN_CLIENT_ReadBytes_return_value, result);
+}
+
+/* end ingest_sub_message Tests */
+
 
 
 void UtTest_Setup(void)
@@ -418,4 +634,46 @@ void UtTest_Setup(void)
       Test_ingest_app_message_SuccessWhenOnlyOneSlotLeft, 
       SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
       "Test_ingest_app_message_SuccessWhenOnlyOneSlotLeft");
-}
\ No newline at end of file
+    UtTest_Add(
+      Test_ingest_app_message_ReadsPayloadDirectlyAfterHeader, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_app_message_ReadsPayloadDirectlyAfterHeader");
+    UtTest_Add(
+      Test_ingest_app_message_PayloadReadFailsDoesNotAddMessage, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_app_message_PayloadReadFailsDoesNotAddMessage");
+    UtTest_Add(
+      Test_ingest_app_message_DeliversOneBufferToEverySubscribedPipe, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_app_message_DeliversOneBufferToEverySubscribedPipe");
+    UtTest_Add(
+      Test_ingest_app_message_FullPipeDoesNotStopDeliveryToOtherPipes, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_app_message_FullPipeDoesNotStopDeliveryToOtherPipes");
+    UtTest_Add(
+      Test_ingest_app_message_WakesOnlyTheWaitingReader, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_app_message_WakesOnlyTheWaitingReader");
+    UtTest_Add(
+      Test_ingest_app_message_SkipsPipeDeletedAfterRouteLookup, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_app_message_SkipsPipeDeletedAfterRouteLookup");
+    
+    /* ingest_sub_message Tests */
+    UtTest_Add(
+      Test_ingest_sub_message_SubAddsRemoteInterest, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_sub_message_SubAddsRemoteInterest");
+    UtTest_Add(
+      Test_ingest_sub_message_UnsubRemovesRemoteInterest, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_sub_message_UnsubRemovesRemoteInterest");
+    UtTest_Add(
+      Test_ingest_sub_message_MalformedFrameWantsEverything, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_sub_message_MalformedFrameWantsEverything");
+    UtTest_Add(
+      Test_ingest_sub_message_ReadBytesFails, 
+      SBN_Client_Ingest_Setup, SBN_Client_Ingest_Teardown, 
+      "Test_ingest_sub_message_ReadBytesFails");
+}
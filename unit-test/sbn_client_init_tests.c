@@ -149,8 +149,179 @@ void Test_SBN_Client_Init_Success(void)
     UtAssert_True(sbn_client_cpuId == 2, "SBN_Client_Init set the "
       "sbn_client_cpuId to 2");
 }
+
+void Test_SBN_Client_Init_RetriesRefusedConnect(void)
+{
+    /* Arrange */
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = Any_Positive_int_Or_Zero();
+    wrap_connect_to_server_succeeds_on_call_number = 3;
+    
+    use_wrap_CFE_SBN_Client_InitPipeTbl = TRUE;
+    pthread_create_errors_on_call_number = 0;
+    use_wrap_check_pthread_create_status = TRUE;
+    wrap_check_pthread_create_status_fail_call = FALSE;
+    
+    /* Act */ 
+    int32 result = SBN_Client_Init();
+
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+      "SBN_Client_Init result should be %d, but was %d", 
+      SBN_CLIENT_SUCCESS, result);
+    UtAssert_True(connect_to_server_call_number == 3, 
+      "connect_to_server should be called 3 times and was called %d times", 
+      connect_to_server_call_number);
+}
+
+void Test_SBN_Client_Init_GivesUpAfterConnectAttempts(void)
+{
+    /* Arrange */
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = SERVER_CONNECT_ERROR;
+    
+    /* Act */ 
+    int32 result = SBN_Client_Init();
+
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_BAD_SOCK_FD_EID, 
+      "SBN_Client_Init result should be %d, but was %d", 
+      SBN_CLIENT_BAD_SOCK_FD_EID, result);
+    UtAssert_True(connect_to_server_call_number == SBN_CLIENT_CONNECT_ATTEMPTS, 
+      "connect_to_server should be called %d times and was called %d times", 
+      SBN_CLIENT_CONNECT_ATTEMPTS, connect_to_server_call_number);
+}
+
+void Test_SBN_Client_Init_DoesNotRetrySocketError(void)
+{
+    /* Arrange */
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = SERVER_SOCKET_ERROR;
+    
+    /* Act */ 
+    int32 result = SBN_Client_Init();
+
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_BAD_SOCK_FD_EID, 
+      "SBN_Client_Init result should be %d, but was %d", 
+      SBN_CLIENT_BAD_SOCK_FD_EID, result);
+    UtAssert_True(connect_to_server_call_number == 1, 
+      "connect_to_server should be called once and was called %d times", 
+      connect_to_server_call_number);
+}
 /* end SBN_Client_Init Tests */
 
+/*******************************************************************************
+**
+**  SBN_Client_InitAsync Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_InitAsync_StartsInitThread(void)
+{
+    /* Arrange */
+    int ready_fd = -1;
+    
+    pthread_create_errors_on_call_number = 0;
+    use_wrap_check_pthread_create_status = TRUE;
+    wrap_check_pthread_create_status_fail_call = FALSE;
+    
+    /* Act */ 
+    int32 result = SBN_Client_InitAsync(NULL, NULL, &ready_fd);
+
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+      "SBN_Client_InitAsync result should be %d, but was %d", 
+      SBN_CLIENT_SUCCESS, result);
+    UtAssert_True(pthread_create_call_number == 1, 
+      "SBN_Client_InitAsync should start one thread and started %d", 
+      pthread_create_call_number);
+    UtAssert_True(ready_fd >= 0, "SBN_Client_InitAsync gave a ready fd");
+    UtAssert_True(SBN_Client_GetInitStatus() == SBN_CLIENT_INIT_PENDING, 
+      "init status should be pending and was %d", SBN_Client_GetInitStatus());
+    
+    sbn_client_sockfd = 0;
+    SBN_Client_Shutdown();
+}
+
+void Test_SBN_Client_InitAsync_FailsWhenThreadCreateFails(void)
+{
+    /* Arrange */
+    int ready_fd = 0;
+    
+    pthread_create_errors_on_call_number = FIRST_CALL;
+    pthread_create_error_value = Any_int_Except(0);
+    use_wrap_check_pthread_create_status = TRUE;
+    wrap_check_pthread_create_status_fail_call = TRUE;
+    check_pthread_create_status_errors_on_call_number = FIRST_CALL;
+    
+    /* Act */ 
+    int32 result = SBN_Client_InitAsync(NULL, NULL, &ready_fd);
+
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_INIT_THREAD_CREATE_EID, 
+      "SBN_Client_InitAsync result should be %d, but was %d", 
+      SBN_CLIENT_INIT_THREAD_CREATE_EID, result);
+    UtAssert_True(ready_fd == -1, "SBN_Client_InitAsync gave no ready fd");
+}
+/* end SBN_Client_InitAsync Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_Shutdown Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_Shutdown_JoinsThreadsAndClosesSocket(void)
+{
+    /* Arrange */
+    int  fds[2];
+    char byte;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = fds[0];
+    use_wrap_CFE_SBN_Client_InitPipeTbl = TRUE;
+    pthread_create_errors_on_call_number = 0;
+    use_wrap_check_pthread_create_status = TRUE;
+    wrap_check_pthread_create_status_fail_call = FALSE;
+    
+    SBN_Client_Init();
+
+    /* Act */ 
+    SBN_Client_Shutdown();
+
+    /* Assert */
+    UtAssert_True(pthread_join_call_number == 2, 
+      "SBN_Client_Shutdown should join 2 threads and joined %d", 
+      pthread_join_call_number);
+    UtAssert_True(continue_heartbeat == FALSE && 
+      continue_receive_check == FALSE, 
+      "SBN_Client_Shutdown stopped the minders");
+    UtAssert_True(sbn_client_sockfd == 0, 
+      "SBN_Client_Shutdown cleared sbn_client_sockfd");
+    UtAssert_True(read(fds[1], &byte, 1) == 0, 
+      "SBN end of the connection should see it closed");
+    
+    close(fds[1]);
+}
+
+void Test_SBN_Client_Shutdown_JoinsNothingWhenNotStarted(void)
+{
+    /* Arrange */
+    sbn_client_sockfd = 0;
+
+    /* Act */ 
+    SBN_Client_Shutdown();
+
+    /* Assert */
+    UtAssert_True(pthread_join_call_number == 0, 
+      "SBN_Client_Shutdown should join no threads and joined %d", 
+      pthread_join_call_number);
+}
+/* end SBN_Client_Shutdown Tests */
+
 
 /*************************************************/
 
@@ -173,4 +344,36 @@ void UtTest_Setup(void)
       Test_SBN_Client_Init_Success, 
       SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
       "Test_SBN_Client_Init_Success");
+    UtTest_Add(
+      Test_SBN_Client_Init_RetriesRefusedConnect, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_Init_RetriesRefusedConnect");
+    UtTest_Add(
+      Test_SBN_Client_Init_GivesUpAfterConnectAttempts, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_Init_GivesUpAfterConnectAttempts");
+    UtTest_Add(
+      Test_SBN_Client_Init_DoesNotRetrySocketError, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_Init_DoesNotRetrySocketError");
+    
+    /* SBN_Client_InitAsync Tests */
+    UtTest_Add(
+      Test_SBN_Client_InitAsync_StartsInitThread, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_InitAsync_StartsInitThread");
+    UtTest_Add(
+      Test_SBN_Client_InitAsync_FailsWhenThreadCreateFails, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_InitAsync_FailsWhenThreadCreateFails");
+    
+    /* SBN_Client_Shutdown Tests */
+    UtTest_Add(
+      Test_SBN_Client_Shutdown_JoinsThreadsAndClosesSocket, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_Shutdown_JoinsThreadsAndClosesSocket");
+    UtTest_Add(
+      Test_SBN_Client_Shutdown_JoinsNothingWhenNotStarted, 
+      SBN_Client_Init_Setup, SBN_Client_Init_Teardown, 
+      "Test_SBN_Client_Shutdown_JoinsNothingWhenNotStarted");
 }
\ No newline at end of file
@@ -0,0 +1,262 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/*******************************************************************************
+**
+**  SBN_Client_Interest_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Interest_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+} /* end SBN_Client_Interest_Tests_Setup */
+
+void SBN_Client_Interest_Tests_Teardown(void)
+{
+    SBN_Client_Teardown();
+} /* end SBN_Client_Interest_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_RemoteWants Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_RemoteWants_EverythingBeforeSbnAnnounces(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+
+    /* Act */
+    boolean result = CFE_SBN_Client_RemoteWants(msg_id);
+
+    /* Assert */
+    UtAssert_True(result == TRUE,
+      "MsgId 0x%04X should be wanted before SBN announces anything", msg_id);
+} /* end Test_CFE_SBN_Client_RemoteWants_EverythingBeforeSbnAnnounces */
+
+void Test_CFE_SBN_Client_RemoteWants_OnlyAnnouncedMsgIds(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t announced[2] = {0x1800, 0x1801};
+
+    CFE_SBN_Client_AddRemoteInterest(announced, 2);
+
+    /* Act */
+    boolean first = CFE_SBN_Client_RemoteWants(0x1800);
+    boolean second = CFE_SBN_Client_RemoteWants(0x1801);
+    boolean other = CFE_SBN_Client_RemoteWants(0x1802);
+
+    /* Assert */
+    UtAssert_True(first == TRUE && second == TRUE,
+      "Announced MsgIds should be wanted");
+    UtAssert_True(other == FALSE,
+      "A MsgId SBN did not announce should not be wanted");
+} /* end Test_CFE_SBN_Client_RemoteWants_OnlyAnnouncedMsgIds */
+
+void Test_CFE_SBN_Client_RemoteWants_NothingAfterEmptyAnnouncement(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_AddRemoteInterest(NULL, 0);
+
+    /* Act */
+    boolean result = CFE_SBN_Client_RemoteWants(0x1800);
+
+    /* Assert */
+    UtAssert_True(result == FALSE,
+      "No MsgId should be wanted once SBN announced no subscriptions");
+} /* end Test_CFE_SBN_Client_RemoteWants_NothingAfterEmptyAnnouncement */
+
+/* end CFE_SBN_Client_RemoteWants Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_AddRemoteInterest Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_AddRemoteInterest_WantsEverythingWhenFull(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t announced[SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE];
+    int i;
+
+    for(i = 0; i < SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE; i++)
+    {
+        announced[i] = 0x0800 + i;
+    }
+
+    /* Act */
+    CFE_SBN_Client_AddRemoteInterest(announced,
+                                     SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE);
+
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_RemoteWants(0x0100) == TRUE,
+      "Every MsgId should be wanted once an announcement did not fit");
+} /* end Test_CFE_SBN_Client_AddRemoteInterest_WantsEverythingWhenFull */
+
+/* end CFE_SBN_Client_AddRemoteInterest Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_RemoveRemoteInterest Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_RemoveRemoteInterest_KeepsOtherMsgIds(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t announced[SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE / 2];
+    CFE_SB_MsgId_t removed[SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE / 4];
+    int num_announced = SBN_CLIENT_REMOTE_INTEREST_MAP_SIZE / 2;
+    int i;
+
+    for(i = 0; i < num_announced; i++)
+    {
+        announced[i] = 0x0800 + i;
+    }
+
+    /* every other MsgId goes, leaving gaps in the probe sequences */
+    for(i = 0; i < num_announced / 2; i++)
+    {
+        removed[i] = announced[2 * i];
+    }
+
+    CFE_SBN_Client_AddRemoteInterest(announced, num_announced);
+
+    /* Act */
+    CFE_SBN_Client_RemoveRemoteInterest(removed, num_announced / 2);
+
+    /* Assert */
+    for(i = 0; i < num_announced; i++)
+    {
+        UtAssert_True(CFE_SBN_Client_RemoteWants(announced[i]) == (i % 2),
+          "MsgId 0x%04X should %sbe wanted", announced[i],
+          i % 2 ? "" : "not ");
+    }
+} /* end Test_CFE_SBN_Client_RemoveRemoteInterest_KeepsOtherMsgIds */
+
+/* end CFE_SBN_Client_RemoveRemoteInterest Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_LoseRemoteInterest and ResetRemoteInterest Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_LoseRemoteInterest_WantsEverythingUntilReset(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t announced = 0x1800;
+    boolean lost_wants, later_wants;
+
+    CFE_SBN_Client_AddRemoteInterest(&announced, 1);
+
+    /* Act */
+    CFE_SBN_Client_LoseRemoteInterest();
+    lost_wants = CFE_SBN_Client_RemoteWants(0x1801);
+    CFE_SBN_Client_AddRemoteInterest(&announced, 1);
+    later_wants = CFE_SBN_Client_RemoteWants(0x1801);
+
+    /* Assert */
+    UtAssert_True(lost_wants == TRUE && later_wants == TRUE,
+      "Every MsgId should be wanted until the next connection");
+} /* end Test_CFE_SBN_Client_LoseRemoteInterest_WantsEverythingUntilReset */
+
+void Test_CFE_SBN_Client_ResetRemoteInterest_ForgetsAnnouncements(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t announced = 0x1800;
+    CFE_SB_MsgId_t announced_again = 0x1801;
+
+    CFE_SBN_Client_AddRemoteInterest(&announced, 1);
+
+    /* Act */
+    CFE_SBN_Client_ResetRemoteInterest();
+    CFE_SBN_Client_AddRemoteInterest(&announced_again, 1);
+
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_RemoteWants(announced) == FALSE,
+      "MsgId 0x%04X was announced to the old connection only", announced);
+    UtAssert_True(CFE_SBN_Client_RemoteWants(announced_again) == TRUE,
+      "MsgId 0x%04X was announced to the new connection", announced_again);
+} /* end Test_CFE_SBN_Client_ResetRemoteInterest_ForgetsAnnouncements */
+
+/* end CFE_SBN_Client_LoseRemoteInterest and ResetRemoteInterest Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_CFE_SBN_Client_RemoteWants_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_RemoteWants_EverythingBeforeSbnAnnounces,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_RemoteWants_EverythingBeforeSbnAnnounces");
+    UtTest_Add(Test_CFE_SBN_Client_RemoteWants_OnlyAnnouncedMsgIds,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_RemoteWants_OnlyAnnouncedMsgIds");
+    UtTest_Add(Test_CFE_SBN_Client_RemoteWants_NothingAfterEmptyAnnouncement,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_RemoteWants_NothingAfterEmptyAnnouncement");
+} /* end add_CFE_SBN_Client_RemoteWants_tests */
+
+void add_CFE_SBN_Client_AddRemoteInterest_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_AddRemoteInterest_WantsEverythingWhenFull,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_AddRemoteInterest_WantsEverythingWhenFull");
+} /* end add_CFE_SBN_Client_AddRemoteInterest_tests */
+
+void add_CFE_SBN_Client_RemoveRemoteInterest_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_RemoveRemoteInterest_KeepsOtherMsgIds,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_RemoveRemoteInterest_KeepsOtherMsgIds");
+} /* end add_CFE_SBN_Client_RemoveRemoteInterest_tests */
+
+void add_CFE_SBN_Client_LoseAndResetRemoteInterest_tests(void)
+{
+    UtTest_Add(
+      Test_CFE_SBN_Client_LoseRemoteInterest_WantsEverythingUntilReset,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_LoseRemoteInterest_WantsEverythingUntilReset");
+    UtTest_Add(Test_CFE_SBN_Client_ResetRemoteInterest_ForgetsAnnouncements,
+      SBN_Client_Interest_Tests_Setup, SBN_Client_Interest_Tests_Teardown,
+      "Test_CFE_SBN_Client_ResetRemoteInterest_ForgetsAnnouncements");
+} /* end add_CFE_SBN_Client_LoseAndResetRemoteInterest_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_CFE_SBN_Client_RemoteWants_tests();
+
+    add_CFE_SBN_Client_AddRemoteInterest_tests();
+
+    add_CFE_SBN_Client_RemoveRemoteInterest_tests();
+
+    add_CFE_SBN_Client_LoseAndResetRemoteInterest_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
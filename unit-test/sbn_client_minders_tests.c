@@ -23,10 +23,15 @@
 void SBN_Client_Minders_Tests_Setup(void)
 {
     SBN_Client_Setup();
+    
+    /* the event loop reads its timer and stop descriptors for real */
+    wrap_read_return_value = INT_MIN;
 }
 
 void SBN_Client_Minders_Tests_Teardown(void)
 {
+    SBN_Client_SetLinkCallback(NULL, NULL);
+    SBN_Client_EventLoopClose();
     SBN_Client_Teardown();
 }
 
@@ -35,6 +40,28 @@ void wrap_log_message_set_continue_recv_check_false(void)
     continue_receive_check = FALSE;
 }
 
+/* link states the client reported, in order */
+boolean link_states[4];
+int     num_link_states = 0;
+
+/* records the link state and stops the minders once the link is back */
+void Stop_When_Link_Is_Up(boolean LinkUp, void *CallbackArg)
+{
+    link_states[num_link_states++] = LinkUp;
+    
+    if (LinkUp)
+    {
+        continue_receive_check = FALSE;
+    }
+}
+
+/* records the link state and stops the minders as soon as the link is lost */
+void Stop_When_Link_Is_Lost(boolean LinkUp, void *CallbackArg)
+{
+    link_states[num_link_states++] = LinkUp;
+    continue_receive_check = FALSE;
+}
+
 void Test_SBN_Client_HeartbeatMinder_NoLoopContinueHeartbeatFalse(void)
 {
     /* Arrange */
@@ -116,6 +143,8 @@ void Test_SBN_Client_ReceiveMinder_Outlog_messageError(void)
     log_message_expected_string = err_msg;
     wrap_log_message_call_func = 
       &wrap_log_message_set_continue_recv_check_false;
+    /* the errors lose the link, stop rather than reconnect */
+    SBN_Client_SetLinkCallback(Stop_When_Link_Is_Lost, NULL);
     
     /* Act */
     result = SBN_Client_ReceiveMinder(NULL);
@@ -144,6 +173,269 @@ void Test_SBN_Client_ReceiveMinder_RunsUntilContinueReceiveCheckIsFalse(void)
       "recv_msg was called the expected number of times");
 }
 
+/* SBN end of the connection for the event loop tests */
+int sbn_end_fd = -1;
+
+void Open_Event_Loop_On_Socket_Pair(void)
+{
+    int fds[2];
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    sbn_end_fd = fds[1];
+    
+    SBN_Client_EventLoopOpen(sbn_client_sockfd);
+}
+
+void Close_Socket_Pair(void)
+{
+    close(sbn_client_sockfd);
+    close(sbn_end_fd);
+    sbn_client_sockfd = 0;
+    sbn_end_fd = -1;
+}
+
+void Test_SBN_Client_EventLoopOpen_FailsWithBadSocket(void)
+{
+    /* Arrange */
+    int32 result;
+    
+    /* Act */
+    result = SBN_Client_EventLoopOpen(-1);
+    
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_EVENT_LOOP_CREATE_EID, 
+      "SBN_Client_EventLoopOpen result should be %d and was %d", 
+      SBN_CLIENT_EVENT_LOOP_CREATE_EID, result);
+}
+
+void Test_SBN_Client_EventLoop_SendsHeartbeatWhenTimerExpires(void)
+{
+    /* Arrange */
+    void * result;
+    
+    Open_Event_Loop_On_Socket_Pair();
+    
+    use_wrap_send_heartbeat = TRUE;
+    send_heartbeat_discontinue_on_call_number = 1;
+    
+    /* Act */
+    result = SBN_Client_EventLoop(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_EventLoop returned NULL");
+    UtAssert_True(send_hearbeat_call_number == 1,
+      "send_heartbeat should be called once and was called %d times", 
+      send_hearbeat_call_number);
+    
+    Close_Socket_Pair();
+}
+
+void Test_SBN_Client_EventLoop_ReceivesWhenSocketIsReadable(void)
+{
+    /* Arrange */
+    void * result;
+    char byte = 0;
+    
+    Open_Event_Loop_On_Socket_Pair();
+    write(sbn_end_fd, &byte, 1);
+    
+    use_wrap_send_heartbeat = TRUE;
+    use_wrap_recv_msg = TRUE;
+    wrap_recv_msg_return_value = CFE_SUCCESS;
+    recv_msg_discontiue_on_call_number = 1;
+    
+    /* Act */
+    result = SBN_Client_EventLoop(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_EventLoop returned NULL");
+    UtAssert_True(recv_msg_call_number == 1,
+      "recv_msg should be called once and was called %d times", 
+      recv_msg_call_number);
+    
+    Close_Socket_Pair();
+}
+
+void Test_SBN_Client_ReceiveMinder_ReconnectsAfterConsecutiveReceiveErrors(void)
+{
+    /* Arrange */
+    void * result;
+    int    new_fds[2];
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, new_fds);
+    
+    use_wrap_recv_msg = TRUE;
+    wrap_recv_msg_return_value = CFE_SBN_CLIENT_PIPE_CLOSED_ERR;
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = new_fds[0];
+    
+    num_link_states = 0;
+    SBN_Client_SetLinkCallback(Stop_When_Link_Is_Up, NULL);
+    
+    /* Act */
+    result = SBN_Client_ReceiveMinder(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_ReceiveMinder returned NULL");
+    UtAssert_True(recv_msg_call_number == 5,
+      "recv_msg should be called 5 times and was called %d times", 
+      recv_msg_call_number);
+    UtAssert_True(connect_to_server_call_number == 1,
+      "connect_to_server should be called once and was called %d times", 
+      connect_to_server_call_number);
+    UtAssert_True(sbn_client_sockfd == new_fds[0],
+      "sbn_client_sockfd should be %d and was %d", new_fds[0], 
+      sbn_client_sockfd);
+    UtAssert_True(num_link_states == 2 && link_states[0] == FALSE && 
+      link_states[1] == TRUE, "link should be reported lost then back");
+    UtAssert_True(continue_heartbeat == TRUE, 
+      "heartbeats should go on after reconnecting");
+    
+    close(new_fds[0]);
+    close(new_fds[1]);
+    sbn_client_sockfd = 0;
+}
+
+void Test_SBN_Client_ReceiveMinder_ReconnectsAtOnceWhenFrameTimesOut(void)
+{
+    /* Arrange */
+    void * result;
+    int    new_fds[2];
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, new_fds);
+    
+    use_wrap_recv_msg = TRUE;
+    wrap_recv_msg_return_value = CFE_SBN_CLIENT_READ_TIMEOUT_ERR;
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = new_fds[0];
+    
+    num_link_states = 0;
+    SBN_Client_SetLinkCallback(Stop_When_Link_Is_Up, NULL);
+    
+    /* Act */
+    result = SBN_Client_ReceiveMinder(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_ReceiveMinder returned NULL");
+    UtAssert_True(recv_msg_call_number == 1,
+      "recv_msg should be called once and was called %d times", 
+      recv_msg_call_number);
+    UtAssert_True(connect_to_server_call_number == 1,
+      "connect_to_server should be called once and was called %d times", 
+      connect_to_server_call_number);
+    
+    close(new_fds[0]);
+    close(new_fds[1]);
+    sbn_client_sockfd = 0;
+}
+
+void Test_SBN_Client_EventLoop_ReconnectsOntoSameSocketAfterReceiveErrors(void)
+{
+    /* Arrange */
+    void * result;
+    int    old_fd;
+    int    new_fds[2];
+    char   byte = 0;
+    
+    Open_Event_Loop_On_Socket_Pair();
+    write(sbn_end_fd, &byte, 1);
+    old_fd = sbn_client_sockfd;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, new_fds);
+    
+    use_wrap_send_heartbeat = TRUE;
+    use_wrap_recv_msg = TRUE;
+    wrap_recv_msg_return_value = CFE_SBN_CLIENT_PIPE_BROKEN_ERR;
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = new_fds[0];
+    
+    num_link_states = 0;
+    SBN_Client_SetLinkCallback(Stop_When_Link_Is_Up, NULL);
+    
+    /* Act */
+    result = SBN_Client_EventLoop(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_EventLoop returned NULL");
+    UtAssert_True(recv_msg_call_number == 5,
+      "recv_msg should be called 5 times and was called %d times", 
+      recv_msg_call_number);
+    UtAssert_True(sbn_client_sockfd == old_fd,
+      "sbn_client_sockfd should stay %d and was %d", old_fd, 
+      sbn_client_sockfd);
+    UtAssert_True(write(new_fds[1], &byte, 1) == 1 && 
+      read(sbn_client_sockfd, &byte, 1) == 1, 
+      "sbn_client_sockfd should now be the new connection");
+    UtAssert_True(num_link_states == 2 && link_states[0] == FALSE && 
+      link_states[1] == TRUE, "link should be reported lost then back");
+    
+    close(new_fds[0]);
+    close(new_fds[1]);
+    Close_Socket_Pair();
+}
+
+void Test_SBN_Client_EventLoop_StopsWhenStoppedWhileReconnecting(void)
+{
+    /* Arrange */
+    void * result;
+    char byte = 0;
+    
+    Open_Event_Loop_On_Socket_Pair();
+    write(sbn_end_fd, &byte, 1);
+    
+    use_wrap_send_heartbeat = TRUE;
+    use_wrap_recv_msg = TRUE;
+    wrap_recv_msg_return_value = CFE_SBN_CLIENT_PIPE_BROKEN_ERR;
+    use_wrap_connect_to_server = TRUE;
+    wrap_connect_to_server_return_value = SERVER_CONNECT_ERROR;
+    
+    num_link_states = 0;
+    SBN_Client_SetLinkCallback(Stop_When_Link_Is_Lost, NULL);
+    
+    /* Act */
+    result = SBN_Client_EventLoop(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_EventLoop returned NULL");
+    UtAssert_True(connect_to_server_call_number == 0,
+      "connect_to_server should not be called and was called %d times", 
+      connect_to_server_call_number);
+    UtAssert_True(num_link_states == 1 && link_states[0] == FALSE, 
+      "link should be reported lost");
+    UtAssert_True(continue_heartbeat == FALSE, 
+      "giving up reconnecting should also stop heartbeats");
+    
+    Close_Socket_Pair();
+}
+
+void Test_SBN_Client_EventLoop_ExitsWhenStopped(void)
+{
+    /* Arrange */
+    void * result;
+    
+    Open_Event_Loop_On_Socket_Pair();
+    
+    use_wrap_send_heartbeat = TRUE;
+    use_wrap_recv_msg = TRUE;
+    
+    SBN_Client_EventLoopStop();
+    
+    /* Act */
+    result = SBN_Client_EventLoop(NULL);
+    
+    /* Assert */
+    UtAssert_True(result == NULL, "SBN_Client_EventLoop returned NULL");
+    UtAssert_True(continue_heartbeat == FALSE && 
+      continue_receive_check == FALSE, 
+      "SBN_Client_EventLoop cleared both continue flags");
+    UtAssert_True(recv_msg_call_number == 0,
+      "recv_msg should not be called and was called %d times", 
+      recv_msg_call_number);
+    
+    Close_Socket_Pair();
+}
+
 void UtTest_Setup(void)
 {
     UtTest_Add(
@@ -174,4 +466,37 @@ void UtTest_Setup(void)
       Test_SBN_Client_ReceiveMinder_RunsUntilContinueReceiveCheckIsFalse,
       SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
       "Test_SBN_Client_ReceiveMinder_RunsUntilContinueReceiveCheckIsFalse");
+    UtTest_Add(
+      Test_SBN_Client_ReceiveMinder_ReconnectsAfterConsecutiveReceiveErrors,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_ReceiveMinder_ReconnectsAfterConsecutiveReceiveErrors");
+    UtTest_Add(
+      Test_SBN_Client_ReceiveMinder_ReconnectsAtOnceWhenFrameTimesOut,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_ReceiveMinder_ReconnectsAtOnceWhenFrameTimesOut");
+
+    UtTest_Add(
+      Test_SBN_Client_EventLoopOpen_FailsWithBadSocket,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_EventLoopOpen_FailsWithBadSocket");
+    UtTest_Add(
+      Test_SBN_Client_EventLoop_SendsHeartbeatWhenTimerExpires,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_EventLoop_SendsHeartbeatWhenTimerExpires");
+    UtTest_Add(
+      Test_SBN_Client_EventLoop_ReceivesWhenSocketIsReadable,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_EventLoop_ReceivesWhenSocketIsReadable");
+    UtTest_Add(
+      Test_SBN_Client_EventLoop_ReconnectsOntoSameSocketAfterReceiveErrors,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_EventLoop_ReconnectsOntoSameSocketAfterReceiveErrors");
+    UtTest_Add(
+      Test_SBN_Client_EventLoop_StopsWhenStoppedWhileReconnecting,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_EventLoop_StopsWhenStoppedWhileReconnecting");
+    UtTest_Add(
+      Test_SBN_Client_EventLoop_ExitsWhenStopped,
+      SBN_Client_Minders_Tests_Setup, SBN_Client_Minders_Tests_Teardown,
+      "Test_SBN_Client_EventLoop_ExitsWhenStopped");
 }
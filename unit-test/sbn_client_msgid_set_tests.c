@@ -0,0 +1,248 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/*******************************************************************************
+**
+**  SBN_Client_MsgIdSet_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+#define TEST_SET_SIZE   16
+
+typedef struct {
+    CFE_SB_MsgId_t MsgId;
+    uint32         Value;
+} Test_Entry_t;
+
+Test_Entry_t              test_entries[TEST_SET_SIZE];
+CFE_SBN_Client_MsgIdSet_t test_set = {
+    test_entries, sizeof(Test_Entry_t), TEST_SET_SIZE, 0
+};
+
+void SBN_Client_MsgIdSet_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+
+    memset(test_entries, 0xFF, sizeof(test_entries));
+    CFE_SBN_Client_MsgIdSetClear(&test_set);
+} /* end SBN_Client_MsgIdSet_Tests_Setup */
+
+void SBN_Client_MsgIdSet_Tests_Teardown(void)
+{
+    SBN_Client_Teardown();
+} /* end SBN_Client_MsgIdSet_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_MsgIdSetInsert and CFE_SBN_Client_MsgIdSetFind Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_MsgIdSetInsert_EntryIsFoundWithItsValue(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    Test_Entry_t *inserted;
+
+    /* Act */
+    inserted = CFE_SBN_Client_MsgIdSetInsert(&test_set, msg_id);
+    inserted->Value = msg_id;
+
+    /* Assert */
+    UtAssert_True(inserted->MsgId == msg_id,
+      "The entry should hold MsgId 0x%04X", msg_id);
+    UtAssert_True(CFE_SBN_Client_MsgIdSetFind(&test_set, msg_id) == inserted,
+      "MsgId 0x%04X should be found at its entry", msg_id);
+    UtAssert_True(CFE_SBN_Client_MsgIdSetFind(&test_set, msg_id + 1) == NULL,
+      "A MsgId not inserted should not be found");
+} /* end Test_CFE_SBN_Client_MsgIdSetInsert_EntryIsFoundWithItsValue */
+
+void Test_CFE_SBN_Client_MsgIdSetInsert_StartsEntriesZeroed(void)
+{
+    /* Arrange */
+    /* Act */
+    Test_Entry_t *inserted = CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x1800);
+
+    /* Assert */
+    UtAssert_True(inserted->Value == 0,
+      "A new entry's value is %u and should be 0", inserted->Value);
+} /* end Test_CFE_SBN_Client_MsgIdSetInsert_StartsEntriesZeroed */
+
+void Test_CFE_SBN_Client_MsgIdSetInsert_KeepsExistingEntry(void)
+{
+    /* Arrange */
+    Test_Entry_t *inserted = CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x1800);
+
+    inserted->Value = 42;
+
+    /* Act */
+    Test_Entry_t *again = CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x1800);
+
+    /* Assert */
+    UtAssert_True(again == inserted && again->Value == 42,
+      "Inserting a MsgId again should return its entry unchanged");
+    UtAssert_True(test_set.Count == 1,
+      "The set holds %u MsgIds and should hold 1", test_set.Count);
+} /* end Test_CFE_SBN_Client_MsgIdSetInsert_KeepsExistingEntry */
+
+void Test_CFE_SBN_Client_MsgIdSetInsert_FailsWhenSetIsFull(void)
+{
+    /* Arrange */
+    int i;
+
+    /* one slot is always kept empty */
+    for(i = 0; i < TEST_SET_SIZE - 1; i++)
+    {
+        CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x0800 + i);
+    }
+
+    /* Act */
+    void *result = CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x1F00);
+
+    /* Assert */
+    UtAssert_True(result == NULL,
+      "CFE_SBN_Client_MsgIdSetInsert should return NULL for a full set");
+    UtAssert_True(CFE_SBN_Client_MsgIdSetFind(&test_set, 0x1F00) == NULL,
+      "The MsgId that did not fit should not be found");
+} /* end Test_CFE_SBN_Client_MsgIdSetInsert_FailsWhenSetIsFull */
+
+void Test_CFE_SBN_Client_MsgIdSetInsert_RefusesInvalidMsgId(void)
+{
+    /* Arrange */
+    /* Act */
+    void *result = CFE_SBN_Client_MsgIdSetInsert(&test_set,
+                                                 CFE_SBN_CLIENT_INVALID_MSG_ID);
+
+    /* Assert */
+    UtAssert_True(result == NULL,
+      "CFE_SBN_Client_MsgIdSetInsert should return NULL for the MsgId "
+      "marking empty entries");
+} /* end Test_CFE_SBN_Client_MsgIdSetInsert_RefusesInvalidMsgId */
+
+/* end CFE_SBN_Client_MsgIdSetInsert and CFE_SBN_Client_MsgIdSetFind Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_MsgIdSetRemove Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_MsgIdSetRemove_OtherEntriesKeepTheirValues(void)
+{
+    /* Arrange */
+    Test_Entry_t *entry;
+    boolean all_found = TRUE;
+    int num_inserted = TEST_SET_SIZE - 1;
+    int i;
+
+    /* a full set, so every probe sequence runs into others */
+    for(i = 0; i < num_inserted; i++)
+    {
+        entry = CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x0800 + i);
+        entry->Value = 0x0800 + i;
+    }
+
+    /* Act */
+    for(i = 0; i < num_inserted; i += 2)
+    {
+        CFE_SBN_Client_MsgIdSetRemove(&test_set, 0x0800 + i);
+    }
+
+    /* Assert */
+    for(i = 0; i < num_inserted; i++)
+    {
+        entry = CFE_SBN_Client_MsgIdSetFind(&test_set, 0x0800 + i);
+
+        if ((i % 2 == 0) != (entry == NULL) ||
+            (entry != NULL && entry->Value != 0x0800 + i))
+        {
+            all_found = FALSE;
+        }
+    }
+
+    UtAssert_True(all_found,
+      "Only the MsgIds left should be found, each with its own value");
+    UtAssert_True(test_set.Count == num_inserted / 2,
+      "The set holds %u MsgIds and should hold %d", test_set.Count,
+      num_inserted / 2);
+} /* end Test_CFE_SBN_Client_MsgIdSetRemove_OtherEntriesKeepTheirValues */
+
+void Test_CFE_SBN_Client_MsgIdSetRemove_FalseForMsgIdNotHeld(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_MsgIdSetInsert(&test_set, 0x1800);
+
+    /* Act */
+    boolean result = CFE_SBN_Client_MsgIdSetRemove(&test_set, 0x1801);
+
+    /* Assert */
+    UtAssert_True(result == FALSE,
+      "CFE_SBN_Client_MsgIdSetRemove should be FALSE for a MsgId not held");
+    UtAssert_True(CFE_SBN_Client_MsgIdSetFind(&test_set, 0x1800) != NULL,
+      "The MsgId held should still be found");
+} /* end Test_CFE_SBN_Client_MsgIdSetRemove_FalseForMsgIdNotHeld */
+
+/* end CFE_SBN_Client_MsgIdSetRemove Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_CFE_SBN_Client_MsgIdSetInsert_and_MsgIdSetFind_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetInsert_EntryIsFoundWithItsValue,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetInsert_EntryIsFoundWithItsValue");
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetInsert_StartsEntriesZeroed,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetInsert_StartsEntriesZeroed");
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetInsert_KeepsExistingEntry,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetInsert_KeepsExistingEntry");
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetInsert_FailsWhenSetIsFull,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetInsert_FailsWhenSetIsFull");
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetInsert_RefusesInvalidMsgId,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetInsert_RefusesInvalidMsgId");
+} /* end add_CFE_SBN_Client_MsgIdSetInsert_and_MsgIdSetFind_tests */
+
+void add_CFE_SBN_Client_MsgIdSetRemove_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetRemove_OtherEntriesKeepTheirValues,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetRemove_OtherEntriesKeepTheirValues");
+    UtTest_Add(Test_CFE_SBN_Client_MsgIdSetRemove_FalseForMsgIdNotHeld,
+      SBN_Client_MsgIdSet_Tests_Setup, SBN_Client_MsgIdSet_Tests_Teardown,
+      "Test_CFE_SBN_Client_MsgIdSetRemove_FalseForMsgIdNotHeld");
+} /* end add_CFE_SBN_Client_MsgIdSetRemove_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_CFE_SBN_Client_MsgIdSetInsert_and_MsgIdSetFind_tests();
+
+    add_CFE_SBN_Client_MsgIdSetRemove_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
@@ -0,0 +1,334 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/*******************************************************************************
+**
+**  SBN_Client_Routing_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Routing_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+} /* end SBN_Client_Routing_Tests_Setup */
+
+void SBN_Client_Routing_Tests_Teardown(void)
+{
+    SBN_Client_Teardown();
+} /* end SBN_Client_Routing_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_AddRoute Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_AddRoute_MsgIdRoutesToEverySubscribedPipe(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint16 num_routes;
+    int i;
+    
+    /* Act */ 
+    for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPES; i++)
+    {
+        CFE_SBN_Client_AddRoute(msg_id, i);
+    }
+    
+    num_routes = CFE_SBN_Client_GetRoutes(msg_id, routes, gens);
+    
+    /* Assert */
+    UtAssert_True(num_routes == CFE_PLATFORM_SBN_CLIENT_MAX_PIPES, 
+      "CFE_SBN_Client_GetRoutes should return %d pipes and returned %d", 
+      CFE_PLATFORM_SBN_CLIENT_MAX_PIPES, num_routes);
+      
+    for(i = 0; i < num_routes; i++)
+    {
+        UtAssert_True(routes[i] == i, "routes[%d] should be %d and was %d", 
+          i, i, routes[i]);
+    }
+    
+} /* end Test_CFE_SBN_Client_AddRoute_MsgIdRoutesToEverySubscribedPipe */
+
+void Test_CFE_SBN_Client_AddRoute_DuplicateRouteIsIgnored(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    uint8 pipe_idx = Any_CFE_SB_PipeId_t();
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint16 num_routes;
+    
+    CFE_SBN_Client_AddRoute(msg_id, pipe_idx);
+    
+    /* Act */ 
+    int32 result = CFE_SBN_Client_AddRoute(msg_id, pipe_idx);
+    
+    /* Assert */
+    num_routes = CFE_SBN_Client_GetRoutes(msg_id, routes, gens);
+    
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+      "CFE_SBN_Client_AddRoute should return %d and returned %d", 
+      SBN_CLIENT_SUCCESS, result);
+    UtAssert_True(num_routes == 1, 
+      "CFE_SBN_Client_GetRoutes should return 1 pipe and returned %d", 
+      num_routes);
+} /* end Test_CFE_SBN_Client_AddRoute_DuplicateRouteIsIgnored */
+
+void Test_CFE_SBN_Client_AddRoute_FailsWhenIndexIsFull(void)
+{
+    /* Arrange */
+    int i;
+    
+    /* one slot is always kept empty */
+    for(i = 0; i < CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE - 1; i++)
+    {
+        CFE_SBN_Client_AddRoute(0x0800 + i, 0);
+    }
+    
+    /* Act */ 
+    int32 result = CFE_SBN_Client_AddRoute(0x1F00, 0);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SB_MAX_MSGS_MET, 
+      "CFE_SBN_Client_AddRoute should return %d and returned %d", 
+      CFE_SB_MAX_MSGS_MET, result);
+} /* end Test_CFE_SBN_Client_AddRoute_FailsWhenIndexIsFull */
+
+/* end CFE_SBN_Client_AddRoute Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_RemoveRoute Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_RemoveRoute_OnlyRemovesGivenPipe(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint16 num_routes;
+    
+    CFE_SBN_Client_AddRoute(msg_id, 0);
+    CFE_SBN_Client_AddRoute(msg_id, 1);
+    
+    /* Act */ 
+    CFE_SBN_Client_RemoveRoute(msg_id, 0);
+    
+    /* Assert */
+    num_routes = CFE_SBN_Client_GetRoutes(msg_id, routes, gens);
+    
+    UtAssert_True(num_routes == 1 && routes[0] == 1, 
+      "MsgId 0x%04X should only route to pipe 1, had %d routes", msg_id, 
+      num_routes);
+} /* end Test_CFE_SBN_Client_RemoveRoute_OnlyRemovesGivenPipe */
+
+void Test_CFE_SBN_Client_RemoveRoute_OtherMsgIdsStayReachable(void)
+{
+    /* Arrange */
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    int i;
+    
+    /* enough MsgIds that some must share probe sequences */
+    for(i = 0; i < CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE / 2; i++)
+    {
+        CFE_SBN_Client_AddRoute(0x0800 + i, i % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES);
+    }
+    
+    /* Act */ 
+    for(i = 0; i < CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE / 2; i += 2)
+    {
+        CFE_SBN_Client_RemoveRoute(0x0800 + i, i % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES);
+    }
+    
+    /* Assert */
+    for(i = 0; i < CFE_SBN_CLIENT_MSG_ID_TO_PIPE_ID_MAP_SIZE / 2; i++)
+    {
+        uint16 expected = (i % 2 == 0) ? 0 : 1;
+        uint16 num_routes = CFE_SBN_Client_GetRoutes(0x0800 + i, routes, gens);
+        
+        UtAssert_True(num_routes == expected, 
+          "MsgId 0x%04X should have %d routes and had %d", 0x0800 + i, 
+          expected, num_routes);
+    }
+    
+} /* end Test_CFE_SBN_Client_RemoveRoute_OtherMsgIdsStayReachable */
+
+/* end CFE_SBN_Client_RemoveRoute Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_GetRoutes Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_GetRoutes_ReturnsZeroForUnsubscribedMsgId(void)
+{
+    /* Arrange */
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    
+    CFE_SBN_Client_AddRoute(0x1800, 0);
+    
+    /* Act */ 
+    uint16 num_routes = CFE_SBN_Client_GetRoutes(0x1801, routes, gens);
+    
+    /* Assert */
+    UtAssert_True(num_routes == 0, 
+      "CFE_SBN_Client_GetRoutes should return 0 and returned %d", num_routes);
+} /* end Test_CFE_SBN_Client_GetRoutes_ReturnsZeroForUnsubscribedMsgId */
+
+/* end CFE_SBN_Client_GetRoutes Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_RetainSbnSub and CFE_SBN_Client_ReleaseSbnSub Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_RetainSbnSub_OnlyFirstPipeIsFirst(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    boolean first, second;
+    
+    CFE_SBN_Client_AddRoute(msg_id, 0);
+    CFE_SBN_Client_AddRoute(msg_id, 1);
+    
+    /* Act */ 
+    first = CFE_SBN_Client_RetainSbnSub(msg_id);
+    second = CFE_SBN_Client_RetainSbnSub(msg_id);
+    
+    /* Assert */
+    UtAssert_True(first == TRUE, 
+      "CFE_SBN_Client_RetainSbnSub should be TRUE for the first pipe");
+    UtAssert_True(second == FALSE, 
+      "CFE_SBN_Client_RetainSbnSub should be FALSE for the second pipe");
+} /* end Test_CFE_SBN_Client_RetainSbnSub_OnlyFirstPipeIsFirst */
+
+void Test_CFE_SBN_Client_RetainSbnSub_FailsWithoutRoute(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    
+    /* Act */ 
+    boolean first = CFE_SBN_Client_RetainSbnSub(msg_id);
+    
+    /* Assert */
+    UtAssert_True(first == FALSE, 
+      "CFE_SBN_Client_RetainSbnSub should be FALSE for an unrouted MsgId");
+} /* end Test_CFE_SBN_Client_RetainSbnSub_FailsWithoutRoute */
+
+void Test_CFE_SBN_Client_ReleaseSbnSub_OnlyLastPipeIsLast(void)
+{
+    /* Arrange */
+    CFE_SB_MsgId_t msg_id = 0x1800 + (rand() % 0x100);
+    boolean first_release, last_release, extra_release;
+    
+    CFE_SBN_Client_AddRoute(msg_id, 0);
+    CFE_SBN_Client_AddRoute(msg_id, 1);
+    CFE_SBN_Client_RetainSbnSub(msg_id);
+    CFE_SBN_Client_RetainSbnSub(msg_id);
+    
+    /* Act */ 
+    first_release = CFE_SBN_Client_ReleaseSbnSub(msg_id);
+    last_release = CFE_SBN_Client_ReleaseSbnSub(msg_id);
+    extra_release = CFE_SBN_Client_ReleaseSbnSub(msg_id);
+    
+    /* Assert */
+    UtAssert_True(first_release == FALSE, 
+      "CFE_SBN_Client_ReleaseSbnSub should be FALSE while a pipe is left");
+    UtAssert_True(last_release == TRUE, 
+      "CFE_SBN_Client_ReleaseSbnSub should be TRUE for the last pipe");
+    UtAssert_True(extra_release == FALSE, 
+      "CFE_SBN_Client_ReleaseSbnSub should be FALSE with nothing to release");
+} /* end Test_CFE_SBN_Client_ReleaseSbnSub_OnlyLastPipeIsLast */
+
+/* end CFE_SBN_Client_RetainSbnSub and CFE_SBN_Client_ReleaseSbnSub Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_CFE_SBN_Client_AddRoute_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_AddRoute_MsgIdRoutesToEverySubscribedPipe, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_AddRoute_MsgIdRoutesToEverySubscribedPipe");
+    UtTest_Add(Test_CFE_SBN_Client_AddRoute_DuplicateRouteIsIgnored, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_AddRoute_DuplicateRouteIsIgnored");
+    UtTest_Add(Test_CFE_SBN_Client_AddRoute_FailsWhenIndexIsFull, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_AddRoute_FailsWhenIndexIsFull");
+} /* end add_CFE_SBN_Client_AddRoute_tests */
+
+void add_CFE_SBN_Client_RemoveRoute_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_RemoveRoute_OnlyRemovesGivenPipe, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_RemoveRoute_OnlyRemovesGivenPipe");
+    UtTest_Add(Test_CFE_SBN_Client_RemoveRoute_OtherMsgIdsStayReachable, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_RemoveRoute_OtherMsgIdsStayReachable");
+} /* end add_CFE_SBN_Client_RemoveRoute_tests */
+
+void add_CFE_SBN_Client_GetRoutes_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_GetRoutes_ReturnsZeroForUnsubscribedMsgId, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_GetRoutes_ReturnsZeroForUnsubscribedMsgId");
+} /* end add_CFE_SBN_Client_GetRoutes_tests */
+
+void add_CFE_SBN_Client_SbnSub_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_RetainSbnSub_OnlyFirstPipeIsFirst, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_RetainSbnSub_OnlyFirstPipeIsFirst");
+    UtTest_Add(Test_CFE_SBN_Client_RetainSbnSub_FailsWithoutRoute, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_RetainSbnSub_FailsWithoutRoute");
+    UtTest_Add(Test_CFE_SBN_Client_ReleaseSbnSub_OnlyLastPipeIsLast, 
+      SBN_Client_Routing_Tests_Setup, SBN_Client_Routing_Tests_Teardown, 
+      "Test_CFE_SBN_Client_ReleaseSbnSub_OnlyLastPipeIsLast");
+} /* end add_CFE_SBN_Client_SbnSub_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_CFE_SBN_Client_AddRoute_tests();
+    
+    add_CFE_SBN_Client_RemoveRoute_tests();
+    
+    add_CFE_SBN_Client_GetRoutes_tests();
+    
+    add_CFE_SBN_Client_SbnSub_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
@@ -0,0 +1,517 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/* SBN end of the connection the send queue writes to */
+int sbn_end_fd = -1;
+
+/* a 16 byte message with MsgId 0x1801, its length field 16 - 7 */
+unsigned char queued_msg[16] = { 0x18, 0x01, 0xC0, 0x00, 0x00, 0x09,
+                                 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                                 0x07, 0x08, 0x09, 0x0A };
+
+/* reads everything SBN has received so far into buf */
+ssize_t Read_What_SBN_Received(unsigned char *buf, size_t size)
+{
+    ssize_t received, total = 0;
+    
+    while ((received = recv(sbn_end_fd, &buf[total], size - total, 
+                            MSG_DONTWAIT)) > 0)
+    {
+        total += received;
+    }
+    
+    return total;
+}
+
+/*******************************************************************************
+**
+**  SBN_Client_Send_Queue_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Send_Queue_Tests_Setup(void)
+{
+    int fds[2];
+    
+    SBN_Client_Setup();
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    sbn_end_fd = fds[1];
+    
+    /* the pthread_create wrapper starts no writer, tests flush instead */
+    CFE_SBN_Client_SendQueueOpen();
+    
+    /* flushing, here or on close, sends to SBN under send_lock */
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+} /* end SBN_Client_Send_Queue_Tests_Setup */
+
+void SBN_Client_Send_Queue_Tests_Teardown(void)
+{
+    CFE_SBN_Client_SendQueueClose();
+    SBN_Client_SetSendQueuePolicy(SBN_CLIENT_SEND_QUEUE_FULL_POLICY, 
+      SBN_CLIENT_SEND_LATENCY_US);
+    
+    close(sbn_client_sockfd);
+    close(sbn_end_fd);
+    sbn_end_fd = -1;
+    
+    SBN_Client_Teardown();
+} /* end SBN_Client_Send_Queue_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_SendQueuePut Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_SendQueuePut_QueuesCopyWithoutSending(void)
+{
+    /* Arrange */
+    unsigned char received[1];
+    int32 result;
+    
+    /* Act */
+    result = CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "CFE_SBN_Client_SendQueuePut returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(Read_What_SBN_Received(received, sizeof(received)) == 0, 
+      "Nothing should be sent until the writer flushes");
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1, 
+      "The queued copy should hold one buffer and %u are held", 
+      CFE_SBN_Client_BuffersInUse());
+} /* end Test_CFE_SBN_Client_SendQueuePut_QueuesCopyWithoutSending */
+
+void Test_CFE_SBN_Client_SendQueuePut_ReturnsFullErrorWhenPolicyIsEagain(void)
+{
+    /* Arrange */
+    uint32 queued = 0;
+    int32 result = CFE_SUCCESS;
+    
+    SBN_Client_SetSendQueuePolicy(SBN_CLIENT_SEND_QUEUE_EAGAIN, 0);
+    
+    /* Act */
+    while (result == CFE_SUCCESS && queued <= SBN_CLIENT_SEND_QUEUE_DEPTH)
+    {
+        result = CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+        
+        if (result == CFE_SUCCESS)
+        {
+            queued++;
+        }
+        
+    }
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR, 
+      "CFE_SBN_Client_SendQueuePut returned %d and should be %d", result, 
+      CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR);
+    UtAssert_True(queued > 0 && queued <= SBN_CLIENT_SEND_QUEUE_DEPTH, 
+      "%u messages queued before full, should be 1 to %d", queued, 
+      SBN_CLIENT_SEND_QUEUE_DEPTH);
+} /* end Test_CFE_SBN_Client_SendQueuePut_ReturnsFullErrorWhenPolicyIsEagain */
+
+void Test_CFE_SBN_Client_SendQueuePut_CountsDropWhenPolicyIsDrop(void)
+{
+    /* Arrange */
+    uint32 i, dropped_before, dropped_after, send_errors;
+    int32 result = CFE_SUCCESS;
+    
+    SBN_Client_SetSendQueuePolicy(SBN_CLIENT_SEND_QUEUE_DROP, 0);
+    SBN_Client_GetSendQueueCounts(&dropped_before, &send_errors);
+    
+    /* Act */
+    for (i = 0; i < SBN_CLIENT_SEND_QUEUE_DEPTH + 1 && result == CFE_SUCCESS;
+         i++)
+    {
+        result = CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+    }
+    
+    /* Assert */
+    SBN_Client_GetSendQueueCounts(&dropped_after, &send_errors);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "CFE_SBN_Client_SendQueuePut returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(dropped_after > dropped_before, 
+      "Messages for a full queue should be counted as dropped");
+} /* end Test_CFE_SBN_Client_SendQueuePut_CountsDropWhenPolicyIsDrop */
+
+/* end CFE_SBN_Client_SendQueuePut Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_SendQueueFlush Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_SendQueueFlush_SendsQueuedMessagesInOrder(void)
+{
+    /* Arrange */
+    uint32 i, count = SBN_CLIENT_MAX_SEND_BATCH + 3, sent_count;
+    size_t frame_size = SBN_PACKED_HDR_SZ + sizeof(queued_msg);
+    unsigned char msg[sizeof(queued_msg)];
+    unsigned char received[(SBN_CLIENT_MAX_SEND_BATCH + 3) * 
+                           (SBN_PACKED_HDR_SZ + sizeof(queued_msg)) + 1];
+    ssize_t received_size;
+    boolean in_order = TRUE;
+    
+    memcpy(msg, queued_msg, sizeof(msg));
+    
+    for (i = 0; i < count; i++)
+    {
+        msg[sizeof(msg) - 1] = i;
+        CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)msg);
+    }
+    
+    /* Act */
+    sent_count = CFE_SBN_Client_SendQueueFlush();
+    
+    /* Assert */
+    received_size = Read_What_SBN_Received(received, sizeof(received));
+    
+    for (i = 0; i < count; i++)
+    {
+        
+        if (received[i * frame_size + 2] != SBN_APP_MSG ||
+            received[(i + 1) * frame_size - 1] != i)
+        {
+            in_order = FALSE;
+        }
+        
+    }
+    
+    UtAssert_True(sent_count == count, 
+      "CFE_SBN_Client_SendQueueFlush sent %u and should have sent %u", 
+      sent_count, count);
+    UtAssert_True(received_size == count * frame_size, 
+      "SBN received %d bytes and should have received %d", 
+      (int)received_size, (int)(count * frame_size));
+    UtAssert_True(in_order, 
+      "SBN should receive every message, framed and in order");
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "Sent messages should give their buffers back");
+} /* end Test_CFE_SBN_Client_SendQueueFlush_SendsQueuedMessagesInOrder */
+
+void Test_CFE_SBN_Client_SendQueueFlush_CountsSendErrorsWhenSbnHasClosed(void)
+{
+    /* Arrange */
+    uint32 dropped, errors_before, errors_after, sent_count;
+    
+    CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+    CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+    SBN_Client_GetSendQueueCounts(&dropped, &errors_before);
+    close(sbn_end_fd);
+    sbn_end_fd = -1;
+    
+    /* Act */
+    sent_count = CFE_SBN_Client_SendQueueFlush();
+    
+    /* Assert */
+    SBN_Client_GetSendQueueCounts(&dropped, &errors_after);
+    
+    UtAssert_True(sent_count == 0, 
+      "CFE_SBN_Client_SendQueueFlush sent %u and should have sent 0", 
+      sent_count);
+    UtAssert_True(errors_after == errors_before + 2, 
+      "Send errors went from %u to %u and should have gone up by 2", 
+      errors_before, errors_after);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "Messages that failed to send should give their buffers back");
+} /* end Test_CFE_SBN_Client_SendQueueFlush_CountsSendErrorsWhenSbnHasClosed */
+
+/* end CFE_SBN_Client_SendQueueFlush Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_SendQueuePutBatch Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_SendQueuePutBatch_QueuesWholeBatchInOrder(void)
+{
+    /* Arrange */
+    uint32 i, count = 3, sent_count;
+    size_t frame_size = SBN_PACKED_HDR_SZ + sizeof(queued_msg);
+    unsigned char msgs[3][sizeof(queued_msg)];
+    unsigned char received[3 * (SBN_PACKED_HDR_SZ + sizeof(queued_msg)) + 1];
+    CFE_SB_Msg_t *batch[3];
+    boolean in_order = TRUE;
+    int32 result;
+    
+    for (i = 0; i < count; i++)
+    {
+        memcpy(msgs[i], queued_msg, sizeof(queued_msg));
+        msgs[i][sizeof(queued_msg) - 1] = i;
+        batch[i] = (CFE_SB_Msg_t *)msgs[i];
+    }
+    
+    /* Act */
+    result = CFE_SBN_Client_SendQueuePutBatch(batch, count);
+    
+    /* Assert */
+    sent_count = CFE_SBN_Client_SendQueueFlush();
+    Read_What_SBN_Received(received, sizeof(received));
+    
+    for (i = 0; i < count; i++)
+    {
+        
+        if (received[(i + 1) * frame_size - 1] != i)
+        {
+            in_order = FALSE;
+        }
+        
+    }
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "CFE_SBN_Client_SendQueuePutBatch returned %d and should be %d", result,
+      CFE_SUCCESS);
+    UtAssert_True(sent_count == count, 
+      "CFE_SBN_Client_SendQueueFlush sent %u and should have sent %u", 
+      sent_count, count);
+    UtAssert_True(in_order, "SBN should receive the batch in order");
+} /* end Test_CFE_SBN_Client_SendQueuePutBatch_QueuesWholeBatchInOrder */
+
+void Test_CFE_SBN_Client_SendQueuePutBatch_QueuesNothingWhenQueueLacksRoom(void)
+{
+    /* Arrange */
+    CFE_SB_Msg_t *batch[2] = { (CFE_SB_Msg_t *)queued_msg, 
+                               (CFE_SB_Msg_t *)queued_msg };
+    uint32 i, room = 0, sent_count;
+    int32 result;
+    
+    SBN_Client_SetSendQueuePolicy(SBN_CLIENT_SEND_QUEUE_EAGAIN, 0);
+    
+    /* find how many fit, then leave room for one less than the batch */
+    while (room <= SBN_CLIENT_SEND_QUEUE_DEPTH && 
+           CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg) == 
+           CFE_SUCCESS)
+    {
+        room++;
+    }
+    
+    CFE_SBN_Client_SendQueueFlush();
+    
+    for (i = 0; i + 1 < room; i++)
+    {
+        CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+    }
+    
+    /* Act */
+    result = CFE_SBN_Client_SendQueuePutBatch(batch, 2);
+    
+    /* Assert */
+    sent_count = CFE_SBN_Client_SendQueueFlush();
+    
+    UtAssert_True(result == CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR, 
+      "CFE_SBN_Client_SendQueuePutBatch returned %d and should be %d", result,
+      CFE_SBN_CLIENT_SEND_QUEUE_FULL_ERR);
+    UtAssert_True(sent_count == room - 1, 
+      "CFE_SBN_Client_SendQueueFlush sent %u and should have sent %u, none "
+      "of the batch", sent_count, room - 1);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "A batch that did not fit should give its buffers back");
+} /* end Test_CFE_SBN_Client_SendQueuePutBatch_QueuesNothingWhenQueueLacksRoom */
+
+void Test_CFE_SBN_Client_SendQueuePutBatch_FailsBatchLargerThanQueue(void)
+{
+    /* Arrange */
+    CFE_SB_Msg_t *batch[1] = { (CFE_SB_Msg_t *)queued_msg };
+    
+    /* Act */
+    int32 result = CFE_SBN_Client_SendQueuePutBatch(batch, 
+      SBN_CLIENT_SEND_QUEUE_DEPTH + 1);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "CFE_SBN_Client_SendQueuePutBatch returned %d and should be %d", result,
+      CFE_SBN_CLIENT_BAD_ARGUMENT);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "A batch larger than the queue should not take buffers");
+} /* end Test_CFE_SBN_Client_SendQueuePutBatch_FailsBatchLargerThanQueue */
+
+/* end CFE_SBN_Client_SendQueuePutBatch Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_SendQueueClose Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_SendQueueClose_SendsWhatIsQueued(void)
+{
+    /* Arrange */
+    unsigned char received[SBN_PACKED_HDR_SZ + sizeof(queued_msg) + 1];
+    ssize_t received_size;
+    
+    CFE_SBN_Client_SendQueuePut((CFE_SB_Msg_t *)queued_msg);
+    
+    /* Act */
+    CFE_SBN_Client_SendQueueClose();
+    
+    /* Assert */
+    received_size = Read_What_SBN_Received(received, sizeof(received));
+    
+    UtAssert_True(received_size == SBN_PACKED_HDR_SZ + sizeof(queued_msg), 
+      "SBN received %d bytes and should have received %d", 
+      (int)received_size, (int)(SBN_PACKED_HDR_SZ + sizeof(queued_msg)));
+    UtAssert_True(CFE_SBN_Client_SendQueueRunning() == FALSE, 
+      "The send queue should not be running once closed");
+    UtAssert_True(pthread_join_call_number == 1, 
+      "The writer thread should be joined");
+} /* end Test_CFE_SBN_Client_SendQueueClose_SendsWhatIsQueued */
+
+/* end CFE_SBN_Client_SendQueueClose Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_SetSendQueuePolicy Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_SetSendQueuePolicy_FailsWithUnknownPolicy(void)
+{
+    /* Arrange */
+    int32 result;
+    
+    /* Act */
+    result = SBN_Client_SetSendQueuePolicy(SBN_CLIENT_SEND_QUEUE_EAGAIN + 1, 
+      0);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "SBN_Client_SetSendQueuePolicy returned %d and should be %d", result, 
+      CFE_SBN_CLIENT_BAD_ARGUMENT);
+} /* end Test_SBN_Client_SetSendQueuePolicy_FailsWithUnknownPolicy */
+
+/* end SBN_Client_SetSendQueuePolicy Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_GetSendQueueCounts Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_GetSendQueueCounts_FailsNullCounter(void)
+{
+    /* Arrange */
+    uint32 dropped;
+    int32 result;
+    
+    /* Act */
+    result = SBN_Client_GetSendQueueCounts(&dropped, NULL);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "SBN_Client_GetSendQueueCounts returned %d and should be %d", result, 
+      CFE_SBN_CLIENT_BAD_ARGUMENT);
+} /* end Test_SBN_Client_GetSendQueueCounts_FailsNullCounter */
+
+/* end SBN_Client_GetSendQueueCounts Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_CFE_SBN_Client_SendQueuePut_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_SendQueuePut_QueuesCopyWithoutSending,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueuePut_QueuesCopyWithoutSending");
+    UtTest_Add(
+      Test_CFE_SBN_Client_SendQueuePut_ReturnsFullErrorWhenPolicyIsEagain,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueuePut_ReturnsFullErrorWhenPolicyIsEagain");
+    UtTest_Add(Test_CFE_SBN_Client_SendQueuePut_CountsDropWhenPolicyIsDrop,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueuePut_CountsDropWhenPolicyIsDrop");
+} /* end add_CFE_SBN_Client_SendQueuePut_tests */
+
+void add_CFE_SBN_Client_SendQueueFlush_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_SendQueueFlush_SendsQueuedMessagesInOrder,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueueFlush_SendsQueuedMessagesInOrder");
+    UtTest_Add(
+      Test_CFE_SBN_Client_SendQueueFlush_CountsSendErrorsWhenSbnHasClosed,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueueFlush_CountsSendErrorsWhenSbnHasClosed");
+} /* end add_CFE_SBN_Client_SendQueueFlush_tests */
+
+void add_CFE_SBN_Client_SendQueuePutBatch_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_SendQueuePutBatch_QueuesWholeBatchInOrder,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueuePutBatch_QueuesWholeBatchInOrder");
+    UtTest_Add(
+      Test_CFE_SBN_Client_SendQueuePutBatch_QueuesNothingWhenQueueLacksRoom,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueuePutBatch_QueuesNothingWhenQueueLacksRoom");
+    UtTest_Add(
+      Test_CFE_SBN_Client_SendQueuePutBatch_FailsBatchLargerThanQueue,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueuePutBatch_FailsBatchLargerThanQueue");
+} /* end add_CFE_SBN_Client_SendQueuePutBatch_tests */
+
+void add_CFE_SBN_Client_SendQueueClose_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_SendQueueClose_SendsWhatIsQueued,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_CFE_SBN_Client_SendQueueClose_SendsWhatIsQueued");
+} /* end add_CFE_SBN_Client_SendQueueClose_tests */
+
+void add_SBN_Client_SetSendQueuePolicy_tests(void)
+{
+    UtTest_Add(Test_SBN_Client_SetSendQueuePolicy_FailsWithUnknownPolicy,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_SBN_Client_SetSendQueuePolicy_FailsWithUnknownPolicy");
+} /* end add_SBN_Client_SetSendQueuePolicy_tests */
+
+void add_SBN_Client_GetSendQueueCounts_tests(void)
+{
+    UtTest_Add(Test_SBN_Client_GetSendQueueCounts_FailsNullCounter,
+      SBN_Client_Send_Queue_Tests_Setup, SBN_Client_Send_Queue_Tests_Teardown,
+      "Test_SBN_Client_GetSendQueueCounts_FailsNullCounter");
+} /* end add_SBN_Client_GetSendQueueCounts_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_CFE_SBN_Client_SendQueuePut_tests();
+
+    add_CFE_SBN_Client_SendQueueFlush_tests();
+
+    add_CFE_SBN_Client_SendQueuePutBatch_tests();
+
+    add_CFE_SBN_Client_SendQueueClose_tests();
+
+    add_SBN_Client_SetSendQueuePolicy_tests();
+
+    add_SBN_Client_GetSendQueueCounts_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
@@ -0,0 +1,385 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+#define STAND_IN_SHM_NAME   "/sbn_client_ut"
+
+CFE_SBN_Client_ShmRegion_t *peer_region;
+
+/*******************************************************************************
+**
+**  SBN_Client_Shm_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Shm_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+    peer_region = Stand_In_Shm_Peer_Create(STAND_IN_SHM_NAME);
+} /* end SBN_Client_Shm_Tests_Setup */
+
+void SBN_Client_Shm_Tests_Teardown(void)
+{
+    CFE_SBN_Client_ShmClose();
+    Stand_In_Shm_Peer_Destroy(peer_region, STAND_IN_SHM_NAME);
+    peer_region = NULL;
+    SBN_Client_Teardown();
+} /* end SBN_Client_Shm_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  connect_to_shm_server Tests
+**
+*******************************************************************************/
+
+void Test_connect_to_shm_server_AttachesToStandInPeer(void)
+{
+    /* Arrange */
+    UtAssert_True(peer_region != NULL, "Stand in peer made its region");
+
+    /* Act */
+    int result = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    /* Assert */
+    UtAssert_True(result >= 0,
+      "connect_to_shm_server returned descriptor %d", result);
+    UtAssert_True(peer_region->ClientAttached == TRUE,
+      "The region should be marked attached");
+    UtAssert_True(peer_region->ClientPid == getpid(),
+      "The region should name the client's process");
+
+    close(result);
+} /* end Test_connect_to_shm_server_AttachesToStandInPeer */
+
+void Test_connect_to_shm_server_FailsWhenNoPeer(void)
+{
+    /* Arrange */
+    Stand_In_Shm_Peer_Destroy(peer_region, STAND_IN_SHM_NAME);
+    peer_region = NULL;
+
+    /* Act */
+    int result = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    /* Assert */
+    UtAssert_True(result == SERVER_CONNECT_ERROR,
+      "connect_to_shm_server returned %d and should be %d "
+      "(SERVER_CONNECT_ERROR)", result, SERVER_CONNECT_ERROR);
+} /* end Test_connect_to_shm_server_FailsWhenNoPeer */
+
+void Test_connect_to_shm_server_FailsWhenRegionAlreadyAttached(void)
+{
+    /* Arrange */
+    peer_region->ClientAttached = TRUE;
+
+    /* Act */
+    int result = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    /* Assert */
+    UtAssert_True(result == SERVER_CONNECT_ERROR,
+      "connect_to_shm_server returned %d and should be %d "
+      "(SERVER_CONNECT_ERROR)", result, SERVER_CONNECT_ERROR);
+} /* end Test_connect_to_shm_server_FailsWhenRegionAlreadyAttached */
+
+/* end connect_to_shm_server Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_ShmWritev Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_ShmWritev_PeerReadsThePiecesInOrder(void)
+{
+    /* Arrange */
+    char header[SBN_PACKED_HDR_SZ];
+    unsigned char *body = Any_Pipe_Message(24);
+    unsigned char received[SBN_PACKED_HDR_SZ + 24];
+    struct iovec iov[2];
+    uint32 taken;
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    CFE_SBN_Client_PackAppHeader(header, 24);
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = body;
+    iov[1].iov_len = 24;
+
+    /* Act */
+    size_t result = CFE_SBN_Client_ShmWritev(iov, 2);
+
+    /* Assert */
+    taken = CFE_SBN_Client_ShmRingRead(&peer_region->ToSbn, received,
+                                       sizeof(received));
+    UtAssert_True(result == sizeof(received),
+      "CFE_SBN_Client_ShmWritev wrote %lu bytes and should be %lu",
+      (unsigned long)result, (unsigned long)sizeof(received));
+    UtAssert_True(taken == sizeof(received),
+      "The peer took %u bytes", taken);
+    UtAssert_True(memcmp(received, header, sizeof(header)) == 0 &&
+                  memcmp(received + sizeof(header), body, 24) == 0,
+      "The peer should get the header then the message");
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmWritev_PeerReadsThePiecesInOrder */
+
+void Test_CFE_SBN_Client_ShmWritev_StopsShortWhenPeerClosesWhileFull(void)
+{
+    /* Arrange */
+    size_t size = SBN_CLIENT_SHM_RING_SZ + 16;
+    struct iovec iov;
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    iov.iov_base = calloc(1, size);
+    iov.iov_len = size;
+    peer_region->PeerClosed = TRUE;
+
+    /* Act */
+    size_t result = CFE_SBN_Client_ShmWritev(&iov, 1);
+
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SHM_RING_SZ,
+      "CFE_SBN_Client_ShmWritev wrote %lu bytes and should be %lu, what "
+      "the ring holds", (unsigned long)result,
+      (unsigned long)SBN_CLIENT_SHM_RING_SZ);
+
+    free(iov.iov_base);
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmWritev_StopsShortWhenPeerClosesWhileFull */
+
+void Test_CFE_SBN_Client_ShmWritev_WritesNothingWhenNotAttached(void)
+{
+    /* Arrange */
+    char byte = 'S';
+    struct iovec iov = { &byte, 1 };
+
+    /* Act */
+    size_t result = CFE_SBN_Client_ShmWritev(&iov, 1);
+
+    /* Assert */
+    UtAssert_True(result == 0,
+      "CFE_SBN_Client_ShmWritev wrote %lu bytes and should be 0",
+      (unsigned long)result);
+} /* end Test_CFE_SBN_Client_ShmWritev_WritesNothingWhenNotAttached */
+
+/* end CFE_SBN_Client_ShmWritev Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_ShmRead and CFE_SBN_Client_ShmPoll Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_ShmRead_TakesBytesAcrossTheRingsEnd(void)
+{
+    /* Arrange */
+    unsigned char *sent = Any_Pipe_Message(8);
+    unsigned char received[8];
+    int shm_fd;
+
+    /* the bytes wrap from the end of the ring to its start */
+    peer_region->FromSbn.Head = SBN_CLIENT_SHM_RING_SZ - 3;
+    peer_region->FromSbn.Tail = SBN_CLIENT_SHM_RING_SZ - 3;
+    shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+    CFE_SBN_Client_ShmRingWrite(&peer_region->FromSbn, sent, 8);
+
+    /* Act */
+    int result = CFE_SBN_Client_ShmRead(received, sizeof(received));
+
+    /* Assert */
+    UtAssert_True(result == 8,
+      "CFE_SBN_Client_ShmRead took %d bytes and should be 8", result);
+    UtAssert_True(memcmp(received, sent, 8) == 0,
+      "The bytes taken should be the bytes the peer wrote");
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmRead_TakesBytesAcrossTheRingsEnd */
+
+void Test_CFE_SBN_Client_ShmRead_ReturnsZeroOncePeerClosed(void)
+{
+    /* Arrange */
+    unsigned char received[8];
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    peer_region->PeerClosed = TRUE;
+
+    /* Act */
+    int result = CFE_SBN_Client_ShmRead(received, sizeof(received));
+
+    /* Assert */
+    UtAssert_True(result == 0,
+      "CFE_SBN_Client_ShmRead returned %d and should be 0, as read() at "
+      "end of stream", result);
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmRead_ReturnsZeroOncePeerClosed */
+
+void Test_CFE_SBN_Client_ShmRead_ReturnsZeroAfterShutdown(void)
+{
+    /* Arrange */
+    unsigned char received[8];
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    CFE_SBN_Client_ShmShutdown();
+
+    /* Act */
+    int result = CFE_SBN_Client_ShmRead(received, sizeof(received));
+
+    /* Assert */
+    UtAssert_True(result == 0,
+      "CFE_SBN_Client_ShmRead returned %d and should be 0", result);
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmRead_ReturnsZeroAfterShutdown */
+
+void Test_CFE_SBN_Client_ShmPoll_TimesOutWhenNothingSent(void)
+{
+    /* Arrange */
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    /* Act */
+    int result = CFE_SBN_Client_ShmPoll(10);
+
+    /* Assert */
+    UtAssert_True(result == 0,
+      "CFE_SBN_Client_ShmPoll returned %d and should be 0", result);
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmPoll_TimesOutWhenNothingSent */
+
+void Test_CFE_SBN_Client_ShmPoll_ReadyWhenPeerSent(void)
+{
+    /* Arrange */
+    char sent = 'S';
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    CFE_SBN_Client_ShmRingWrite(&peer_region->FromSbn, &sent, 1);
+
+    /* Act */
+    int result = CFE_SBN_Client_ShmPoll(10);
+
+    /* Assert */
+    UtAssert_True(result == 1,
+      "CFE_SBN_Client_ShmPoll returned %d and should be 1", result);
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmPoll_ReadyWhenPeerSent */
+
+/* end CFE_SBN_Client_ShmRead and CFE_SBN_Client_ShmPoll Tests */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_ShmClose Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_ShmClose_MarksRegionClosedForPeer(void)
+{
+    /* Arrange */
+    unsigned char received[8];
+    int shm_fd = connect_to_shm_server(STAND_IN_SHM_NAME);
+
+    /* Act */
+    CFE_SBN_Client_ShmClose();
+
+    /* Assert */
+    UtAssert_True(peer_region->ClientClosed == TRUE,
+      "The peer should see the client closed the region");
+    UtAssert_True(CFE_SBN_Client_ShmRead(received, sizeof(received)) == -1,
+      "Reads should fail with no region attached");
+    UtAssert_True(connect_to_shm_server(STAND_IN_SHM_NAME) ==
+                    SERVER_CONNECT_ERROR,
+      "A region once attached should not be attached again");
+
+    close(shm_fd);
+} /* end Test_CFE_SBN_Client_ShmClose_MarksRegionClosedForPeer */
+
+/* end CFE_SBN_Client_ShmClose Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_connect_to_shm_server_tests(void)
+{
+    UtTest_Add(Test_connect_to_shm_server_AttachesToStandInPeer,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_connect_to_shm_server_AttachesToStandInPeer");
+    UtTest_Add(Test_connect_to_shm_server_FailsWhenNoPeer,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_connect_to_shm_server_FailsWhenNoPeer");
+    UtTest_Add(Test_connect_to_shm_server_FailsWhenRegionAlreadyAttached,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_connect_to_shm_server_FailsWhenRegionAlreadyAttached");
+} /* end add_connect_to_shm_server_tests */
+
+void add_CFE_SBN_Client_ShmWritev_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_ShmWritev_PeerReadsThePiecesInOrder,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmWritev_PeerReadsThePiecesInOrder");
+    UtTest_Add(Test_CFE_SBN_Client_ShmWritev_StopsShortWhenPeerClosesWhileFull,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmWritev_StopsShortWhenPeerClosesWhileFull");
+    UtTest_Add(Test_CFE_SBN_Client_ShmWritev_WritesNothingWhenNotAttached,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmWritev_WritesNothingWhenNotAttached");
+} /* end add_CFE_SBN_Client_ShmWritev_tests */
+
+void add_CFE_SBN_Client_ShmRead_and_ShmPoll_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_ShmRead_TakesBytesAcrossTheRingsEnd,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmRead_TakesBytesAcrossTheRingsEnd");
+    UtTest_Add(Test_CFE_SBN_Client_ShmRead_ReturnsZeroOncePeerClosed,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmRead_ReturnsZeroOncePeerClosed");
+    UtTest_Add(Test_CFE_SBN_Client_ShmRead_ReturnsZeroAfterShutdown,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmRead_ReturnsZeroAfterShutdown");
+    UtTest_Add(Test_CFE_SBN_Client_ShmPoll_TimesOutWhenNothingSent,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmPoll_TimesOutWhenNothingSent");
+    UtTest_Add(Test_CFE_SBN_Client_ShmPoll_ReadyWhenPeerSent,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmPoll_ReadyWhenPeerSent");
+} /* end add_CFE_SBN_Client_ShmRead_and_ShmPoll_tests */
+
+void add_CFE_SBN_Client_ShmClose_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_ShmClose_MarksRegionClosedForPeer,
+      SBN_Client_Shm_Tests_Setup, SBN_Client_Shm_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmClose_MarksRegionClosedForPeer");
+} /* end add_CFE_SBN_Client_ShmClose_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_connect_to_shm_server_tests();
+
+    add_CFE_SBN_Client_ShmWritev_tests();
+
+    add_CFE_SBN_Client_ShmRead_and_ShmPoll_tests();
+
+    add_CFE_SBN_Client_ShmClose_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
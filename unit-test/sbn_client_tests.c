@@ -56,14 +56,13 @@ void Test_CFE_SBN_Client_InitPipeTblFullyInitializesPipes(void)
         UtAssert_True(test_pipe.PipeId == CFE_SBN_CLIENT_INVALID_PIPE, 
           "PipeTbl[%d].PipeId should equal %d and was %d", i, 
           CFE_SBN_CLIENT_INVALID_PIPE, test_pipe.PipeId);
-        UtAssert_True(test_pipe.NumberOfMessages == 1, 
-          "PipeTbl[%d].NumberOfMessages should equal %d and was %d", i, 1, 
-          test_pipe.NumberOfMessages);
-        UtAssert_True(test_pipe.ReadMessage == 
-          (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1), 
-          "PipeTbl[%d].ReadMessage should equal %d and was %d", i, 
-          CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1, 
-          test_pipe.ReadMessage);
+        UtAssert_True(test_pipe.ReadIdx == 0 && test_pipe.WriteIdx == 0, 
+          "PipeTbl[%d].ReadIdx and WriteIdx should equal 0 and were %u, %u", 
+          i, test_pipe.ReadIdx, test_pipe.WriteIdx);
+        UtAssert_True(test_pipe.CurrentBuff == NULL, 
+          "PipeTbl[%d].CurrentBuff should be NULL", i);
+        UtAssert_True(test_pipe.Messages == NULL, 
+          "PipeTbl[%d].Messages should be NULL", i);
         UtAssert_True(strcmp(test_pipe.PipeName, "") == 0, 
           "PipeTbl[%d].PipeId should equal '' and was '%s'", i, 
           test_pipe.PipeName);  
@@ -129,6 +128,77 @@ void Test_CFE_SBN_Client_GetAvailPipeIdx_ReturnsIndexForFirstOpenPipe(void)
 
 /* end CFE_SBN_Client_GetAvailPipeIdx Tests */
 
+/*******************************************************************************
+**
+**  SendSubsToSbn Tests
+**
+*******************************************************************************/
+
+/* takes the next frame sent to sbn_fd, returning how many subscriptions it
+ * holds or -1 when nothing was sent.  A header size that does not match the
+ * frame also gives -1. */
+int Subs_In_Frame_Sent(int sbn_fd)
+{
+    unsigned char frame[2 * SBN_PACKED_SUB_SZ];
+    ssize_t       frame_size;
+    
+    frame_size = recv(sbn_fd, frame, sizeof(frame), MSG_DONTWAIT);
+    
+    if (frame_size < SBN_PACKED_HDR_SZ + SBN_IDENT_LEN + 2 || 
+        (frame[0] << 8 | frame[1]) != frame_size - SBN_PACKED_HDR_SZ)
+    {
+        return -1;
+    }
+    
+    return frame[SBN_PACKED_HDR_SZ + SBN_IDENT_LEN] << 8 | 
+           frame[SBN_PACKED_HDR_SZ + SBN_IDENT_LEN + 1];
+} /* end Subs_In_Frame_Sent */
+
+void Test_SendSubsToSbn_SplitsAtMaxSubsPerFrame(void)
+{
+    /* Arrange */
+    int            fds[2];
+    int            first_subs, second_subs;
+    CFE_SB_MsgId_t msg_ids[SBN_MAX_SUBS_PER_PEER + 1];
+    CFE_SB_Qos_t   qos[SBN_MAX_SUBS_PER_PEER + 1];
+    int            i;
+    
+    socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds);
+    sbn_client_sockfd = fds[0];
+    
+    for(i = 0; i < SBN_MAX_SUBS_PER_PEER + 1; i++)
+    {
+        msg_ids[i] = 0x1800 + i;
+        qos[i].Priority = 0x00;
+        qos[i].Reliability = 0x00;
+    }
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    SendSubsToSbn(SBN_SUB_MSG, msg_ids, qos, SBN_MAX_SUBS_PER_PEER + 1);
+    
+    /* Assert */
+    first_subs = Subs_In_Frame_Sent(fds[1]);
+    second_subs = Subs_In_Frame_Sent(fds[1]);
+    
+    UtAssert_True(first_subs == SBN_MAX_SUBS_PER_PEER, 
+      "The first frame should hold %d subscriptions and held %d", 
+      SBN_MAX_SUBS_PER_PEER, first_subs);
+    UtAssert_True(second_subs == 1, 
+      "The second frame should hold the last subscription and held %d", 
+      second_subs);
+    UtAssert_True(Subs_In_Frame_Sent(fds[1]) == -1, 
+      "Only two frames should be sent");
+    
+    close(fds[0]);
+    close(fds[1]);
+    sbn_client_sockfd = 0;
+} /* end Test_SendSubsToSbn_SplitsAtMaxSubsPerFrame */
+
+/* end SendSubsToSbn Tests */
+
 /*******************************************************************************
 **
 **  add test group functions
@@ -152,6 +222,13 @@ void add_CFE_SBN_Client_GetAvailPipeIdx(void)
       "Test_CFE_SBN_Client_GetAvailPipeIdx_ReturnsIndexForFirstOpenPipe");
 } /* end add_CFE_SBN_Client_GetAvailPipeIdx */
 
+void add_SendSubsToSbn_tests(void)
+{
+    UtTest_Add(Test_SendSubsToSbn_SplitsAtMaxSubsPerFrame, 
+      SBN_Client_Tests_Setup, SBN_Client_Tests_Teardown, 
+      "Test_SendSubsToSbn_SplitsAtMaxSubsPerFrame");
+} /* end add_SendSubsToSbn_tests */
+
 /* end add test group functions */
 
 /*******************************************************************************
@@ -165,6 +242,8 @@ void UtTest_Setup(void)
     add_CFE_SBN_Client_InitPipeTbl_tests();
     
     add_CFE_SBN_Client_GetAvailPipeIdx();
+    
+    add_SendSubsToSbn_tests();
 } /* end UtTest_Setup */
 
 /* end Required UtTest_Setup function for ut-assert framework */
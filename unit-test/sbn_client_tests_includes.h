@@ -16,6 +16,7 @@
 /* Library includes */
 #include <arpa/inet.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -23,6 +24,9 @@
 #include <stdarg.h>
 #include <time.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 /* UT includes */
 #include "uttest.h"
@@ -30,12 +34,21 @@
 #include "utstubs.h"
 
 /* SBN_Client includes */
+#include "sbn_client_buffers.h"
+#include "sbn_client_health.h"
 #include "sbn_client_ingest.h"
 #include "sbn_client_init.h"
+#include "sbn_client_interest.h"
 #include "sbn_client_logger.h"
 #include "sbn_client_minders.h"
+#include "sbn_client_msgid_set.h"
+#include "sbn_client_routing.h"
+#include "sbn_client_send_queue.h"
+#include "sbn_client_shm.h"
+#include "sbn_client_transport.h"
 #include "sbn_client_utils.h"
 #include "sbn_client_version.h"
+#include "sbn_client_wrappers.h"
 #include "sbn_client.h"
 
 /* SBN_Client test includes */
@@ -0,0 +1,366 @@
+/*
+** GSC-18396-1, “Software Bus Network Client for External Process”
+**
+** Copyright © 2019 United States Government as represented by
+** the Administrator of the National Aeronautics and Space Administration.
+** No copyright is claimed in the United States under Title 17, U.S. Code.
+** All Other Rights Reserved.
+**
+** Licensed under the NASA Open Source Agreement version 1.3
+** See "NOSA GSC-18396-1.pdf"
+*/
+
+#include "sbn_client_tests_includes.h"
+
+/*******************************************************************************
+**
+**  In memory loopback transport, what the client sends it can read back
+**
+*******************************************************************************/
+
+#define LOOPBACK_SZ     256
+
+unsigned char loopback_data[LOOPBACK_SZ];
+size_t        loopback_written;
+size_t        loopback_read;
+int           loopback_recv_calls;
+
+int Loopback_Connect(void)
+{
+    return 1;
+} /* end Loopback_Connect */
+
+int Loopback_RecvInto(int SockFd, unsigned char *Data, size_t Size)
+{
+    size_t available = loopback_written - loopback_read;
+
+    loopback_recv_calls++;
+
+    if (Size > available)
+    {
+        Size = available;
+    }
+
+    memcpy(Data, loopback_data + loopback_read, Size);
+    loopback_read += Size;
+
+    return Size;
+} /* end Loopback_RecvInto */
+
+int Loopback_PollIn(int SockFd, int TimeoutMs)
+{
+    return loopback_written > loopback_read;
+} /* end Loopback_PollIn */
+
+ssize_t Loopback_SendV(int SockFd, const struct msghdr *Msg, int Flags)
+{
+    size_t sent = 0;
+    size_t i;
+
+    for (i = 0; i < Msg->msg_iovlen; i++)
+    {
+        memcpy(loopback_data + loopback_written, Msg->msg_iov[i].iov_base,
+               Msg->msg_iov[i].iov_len);
+        loopback_written += Msg->msg_iov[i].iov_len;
+        sent += Msg->msg_iov[i].iov_len;
+    }
+
+    return sent;
+} /* end Loopback_SendV */
+
+void Loopback_Shutdown(int SockFd)
+{
+} /* end Loopback_Shutdown */
+
+void Loopback_Close(int SockFd)
+{
+} /* end Loopback_Close */
+
+int Loopback_PollFd(int SockFd)
+{
+    return -1;
+} /* end Loopback_PollFd */
+
+const CFE_SBN_Client_Transport_t Loopback_Transport = {
+    "loopback",
+    "memory",
+    Loopback_Connect,
+    Loopback_RecvInto,
+    Loopback_PollIn,
+    Loopback_SendV,
+    Loopback_Shutdown,
+    Loopback_Close,
+    Loopback_PollFd,
+    NULL
+};
+
+/*******************************************************************************
+**
+**  SBN_Client_Transport_Tests Setup and Teardown
+**
+*******************************************************************************/
+
+void SBN_Client_Transport_Tests_Setup(void)
+{
+    SBN_Client_Setup();
+
+    loopback_written = 0;
+    loopback_read = 0;
+    loopback_recv_calls = 0;
+} /* end SBN_Client_Transport_Tests_Setup */
+
+void SBN_Client_Transport_Tests_Teardown(void)
+{
+    SBN_Client_Teardown();
+} /* end SBN_Client_Transport_Tests_Teardown */
+
+/*******************************************************************************
+**
+**  CFE_SBN_Client_GetTransport and CFE_SBN_Client_SetTransport Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_GetTransport_DefaultsToTcp(void)
+{
+    /* Arrange */
+    /* Act */
+    const CFE_SBN_Client_Transport_t *result = CFE_SBN_Client_GetTransport();
+
+    /* Assert */
+    UtAssert_True(result == &CFE_SBN_Client_TcpTransport,
+      "The default transport is %s and should be tcp", result->Name);
+} /* end Test_CFE_SBN_Client_GetTransport_DefaultsToTcp */
+
+void Test_CFE_SBN_Client_SetTransport_NullRestoresTheDefault(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_SetTransport(&Loopback_Transport);
+
+    /* Act */
+    CFE_SBN_Client_SetTransport(NULL);
+
+    /* Assert */
+    UtAssert_True(CFE_SBN_Client_GetTransport() == &CFE_SBN_Client_TcpTransport,
+      "The default transport should be back");
+} /* end Test_CFE_SBN_Client_SetTransport_NullRestoresTheDefault */
+
+/* end CFE_SBN_Client_GetTransport and CFE_SBN_Client_SetTransport Tests */
+
+/*******************************************************************************
+**
+**  Loopback Transport Tests
+**
+*******************************************************************************/
+
+void Test_Transport_WriteMessageGoesThroughTheTransport(void)
+{
+    /* Arrange */
+    char *msg = (char *)Any_Pipe_Message(16);
+
+    CFE_SBN_Client_SetTransport(&Loopback_Transport);
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+
+    /* Act */
+    size_t result = write_message(1, msg, 16);
+
+    /* Assert */
+    UtAssert_True(result == 16,
+      "write_message sent %lu bytes and should be 16", (unsigned long)result);
+    UtAssert_True(loopback_written == 16 &&
+                  memcmp(loopback_data, msg, 16) == 0,
+      "The transport should get the message");
+} /* end Test_Transport_WriteMessageGoesThroughTheTransport */
+
+void Test_Transport_ReadBytesGoesThroughTheTransport(void)
+{
+    /* Arrange */
+    unsigned char received[12];
+    int result;
+
+    CFE_SBN_Client_SetTransport(&Loopback_Transport);
+    memcpy(loopback_data, "from the sbn", 12);
+    loopback_written = 12;
+
+    /* Act */
+    result = CFE_SBN_CLIENT_ReadBytes(1, received, sizeof(received));
+
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS,
+      "CFE_SBN_CLIENT_ReadBytes returned %d and should be %d (CFE_SUCCESS)",
+      result, CFE_SUCCESS);
+    UtAssert_True(loopback_recv_calls > 0 &&
+                  memcmp(received, "from the sbn", 12) == 0,
+      "The bytes should come from the transport");
+} /* end Test_Transport_ReadBytesGoesThroughTheTransport */
+
+void Test_Transport_SendHeartbeatGoesThroughTheTransport(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_SetTransport(&Loopback_Transport);
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+
+    /* Act */
+    int result = send_heartbeat(1);
+
+    /* Assert */
+    UtAssert_True(result == SBN_PACKED_HDR_SZ,
+      "send_heartbeat sent %d bytes and should be %d", result,
+      SBN_PACKED_HDR_SZ);
+    UtAssert_True(loopback_written == SBN_PACKED_HDR_SZ,
+      "The transport should get the heartbeat");
+} /* end Test_Transport_SendHeartbeatGoesThroughTheTransport */
+
+void Test_Transport_CorkDoesNothingWithoutSegments(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_SetTransport(&Loopback_Transport);
+
+    /* Act */
+    int32 result = SBN_Client_Cork();
+
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS,
+      "SBN_Client_Cork returned %d and should be %d (CFE_SUCCESS)",
+      result, CFE_SUCCESS);
+} /* end Test_Transport_CorkDoesNothingWithoutSegments */
+
+/* end Loopback Transport Tests */
+
+/*******************************************************************************
+**
+**  Built In Transport Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_TcpTransport_AddressIsIpAndPort(void)
+{
+    /* Arrange */
+    char expected[64];
+
+    snprintf(expected, sizeof(expected), "%s:%d", SBN_CLIENT_IP_ADDR,
+             SBN_CLIENT_PORT);
+
+    /* Act */
+    const char *result = CFE_SBN_Client_TcpTransport.Address;
+
+    /* Assert */
+    UtAssert_True(strcmp(result, expected) == 0,
+      "The TCP transport's Address is %s and should be %s", result,
+      expected);
+} /* end Test_CFE_SBN_Client_TcpTransport_AddressIsIpAndPort */
+
+void Test_CFE_SBN_Client_UnixTransport_PollsTheSocket(void)
+{
+    /* Arrange */
+    int sockfd = Any_Positive_int32();
+
+    /* Act */
+    int result = CFE_SBN_Client_UnixTransport.PollFd(sockfd);
+
+    /* Assert */
+    UtAssert_True(result == sockfd,
+      "PollFd returned %d and should be the socket %d", result, sockfd);
+    UtAssert_True(CFE_SBN_Client_UnixTransport.Cork == NULL,
+      "A Unix socket has nothing to cork");
+} /* end Test_CFE_SBN_Client_UnixTransport_PollsTheSocket */
+
+void Test_CFE_SBN_Client_ShmTransport_HasNothingToPoll(void)
+{
+    /* Arrange */
+    /* Act */
+    int result = CFE_SBN_Client_ShmTransport.PollFd(Any_Positive_int32());
+
+    /* Assert */
+    UtAssert_True(result == -1,
+      "PollFd returned %d and should be -1", result);
+} /* end Test_CFE_SBN_Client_ShmTransport_HasNothingToPoll */
+
+void Test_CFE_SBN_Client_ShmTransport_SendFailsWhenNotAttached(void)
+{
+    /* Arrange */
+    char byte = 'S';
+    struct iovec iov = { &byte, 1 };
+    struct msghdr msg;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    /* Act */
+    ssize_t result = CFE_SBN_Client_ShmTransport.SendV(1, &msg, 0);
+
+    /* Assert */
+    UtAssert_True(result == -1 && errno == EPIPE,
+      "SendV returned %ld and should be -1 with errno EPIPE", (long)result);
+} /* end Test_CFE_SBN_Client_ShmTransport_SendFailsWhenNotAttached */
+
+/* end Built In Transport Tests */
+
+/*******************************************************************************
+**
+**  add test group functions
+**
+*******************************************************************************/
+
+void add_CFE_SBN_Client_GetTransport_and_SetTransport_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_GetTransport_DefaultsToTcp,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_CFE_SBN_Client_GetTransport_DefaultsToTcp");
+    UtTest_Add(Test_CFE_SBN_Client_SetTransport_NullRestoresTheDefault,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_CFE_SBN_Client_SetTransport_NullRestoresTheDefault");
+} /* end add_CFE_SBN_Client_GetTransport_and_SetTransport_tests */
+
+void add_Loopback_Transport_tests(void)
+{
+    UtTest_Add(Test_Transport_WriteMessageGoesThroughTheTransport,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_Transport_WriteMessageGoesThroughTheTransport");
+    UtTest_Add(Test_Transport_ReadBytesGoesThroughTheTransport,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_Transport_ReadBytesGoesThroughTheTransport");
+    UtTest_Add(Test_Transport_SendHeartbeatGoesThroughTheTransport,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_Transport_SendHeartbeatGoesThroughTheTransport");
+    UtTest_Add(Test_Transport_CorkDoesNothingWithoutSegments,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_Transport_CorkDoesNothingWithoutSegments");
+} /* end add_Loopback_Transport_tests */
+
+void add_Built_In_Transport_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_TcpTransport_AddressIsIpAndPort,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_CFE_SBN_Client_TcpTransport_AddressIsIpAndPort");
+    UtTest_Add(Test_CFE_SBN_Client_UnixTransport_PollsTheSocket,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_CFE_SBN_Client_UnixTransport_PollsTheSocket");
+    UtTest_Add(Test_CFE_SBN_Client_ShmTransport_HasNothingToPoll,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmTransport_HasNothingToPoll");
+    UtTest_Add(Test_CFE_SBN_Client_ShmTransport_SendFailsWhenNotAttached,
+      SBN_Client_Transport_Tests_Setup, SBN_Client_Transport_Tests_Teardown,
+      "Test_CFE_SBN_Client_ShmTransport_SendFailsWhenNotAttached");
+} /* end add_Built_In_Transport_tests */
+
+/* end add test group functions */
+
+/*******************************************************************************
+**
+**  Required UtTest_Setup function for ut-assert framework
+**
+*******************************************************************************/
+
+void UtTest_Setup(void)
+{
+    add_CFE_SBN_Client_GetTransport_and_SetTransport_tests();
+
+    add_Loopback_Transport_tests();
+
+    add_Built_In_Transport_tests();
+} /* end UtTest_Setup */
+
+/* end Required UtTest_Setup function for ut-assert framework */
@@ -13,6 +13,7 @@
 #include "sbn_client_tests_includes.h"
 
 void add_connect_to_server_tests(void);
+void add_connect_to_unix_server_tests(void);
 
 /*******************************************************************************
 **
@@ -358,9 +359,68 @@ void Test_connect_to_server_Outlog_message_EFAULT_errorFromConnectCall(void)
     connect_to_server_connect_fail_check(EFAULT, "EFAULT");
 }
 
-void Test_connect_to_server_Outlog_message_EINPROGRESS_errorFromConnectCall(void)
+void Test_connect_to_server_WaitsForConnectInProgress(void)
 {
-    connect_to_server_connect_fail_check(EINPROGRESS, "EINPROGRESS");
+    /* Arrange */
+    int fds[2];
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    
+    wrap_socket_return_value = fds[0];
+    wrap_htons_return_value = 0;
+    wrap_inet_pton_return_value = 1;
+    wrap_connect_return_value = CONNECT_ERROR_VALUE;
+    errno = EINPROGRESS;
+    const char * dummyIp = NULL;
+    uint16_t dummyPort = 0;
+
+    /* Act */ 
+    int result = connect_to_server(dummyIp, dummyPort);
+
+    /* Assert */
+    UtAssert_True(result == fds[0], 
+      "Sockfd returned should have been %d and was %d", fds[0], result);
+    UtAssert_True((fcntl(fds[0], F_GETFL) & O_NONBLOCK) == 0, 
+      "connected socket should be blocking");
+    
+    close(fds[0]);
+    close(fds[1]);
+}
+
+void Test_connect_to_server_returns_error_WhenConnectTimesOut(void)
+{
+    /* Arrange */
+    int  fds[2];
+    char fill[1024] = {0};
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    fcntl(fds[0], F_SETFL, O_NONBLOCK);
+    
+    /* a socket with a full send buffer never becomes writable */
+    while (write(fds[0], fill, sizeof(fill)) > 0);
+    
+    wrap_socket_return_value = fds[0];
+    wrap_htons_return_value = 0;
+    wrap_inet_pton_return_value = 1;
+    wrap_connect_return_value = CONNECT_ERROR_VALUE;
+    errno = EINPROGRESS;
+    const char * dummyIp = NULL;
+    uint16_t dummyPort = 0;
+
+    /* Act */ 
+    int result = connect_to_server(dummyIp, dummyPort);
+
+    /* Assert */
+    UtAssert_True(result == SERVER_CONNECT_ERROR, 
+      "error returned should have been %d and was %d", 
+      SERVER_CONNECT_ERROR, result);
+    UtAssert_True(errno == ETIMEDOUT, 
+      "errno should be ETIMEDOUT and was %d", errno);
+    UtAssert_True(fcntl(fds[0], F_GETFD) == -1, 
+      "socket of the failed connect should be closed");
+    
+    close(fds[1]);
 }
 
 void Test_connect_to_server_Outlog_message_EINTR_errorFromConnectCall(void)
@@ -394,6 +454,80 @@ void Test_connect_to_server_Outlog_message_ETIMEDOUT_errorFromConnectCall(void)
 }
 /* end connect_to_server Tests */
 
+/*******************************************************************************
+**
+**  connect_to_unix_server Tests
+**
+*******************************************************************************/
+
+#define STAND_IN_SBN_PATH   "/tmp/sbn_client_ut.sock"
+
+void Test_connect_to_unix_server_ConnectsToStandInSbn(void)
+{
+    /* Arrange */
+    int listen_fd = Stand_In_Sbn_Listen(STAND_IN_SBN_PATH);
+    int sbn_fd;
+    char sent = 'S', received = 0;
+    
+    use_real_socket = TRUE;
+    use_real_connect = TRUE;
+    
+    /* Act */ 
+    int result = connect_to_unix_server(STAND_IN_SBN_PATH);
+    
+    /* Assert */
+    sbn_fd = accept(listen_fd, NULL, NULL);
+    send(sbn_fd, &sent, 1, 0);
+    
+    UtAssert_True(listen_fd >= 0, "The stand in SBN should be listening");
+    UtAssert_True(result >= 0, 
+      "connect_to_unix_server should return a socket and returned %d", 
+      result);
+    UtAssert_True(recv(result, &received, 1, 0) == 1 && received == sent, 
+      "Bytes from SBN should arrive on the socket");
+    UtAssert_True((fcntl(result, F_GETFL) & O_NONBLOCK) == 0, 
+      "The socket should be blocking");
+    
+    close(sbn_fd);
+    close(result);
+    Stand_In_Sbn_Close(listen_fd, STAND_IN_SBN_PATH);
+}
+
+void Test_connect_to_unix_server_FailsWhenNoSbnListens(void)
+{
+    /* Arrange */
+    unlink(STAND_IN_SBN_PATH);
+    use_real_socket = TRUE;
+    use_real_connect = TRUE;
+    
+    /* Act */ 
+    int result = connect_to_unix_server(STAND_IN_SBN_PATH);
+    
+    /* Assert */
+    UtAssert_True(result == SERVER_CONNECT_ERROR, 
+      "connect_to_unix_server should return %d and returned %d", 
+      SERVER_CONNECT_ERROR, result);
+}
+
+void Test_connect_to_unix_server_FailsWhenPathIsTooLong(void)
+{
+    /* Arrange */
+    struct sockaddr_un address;
+    char path[sizeof(address.sun_path) + 1];
+    
+    memset(path, 'p', sizeof(path) - 1);
+    path[sizeof(path) - 1] = '\0';
+    
+    /* Act */ 
+    int result = connect_to_unix_server(path);
+    
+    /* Assert */
+    UtAssert_True(result == SERVER_PATH_ERROR, 
+      "connect_to_unix_server should return %d and returned %d", 
+      SERVER_PATH_ERROR, result);
+}
+/* end connect_to_unix_server Tests */
+
 /*******************************************************************************
 **
 **  CFE_SBN_Client_GetPipeIdx Tests
@@ -498,8 +632,653 @@ void Test_CFE_SBN_CLIENT_ReadBytes_ReturnsCfeSuccessWhenAllBytesReceived(void)
     UtAssert_True(result == CFE_SUCCESS, 
         "CFE_SBN_CLIENT_ReadBytes returned CFE_SUCCESS");
 }
+
+void Test_CFE_SBN_CLIENT_ReadBytes_ServesConsecutiveReadsFromOneRead(void)
+{
+    /* Arrange */
+    int sock_fd = (rand() % 10) + 1; /* 1 to 10 */
+    unsigned char socket_bytes[16];
+    unsigned char first[SBN_PACKED_HDR_SZ];
+    unsigned char second[sizeof(socket_bytes) - SBN_PACKED_HDR_SZ];
+    int result1, result2, i;
+    
+    for(i = 0; i < sizeof(socket_bytes); i++)
+    {
+        socket_bytes[i] = Any_unsigned_char();
+    }
+    
+    wrap_read_data = socket_bytes;
+    wrap_read_return_value = sizeof(socket_bytes);
+    
+    /* Act */ 
+    result1 = CFE_SBN_CLIENT_ReadBytes(sock_fd, first, sizeof(first));
+    result2 = CFE_SBN_CLIENT_ReadBytes(sock_fd, second, sizeof(second));
+    
+    /* Assert */
+    UtAssert_True(result1 == CFE_SUCCESS && result2 == CFE_SUCCESS, 
+        "CFE_SBN_CLIENT_ReadBytes returned CFE_SUCCESS for both reads");
+    UtAssert_True(wrap_read_call_number == 1, 
+        "read should have been called once and was called %d times", 
+        wrap_read_call_number);
+    UtAssert_True(memcmp(first, socket_bytes, sizeof(first)) == 0, 
+        "first read should get the start of the received bytes");
+    UtAssert_True(memcmp(second, socket_bytes + sizeof(first), 
+        sizeof(second)) == 0, 
+        "second read should get the bytes carried over from the first read");
+    UtAssert_True(CFE_SBN_CLIENT_RecvBufferedBytes() == 0, 
+        "receive buffer should be empty and had %d bytes", 
+        CFE_SBN_CLIENT_RecvBufferedBytes());
+}
+
+void Test_CFE_SBN_CLIENT_ReadBytes_ReturnsTimeoutWhenFrameStalls(void)
+{
+    /* Arrange */
+    int fds[2];
+    unsigned char partial_frame[3] = {0};
+    unsigned char msg_buffer[8];
+    int result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    write(fds[1], partial_frame, sizeof(partial_frame));
+    
+    CFE_SBN_CLIENT_StartFrame();
+    
+    /* Act */ 
+    result = CFE_SBN_CLIENT_ReadBytes(fds[0], msg_buffer, sizeof(msg_buffer));
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_READ_TIMEOUT_ERR, 
+        "CFE_SBN_CLIENT_ReadBytes should return %d and returned %d", 
+        CFE_SBN_CLIENT_READ_TIMEOUT_ERR, result);
+    
+    close(fds[0]);
+    close(fds[1]);
+}
 /* end CFE_SBN_CLIENT_ReadBytes Tests*/
 
+/* CFE_SBN_CLIENT_DiscardBytes Tests*/
+void Test_CFE_SBN_CLIENT_DiscardBytes_SkipsBufferedBytesWithoutReading(void)
+{
+    /* Arrange */
+    int sock_fd = (rand() % 10) + 1; /* 1 to 10 */
+    unsigned char socket_bytes[16] = {0};
+    unsigned char last_byte;
+    int result;
+    
+    socket_bytes[sizeof(socket_bytes) - 1] = 0xA5;
+    wrap_read_data = socket_bytes;
+    wrap_read_return_value = sizeof(socket_bytes);
+    
+    /* Act */ 
+    result = CFE_SBN_CLIENT_DiscardBytes(sock_fd, sizeof(socket_bytes) - 1);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+        "CFE_SBN_CLIENT_DiscardBytes returned CFE_SUCCESS");
+    UtAssert_True(CFE_SBN_CLIENT_RecvBufferedBytes() == 1, 
+        "receive buffer should have 1 byte left and had %d", 
+        CFE_SBN_CLIENT_RecvBufferedBytes());
+    
+    CFE_SBN_CLIENT_ReadBytes(sock_fd, &last_byte, 1);
+    
+    UtAssert_True(last_byte == 0xA5, 
+        "byte after discarded bytes should be 0xA5 and was 0x%02X", last_byte);
+    UtAssert_True(wrap_read_call_number == 1, 
+        "read should have been called once and was called %d times", 
+        wrap_read_call_number);
+}
+
+void Test_CFE_SBN_CLIENT_DiscardBytes_ReturnsErrorWhenPipeClosed(void)
+{
+    /* Arrange */
+    int sock_fd = (rand() % 10) + 1; /* 1 to 10 */
+    int result;
+    
+    wrap_read_return_value = 0;
+    
+    /* Act */ 
+    result = CFE_SBN_CLIENT_DiscardBytes(sock_fd, 8);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_PIPE_CLOSED_ERR, 
+        "CFE_SBN_CLIENT_DiscardBytes returned CFE_SBN_CLIENT_PIPE_CLOSED_ERR");
+}
+/* end CFE_SBN_CLIENT_DiscardBytes Tests*/
+
+/* CFE_SBN_Client_AllocPipeRing Tests*/
+void Test_CFE_SBN_Client_AllocPipeRing_RoundsRingUpToPowerOfTwo(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    uint16 depth = (rand() % (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH / 2)) + 
+      (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH / 2) + 1; /* MAX/2+1 to MAX */
+    int32 result;
+    
+    free(pipe->Messages);
+    
+    /* Act */ 
+    result = CFE_SBN_Client_AllocPipeRing(pipe, depth);
+    
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+        "CFE_SBN_Client_AllocPipeRing returned SBN_CLIENT_SUCCESS");
+    UtAssert_True(pipe->Messages != NULL, "pipe ring should be allocated");
+    UtAssert_True(pipe->QueueDepth == depth, 
+        "QueueDepth should be %d and was %d", depth, pipe->QueueDepth);
+    UtAssert_True(pipe->RingMask == CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1, 
+        "RingMask should be %d and was %u", 
+        CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1, pipe->RingMask);
+}
+/* end CFE_SBN_Client_AllocPipeRing Tests*/
+
+/* CFE_SBN_Client_PipeEnqueue Tests*/
+void Test_CFE_SBN_Client_PipeEnqueue_AddsReferenceToBufferAtTail(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    uint32 write_idx = rand();
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->ReadIdx = write_idx;
+    pipe->WriteIdx = write_idx;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+        "CFE_SBN_Client_PipeEnqueue returned SBN_CLIENT_SUCCESS");
+    UtAssert_True(pipe->Messages[write_idx % 
+        CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH] == buf, 
+        "buffer should be in the slot at the old write index");
+    UtAssert_True(pipe->WriteIdx == write_idx + 1, 
+        "WriteIdx should be %u and was %u", write_idx + 1, pipe->WriteIdx);
+    UtAssert_True(buf->UseCount == 2, 
+        "UseCount should be 2 and was %d", buf->UseCount);
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_FailsWhenPipeIsFull(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->WriteIdx = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_PIPE_FULL_ERR, 
+        "CFE_SBN_Client_PipeEnqueue returned CFE_SBN_CLIENT_PIPE_FULL_ERR");
+    UtAssert_True(pipe->WriteIdx == CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, 
+        "WriteIdx should not have changed and was %u", pipe->WriteIdx);
+    UtAssert_True(buf->UseCount == 1, 
+        "UseCount should be 1 and was %d", buf->UseCount);
+    UtAssert_True(pipe->SendErrors == 1, 
+        "SendErrors should be 1 and was %u", pipe->SendErrors);
+    UtAssert_True(pipe->DroppedBytes == 8, 
+        "DroppedBytes should be 8 and was %u", pipe->DroppedBytes);
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_FailsWhenPipeIsNotInUse(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_INVALID_PIPE, 
+        "CFE_SBN_Client_PipeEnqueue returned CFE_SBN_CLIENT_INVALID_PIPE");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 0, 
+        "pipe should be empty and had %u messages", 
+        CFE_SBN_Client_PipeMsgCount(pipe));
+    UtAssert_True(pipe->Producers == 0, 
+        "Producers should be 0 and was %u", pipe->Producers);
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_FailsForEarlierGeneration(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation - 1);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_INVALID_PIPE, 
+        "A route to a deleted pipe should get CFE_SBN_CLIENT_INVALID_PIPE "
+        "and got %d", result);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 0, 
+        "pipe should be empty and had %u messages", 
+        CFE_SBN_Client_PipeMsgCount(pipe));
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_LastProducerOutOfClosingPipeSignals(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_CLOSING;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_signal_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_INVALID_PIPE, 
+        "CFE_SBN_Client_PipeEnqueue returned CFE_SBN_CLIENT_INVALID_PIPE");
+    UtAssert_True(wrap_pthread_cond_signal_cond == &pipe->NoProducers, 
+        "NoProducers should have been signalled");
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_FailsWhenQueueDepthIsReached(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    uint16 depth = 5; /* ring has 8 slots */
+    int32 result;
+    int i;
+    
+    free(pipe->Messages);
+    CFE_SBN_Client_AllocPipeRing(pipe, depth);
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    
+    for(i = 0; i < depth; i++)
+    {
+        CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    }
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_PIPE_FULL_ERR, 
+        "CFE_SBN_Client_PipeEnqueue returned CFE_SBN_CLIENT_PIPE_FULL_ERR");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == depth, 
+        "pipe should hold %d messages and had %u", depth, 
+        CFE_SBN_Client_PipeMsgCount(pipe));
+}
+void Test_CFE_SBN_Client_PipeEnqueue_DropOldestReplacesOldestMessage(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *first = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    CFE_SBN_Client_BufferD_t *second = CFE_SBN_Client_GetBuffer(0x1801, 16);
+    CFE_SBN_Client_BufferD_t *third = CFE_SBN_Client_GetBuffer(0x1802, 24);
+    int32 result;
+    
+    free(pipe->Messages);
+    CFE_SBN_Client_AllocPipeRing(pipe, 2);
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->OverflowPolicy = SBN_CLIENT_OVERFLOW_DROP_OLDEST;
+    CFE_SBN_Client_PipeEnqueue(pipe, first, pipe->Generation);
+    CFE_SBN_Client_PipeEnqueue(pipe, second, pipe->Generation);
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, third, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+        "CFE_SBN_Client_PipeEnqueue returned SBN_CLIENT_SUCCESS");
+    UtAssert_True(first->UseCount == 1, 
+        "the pipe should have released the oldest message, UseCount was %d",
+        first->UseCount);
+    UtAssert_True(pipe->SendErrors == 1, 
+        "SendErrors should be 1 and was %u", pipe->SendErrors);
+    UtAssert_True(pipe->DroppedBytes == 8, 
+        "DroppedBytes should be 8 and was %u", pipe->DroppedBytes);
+    UtAssert_True(CFE_SBN_Client_PipeDequeue(pipe) == second && 
+        CFE_SBN_Client_PipeDequeue(pipe) == third, 
+        "pipe should hold the two newest messages in order");
+}
+
+/* stands in for the reader taking a message while the producer waits */
+CFE_SBN_Client_PipeD_t *pipe_read_during_wait;
+
+void Read_Message_During_Wait(void)
+{
+    CFE_SBN_Client_ReleaseBuffer(
+      CFE_SBN_Client_PipeDequeue(pipe_read_during_wait));
+}
+
+void Delete_Pipe_During_Wait(void)
+{
+    pipe_read_during_wait->InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_BlockWaitsForReader(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    int i;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->OverflowPolicy = SBN_CLIENT_OVERFLOW_BLOCK;
+    
+    for(i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; i++)
+    {
+        CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    }
+    
+    pipe_read_during_wait = pipe;
+    wrap_pthread_cond_wait_call_func = Read_Message_During_Wait;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_wait_should_be_called = TRUE;
+    use_wrap_pthread_cond_wait = TRUE;
+    wrap_pthread_cond_wait_return_value = 0;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+        "CFE_SBN_Client_PipeEnqueue returned SBN_CLIENT_SUCCESS");
+    UtAssert_True(wrap_pthread_cond_wait_was_called, 
+        "producer should have waited for space");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 
+        CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, 
+        "pipe should be full again and had %u messages", 
+        CFE_SBN_Client_PipeMsgCount(pipe));
+    UtAssert_True(pipe->WriterWaiting == 0, 
+        "WriterWaiting should be cleared and was %u", pipe->WriterWaiting);
+    UtAssert_True(pipe->SendErrors == 0, 
+        "SendErrors should be 0 and was %u", pipe->SendErrors);
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_BlockFailsWhenPipeIsDeleted(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->OverflowPolicy = SBN_CLIENT_OVERFLOW_BLOCK;
+    pipe->WriteIdx = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
+    
+    pipe_read_during_wait = pipe;
+    wrap_pthread_cond_wait_call_func = Delete_Pipe_During_Wait;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_wait_should_be_called = TRUE;
+    use_wrap_pthread_cond_wait = TRUE;
+    wrap_pthread_cond_wait_return_value = 0;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_INVALID_PIPE, 
+        "CFE_SBN_Client_PipeEnqueue returned CFE_SBN_CLIENT_INVALID_PIPE");
+    UtAssert_True(pipe->WriteIdx == CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, 
+        "WriteIdx should not have changed and was %u", pipe->WriteIdx);
+    UtAssert_True(buf->UseCount == 1, 
+        "UseCount should be 1 and was %d", buf->UseCount);
+}
+
+void Test_CFE_SBN_Client_PipeEnqueue_LetsNextProducerWrite(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 first_result, second_result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    
+    /* Act */ 
+    first_result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    second_result = CFE_SBN_Client_PipeEnqueueNoWait(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(first_result == SBN_CLIENT_SUCCESS && 
+        second_result == SBN_CLIENT_SUCCESS, 
+        "both producers should have added their message");
+    UtAssert_True(pipe->Writing == 0, 
+        "Writing should be cleared and was %u", pipe->Writing);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 2, 
+        "pipe should have 2 messages and had %u", 
+        CFE_SBN_Client_PipeMsgCount(pipe));
+}
+/* end CFE_SBN_Client_PipeEnqueue Tests*/
+
+/* CFE_SBN_Client_PipeEnqueueNoWait Tests*/
+void Test_CFE_SBN_Client_PipeEnqueueNoWait_DropsWhenBlockPipeIsFull(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->OverflowPolicy = SBN_CLIENT_OVERFLOW_BLOCK;
+    pipe->WriteIdx = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueueNoWait(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_PIPE_FULL_ERR, 
+        "CFE_SBN_Client_PipeEnqueueNoWait returned "
+        "CFE_SBN_CLIENT_PIPE_FULL_ERR");
+    UtAssert_True(buf->UseCount == 1, 
+        "UseCount should be 1 and was %d", buf->UseCount);
+    UtAssert_True(pipe->SendErrors == 1, 
+        "SendErrors should be 1 and was %u", pipe->SendErrors);
+    UtAssert_True(pipe->Writing == 0, 
+        "Writing should be cleared and was %u", pipe->Writing);
+}
+
+void Test_CFE_SBN_Client_PipeEnqueueNoWait_DropsWhileProducerWaits(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->OverflowPolicy = SBN_CLIENT_OVERFLOW_BLOCK;
+    /* the receive thread holds the ring, waiting on the full pipe */
+    pipe->Writing = 1;
+    pipe->WriterWaiting = 1;
+    
+    /* Act */ 
+    result = CFE_SBN_Client_PipeEnqueueNoWait(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_PIPE_FULL_ERR, 
+        "CFE_SBN_Client_PipeEnqueueNoWait returned "
+        "CFE_SBN_CLIENT_PIPE_FULL_ERR");
+    UtAssert_True(pipe->Writing == 1, 
+        "the waiting producer should still hold the ring");
+    UtAssert_True(pipe->SendErrors == 1, 
+        "SendErrors should be 1 and was %u", pipe->SendErrors);
+}
+/* end CFE_SBN_Client_PipeEnqueueNoWait Tests*/
+
+/* CFE_SBN_Client_PipeWakeWriter Tests*/
+void Test_CFE_SBN_Client_PipeWakeWriter_SignalsWaitingWriter(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    
+    pipe->WriterWaiting = 1;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_signal_should_be_called = TRUE;
+    
+    /* Act */ 
+    CFE_SBN_Client_PipeWakeWriter(pipe);
+    
+    /* Assert */
+    UtAssert_True(wrap_pthread_cond_signal_cond == &pipe->SpaceAvail, 
+        "SpaceAvail should have been signalled");
+}
+
+void Test_CFE_SBN_Client_PipeWakeWriter_DoesNothingWithoutWaitingWriter(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    
+    pipe->WriterWaiting = 0;
+    
+    /* Act */ 
+    CFE_SBN_Client_PipeWakeWriter(pipe);
+    
+    /* Assert */
+    UtAssert_True(!wrap_pthread_cond_signal_was_called, 
+        "pthread_cond_signal should not have been called");
+}
+/* end CFE_SBN_Client_PipeWakeWriter Tests*/
+
+/* CFE_SBN_Client_PipeWaitForProducers Tests*/
+void Producer_Leaves_During_Wait(void)
+{
+    __atomic_sub_fetch(&pipe_read_during_wait->Producers, 1, 
+                       __ATOMIC_SEQ_CST);
+}
+
+void Test_CFE_SBN_Client_PipeWaitForProducers_WaitsForLastProducer(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    
+    pipe->InUse = CFE_SBN_CLIENT_CLOSING;
+    pipe->Producers = 1;
+    pipe_read_during_wait = pipe;
+    wrap_pthread_cond_wait_call_func = Producer_Leaves_During_Wait;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_wait_should_be_called = TRUE;
+    use_wrap_pthread_cond_wait = TRUE;
+    wrap_pthread_cond_wait_return_value = 0;
+    
+    /* Act */ 
+    CFE_SBN_Client_PipeWaitForProducers(pipe);
+    
+    /* Assert */
+    UtAssert_True(wrap_pthread_cond_wait_was_called, 
+        "pthread_cond_wait should have been called");
+    UtAssert_True(pipe->Producers == 0, 
+        "Producers should be 0 and was %u", pipe->Producers);
+}
+
+void Test_CFE_SBN_Client_PipeWaitForProducers_DoesNotWaitWithoutProducers(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    
+    pipe->InUse = CFE_SBN_CLIENT_CLOSING;
+    pipe->Producers = 0;
+    
+    /* Act */ 
+    CFE_SBN_Client_PipeWaitForProducers(pipe);
+    
+    /* Assert */
+    UtAssert_True(!wrap_pthread_mutex_lock_was_called, 
+        "pthread_mutex_lock should not have been called");
+}
+/* end CFE_SBN_Client_PipeWaitForProducers Tests*/
+
+/* CFE_SBN_Client_PipeDequeue Tests*/
+void Test_CFE_SBN_Client_PipeDequeue_ReturnsNullWhenPipeIsEmpty(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    uint32 read_idx = rand();
+    
+    pipe->ReadIdx = read_idx;
+    pipe->WriteIdx = read_idx;
+    
+    /* Act */ 
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_PipeDequeue(pipe);
+    
+    /* Assert */
+    UtAssert_True(buf == NULL, "CFE_SBN_Client_PipeDequeue returned NULL");
+    UtAssert_True(pipe->ReadIdx == read_idx, 
+        "ReadIdx should not have changed and was %u", pipe->ReadIdx);
+}
+
+void Test_CFE_SBN_Client_PipeDequeue_ReturnsMessagesInOrder(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *first = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    CFE_SBN_Client_BufferD_t *second = CFE_SBN_Client_GetBuffer(0x1801, 8);
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    /* start just before the free running indices wrap */
+    pipe->ReadIdx = UINT32_MAX;
+    pipe->WriteIdx = UINT32_MAX;
+    CFE_SBN_Client_PipeEnqueue(pipe, first, pipe->Generation);
+    CFE_SBN_Client_PipeEnqueue(pipe, second, pipe->Generation);
+    
+    /* Act */ 
+    CFE_SBN_Client_BufferD_t *first_out = CFE_SBN_Client_PipeDequeue(pipe);
+    CFE_SBN_Client_BufferD_t *second_out = CFE_SBN_Client_PipeDequeue(pipe);
+    
+    /* Assert */
+    UtAssert_True(first_out == first && second_out == second, 
+        "CFE_SBN_Client_PipeDequeue returned the messages in order");
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 0, 
+        "pipe should be empty and had %u messages", 
+        CFE_SBN_Client_PipeMsgCount(pipe));
+}
+
+void Test_CFE_SBN_Client_PipeDequeue_MakesRoomUnderMsgLim(void)
+{
+    /* Arrange */
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[0];
+    CFE_SBN_Client_BufferD_t *buf = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    int32 full_result;
+    int32 result;
+    
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->SubscribedMsgIds[0] = 0x1800;
+    pipe->MsgLim[0] = 1;
+    CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    full_result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Act */ 
+    CFE_SBN_Client_ReleaseBuffer(CFE_SBN_Client_PipeDequeue(pipe));
+    result = CFE_SBN_Client_PipeEnqueue(pipe, buf, pipe->Generation);
+    
+    /* Assert */
+    UtAssert_True(full_result == CFE_SBN_CLIENT_MSG_LIM_ERR, 
+        "CFE_SBN_Client_PipeEnqueue returned CFE_SBN_CLIENT_MSG_LIM_ERR "
+        "with MsgLim messages waiting");
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+        "CFE_SBN_Client_PipeEnqueue returned SBN_CLIENT_SUCCESS once the "
+        "message was read");
+    UtAssert_True(pipe->MsgCount[0] == 1, 
+        "MsgCount should be 1 and was %u", pipe->MsgCount[0]);
+    UtAssert_True(pipe->MsgLimDrops[0] == 1, 
+        "MsgLimDrops should be 1 and was %u", pipe->MsgLimDrops[0]);
+}
+/* end CFE_SBN_Client_PipeDequeue Tests*/
+
 /*************************************************/
 
 void Test_CFE_SBN_Client_GetMessageSubscribeIndex_FailsMaxMessagesHit(CFE_SB_PipeId_t PipeId)
@@ -557,6 +1336,7 @@ void UtTest_Setup(void)
     
     /* connect_to_server Tests */
     add_connect_to_server_tests();
+    add_connect_to_unix_server_tests();
     
     /* CFE_SBN_Client_GetPipeIdx Tests */
     UtTest_Add(
@@ -581,6 +1361,116 @@ void UtTest_Setup(void)
       Test_CFE_SBN_CLIENT_ReadBytes_ReturnsCfeSuccessWhenAllBytesReceived, 
       SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
       "Test_CFE_SBN_CLIENT_ReadBytes_ReturnsCfeSuccessWhenAllBytesReceived");
+    UtTest_Add(
+      Test_CFE_SBN_CLIENT_ReadBytes_ServesConsecutiveReadsFromOneRead, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_CLIENT_ReadBytes_ServesConsecutiveReadsFromOneRead");
+    UtTest_Add(
+      Test_CFE_SBN_CLIENT_ReadBytes_ReturnsTimeoutWhenFrameStalls, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_CLIENT_ReadBytes_ReturnsTimeoutWhenFrameStalls");
+    
+    /* CFE_SBN_CLIENT_DiscardBytes Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_CLIENT_DiscardBytes_SkipsBufferedBytesWithoutReading, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_CLIENT_DiscardBytes_SkipsBufferedBytesWithoutReading");
+    UtTest_Add(
+      Test_CFE_SBN_CLIENT_DiscardBytes_ReturnsErrorWhenPipeClosed, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_CLIENT_DiscardBytes_ReturnsErrorWhenPipeClosed");
+    
+    /* CFE_SBN_Client_AllocPipeRing Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_Client_AllocPipeRing_RoundsRingUpToPowerOfTwo, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_AllocPipeRing_RoundsRingUpToPowerOfTwo");
+    
+    /* CFE_SBN_Client_PipeEnqueue Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_AddsReferenceToBufferAtTail, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_AddsReferenceToBufferAtTail");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_FailsWhenPipeIsFull, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_FailsWhenPipeIsFull");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_FailsWhenPipeIsNotInUse, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_FailsWhenPipeIsNotInUse");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_FailsForEarlierGeneration, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_FailsForEarlierGeneration");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_LastProducerOutOfClosingPipeSignals, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_LastProducerOutOfClosingPipeSignals");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_FailsWhenQueueDepthIsReached, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_FailsWhenQueueDepthIsReached");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_DropOldestReplacesOldestMessage, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_DropOldestReplacesOldestMessage");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_BlockWaitsForReader, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_BlockWaitsForReader");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_BlockFailsWhenPipeIsDeleted, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_BlockFailsWhenPipeIsDeleted");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueue_LetsNextProducerWrite, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueue_LetsNextProducerWrite");
+    
+    /* CFE_SBN_Client_PipeEnqueueNoWait Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueueNoWait_DropsWhenBlockPipeIsFull, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueueNoWait_DropsWhenBlockPipeIsFull");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeEnqueueNoWait_DropsWhileProducerWaits, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeEnqueueNoWait_DropsWhileProducerWaits");
+    
+    /* CFE_SBN_Client_PipeWakeWriter Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeWakeWriter_SignalsWaitingWriter, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeWakeWriter_SignalsWaitingWriter");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeWakeWriter_DoesNothingWithoutWaitingWriter, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeWakeWriter_DoesNothingWithoutWaitingWriter");
+    
+    /* CFE_SBN_Client_PipeWaitForProducers Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeWaitForProducers_WaitsForLastProducer, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeWaitForProducers_WaitsForLastProducer");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeWaitForProducers_DoesNotWaitWithoutProducers, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeWaitForProducers_DoesNotWaitWithoutProducers");
+    
+    /* CFE_SBN_Client_PipeDequeue Tests*/
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeDequeue_ReturnsNullWhenPipeIsEmpty, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeDequeue_ReturnsNullWhenPipeIsEmpty");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeDequeue_ReturnsMessagesInOrder, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeDequeue_ReturnsMessagesInOrder");
+    UtTest_Add(
+      Test_CFE_SBN_Client_PipeDequeue_MakesRoomUnderMsgLim, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_CFE_SBN_Client_PipeDequeue_MakesRoomUnderMsgLim");
 
 }
 
@@ -677,9 +1567,13 @@ void add_connect_to_server_tests(void)
       SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
       "Test_connect_to_server_Outlog_message_EFAULT_errorFromConnectCall");  
     UtTest_Add(
-      Test_connect_to_server_Outlog_message_EINPROGRESS_errorFromConnectCall, 
+      Test_connect_to_server_WaitsForConnectInProgress, 
       SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
-      "Test_connect_to_server_Outlog_message_EINPROGRESS_errorFromConnectCall");  
+      "Test_connect_to_server_WaitsForConnectInProgress");
+    UtTest_Add(
+      Test_connect_to_server_returns_error_WhenConnectTimesOut, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_connect_to_server_returns_error_WhenConnectTimesOut");
     UtTest_Add(
       Test_connect_to_server_Outlog_message_EINTR_errorFromConnectCall, 
       SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
@@ -704,4 +1598,20 @@ void add_connect_to_server_tests(void)
       Test_connect_to_server_Outlog_message_ETIMEDOUT_errorFromConnectCall, 
       SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
       "Test_connect_to_server_Outlog_message_ETIMEDOUT_errorFromConnectCall");  
-}
\ No newline at end of file
+}
+
+void add_connect_to_unix_server_tests(void)
+{
+    UtTest_Add(
+      Test_connect_to_unix_server_ConnectsToStandInSbn, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_connect_to_unix_server_ConnectsToStandInSbn");
+    UtTest_Add(
+      Test_connect_to_unix_server_FailsWhenNoSbnListens, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_connect_to_unix_server_FailsWhenNoSbnListens");
+    UtTest_Add(
+      Test_connect_to_unix_server_FailsWhenPathIsTooLong, 
+      SBN_Client_Utils_Tests_Setup, SBN_Client_Utils_Tests_Teardown, 
+      "Test_connect_to_unix_server_FailsWhenPathIsTooLong");
+}
@@ -14,6 +14,16 @@
 
 CFE_SB_PipeId_t pipePtr;
 uint16 pipe_depth = 5;
+/* pipe that receives a message while RcvMsg waits on it */
+CFE_SBN_Client_PipeD_t *pipe_receiving_during_wait = NULL;
+unsigned char *msg_received_during_wait = NULL;
+size_t msg_size_received_during_wait = 0;
+
+void wrap_pthread_cond_wait_receive_message(void)
+{
+    Put_Message_In_Pipe(pipe_receiving_during_wait, msg_received_during_wait, 
+      msg_size_received_during_wait);
+}
 const char *pipeName = "TestPipe";
 
 /*******************************************************************************
@@ -33,6 +43,9 @@ void SBN_Client_Wrappers_Tests_Teardown(void)
     
     pipePtr = 0;
     pipe_depth = 5;
+    pipe_receiving_during_wait = NULL;
+    msg_received_during_wait = NULL;
+    msg_size_received_during_wait = 0;
 } /* end SBN_Client_Wrappers_Tests_Teardown */
 
 /*******************************************************************************
@@ -43,7 +56,9 @@ void SBN_Client_Wrappers_Tests_Teardown(void)
 
 void Test__wrap_CFE_SB_CreatePipe_Results_In_CFE_SUCCESS(void)
 {
-  /* Arrange - none required */
+  /* Arrange */
+  invalidate_pipe(&PipeTbl[0]); /* an unused pipe has no ring */
+  
   /* Act */ 
   int32 result = CFE_SB_CreatePipe(&pipePtr, pipe_depth, pipeName);
   
@@ -55,7 +70,9 @@ void Test__wrap_CFE_SB_CreatePipe_Results_In_CFE_SUCCESS(void)
 
 void Test__wrap_CFE_SB_CreatePipe_InitializesPipeCorrectly(void)
 {
-  /* Arrange - none required */
+  /* Arrange */
+  invalidate_pipe(&PipeTbl[0]); /* an unused pipe has no ring */
+  
   /* Act */ 
   CFE_SB_CreatePipe(&pipePtr, pipe_depth, pipeName);
   
@@ -73,14 +90,32 @@ void Test__wrap_CFE_SB_CreatePipe_InitializesPipeCorrectly(void)
   UtAssert_True(strcmp(&PipeTbl[0].PipeName[0], pipeName) == 0, 
   "PipeTbl[0].PipeName should be %s and was %s", pipeName, 
     PipeTbl[0].PipeName);
-  UtAssert_True(PipeTbl[0].NumberOfMessages == 0, 
-    "PipeTbl[0].NumberOfMessages should be %d and was %d", 0, 
-    PipeTbl[0].NumberOfMessages);
-  UtAssert_True(PipeTbl[0].ReadMessage == 0, 
-    "PipeTbl[0].ReadMessage should be %d and was %d", 0, 
-    PipeTbl[0].ReadMessage);
+  UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[0]) == 0, 
+    "PipeTbl[0] message count should be %d and was %u", 0, 
+    CFE_SBN_Client_PipeMsgCount(&PipeTbl[0]));
+  UtAssert_True(PipeTbl[0].CurrentBuff == NULL, 
+    "PipeTbl[0].CurrentBuff should be NULL");
 } /* end Test__wrap_CFE_SB_CreatePipe_InitializesPipeCorrectly */
 
+void Test__wrap_CFE_SB_CreatePipe_AllocatesRingForDepth(void)
+{
+  /* Arrange */
+  invalidate_pipe(&PipeTbl[0]); /* an unused pipe has no ring */
+  
+  /* Act */ 
+  CFE_SB_CreatePipe(&pipePtr, pipe_depth, pipeName);
+  
+  /* Assert */
+  UtAssert_True(PipeTbl[0].Messages != NULL, 
+    "PipeTbl[0].Messages should have been allocated");
+  UtAssert_True(PipeTbl[0].QueueDepth == pipe_depth, 
+    "PipeTbl[0].QueueDepth should be %d and was %d", pipe_depth, 
+    PipeTbl[0].QueueDepth);
+  UtAssert_True(PipeTbl[0].RingMask == 7, 
+    "PipeTbl[0].RingMask should be 7 for a depth of %d and was %u", 
+    pipe_depth, PipeTbl[0].RingMask);
+} /* end Test__wrap_CFE_SB_CreatePipe_AllocatesRingForDepth */
+
 void Test__wrap_CFE_SB_CreatePipe_SendsMaxPipesErrorWhenPipesAreFull(void)
 {
   /* Arrange */
@@ -111,14 +146,267 @@ void Test__wrap_CFE_SB_CreatePipe_SendsMaxPipesErrorWhenPipesAreFull(void)
   // expected_error_msg);
 } /* end Test__wrap_CFE_SB_CreatePipe_SendsMaxPipesErrorWhenPipesAreFull */
 
+void Test__wrap_CFE_SB_CreatePipe_DefaultsToDropNewest(void)
+{
+  /* Arrange */
+  invalidate_pipe(&PipeTbl[0]); /* an unused pipe has no ring */
+  PipeTbl[0].OverflowPolicy = SBN_CLIENT_OVERFLOW_BLOCK;
+  
+  /* Act */ 
+  CFE_SB_CreatePipe(&pipePtr, pipe_depth, pipeName);
+  
+  /* Assert */
+  UtAssert_True(PipeTbl[0].OverflowPolicy == SBN_CLIENT_OVERFLOW_DROP_NEWEST, 
+    "PipeTbl[0].OverflowPolicy should be %d and was %d", 
+    SBN_CLIENT_OVERFLOW_DROP_NEWEST, PipeTbl[0].OverflowPolicy);
+} /* end Test__wrap_CFE_SB_CreatePipe_DefaultsToDropNewest */
+
+void Test__wrap_CFE_SB_CreatePipe_DoesNotTakeClosingPipe(void)
+{
+  /* Arrange */
+  invalidate_pipe(&PipeTbl[0]);
+  invalidate_pipe(&PipeTbl[1]); /* an unused pipe has no ring */
+  PipeTbl[0].InUse = CFE_SBN_CLIENT_CLOSING;
+  
+  /* Act */ 
+  CFE_SB_CreatePipe(&pipePtr, pipe_depth, pipeName);
+  
+  /* Assert */
+  UtAssert_True(pipePtr == 1, 
+    "A pipe being deleted keeps its slot, pipe id should be 1 and was %d", 
+    pipePtr);
+  UtAssert_True(PipeTbl[0].InUse == CFE_SBN_CLIENT_CLOSING, 
+    "PipeTbl[0].InUse should still be %d and was %d", 
+    CFE_SBN_CLIENT_CLOSING, PipeTbl[0].InUse);
+} /* end Test__wrap_CFE_SB_CreatePipe_DoesNotTakeClosingPipe */
+
 /* end __wrap_CFE_SB_CreatePipe Tests */
 
+/*******************************************************************************
+**
+**  SBN_Client_CreatePipeEx Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_CreatePipeEx_SetsOverflowPolicy(void)
+{
+  /* Arrange */
+  uint8 policy = rand() % (SBN_CLIENT_OVERFLOW_BLOCK + 1);
+  
+  invalidate_pipe(&PipeTbl[0]); /* an unused pipe has no ring */
+  PipeTbl[0].SendErrors = Any_Positive_int32();
+  PipeTbl[0].DroppedBytes = Any_Positive_int32();
+  
+  /* Act */ 
+  int32 result = SBN_Client_CreatePipeEx(&pipePtr, pipe_depth, pipeName, 
+    policy);
+  
+  /* Assert */
+  UtAssert_True(result == CFE_SUCCESS, 
+    "SBN_Client_CreatePipeEx result should be %d and was %d", CFE_SUCCESS, 
+    result);
+  UtAssert_True(PipeTbl[0].OverflowPolicy == policy, 
+    "PipeTbl[0].OverflowPolicy should be %d and was %d", policy, 
+    PipeTbl[0].OverflowPolicy);
+  UtAssert_True(PipeTbl[0].SendErrors == 0 && PipeTbl[0].DroppedBytes == 0, 
+    "PipeTbl[0] drop counters should have been cleared");
+} /* end Test_SBN_Client_CreatePipeEx_SetsOverflowPolicy */
+
+void Test_SBN_Client_CreatePipeEx_FailsWithUnknownOverflowPolicy(void)
+{
+  /* Arrange */
+  uint8 policy = SBN_CLIENT_OVERFLOW_BLOCK + 1 + 
+    (rand() % (UCHAR_MAX - SBN_CLIENT_OVERFLOW_BLOCK));
+  
+  invalidate_pipe(&PipeTbl[0]); /* an unused pipe has no ring */
+  
+  /* Act */ 
+  int32 result = SBN_Client_CreatePipeEx(&pipePtr, pipe_depth, pipeName, 
+    policy);
+  
+  /* Assert */
+  UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+    "SBN_Client_CreatePipeEx result should be %d and was %d", 
+    CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+  UtAssert_True(PipeTbl[0].InUse == CFE_SBN_CLIENT_NOT_IN_USE, 
+    "PipeTbl[0] should not have been created");
+} /* end Test_SBN_Client_CreatePipeEx_FailsWithUnknownOverflowPolicy */
+
+/* end SBN_Client_CreatePipeEx Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_GetPipeDropCounts Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_GetPipeDropCounts_ReturnsPipeCounters(void)
+{
+  /* Arrange */
+  CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
+  uint32 dropped_msgs = Any_Positive_int32();
+  uint32 dropped_bytes = Any_Positive_int32();
+  uint32 msgs_out, bytes_out;
+  
+  PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
+  PipeTbl[pipe_assigned].PipeId = pipe_assigned;
+  PipeTbl[pipe_assigned].SendErrors = dropped_msgs;
+  PipeTbl[pipe_assigned].DroppedBytes = dropped_bytes;
+  
+  /* Act */ 
+  int32 result = SBN_Client_GetPipeDropCounts(pipe_assigned, &msgs_out, 
+    &bytes_out);
+  
+  /* Assert */
+  UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+    "SBN_Client_GetPipeDropCounts result should be %d and was %d", 
+    SBN_CLIENT_SUCCESS, result);
+  UtAssert_True(msgs_out == dropped_msgs, 
+    "dropped messages should be %u and were %u", dropped_msgs, msgs_out);
+  UtAssert_True(bytes_out == dropped_bytes, 
+    "dropped bytes should be %u and were %u", dropped_bytes, bytes_out);
+} /* end Test_SBN_Client_GetPipeDropCounts_ReturnsPipeCounters */
+
+void Test_SBN_Client_GetPipeDropCounts_FailsInvalidPipe(void)
+{
+  /* Arrange */
+  CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
+  uint32 msgs_out, bytes_out;
+  
+  PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+  
+  /* Act */ 
+  int32 result = SBN_Client_GetPipeDropCounts(pipe_assigned, &msgs_out, 
+    &bytes_out);
+  
+  /* Assert */
+  UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+    "SBN_Client_GetPipeDropCounts result should be %d and was %d", 
+    CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test_SBN_Client_GetPipeDropCounts_FailsInvalidPipe */
+
+void Test_SBN_Client_GetPipeDropCounts_FailsNullCounter(void)
+{
+  /* Arrange */
+  CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
+  uint32 msgs_out;
+  
+  PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
+  PipeTbl[pipe_assigned].PipeId = pipe_assigned;
+  
+  /* Act */ 
+  int32 result = SBN_Client_GetPipeDropCounts(pipe_assigned, &msgs_out, NULL);
+  
+  /* Assert */
+  UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+    "SBN_Client_GetPipeDropCounts result should be %d and was %d", 
+    CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test_SBN_Client_GetPipeDropCounts_FailsNullCounter */
+
+/* end SBN_Client_GetPipeDropCounts Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_GetSubscriptionCounts Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_GetSubscriptionCounts_ReturnsSubscriptionCounters(void)
+{
+  /* Arrange */
+  CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
+  int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
+  uint16 msgs_waiting = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
+  uint32 drops = Any_Positive_int32();
+  uint16 waiting_out;
+  uint32 drops_out;
+  
+  PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
+  PipeTbl[pipe_assigned].PipeId = pipe_assigned;
+  PipeTbl[pipe_assigned].SubscribedMsgIds[msg_id_slot] = 0x1800;
+  PipeTbl[pipe_assigned].MsgCount[msg_id_slot] = msgs_waiting;
+  PipeTbl[pipe_assigned].MsgLimDrops[msg_id_slot] = drops;
+  
+  /* Act */ 
+  int32 result = SBN_Client_GetSubscriptionCounts(0x1800, pipe_assigned, 
+    &waiting_out, &drops_out);
+  
+  /* Assert */
+  UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+    "SBN_Client_GetSubscriptionCounts result should be %d and was %d", 
+    SBN_CLIENT_SUCCESS, result);
+  UtAssert_True(waiting_out == msgs_waiting, 
+    "waiting messages should be %u and were %u", msgs_waiting, waiting_out);
+  UtAssert_True(drops_out == drops, 
+    "MsgLim drops should be %u and were %u", drops, drops_out);
+} /* end Test_SBN_Client_GetSubscriptionCounts_ReturnsSubscriptionCounters */
+
+void Test_SBN_Client_GetSubscriptionCounts_FailsWhenNotSubscribed(void)
+{
+  /* Arrange */
+  CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
+  uint16 waiting_out;
+  uint32 drops_out;
+  
+  PipeTbl[pipe_assigned].InUse = CFE_SBN_CLIENT_IN_USE;
+  PipeTbl[pipe_assigned].PipeId = pipe_assigned;
+  
+  /* Act */ 
+  int32 result = SBN_Client_GetSubscriptionCounts(0x1800, pipe_assigned, 
+    &waiting_out, &drops_out);
+  
+  /* Assert */
+  UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+    "SBN_Client_GetSubscriptionCounts result should be %d and was %d", 
+    CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test_SBN_Client_GetSubscriptionCounts_FailsWhenNotSubscribed */
+
+/* end SBN_Client_GetSubscriptionCounts Tests */
+
 /*******************************************************************************
 **
 **  __wrap_CFE_SB_DeletePipe Tests
 **
 *******************************************************************************/
 
+/* connects the client to a socketpair standing in for SBN, fds[1] is SBN.
+ * Packets keep each frame the client sends apart for Sub_Frame_Sent_To_Sbn */
+void Connect_To_Test_Sbn(int *fds)
+{
+    socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds);
+    sbn_client_sockfd = fds[0];
+} /* end Connect_To_Test_Sbn */
+
+/* takes the next frame the client sent SBN, returning its type or -1 when 
+ * nothing was sent */
+int Sub_Frame_Sent_To_Sbn(int sbn_fd)
+{
+    unsigned char sent[1024];
+    
+    if (recv(sbn_fd, sent, sizeof(sent), MSG_DONTWAIT) < 3)
+    {
+        return -1;
+    }
+    
+    return sent[2];
+} /* end Sub_Frame_Sent_To_Sbn */
+
+/* takes the next frame the client sent SBN, returning how many 
+ * subscriptions it holds or -1 when nothing was sent */
+int Subs_In_Frame_Sent_To_Sbn(int sbn_fd)
+{
+    unsigned char sent[SBN_PACKED_SUB_SZ];
+    
+    if (recv(sbn_fd, sent, sizeof(sent), MSG_DONTWAIT) < 
+        SBN_PACKED_HDR_SZ + SBN_IDENT_LEN + 2)
+    {
+        return -1;
+    }
+    
+    return sent[SBN_PACKED_HDR_SZ + SBN_IDENT_LEN] << 8 | 
+           sent[SBN_PACKED_HDR_SZ + SBN_IDENT_LEN + 1];
+} /* end Subs_In_Frame_Sent_To_Sbn */
+
 void Test__wrap_CFE_SB_DeletePipeSuccessWhenPipeIdIsCorrectAndInUse(void)
 {
   /* Arrange */
@@ -135,8 +423,208 @@ void Test__wrap_CFE_SB_DeletePipeSuccessWhenPipeIdIsCorrectAndInUse(void)
     pipeIdToDelete, CFE_SUCCESS, result);
 } /* end Test__wrap_CFE_SB_DeletePipeSuccessWhenPipeIdIsCorrectAndInUse */
 
+void Test__wrap_CFE_SB_DeletePipeRemovesPipeFromMsgIdRoutes(void)
+{
+  /* Arrange */
+  int pipeIdToDelete = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  int otherPipeId = (pipeIdToDelete + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  CFE_SB_MsgId_t msg_id = 0x1800;
+  uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+  uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+  uint16 num_routes;
+  PipeTbl[pipeIdToDelete].PipeId = pipeIdToDelete;  
+  PipeTbl[pipeIdToDelete].InUse = CFE_SBN_CLIENT_IN_USE;
+  PipeTbl[pipeIdToDelete].SubscribedMsgIds[0] = msg_id;
+  CFE_SBN_Client_AddRoute(msg_id, pipeIdToDelete);
+  CFE_SBN_Client_AddRoute(msg_id, otherPipeId);
+  
+  /* Act */ 
+  CFE_SB_DeletePipe(pipeIdToDelete);
+  
+  /* Assert */
+  num_routes = CFE_SBN_Client_GetRoutes(msg_id, routes, gens);
+  
+  UtAssert_True(num_routes == 1 && routes[0] == otherPipeId, 
+    "MsgId 0x%04X should route only to pipe %d, had %d routes", msg_id, 
+    otherPipeId, num_routes);
+} /* end Test__wrap_CFE_SB_DeletePipeRemovesPipeFromMsgIdRoutes */
+
+void Test__wrap_CFE_SB_DeletePipeReleasesMessagesHeldByPipe(void)
+{
+  /* Arrange */
+  unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
+  int pipeIdToDelete = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  PipeTbl[pipeIdToDelete].PipeId = pipeIdToDelete;  
+  PipeTbl[pipeIdToDelete].InUse = CFE_SBN_CLIENT_IN_USE;
+  Put_Message_In_Pipe(&PipeTbl[pipeIdToDelete], msg, sizeof(msg));
+  Put_Message_In_Pipe(&PipeTbl[pipeIdToDelete], msg, sizeof(msg));
+  
+  /* Act */ 
+  CFE_SB_DeletePipe(pipeIdToDelete);
+  
+  /* Assert */
+  UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+    "Buffers in use should be 0 and were %d", CFE_SBN_Client_BuffersInUse());
+} /* end Test__wrap_CFE_SB_DeletePipeReleasesMessagesHeldByPipe */
+
+void Test__wrap_CFE_SB_DeletePipeFreesRing(void)
+{
+  /* Arrange */
+  int pipeIdToDelete = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  PipeTbl[pipeIdToDelete].PipeId = pipeIdToDelete;  
+  PipeTbl[pipeIdToDelete].InUse = CFE_SBN_CLIENT_IN_USE;
+  
+  /* Act */ 
+  CFE_SB_DeletePipe(pipeIdToDelete);
+  
+  /* Assert */
+  UtAssert_True(PipeTbl[pipeIdToDelete].Messages == NULL, 
+    "PipeTbl[%d].Messages should be NULL", pipeIdToDelete);
+  UtAssert_True(PipeTbl[pipeIdToDelete].QueueDepth == 0, 
+    "PipeTbl[%d].QueueDepth should be 0 and was %d", pipeIdToDelete, 
+    PipeTbl[pipeIdToDelete].QueueDepth);
+} /* end Test__wrap_CFE_SB_DeletePipeFreesRing */
+
+void Test__wrap_CFE_SB_DeletePipeFreesSlotForNextGeneration(void)
+{
+  /* Arrange */
+  int pipeIdToDelete = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  uint32 generation = PipeTbl[pipeIdToDelete].Generation;
+  PipeTbl[pipeIdToDelete].PipeId = pipeIdToDelete;  
+  PipeTbl[pipeIdToDelete].InUse = CFE_SBN_CLIENT_IN_USE;
+  
+  /* Act */ 
+  CFE_SB_DeletePipe(pipeIdToDelete);
+  
+  /* Assert */
+  UtAssert_True(PipeTbl[pipeIdToDelete].InUse == CFE_SBN_CLIENT_NOT_IN_USE, 
+    "PipeTbl[%d].InUse should be %d and was %d", pipeIdToDelete, 
+    CFE_SBN_CLIENT_NOT_IN_USE, PipeTbl[pipeIdToDelete].InUse);
+  UtAssert_True(PipeTbl[pipeIdToDelete].Generation == generation + 1, 
+    "PipeTbl[%d].Generation should be %u and was %u", pipeIdToDelete, 
+    generation + 1, PipeTbl[pipeIdToDelete].Generation);
+} /* end Test__wrap_CFE_SB_DeletePipeFreesSlotForNextGeneration */
+
+void Test__wrap_CFE_SB_DeletePipeFailsWhenPipeIsClosing(void)
+{
+  /* Arrange */
+  int pipeIdToDelete = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  PipeTbl[pipeIdToDelete].PipeId = pipeIdToDelete;  
+  PipeTbl[pipeIdToDelete].InUse = CFE_SBN_CLIENT_CLOSING;
+  
+  /* Act */ 
+  int32 result = CFE_SB_DeletePipe(pipeIdToDelete);
+  
+  /* Assert */
+  UtAssert_True(result == -1, 
+    "CFE_SB_DeletePipe of a pipe being deleted should be -1 and was %d", 
+    result);
+  UtAssert_True(PipeTbl[pipeIdToDelete].InUse == CFE_SBN_CLIENT_CLOSING, 
+    "The other delete frees the slot, InUse should be %d and was %d", 
+    CFE_SBN_CLIENT_CLOSING, PipeTbl[pipeIdToDelete].InUse);
+} /* end Test__wrap_CFE_SB_DeletePipeFailsWhenPipeIsClosing */
+
+void Test__wrap_CFE_SB_DeletePipeTellsSbnOfLastSubscription(void)
+{
+  /* Arrange */
+  int fds[2];
+  int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  int other_pipe_id = (pipe_id + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+  PipeTbl[pipe_id].PipeId = pipe_id;  
+  PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+  PipeTbl[other_pipe_id].PipeId = other_pipe_id;  
+  PipeTbl[other_pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+  Connect_To_Test_Sbn(fds);
+  wrap_pthread_mutex_lock_should_be_called = TRUE;
+  wrap_pthread_mutex_unlock_should_be_called = TRUE;
+  CFE_SB_Subscribe(0x1800, pipe_id);
+  CFE_SB_Subscribe(0x1801, pipe_id);
+  CFE_SB_Subscribe(0x1801, other_pipe_id);
+  while (Sub_Frame_Sent_To_Sbn(fds[1]) != -1);
+  
+  /* Act */ 
+  int32 result = CFE_SB_DeletePipe(pipe_id);
+  
+  /* Assert */
+  UtAssert_True(result == CFE_SUCCESS, 
+    "CFE_SB_DeletePipe should return %d and was %d", CFE_SUCCESS, result);
+  UtAssert_True(Sub_Frame_Sent_To_Sbn(fds[1]) == SBN_UNSUB_MSG, 
+    "SBN should be unsubscribed from the MsgId only the pipe wanted");
+  UtAssert_True(Sub_Frame_Sent_To_Sbn(fds[1]) == -1, 
+    "SBN should stay subscribed to the MsgId another pipe wants");
+  
+  close(fds[0]);
+  close(fds[1]);
+} /* end Test__wrap_CFE_SB_DeletePipeTellsSbnOfLastSubscription */
+
 /* end __wrap_CFE_SB_DeletePipe Tests */
 
+/*******************************************************************************
+**
+**  CFE_SBN_Client_ResendSubscriptions Tests
+**
+*******************************************************************************/
+
+void Test_CFE_SBN_Client_ResendSubscriptions_SendsEachMsgIdOnce(void)
+{
+    /* Arrange */
+    int            fds[2];
+    int            subs_sent;
+    CFE_SB_MsgId_t shared_id = 0x1801;
+    CFE_SB_MsgId_t other_id = 0x1802;
+    
+    Connect_To_Test_Sbn(fds);
+    
+    PipeTbl[0].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[0].SubscribedMsgIds[1] = shared_id;
+    PipeTbl[2].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[2].SubscribedMsgIds[0] = other_id;
+    PipeTbl[2].SubscribedMsgIds[3] = shared_id;
+    /* a pipe no longer in use is not subscribed to anything */
+    PipeTbl[3].SubscribedMsgIds[0] = 0x1803;
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    CFE_SBN_Client_ResendSubscriptions();
+    
+    /* Assert */
+    subs_sent = Subs_In_Frame_Sent_To_Sbn(fds[1]);
+    
+    UtAssert_True(subs_sent == 2, 
+      "One frame of 2 subscriptions should be sent, it held %d", subs_sent);
+    UtAssert_True(Subs_In_Frame_Sent_To_Sbn(fds[1]) == -1, 
+      "Only one frame should be sent");
+    
+    close(fds[0]);
+    close(fds[1]);
+    sbn_client_sockfd = 0;
+} /* end Test_CFE_SBN_Client_ResendSubscriptions_SendsEachMsgIdOnce */
+
+void Test_CFE_SBN_Client_ResendSubscriptions_SendsNothingWithoutSubscriptions(void)
+{
+    /* Arrange */
+    int fds[2];
+    
+    Connect_To_Test_Sbn(fds);
+    
+    PipeTbl[0].InUse = CFE_SBN_CLIENT_IN_USE;
+    
+    /* Act */ 
+    CFE_SBN_Client_ResendSubscriptions();
+    
+    /* Assert */
+    UtAssert_True(Subs_In_Frame_Sent_To_Sbn(fds[1]) == -1, 
+      "No frame should be sent when nothing is subscribed");
+    
+    close(fds[0]);
+    close(fds[1]);
+    sbn_client_sockfd = 0;
+} /* end Test_CFE_SBN_Client_ResendSubscriptions_SendsNothingWithoutSubscriptions */
+
+/* end CFE_SBN_Client_ResendSubscriptions Tests */
+
 /*******************************************************************************
 **
 **  __wrap_CFE_SB_Subscribe Tests
@@ -165,6 +653,9 @@ void Test__wrap_CFE_SB_SubscribePipeIsValidMsgIdUnsubscribedNotAtMaxMsgIds(void)
         PipeTbl[pipe_id].SubscribedMsgIds[i] = CFE_SBN_CLIENT_INVALID_MSG_ID;
     }
     
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
     /* Act */ 
     int32 result = CFE_SB_Subscribe(msg_id, pipe_id);
     
@@ -178,6 +669,31 @@ void Test__wrap_CFE_SB_SubscribePipeIsValidMsgIdUnsubscribedNotAtMaxMsgIds(void)
       PipeTbl[pipe_id].SubscribedMsgIds[num_msgIds_subscribed]);    
 }
 
+void Test__wrap_CFE_SB_SubscribeAddsPipeToMsgIdRoutes(void)
+{
+    /* Arrange */
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id = 0x1800;
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint16 num_routes;
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    CFE_SB_Subscribe(msg_id, pipe_id);
+    
+    /* Assert */
+    num_routes = CFE_SBN_Client_GetRoutes(msg_id, routes, gens);
+    
+    UtAssert_True(num_routes == 1 && routes[0] == pipe_id, 
+      "MsgId 0x%04X should route only to pipe %d, had %d routes", msg_id, 
+      pipe_id, num_routes);
+} /* end Test__wrap_CFE_SB_SubscribeAddsPipeToMsgIdRoutes */
+
 void Test__wrap_CFE_SB_SubscribeFailsWhenPipeIsInvalid(void)
 {
     /* Arrange */
@@ -221,6 +737,61 @@ void Test__wrap_CFE_SB_SubscribeFailsWhenNumberOfMessagesForPipeIsExceeded(void)
       pipe_id, CFE_SBN_CLIENT_BAD_ARGUMENT, result);
 } /* end Test__wrap_CFE_SB_SubscribeFailsWhenNumberOfMessagesForPipeIsExceeded */
 
+void Test__wrap_CFE_SB_SubscribeTellsSbnOnlyForFirstPipe(void)
+{
+    /* Arrange */
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int other_pipe_id = (pipe_id + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int first_frame;
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    PipeTbl[other_pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[other_pipe_id].PipeId = other_pipe_id;
+    Connect_To_Test_Sbn(fds);
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    CFE_SB_Subscribe(0x1800, pipe_id);
+    first_frame = Sub_Frame_Sent_To_Sbn(fds[1]);
+    CFE_SB_Subscribe(0x1800, other_pipe_id);
+    
+    /* Assert */
+    UtAssert_True(first_frame == SBN_SUB_MSG, 
+      "SBN should be sent a subscription for the first pipe");
+    UtAssert_True(Sub_Frame_Sent_To_Sbn(fds[1]) == -1, 
+      "SBN should not be sent a subscription for the second pipe");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SubscribeTellsSbnOnlyForFirstPipe */
+
+void Test__wrap_CFE_SB_SubscribeDuplicateKeepsOneSubscription(void)
+{
+    /* Arrange */
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id = 0x1800;
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    CFE_SB_Subscribe(msg_id, pipe_id);
+    
+    /* Act */ 
+    int32 result = CFE_SB_Subscribe(msg_id, pipe_id);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "Call to CFE_SB_Subscribe should return %d and was %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(PipeTbl[pipe_id].SubscribedMsgIds[1] == 
+      CFE_SBN_CLIENT_INVALID_MSG_ID, 
+      "PipeTbl[%d] should be subscribed to 0x%04X only once", pipe_id, 
+      msg_id);
+} /* end Test__wrap_CFE_SB_SubscribeDuplicateKeepsOneSubscription */
+
 /* end __wrap_CFE_SB_Subscribe Tests */
 
 /*******************************************************************************
@@ -295,12 +866,10 @@ void Test__wrap_CFE_SB_RcvMsg_FailPthreadMutexLockFailure(void)
     /* Arrange */
     CFE_SB_MsgPtr_t buffer;
     CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
-    int32 timeout = CFE_SB_POLL;
-    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
+    int32 timeout = CFE_SB_PEND_FOREVER;
     int32 result;
     
-    pipe->NumberOfMessages = 1;
-    
+    /* the pipe is empty so RcvMsg has to lock it to wait */
     wrap_pthread_mutex_lock_should_be_called = TRUE;
     wrap_pthread_mutex_lock_return_value = Any_int_Except(0);
     use_wrap_CFE_SBN_Client_GetPipeIdx = TRUE;
@@ -323,13 +892,11 @@ void Test__wrap_CFE_SB_RcvMsg_PollRequestReturnsWhenNoMessage(void)
     CFE_SB_MsgPtr_t buffer;
     CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
     int32 timeout = CFE_SB_POLL;
-    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
     int32 result;
     
-    pipe->NumberOfMessages = 1;
-    
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    /* a poll never sleeps, so the pipe is never locked */
+    wrap_pthread_mutex_lock_should_be_called = FALSE;
+    wrap_pthread_mutex_unlock_should_be_called = FALSE;
     use_wrap_CFE_SBN_Client_GetPipeIdx = TRUE;
     wrap_CFE_SBN_Client_GetPipeIdx_return_value = pipe_assigned;
     
@@ -340,10 +907,8 @@ void Test__wrap_CFE_SB_RcvMsg_PollRequestReturnsWhenNoMessage(void)
     UtAssert_True(result == CFE_SB_NO_MESSAGE, 
       "__wrap_CFE_SB_RcvMsg returned CFE_SB_NO_MESSAGE, pipe empty, poll rqst");
     UtAssert_True(buffer == NULL, "__wrap_CFE_SB_RcvMsg set *BufPtr to NULL");
-    UtAssert_True(wrap_pthread_mutex_lock_was_called, 
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
-      "pthread_mutex_unlock was called");
+    UtAssert_True(wrap_pthread_mutex_lock_was_called == FALSE, 
+      "pthread_mutex_lock was not called");
 } /* end Test__wrap_CFE_SB_RcvMsg_PollRequestReturnsWhenNoMessage */
 
 void Test__wrap_CFE_SB_RcvMsg_FailsPendWhenWaitReturnsError(void)
@@ -359,12 +924,10 @@ void Test__wrap_CFE_SB_RcvMsg_FailsPendWhenWaitReturnsError(void)
     wrap_pthread_mutex_unlock_should_be_called = TRUE;
     wrap_pthread_cond_wait_should_be_called = TRUE;
     use_wrap_pthread_cond_wait = TRUE;
-    wrap_pthread_cond_timedwait_return_value = Any_int_Except(0);
+    wrap_pthread_cond_wait_return_value = Any_int_Except(0);
     use_wrap_CFE_SBN_Client_GetPipeIdx = TRUE;
     wrap_CFE_SBN_Client_GetPipeIdx_return_value = pipe_assigned;
 
-    pipe->NumberOfMessages = 1;
-
     /* Act */
     result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
 
@@ -378,6 +941,8 @@ void Test__wrap_CFE_SB_RcvMsg_FailsPendWhenWaitReturnsError(void)
       "pthread_cond_wait was called");
     UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
       "pthread_mutex_unlock was called");
+    UtAssert_True(pipe->ReaderWaiting == 0, 
+      "PipeTbl[%d].ReaderWaiting should be cleared", pipe_assigned);
 } /* end Test__wrap_CFE_SB_RcvMsg_FailsPendWhenWaitReturnsError */
 
 void Test__wrap_CFE_SB_RcvMsg_TimeoutReturnsNoMessageAfterTimeoutExpires(void)
@@ -397,8 +962,6 @@ void Test__wrap_CFE_SB_RcvMsg_TimeoutReturnsNoMessageAfterTimeoutExpires(void)
     use_wrap_CFE_SBN_Client_GetPipeIdx = TRUE;
     wrap_CFE_SBN_Client_GetPipeIdx_return_value = pipe_assigned;
 
-    pipe->NumberOfMessages = 1;
-
     /* Act */
     result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
 
@@ -412,35 +975,40 @@ void Test__wrap_CFE_SB_RcvMsg_TimeoutReturnsNoMessageAfterTimeoutExpires(void)
       "pthread_cond_timedwait was called");
     UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
       "pthread_mutex_unlock was called");
+    UtAssert_True(pipe->ReaderWaiting == 0, 
+      "PipeTbl[%d].ReaderWaiting should be cleared", pipe_assigned);
 } /* end Test__wrap_CFE_SB_RcvMsg_TimeoutReturnsNoMessageAfterTimeoutExpires */
 
-void Test__wrap_CFE_SB_RcvMsg_SuccessPollRequestHasMessageInPipe(void)
+/* Test__wrap_CFE_SB_RcvMsg_ReadsMessageInPipe checks a message already in the 
+ * pipe is returned without locking the pipe whatever the timeout */
+void Test__wrap_CFE_SB_RcvMsg_ReadsMessageInPipe(int32 timeout)
 {
     /* Arrange */
     size_t msgSize = Any_Message_Size();
     unsigned char *msg = Any_Pipe_Message(msgSize);
     CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();    
     CFE_SB_MsgId_t msg_id_slot = Any_Message_Id_Slot();
-    uint32 previous_read_msg = Any_Pipe_Message_Location();
-    uint32 current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wraps to 0 if necessary */
+    uint32 read_idx = rand();
     uint32 number_of_messages = rand() % 
       (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1) + 2; /* 2 to MAX */
+    uint32 i;
       
     CFE_SB_MsgPtr_t buffer;
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-    int32 timeout = CFE_SB_POLL;
     
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_mutex_lock_should_be_called = FALSE;
+    wrap_pthread_mutex_unlock_should_be_called = FALSE;
 
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
     pipe->SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    pipe->NumberOfMessages = number_of_messages;
-    pipe->ReadMessage = previous_read_msg;
+    pipe->ReadIdx = read_idx;
+    pipe->WriteIdx = read_idx;
     
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    for(i = 0; i < number_of_messages; i++)
+    {
+        Put_Message_In_Pipe(pipe, msg, msgSize);
+    }
     
     /* Act */ 
     int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
@@ -451,121 +1019,30 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessPollRequestHasMessageInPipe(void)
       result);
     UtAssert_MemCmp(buffer, msg, msgSize, "Message in buffer is as expected");    
     UtAssert_True(
-      PipeTbl[pipe_assigned].NumberOfMessages == number_of_messages - 1, 
-      "PipeTbl[%d].NumberOfMessages should have decreased by 1 to %d and is %d", 
+      CFE_SBN_Client_PipeMsgCount(pipe) == number_of_messages - 1, 
+      "PipeTbl[%d] message count should have decreased by 1 to %u and is %u", 
       pipe_assigned, number_of_messages - 1, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called, 
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
-        "pthread_mutex_unlock was called");
+      CFE_SBN_Client_PipeMsgCount(pipe));
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx + 1, 
+      "PipeTbl[%d].ReadIdx should have progressed to %u from %u and is %u", 
+      pipe_assigned, read_idx + 1, read_idx, PipeTbl[pipe_assigned].ReadIdx);
+    UtAssert_True(wrap_pthread_mutex_lock_was_called == FALSE, 
+      "pthread_mutex_lock was not called");
+} /* end Test__wrap_CFE_SB_RcvMsg_ReadsMessageInPipe */
+
+void Test__wrap_CFE_SB_RcvMsg_SuccessPollRequestHasMessageInPipe(void)
+{
+    Test__wrap_CFE_SB_RcvMsg_ReadsMessageInPipe(CFE_SB_POLL);
 } /* end Test__wrap_CFE_SB_RcvMsg_SuccessPollRequestHasMessageInPipe */
 
 void Test__wrap_CFE_SB_RcvMsg_SuccessTimeoutPendMessageAlreadyInPipe(void)
 {
-    /* Arrange */
-    size_t msgSize = Any_Message_Size();
-    unsigned char *msg = Any_Pipe_Message(msgSize);
-    CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();    
-    CFE_SB_MsgId_t msg_id_slot = Any_Message_Id_Slot();
-    uint32 previous_read_msg = Any_Pipe_Message_Location();
-    uint32 current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wraps to 0 if necessary */
-    uint32 number_of_messages = rand() % 
-      (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1) + 2; /* 2 to MAX */
-      
-    CFE_SB_MsgPtr_t buffer;
-    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-    int32 timeout = CFE_SB_PEND_FOREVER;
-    
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-
-    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
-    pipe->PipeId = pipe_assigned;
-    pipe->SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    pipe->NumberOfMessages = number_of_messages;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
-    
-    /* Act */ 
-    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
-
-    /* Assert */
-    UtAssert_True(result == CFE_SUCCESS, 
-      "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
-      result);
-    UtAssert_MemCmp(buffer, msg, msgSize, "Message in buffer is as expected"); 
-    UtAssert_True(
-      PipeTbl[pipe_assigned].NumberOfMessages == number_of_messages - 1, 
-      "PipeTbl[%d].NumberOfMessages should have decreased by 1 to %d and is %d", 
-      pipe_assigned, number_of_messages - 1, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(
-      PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
-    UtAssert_True(wrap_pthread_mutex_lock_was_called, 
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
-      "pthread_mutex_unlock was called");
+    Test__wrap_CFE_SB_RcvMsg_ReadsMessageInPipe(CFE_SB_PEND_FOREVER);
 } /* end Test__wrap_CFE_SB_RcvMsg_SuccessTimeoutPendMessageAlreadyInPipe */
 
 void Test__wrap_CFE_SB_RcvMsg_SuccessTimeoutValueMessageAlreadyInPipe(void)
 {
-    /* Arrange */
-    size_t msgSize = Any_Message_Size();
-    unsigned char *msg = Any_Pipe_Message(msgSize);
-    CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();    
-    CFE_SB_MsgId_t msg_id_slot = Any_Message_Id_Slot();
-    uint32 previous_read_msg = Any_Pipe_Message_Location();
-    uint32 current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wraps to 0 if necessary */
-    uint32 number_of_messages = rand() % 
-      (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1) + 2; /* 2 to MAX */
-      
-    CFE_SB_MsgPtr_t buffer;
-    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-    int32 timeout = Any_Positive_int32();
-    
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-
-    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
-    pipe->PipeId = pipe_assigned;
-    pipe->SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    pipe->NumberOfMessages = number_of_messages;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
-    
-    /* Act */ 
-    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
-
-    /* Assert */
-    UtAssert_True(result == CFE_SUCCESS, 
-      "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
-      result);
-    UtAssert_MemCmp(buffer, msg, msgSize, "Message in buffer is as expected"); 
-    UtAssert_True(
-      PipeTbl[pipe_assigned].NumberOfMessages == number_of_messages - 1, 
-      "PipeTbl[%d].NumberOfMessages should have decreased by 1 to %d and is %d", 
-      pipe_assigned, number_of_messages - 1, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);      
-    UtAssert_True(wrap_pthread_mutex_lock_was_called, 
-      "pthread_mutex_lock was called");
-    UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
-      "pthread_mutex_unlock was called");
+    Test__wrap_CFE_SB_RcvMsg_ReadsMessageInPipe(Any_Positive_int32());
 } /* end Test__wrap_CFE_SB_RcvMsg_SuccessTimeoutValueMessageAlreadyInPipe */
 
 void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageDuringWait(void)
@@ -575,10 +1052,7 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageDuringWait(void)
     unsigned char *msg = Any_Pipe_Message(msgSize);
     CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();    
     CFE_SB_MsgId_t msg_id_slot = Any_Message_Id_Slot();
-    uint32 previous_read_msg = Any_Pipe_Message_Location();
-    uint32 current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wraps to 0 if necessary */
-    uint32 number_of_messages = 1;
+    uint32 read_idx = rand();
       
     CFE_SB_MsgPtr_t buffer;
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
@@ -588,15 +1062,17 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageDuringWait(void)
     wrap_pthread_cond_wait_should_be_called = TRUE;
     use_wrap_pthread_cond_wait = TRUE;
     wrap_pthread_cond_wait_return_value = 0;
+    wrap_pthread_cond_wait_call_func = wrap_pthread_cond_wait_receive_message;
     wrap_pthread_mutex_unlock_should_be_called = TRUE;
 
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
     pipe->SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    pipe->NumberOfMessages = number_of_messages;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    pipe->ReadIdx = read_idx;
+    pipe->WriteIdx = read_idx;
+    pipe_receiving_during_wait = pipe;
+    msg_received_during_wait = msg;
+    msg_size_received_during_wait = msgSize;
     
     /* Act */ 
     int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
@@ -606,14 +1082,12 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageDuringWait(void)
       "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
       result);
     UtAssert_MemCmp(buffer, msg, msgSize, "Message in buffer is as expected"); 
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == 0, 
-      "PipeTbl[%d].NumberOfMessages should be 1", 
-      pipe_assigned, number_of_messages, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 0, 
+      "PipeTbl[%d] should be empty and has %u messages", 
+      pipe_assigned, CFE_SBN_Client_PipeMsgCount(pipe));
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx + 1, 
+      "PipeTbl[%d].ReadIdx should have progressed to %u from %u and is %u", 
+      pipe_assigned, read_idx + 1, read_idx, PipeTbl[pipe_assigned].ReadIdx);
     UtAssert_True(wrap_pthread_mutex_lock_was_called, 
       "pthread_mutex_lock was called");
     UtAssert_True(wrap_pthread_cond_wait_was_called, 
@@ -629,10 +1103,7 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageWithinTimeout(void)
     unsigned char *msg = Any_Pipe_Message(msgSize);
     CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();    
     CFE_SB_MsgId_t msg_id_slot = Any_Message_Id_Slot();
-    uint32 previous_read_msg = Any_Pipe_Message_Location();
-    uint32 current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wraps to 0 if necessary */
-    uint32 number_of_messages = 1;
+    uint32 read_idx = rand();
       
     CFE_SB_MsgPtr_t buffer;
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
@@ -642,15 +1113,17 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageWithinTimeout(void)
     wrap_pthread_cond_timedwait_should_be_called = TRUE;
     use_wrap_pthread_cond_timedwait = TRUE;
     wrap_pthread_cond_timedwait_return_value = 0;
+    wrap_pthread_cond_wait_call_func = wrap_pthread_cond_wait_receive_message;
     wrap_pthread_mutex_unlock_should_be_called = TRUE;
 
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
     pipe->SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    pipe->NumberOfMessages = number_of_messages;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    pipe->ReadIdx = read_idx;
+    pipe->WriteIdx = read_idx;
+    pipe_receiving_during_wait = pipe;
+    msg_received_during_wait = msg;
+    msg_size_received_during_wait = msgSize;
     
     /* Act */ 
     int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
@@ -660,14 +1133,12 @@ void Test__wrap_CFE_SB_RcvMsg_SuccessReceivesMessageWithinTimeout(void)
       "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
       result);
     UtAssert_MemCmp(buffer, msg, msgSize, "Message in buffer is as expected"); 
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == 0, 
-      "PipeTbl[%d].NumberOfMessages should be 1", 
-      pipe_assigned, number_of_messages, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == 0, 
+      "PipeTbl[%d] should be empty and has %u messages", 
+      pipe_assigned, CFE_SBN_Client_PipeMsgCount(pipe));
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx + 1, 
+      "PipeTbl[%d].ReadIdx should have progressed to %u from %u and is %u", 
+      pipe_assigned, read_idx + 1, read_idx, PipeTbl[pipe_assigned].ReadIdx);
     UtAssert_True(wrap_pthread_mutex_lock_was_called, 
       "pthread_mutex_lock was called");
     UtAssert_True(wrap_pthread_cond_timedwait_was_called, 
@@ -683,27 +1154,28 @@ void Test__wrap_CFE_SB_RcvMsg_FailsPthreadMutexUnlockFailure(void)
     unsigned char *msg = Any_Pipe_Message(msgSize);
     CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();    
     CFE_SB_MsgId_t msg_id_slot = Any_Message_Id_Slot();
-    uint32 previous_read_msg = Any_Pipe_Message_Location();
-    uint32 current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wraps to 0 if necessary */
-    uint32 number_of_messages = rand() % 
-      (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1) + 2; /* 2 to MAX */
+    uint32 read_idx = rand();
       
     CFE_SB_MsgPtr_t buffer;
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-    int32 timeout = CFE_SB_POLL;
+    int32 timeout = CFE_SB_PEND_FOREVER;
     
     wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_cond_wait_should_be_called = TRUE;
+    use_wrap_pthread_cond_wait = TRUE;
+    wrap_pthread_cond_wait_return_value = 0;
+    wrap_pthread_cond_wait_call_func = wrap_pthread_cond_wait_receive_message;
     wrap_pthread_mutex_unlock_should_be_called = TRUE;
     wrap_pthread_mutex_unlock_return_value = Any_int_Except(0);
 
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
     pipe->SubscribedMsgIds[msg_id_slot] = msg[0] << 8 | msg[1];
-    pipe->NumberOfMessages = number_of_messages;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    pipe->ReadIdx = read_idx;
+    pipe->WriteIdx = read_idx;
+    pipe_receiving_during_wait = pipe;
+    msg_received_during_wait = msg;
+    msg_size_received_during_wait = msgSize;
     
     /* Act */ 
     int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, timeout);
@@ -713,244 +1185,152 @@ void Test__wrap_CFE_SB_RcvMsg_FailsPthreadMutexUnlockFailure(void)
       "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SB_PIPE_RD_ERR, 
       result);
     UtAssert_True(buffer == NULL, "Buffer returned points to NULL");    
-    UtAssert_True(
-      PipeTbl[pipe_assigned].NumberOfMessages == number_of_messages - 1, 
-      "PipeTbl[%d].NumberOfMessages should have decreased by 1 to %d and is %d", 
-      pipe_assigned, number_of_messages - 1, 
-      PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
-      UtAssert_True(wrap_pthread_mutex_lock_was_called, 
-        "pthread_mutex_lock was called");
-      UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
-        "pthread_mutex_unlock was called");
+    UtAssert_True(PipeTbl[pipe_assigned].ReadIdx == read_idx + 1, 
+      "PipeTbl[%d].ReadIdx should have progressed to %u from %u and is %u", 
+      pipe_assigned, read_idx + 1, read_idx, PipeTbl[pipe_assigned].ReadIdx);
+    UtAssert_True(wrap_pthread_mutex_lock_was_called, 
+      "pthread_mutex_lock was called");
+    UtAssert_True(wrap_pthread_mutex_unlock_was_called, 
+      "pthread_mutex_unlock was called");
 } /* end Test__wrap_CFE_SB_RcvMsg_FailsPthreadMutexUnlockFailure */
 
-void Test__wrap_CFE_SB_RcvMsg_SuccessPipeIsFull(void)
+/* Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf checks the oldest of num_msg messages
+ * is returned when the ring read index is at read_idx */
+void Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf(uint32 num_msg, uint32 read_idx)
 {
     /* Arrange */
     unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
+    unsigned char other_msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0xFF, 0xFF};
     int msgSize = sizeof(msg);
     int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
-    
     int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-
-    int previous_read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-
-    int current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wrap to 0 if necessary */
-
-    int num_msg = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; 
-
+    uint32 current_read_msg = read_idx % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
     CFE_SB_MsgPtr_t buffer;
-
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-    
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    uint32 i;
 
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
     pipe->SubscribedMsgIds[msg_id_slot] = 0x1881;
-    pipe->NumberOfMessages = num_msg;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    pipe->ReadIdx = read_idx;
+    pipe->WriteIdx = read_idx;
     
-    /* Act */ 
-    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, 5000);
-
-    /* Assert */
-    int i = 0;
+    Put_Message_In_Pipe(pipe, msg, msgSize);
     
-    UtAssert_True(result == CFE_SUCCESS, 
-      "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
-      result);
-    for(i = 0; i < msgSize; i++)
+    for(i = 1; i < num_msg; i++)
     {
-      UtAssert_True(((unsigned char *)buffer)[i] == PipeTbl[pipe_assigned].
-        Messages[current_read_msg][i], "buffer[%d] should = %d and was %d", i, 
-        PipeTbl[pipe_assigned].Messages[current_read_msg][i], 
-        ((unsigned char *)buffer)[i]);
+        Put_Message_In_Pipe(pipe, other_msg, msgSize);
     }
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg - 1, 
-      "PipeTbl[%d].NumberOfMessages should have decreased by 1 to %d and is %d", 
-      pipe_assigned, num_msg - 1, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should have progressed to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
-} /* end Test__wrap_CFE_SB_RcvMsg_SuccessPipeIsFull */
-
-void Test__wrap_CFE_SB_RcvMsgSuccessAtLeastTwoMessagesInPipe(void)
-{
-    /* Arrange */
-    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
-    int msgSize = sizeof(msg);
-    int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
-    //printf("pipe_assigned = %d\n", pipe_assigned);
-    int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    //printf("msg_id_slot = %d\n", msg_id_slot);
-    int previous_read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    //printf("previous_read_msg = %d\n", previous_read_msg);
-    int current_read_msg = (previous_read_msg + 1) % 
-      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wrap to 0 if necessary */
-    //printf("current_read_msg = %d\n", current_read_msg);
-    int num_msg = (rand() % (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1)) + 2; 
-    //printf("num_msg = %d\n", num_msg);
-    CFE_SB_MsgPtr_t buffer;
-
-    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-    
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-
-    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
-    pipe->PipeId = pipe_assigned;
-    pipe->SubscribedMsgIds[msg_id_slot] = 0x1881;
-    pipe->NumberOfMessages = num_msg;
-    pipe->ReadMessage = previous_read_msg;
-    
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
     
     /* Act */ 
     int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, 5000);
 
     /* Assert */
-    int i = 0;
-    
     UtAssert_True(result == CFE_SUCCESS, 
       "__wrap_CFE_SB_RcvMsg did not succeed, result should be %d, but was %d", 
       CFE_SUCCESS, result);
     for(i = 0; i < msgSize; i++)
     {
-      UtAssert_True(((unsigned char *)buffer)[i] == PipeTbl[pipe_assigned].
-        Messages[current_read_msg][i], "buffer[%d] should = %d and was %d", i, 
-        PipeTbl[pipe_assigned].Messages[current_read_msg][i], 
+      UtAssert_True(((unsigned char *)buffer)[i] == msg[i], 
+        "buffer[%d] should = %d and was %d", i, msg[i], 
         ((unsigned char *)buffer)[i]);
     }
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg - 1, 
-      "PipeTbl[%d].NumberOfMessages should decrease by 1 to %d and is %d", 
-      pipe_assigned, num_msg - 1, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should progress to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
+    UtAssert_True(pipe->CurrentBuff->Buffer == 
+      Pipe_Message_Data(pipe, current_read_msg), 
+      "PipeTbl[%d].CurrentBuff should be the message read from slot %u", 
+      pipe_assigned, current_read_msg);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(pipe) == num_msg - 1, 
+      "PipeTbl[%d] message count should decrease by 1 to %u and is %u", 
+      pipe_assigned, num_msg - 1, CFE_SBN_Client_PipeMsgCount(pipe));
+} /* end Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf */
+
+void Test__wrap_CFE_SB_RcvMsg_SuccessPipeIsFull(void)
+{
+    Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf(
+      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH, rand());
+} /* end Test__wrap_CFE_SB_RcvMsg_SuccessPipeIsFull */
+
+void Test__wrap_CFE_SB_RcvMsgSuccessAtLeastTwoMessagesInPipe(void)
+{
+    Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf(
+      (rand() % (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1)) + 2, rand());
 } /* end Test__wrap_CFE_SB_RcvMsgSuccessAtLeastTwoMessagesInPipe */
 
 void Test__wrap_CFE_SB_RcvMsgSuccessTwoMessagesInPipe(void)
+{
+    Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf(2, rand());
+} /* end Test__wrap_CFE_SB_RcvMsgSuccessTwoMessagesInPipe */
+
+void Test__wrap_CFE_SB_RcvMsgSuccessPreviousMessageIsAtEndOfPipe(void)
+{
+    /* the oldest message is in slot 0 after wrapping */
+    Test__wrap_CFE_SB_RcvMsg_ReadsOldestOf(
+      (rand() % (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1)) + 2, 
+      CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH);
+} /* end Test__wrap_CFE_SB_RcvMsgSuccessPreviousMessageIsAtEndOfPipe */
+
+void Test__wrap_CFE_SB_RcvMsg_WakesProducerWaitingForSpace(void)
 {
     /* Arrange */
-    unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
-    int msgSize = sizeof(msg);
-    int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
-    //printf("pipe_assigned = %d\n", pipe_assigned);
-    int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    //printf("msg_id_slot = %d\n", msg_id_slot);
-    int previous_read_msg = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH;
-    //printf("previous_read_msg = %d\n", previous_read_msg);
-    int current_read_msg = (previous_read_msg + 1) % 
-    CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; /* auto wrap to 0 if necessary */
-    //printf("current_read_msg = %d\n", current_read_msg);
-    int num_msg = 2; 
-    //printf("num_msg = %d\n", num_msg);
+    size_t msgSize = Any_Message_Size();
+    unsigned char *msg = Any_Pipe_Message(msgSize);
+    CFE_SB_PipeId_t pipe_assigned = Any_CFE_SB_PipeId_t();
     CFE_SB_MsgPtr_t buffer;
-
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
-
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-
+    
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
-    pipe->SubscribedMsgIds[msg_id_slot] = 0x1881;
-    pipe->NumberOfMessages = num_msg;
-    pipe->ReadMessage = previous_read_msg;
+    Put_Message_In_Pipe(pipe, msg, msgSize);
+    pipe->WriterWaiting = 1;
     
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    wrap_pthread_cond_signal_should_be_called = TRUE;
     
     /* Act */ 
-    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, 5000);
+    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, CFE_SB_POLL);
 
     /* Assert */
-    int i = 0;
-    
     UtAssert_True(result == CFE_SUCCESS, 
-      "__wrap_CFE_SB_RcvMsg did not succeed, result should be %d, but was %d", 
-      CFE_SUCCESS, result);
-    for(i = 0; i < msgSize; i++)
-    {
-      UtAssert_True(((unsigned char *)buffer)[i] == PipeTbl[pipe_assigned].
-        Messages[current_read_msg][i], 
-        "buffer[%d] should = %d and was %d", i, 
-        PipeTbl[pipe_assigned].Messages[current_read_msg][i], 
-        ((unsigned char *)buffer)[i]);
-    }
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg - 1, 
-      "PipeTbl[%d].NumberOfMessages should decrease by 1 to %d and is %d", 
-      pipe_assigned, num_msg - 1, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should progress to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
-} /* end Test__wrap_CFE_SB_RcvMsgSuccessTwoMessagesInPipe */
+      "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(wrap_pthread_cond_signal_cond == &pipe->SpaceAvail, 
+      "PipeTbl[%d].SpaceAvail should have been signalled", pipe_assigned);
+} /* end Test__wrap_CFE_SB_RcvMsg_WakesProducerWaitingForSpace */
 
-void Test__wrap_CFE_SB_RcvMsgSuccessPreviousMessageIsAtEndOfPipe(void)
+void Test__wrap_CFE_SB_RcvMsg_ReleasesPreviouslyReceivedMessage(void)
 {
     /* Arrange */
     unsigned char msg[8] = {0x18, 0x81, 0xC0, 0x00, 0x00, 0x01, 0x00, 0x00};
-    int msgSize = sizeof(msg);
     int pipe_assigned = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
-    //printf("pipe_assigned = %d\n", pipe_assigned);
-    int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
-    //printf("msg_id_slot = %d\n", msg_id_slot);
-    int previous_read_msg = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1;
-    //printf("previous_read_msg = %d\n", previous_read_msg);
-    int current_read_msg = 0; /* auto wrap to 0 if necessary */
-    //printf("current_read_msg = %d\n", current_read_msg);
-    int num_msg = (rand() % (CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 1)) + 2; 
-    //printf("num_msg = %d\n", num_msg);
+    CFE_SBN_Client_BufferD_t *previous_buff;
     CFE_SB_MsgPtr_t buffer;
-
     CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_assigned];
 
-    wrap_pthread_mutex_lock_should_be_called = TRUE;
-    wrap_pthread_mutex_unlock_should_be_called = TRUE;
-
     pipe->InUse = CFE_SBN_CLIENT_IN_USE;
     pipe->PipeId = pipe_assigned;
-    pipe->SubscribedMsgIds[msg_id_slot] = 0x1881;
-    pipe->NumberOfMessages = num_msg;
-    pipe->ReadMessage = previous_read_msg;
     
-    memcpy(pipe->Messages[current_read_msg], msg, msgSize);
+    Put_Message_In_Pipe(pipe, msg, sizeof(msg));
+    Put_Message_In_Pipe(pipe, msg, sizeof(msg));
+    CFE_SB_RcvMsg(&buffer, pipe_assigned, CFE_SB_POLL);
+    previous_buff = pipe->CurrentBuff;
     
     /* Act */ 
-    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, 5000);
+    int32 result = CFE_SB_RcvMsg(&buffer, pipe_assigned, CFE_SB_POLL);
 
     /* Assert */
-    int i = 0;
-    
     UtAssert_True(result == CFE_SUCCESS, 
-      "__wrap_CFE_SB_RcvMsg did not succeed, result should be %d, but was %d", 
-      CFE_SUCCESS, result);
-    for(i = 0; i < msgSize; i++)
-    {
-      UtAssert_True(((unsigned char *)buffer)[i] == PipeTbl[pipe_assigned].
-        Messages[current_read_msg][i], "buffer[%d] should = %d and was %d", i, 
-        PipeTbl[pipe_assigned].Messages[current_read_msg][i], 
-        ((unsigned char *)buffer)[i]);
-    }
-    UtAssert_True(PipeTbl[pipe_assigned].NumberOfMessages == num_msg - 1, 
-      "PipeTbl[%d].NumberOfMessages should decrease by 1 to %d and is %d", 
-      pipe_assigned, num_msg - 1, PipeTbl[pipe_assigned].NumberOfMessages);
-    UtAssert_True(PipeTbl[pipe_assigned].ReadMessage == current_read_msg, 
-      "PipeTbl[%d].ReadMessage should progress to %d from %d and is %d", 
-      pipe_assigned, current_read_msg, previous_read_msg, 
-      PipeTbl[pipe_assigned].ReadMessage);
-} /* end Test__wrap_CFE_SB_RcvMsgSuccessPreviousMessageIsAtEndOfPipe */
+      "__wrap_CFE_SB_RcvMsg result should be %d and was %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(pipe->CurrentBuff != previous_buff, 
+      "PipeTbl[%d].CurrentBuff should have moved to the new message", 
+      pipe_assigned);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1, 
+      "Buffers in use should be 1 and were %d", 
+      CFE_SBN_Client_BuffersInUse());
+    UtAssert_True(buffer == pipe->CurrentBuff->Buffer, 
+      "buffer should point at the pipe's current message buffer");
+} /* end Test__wrap_CFE_SB_RcvMsg_ReleasesPreviouslyReceivedMessage */
 
 /* TODO: Test__wrap_CFE_SB_RcvMsgSuccess when num messages = 1
  * TODO: Test__wrap_CFE_SB_RcvMsgSuccess when num messages = CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH
@@ -958,88 +1338,953 @@ void Test__wrap_CFE_SB_RcvMsgSuccessPreviousMessageIsAtEndOfPipe(void)
  * end __wrap_CFE_SB_RcvMsg Tests */
 
 
-void Test__wrap_CFE_SB_SubscribeEx_AlwaysFails(void)
+void Test__wrap_CFE_SB_SubscribeEx_SetsMsgLimOfSubscription(void)
 {
     /* Arrange */
-    int32 expectedResult = -1;
-    CFE_SB_MsgId_t dummyMsgId = NULL;
-    CFE_SB_PipeId_t dummyPipeId = NULL;
-    CFE_SB_Qos_t dummyQuality;
-    uint16 dummyMsgLim = 0;
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id = 0x1800;
+    uint16 msg_lim = (rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH) + 1;
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    CFE_SB_Qos_t quality = {0, 0};
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    PipeTbl[pipe_id].MsgLimDrops[0] = 1;
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
     
     /* Act */ 
-    int32 result = CFE_SB_SubscribeEx(dummyMsgId, dummyPipeId, 
-      dummyQuality, dummyMsgLim);
+    int32 result = CFE_SB_SubscribeEx(msg_id, pipe_id, quality, msg_lim);
     
     /* Assert */
-    UtAssert_True(result == expectedResult, 
-        "__wrap_CFE_SB_SubscribeEx failed and returned -1");
-} /* end Test__wrap_CFE_SB_SubscribeEx_AlwaysFails */
-
-void Test__wrap_CFE_SB_SubscribeLocal_AlwaysFails(void)
+    UtAssert_True(result == CFE_SUCCESS, 
+      "Call to CFE_SB_SubscribeEx should return %d and was %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(PipeTbl[pipe_id].SubscribedMsgIds[0] == msg_id && 
+      PipeTbl[pipe_id].MsgLim[0] == msg_lim, 
+      "PipeTbl[%d] should be subscribed to 0x%04X with MsgLim %d", pipe_id, 
+      msg_id, msg_lim);
+    UtAssert_True(PipeTbl[pipe_id].MsgLimDrops[0] == 0, 
+      "A new subscription should have no MsgLim drops, had %u", 
+      PipeTbl[pipe_id].MsgLimDrops[0]);
+    UtAssert_True(CFE_SBN_Client_GetRoutes(msg_id, routes, gens) == 1, 
+      "MsgId 0x%04X should be routed to the pipe", msg_id);
+} /* end Test__wrap_CFE_SB_SubscribeEx_SetsMsgLimOfSubscription */
+
+void Test__wrap_CFE_SB_SubscribeEx_FailsWhenPipeIsInvalid(void)
 {
     /* Arrange */
-    int32 expectedResult = -1;
-    CFE_SB_MsgId_t dummyMsgId = NULL;
-    CFE_SB_PipeId_t dummyPipeId = NULL;
-    uint16 dummyMsgLim = 0;
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    CFE_SB_Qos_t quality = {0, 0};
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+    PipeTbl[pipe_id].PipeId = CFE_SBN_CLIENT_INVALID_PIPE;
     
     /* Act */ 
-    int32 result = CFE_SB_SubscribeLocal(dummyMsgId, dummyPipeId,
-      dummyMsgLim);
+    int32 result = CFE_SB_SubscribeEx(0x1800, pipe_id, quality, 1);
     
     /* Assert */
-    UtAssert_True(result == expectedResult, 
-        "__wrap_CFE_SB_SubscribeLocal failed and returned -1");
-} /* end Test__wrap_CFE_SB_SubscribeLocal_AlwaysFails */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "Call to CFE_SB_SubscribeEx with pipeId %d should be error %d and was %d",
+      pipe_id, CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test__wrap_CFE_SB_SubscribeEx_FailsWhenPipeIsInvalid */
 
-void Test__wrap_CFE_SB_Unsubscribe_AlwaysFails(void)
+void Test__wrap_CFE_SB_SubscribeEx_MsgLimDoesNotStarveOtherMsgIds(void)
 {
     /* Arrange */
-    int32 expectedResult = -1;
-    CFE_SB_MsgId_t dummyMsgId = NULL;
-    CFE_SB_PipeId_t dummyPipeId = NULL;
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    CFE_SBN_Client_PipeD_t *pipe = &PipeTbl[pipe_id];
+    CFE_SBN_Client_BufferD_t *flood = CFE_SBN_Client_GetBuffer(0x1800, 8);
+    CFE_SBN_Client_BufferD_t *other = CFE_SBN_Client_GetBuffer(0x1801, 8);
+    CFE_SB_Qos_t quality = {0, 0};
+    uint16 msgs_waiting = 0;
+    uint32 drops = 0;
+    int32 result;
+    int i;
+    pipe->InUse = CFE_SBN_CLIENT_IN_USE;
+    pipe->PipeId = pipe_id;
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    CFE_SB_SubscribeEx(0x1800, pipe_id, quality, 2);
+    CFE_SB_SubscribeEx(0x1801, pipe_id, quality, 2);
     
     /* Act */ 
-    int32 result = CFE_SB_Unsubscribe(dummyMsgId, dummyPipeId);
+    for (i = 0; i < CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH; i++)
+    {
+        CFE_SBN_Client_PipeEnqueue(pipe, flood, pipe->Generation);
+    }
+    
+    result = CFE_SBN_Client_PipeEnqueue(pipe, other, pipe->Generation);
     
     /* Assert */
-    UtAssert_True(result == expectedResult, 
-        "__wrap_CFE_SB_Unsubscribe failed and returned -1");
-} /* end Test__wrap_CFE_SB_Unsubscribe_AlwaysFails */
-
-void Test__wrap_CFE_SB_UnsubscribeLocal_AlwaysFails(void)
+    SBN_Client_GetSubscriptionCounts(0x1800, pipe_id, &msgs_waiting, &drops);
+    
+    UtAssert_True(result == SBN_CLIENT_SUCCESS, 
+      "A message of the other MsgId should still be added, result was %d", 
+      result);
+    UtAssert_True(msgs_waiting == 2, 
+      "MsgLim of the flooding MsgId should be waiting, %d were", 
+      msgs_waiting);
+    UtAssert_True(drops == CFE_PLATFORM_SBN_CLIENT_MAX_PIPE_DEPTH - 2, 
+      "The rest of the flood should be counted as dropped, %u were", drops);
+    UtAssert_True(pipe->SendErrors == 0, 
+      "The pipe itself should not have overflowed, SendErrors was %u", 
+      pipe->SendErrors);
+} /* end Test__wrap_CFE_SB_SubscribeEx_MsgLimDoesNotStarveOtherMsgIds */
+
+void Test__wrap_CFE_SB_SubscribeLocal_DoesNotTellSbn(void)
 {
     /* Arrange */
-    int32 expectedResult = -1;
-    CFE_SB_MsgId_t dummyMsgId = NULL;
-    CFE_SB_PipeId_t dummyPipeId = NULL;
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id = 0x1800;
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    char sent[SBN_PACKED_SUB_SZ];
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
     
     /* Act */ 
-    int32 result = CFE_SB_UnsubscribeLocal(dummyMsgId, dummyPipeId);
+    int32 result = CFE_SB_SubscribeLocal(msg_id, pipe_id, 1);
     
     /* Assert */
-    UtAssert_True(result == expectedResult, 
-        "__wrap_CFE_SB_UnsubscribeLocal failed and returned -1");
-} /* end Test__wrap_CFE_SB_UnsubscribeLocal_AlwaysFails */
-
-void Test__wrap_CFE_SB_ZeroCopySend_AlwaysFails(void)
+    UtAssert_True(result == CFE_SUCCESS, 
+      "Call to CFE_SB_SubscribeLocal should return %d and was %d", 
+      CFE_SUCCESS, result);
+    UtAssert_True(CFE_SBN_Client_GetRoutes(msg_id, routes, gens) == 1, 
+      "MsgId 0x%04X should be routed to the pipe", msg_id);
+    UtAssert_True(PipeTbl[pipe_id].SubscribedLocal[0] == TRUE, 
+      "The subscription should be marked local");
+    UtAssert_True(recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT) < 0, 
+      "SBN should not have been sent the subscription");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SubscribeLocal_DoesNotTellSbn */
+
+void Test_SBN_Client_SubscribeBatch_TellsSbnInOneFrame(void)
 {
     /* Arrange */
-    int32 expectedResult = -1;
-    CFE_SB_Msg_t *dummyMsg = NULL;
-    CFE_SB_ZeroCopyHandle_t dummyHandle = NULL;
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int other_pipe_id = (pipe_id + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int subs_sent;
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    SBN_Client_Subscription_t subs[3] = {
+        {0x1800, pipe_id, {0, 0}, 4},
+        {0x1801, pipe_id, {1, 0}, 4},
+        {0x1801, other_pipe_id, {1, 0}, 4}
+    };
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    PipeTbl[other_pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[other_pipe_id].PipeId = other_pipe_id;
+    Connect_To_Test_Sbn(fds);
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
     
     /* Act */ 
-    int32 result = CFE_SB_ZeroCopySend(dummyMsg, dummyHandle);
+    int32 result = SBN_Client_SubscribeBatch(subs, 3);
+    
+    /* Assert */
+    subs_sent = Subs_In_Frame_Sent_To_Sbn(fds[1]);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "SBN_Client_SubscribeBatch should return %d and was %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(CFE_SBN_Client_GetRoutes(0x1801, routes, gens) == 2, 
+      "MsgId 0x1801 should be routed to both pipes");
+    UtAssert_True(subs_sent == 2, 
+      "SBN should be sent one frame of 2 subscriptions, it held %d", 
+      subs_sent);
+    UtAssert_True(Sub_Frame_Sent_To_Sbn(fds[1]) == -1, 
+      "SBN should be sent only one frame");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_SBN_Client_SubscribeBatch_TellsSbnInOneFrame */
+
+void Test_SBN_Client_SubscribeBatch_KeepsGoingPastFailedEntry(void)
+{
+    /* Arrange */
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int bad_pipe_id = (pipe_id + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int subs_sent;
+    SBN_Client_Subscription_t subs[2] = {
+        {0x1800, bad_pipe_id, {0, 0}, 4},
+        {0x1801, pipe_id, {0, 0}, 4}
+    };
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    PipeTbl[bad_pipe_id].InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+    Connect_To_Test_Sbn(fds);
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    int32 result = SBN_Client_SubscribeBatch(subs, 2);
+    
+    /* Assert */
+    subs_sent = Subs_In_Frame_Sent_To_Sbn(fds[1]);
+    
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "SBN_Client_SubscribeBatch should return %d and was %d", 
+      CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+    UtAssert_True(PipeTbl[pipe_id].SubscribedMsgIds[0] == 0x1801, 
+      "The entry after the failed one should still be subscribed");
+    UtAssert_True(subs_sent == 1, 
+      "SBN should be sent only the entry that worked, the frame held %d", 
+      subs_sent);
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_SBN_Client_SubscribeBatch_KeepsGoingPastFailedEntry */
+
+void Test_SBN_Client_SubscribeBatch_FailsWithNullSubs(void)
+{
+    /* Arrange */
+    /* Act */ 
+    int32 result = SBN_Client_SubscribeBatch(NULL, 1);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "SBN_Client_SubscribeBatch should return %d and was %d", 
+      CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test_SBN_Client_SubscribeBatch_FailsWithNullSubs */
+
+void Test__wrap_CFE_SB_Unsubscribe_FailsWhenPipeIsInvalid(void)
+{
+    /* Arrange */
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id = 0x1800;
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_NOT_IN_USE;
+    PipeTbl[pipe_id].PipeId = CFE_SBN_CLIENT_INVALID_PIPE;
+    
+    /* Act */ 
+    int32 result = CFE_SB_Unsubscribe(msg_id, pipe_id);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "Call to CFE_SB_Unsubscribe with pipeId %d should be error %d and was %d", 
+      pipe_id, CFE_SBN_CLIENT_BAD_ARGUMENT, result);
+} /* end Test__wrap_CFE_SB_Unsubscribe_FailsWhenPipeIsInvalid */
+
+void Test__wrap_CFE_SB_Unsubscribe_RemovesMsgIdAndRoute(void)
+{
+    /* Arrange */
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id_slot = rand() % CFE_SBN_CLIENT_MAX_MSG_IDS_PER_PIPE;
+    int msg_id = 0x1800;
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    PipeTbl[pipe_id].SubscribedMsgIds[msg_id_slot] = msg_id;
+    CFE_SBN_Client_AddRoute(msg_id, pipe_id);
+    
+    /* Act */ 
+    int32 result = CFE_SB_Unsubscribe(msg_id, pipe_id);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "Call to CFE_SB_Unsubscribe should return %d and was %d", CFE_SUCCESS, 
+      result);
+    UtAssert_True(PipeTbl[pipe_id].SubscribedMsgIds[msg_id_slot] == 
+      CFE_SBN_CLIENT_INVALID_MSG_ID, 
+      "PipeTbl[%d].SubscribedMsgIds[%d] should be %d and was %d", pipe_id, 
+      msg_id_slot, CFE_SBN_CLIENT_INVALID_MSG_ID, 
+      PipeTbl[pipe_id].SubscribedMsgIds[msg_id_slot]);
+    UtAssert_True(CFE_SBN_Client_GetRoutes(msg_id, routes, gens) == 0, 
+      "MsgId 0x%04X should no longer be routed", msg_id);
+} /* end Test__wrap_CFE_SB_Unsubscribe_RemovesMsgIdAndRoute */
+
+void Test__wrap_CFE_SB_Unsubscribe_TellsSbnAfterLastPipe(void)
+{
+    /* Arrange */
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int other_pipe_id = (pipe_id + 1) % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int first_frame;
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    PipeTbl[other_pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[other_pipe_id].PipeId = other_pipe_id;
+    Connect_To_Test_Sbn(fds);
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    CFE_SB_Subscribe(0x1800, pipe_id);
+    CFE_SB_Subscribe(0x1800, other_pipe_id);
+    while (Sub_Frame_Sent_To_Sbn(fds[1]) != -1);
+    
+    /* Act */ 
+    CFE_SB_Unsubscribe(0x1800, pipe_id);
+    first_frame = Sub_Frame_Sent_To_Sbn(fds[1]);
+    CFE_SB_Unsubscribe(0x1800, other_pipe_id);
+    
+    /* Assert */
+    UtAssert_True(first_frame == -1, 
+      "SBN should not be unsubscribed while another pipe is subscribed");
+    UtAssert_True(Sub_Frame_Sent_To_Sbn(fds[1]) == SBN_UNSUB_MSG, 
+      "SBN should be unsubscribed once no pipe is subscribed");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_Unsubscribe_TellsSbnAfterLastPipe */
+
+void Test__wrap_CFE_SB_UnsubscribeLocal_RemovesMsgIdAndRoute(void)
+{
+    /* Arrange */
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    int msg_id = 0x1800;
+    uint8 routes[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    uint32 gens[CFE_PLATFORM_SBN_CLIENT_MAX_PIPES];
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    CFE_SB_SubscribeLocal(msg_id, pipe_id, 1);
+    
+    /* Act */ 
+    int32 result = CFE_SB_UnsubscribeLocal(msg_id, pipe_id);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "Call to CFE_SB_UnsubscribeLocal should return %d and was %d", 
+      CFE_SUCCESS, result);
+    UtAssert_True(PipeTbl[pipe_id].SubscribedMsgIds[0] == 
+      CFE_SBN_CLIENT_INVALID_MSG_ID, 
+      "PipeTbl[%d] should no longer be subscribed to 0x%04X", pipe_id, 
+      msg_id);
+    UtAssert_True(CFE_SBN_Client_GetRoutes(msg_id, routes, gens) == 0, 
+      "MsgId 0x%04X should no longer be routed", msg_id);
+} /* end Test__wrap_CFE_SB_UnsubscribeLocal_RemovesMsgIdAndRoute */
+
+/* fills a zero copy buffer with a 16 byte message with MsgId 0x1801 */
+void Fill_Zero_Copy_Message(CFE_SB_Msg_t *msg)
+{
+    unsigned char header[6] = { 0x18, 0x01, 0xC0, 0x00, 0x00, 0x09 };
+    int i;
+    
+    memcpy(msg, header, sizeof(header));
+    
+    for (i = sizeof(header); i < 16; i++)
+    {
+        ((unsigned char *)msg)[i] = i;
+    }
+    
+}
+
+void Test__wrap_CFE_SB_ZeroCopyGetPtr_LeavesRoomForSbnHeader(void)
+{
+    /* Arrange */
+    CFE_SB_ZeroCopyHandle_t handle;
+    CFE_SBN_Client_BufferD_t *buf;
+    CFE_SB_Msg_t *msg;
+    
+    /* Act */ 
+    msg = CFE_SB_ZeroCopyGetPtr(16, &handle);
+    
+    /* Assert */
+    buf = (CFE_SBN_Client_BufferD_t *)handle;
+    
+    UtAssert_True(msg != NULL, "CFE_SB_ZeroCopyGetPtr should return a buffer");
+    UtAssert_True((char *)msg - (char *)buf->Buffer >= SBN_PACKED_HDR_SZ, 
+      "The SBN header should fit ahead of the message");
+    UtAssert_True(((uintptr_t)msg & 7) == 0, 
+      "The message should be aligned for the app's structures");
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1, 
+      "The buffer should come from the pool");
+    
+    CFE_SB_ZeroCopyReleasePtr(msg, handle);
+} /* end Test__wrap_CFE_SB_ZeroCopyGetPtr_LeavesRoomForSbnHeader */
+
+void Test__wrap_CFE_SB_ZeroCopyGetPtr_FailsWhenAppHoldsMaxBuffers(void)
+{
+    /* Arrange */
+    CFE_SB_ZeroCopyHandle_t handles[SBN_CLIENT_MAX_ZERO_COPY_BUFFERS];
+    CFE_SB_Msg_t *msgs[SBN_CLIENT_MAX_ZERO_COPY_BUFFERS];
+    CFE_SB_ZeroCopyHandle_t handle;
+    CFE_SB_Msg_t *msg;
+    int i;
+    
+    for (i = 0; i < SBN_CLIENT_MAX_ZERO_COPY_BUFFERS; i++)
+    {
+        msgs[i] = CFE_SB_ZeroCopyGetPtr(16, &handles[i]);
+    }
+    
+    /* Act */ 
+    msg = CFE_SB_ZeroCopyGetPtr(16, &handle);
+    
+    /* Assert */
+    UtAssert_True(msg == NULL, 
+      "CFE_SB_ZeroCopyGetPtr should fail once %d buffers are held", 
+      SBN_CLIENT_MAX_ZERO_COPY_BUFFERS);
+    
+    for (i = 0; i < SBN_CLIENT_MAX_ZERO_COPY_BUFFERS; i++)
+    {
+        CFE_SB_ZeroCopyReleasePtr(msgs[i], handles[i]);
+    }
+    
+} /* end Test__wrap_CFE_SB_ZeroCopyGetPtr_FailsWhenAppHoldsMaxBuffers */
+
+void Test__wrap_CFE_SB_ZeroCopyReleasePtr_ReturnsBufferToPool(void)
+{
+    /* Arrange */
+    CFE_SB_ZeroCopyHandle_t handle;
+    CFE_SB_Msg_t *msg = CFE_SB_ZeroCopyGetPtr(16, &handle);
+    int32 result;
+    
+    /* Act */ 
+    result = CFE_SB_ZeroCopyReleasePtr(msg, handle);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "CFE_SB_ZeroCopyReleasePtr returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "The buffer should be back in the pool");
+} /* end Test__wrap_CFE_SB_ZeroCopyReleasePtr_ReturnsBufferToPool */
+
+void Test__wrap_CFE_SB_ZeroCopyReleasePtr_FailsWithPointerNotFromHandle(void)
+{
+    /* Arrange */
+    CFE_SB_ZeroCopyHandle_t handle;
+    CFE_SB_Msg_t *msg = CFE_SB_ZeroCopyGetPtr(16, &handle);
+    int32 result;
+    
+    /* Act */ 
+    result = CFE_SB_ZeroCopyReleasePtr((CFE_SB_Msg_t *)((char *)msg + 1), 
+      handle);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SB_BUFFER_INVALID, 
+      "CFE_SB_ZeroCopyReleasePtr returned %d and should be %d", result, 
+      CFE_SB_BUFFER_INVALID);
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 1, 
+      "The buffer should still be held");
+    
+    CFE_SB_ZeroCopyReleasePtr(msg, handle);
+} /* end Test__wrap_CFE_SB_ZeroCopyReleasePtr_FailsWithPointerNotFromHandle */
+
+void Test__wrap_CFE_SB_ZeroCopySend_FailsWithInvalidHandle(void)
+{
+    /* Arrange */
+    int32 expectedResult = CFE_SB_BUFFER_INVALID;
+    CFE_SB_Msg_t *dummyMsg = NULL;
+    CFE_SB_ZeroCopyHandle_t dummyHandle = (CFE_SB_ZeroCopyHandle_t)0;
+    
+    /* Act */ 
+    int32 result = CFE_SB_ZeroCopySend(dummyMsg, dummyHandle);
     
     /* Assert */
     UtAssert_True(result == expectedResult, 
-        "__wrap_CFE_SB_ZeroCopySend failed and returned -1");
-} /* end Test__wrap_CFE_SB_ZeroCopySend_AlwaysFails */
+        "__wrap_CFE_SB_ZeroCopySend returned %d and should be %d", result, 
+        expectedResult);
+} /* end Test__wrap_CFE_SB_ZeroCopySend_FailsWithInvalidHandle */
+
+void Test__wrap_CFE_SB_ZeroCopySend_SendsBufferAndReturnsItToPool(void)
+{
+    /* Arrange */
+    int fds[2];
+    CFE_SB_ZeroCopyHandle_t handle;
+    CFE_SB_Msg_t *msg = CFE_SB_ZeroCopyGetPtr(16, &handle);
+    unsigned char sent[SBN_PACKED_HDR_SZ + 16 + 1];
+    ssize_t sent_size;
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    Fill_Zero_Copy_Message(msg);
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = CFE_SB_ZeroCopySend(msg, handle);
+    
+    /* Assert */
+    sent_size = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_ZeroCopySend returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(sent_size == SBN_PACKED_HDR_SZ + 16, 
+      "SBN received %d bytes and should have received %d", (int)sent_size, 
+      SBN_PACKED_HDR_SZ + 16);
+    UtAssert_True(sent[0] == 0 && sent[1] == 16 && sent[2] == SBN_APP_MSG &&
+      sent[SBN_PACKED_HDR_SZ] == 0x18 && sent[sizeof(sent) - 2] == 15, 
+      "SBN should receive the SBN header followed by the message");
+    UtAssert_True(CFE_SBN_Client_BuffersInUse() == 0, 
+      "The buffer should be back in the pool once sent");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_ZeroCopySend_SendsBufferAndReturnsItToPool */
+
+void Test__wrap_CFE_SB_ZeroCopySend_FailsWhenMessageOutgrowsBuffer(void)
+{
+    /* Arrange */
+    CFE_SB_ZeroCopyHandle_t handle;
+    CFE_SB_Msg_t *msg = CFE_SB_ZeroCopyGetPtr(8, &handle);
+    int32 result;
+    
+    Fill_Zero_Copy_Message(msg);
+    
+    /* Act */ 
+    result = CFE_SB_ZeroCopySend(msg, handle);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SB_MSG_TOO_BIG, 
+      "__wrap_CFE_SB_ZeroCopySend returned %d and should be %d", result, 
+      CFE_SB_MSG_TOO_BIG);
+    
+    CFE_SB_ZeroCopyReleasePtr(msg, handle);
+} /* end Test__wrap_CFE_SB_ZeroCopySend_FailsWhenMessageOutgrowsBuffer */
 
 /* end __wrap_CFE_SB_RcvMsg Tests */
 
+/*******************************************************************************
+**
+**  __wrap_CFE_SB_SendMsg Tests
+**
+*******************************************************************************/
+
+/* a 16 byte message with MsgId 0x1801, its length field 16 - 7 */
+unsigned char msg_to_send[16] = { 0x18, 0x01, 0xC0, 0x00, 0x00, 0x09,
+                                  0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+                                  0x07, 0x08, 0x09, 0x0A };
+
+void Test__wrap_CFE_SB_SendMsg_SendsHeaderAndMessageTogether(void)
+{
+    /* Arrange */
+    int fds[2];
+    unsigned char sent[SBN_PACKED_HDR_SZ + sizeof(msg_to_send) + 1];
+    ssize_t sent_size;
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    sent_size = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(sent_size == SBN_PACKED_HDR_SZ + sizeof(msg_to_send), 
+      "SBN received %d bytes and should have received %d", (int)sent_size, 
+      (int)(SBN_PACKED_HDR_SZ + sizeof(msg_to_send)));
+    UtAssert_True(sent[0] == 0 && sent[1] == sizeof(msg_to_send), 
+      "SBN header should give the message size %d", 
+      (int)sizeof(msg_to_send));
+    UtAssert_True(sent[2] == SBN_APP_MSG, 
+      "SBN header should give message type SBN_APP_MSG");
+    UtAssert_True(memcmp(&sent[SBN_PACKED_HDR_SZ], msg_to_send, 
+      sizeof(msg_to_send)) == 0, 
+      "Message should follow the SBN header unchanged");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SendMsg_SendsHeaderAndMessageTogether */
+
+void Test__wrap_CFE_SB_SendMsg_FailsWhenSbnHasClosedTheConnection(void)
+{
+    /* Arrange */
+    int fds[2];
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    close(fds[1]);
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SB_BUF_ALOC_ERR, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SB_BUF_ALOC_ERR);
+    
+    close(fds[0]);
+} /* end Test__wrap_CFE_SB_SendMsg_FailsWhenSbnHasClosedTheConnection */
+
+void Test__wrap_CFE_SB_SendMsg_QueuesWhenSendQueueIsRunning(void)
+{
+    /* Arrange */
+    int fds[2];
+    unsigned char sent[SBN_PACKED_HDR_SZ + sizeof(msg_to_send) + 1];
+    ssize_t sent_before_close, sent_size;
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    CFE_SBN_Client_SendQueueOpen();
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    sent_before_close = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    CFE_SBN_Client_SendQueueClose();
+    sent_size = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(sent_before_close < 0, 
+      "SendMsg should leave sending to the send queue writer");
+    UtAssert_True(sent_size == SBN_PACKED_HDR_SZ + sizeof(msg_to_send), 
+      "SBN received %d bytes and should have received %d", (int)sent_size, 
+      (int)(SBN_PACKED_HDR_SZ + sizeof(msg_to_send)));
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SendMsg_QueuesWhenSendQueueIsRunning */
+
+void Test__wrap_CFE_SB_SendMsg_SkipsMsgIdNobodyWants(void)
+{
+    /* Arrange */
+    int fds[2];
+    unsigned char sent[1];
+    CFE_SB_MsgId_t wanted = 0x1800;
+    uint32 skipped_before = 0, skipped_after = 0;
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    CFE_SBN_Client_AddRemoteInterest(&wanted, 1);
+    SBN_Client_GetNoSubscribersCount(&skipped_before);
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    SBN_Client_GetNoSubscribersCount(&skipped_after);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT) < 0, 
+      "SBN should not be sent a MsgId nobody subscribes to");
+    UtAssert_True(skipped_after == skipped_before + 1, 
+      "The skipped message should be counted, the count went from %u to %u",
+      skipped_before, skipped_after);
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SendMsg_SkipsMsgIdNobodyWants */
+
+void Test__wrap_CFE_SB_SendMsg_DeliversToOwnSubscriberAndSbn(void)
+{
+    /* Arrange */
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    unsigned char sent[SBN_PACKED_HDR_SZ + sizeof(msg_to_send) + 1];
+    char sub_sent[SBN_PACKED_SUB_SZ];
+    CFE_SBN_Client_BufferD_t *delivered;
+    ssize_t sent_size;
+    int32 result;
+    
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    CFE_SB_Subscribe(0x1801, pipe_id);
+    recv(fds[1], sub_sent, sizeof(sub_sent), MSG_DONTWAIT);
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    delivered = CFE_SBN_Client_PipeDequeue(&PipeTbl[pipe_id]);
+    sent_size = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(delivered != NULL && 
+      memcmp(delivered->Buffer, msg_to_send, sizeof(msg_to_send)) == 0, 
+      "The message should be in the subscribed pipe");
+    UtAssert_True(sent_size == SBN_PACKED_HDR_SZ + sizeof(msg_to_send), 
+      "SBN received %d bytes and should have received %d", (int)sent_size, 
+      (int)(SBN_PACKED_HDR_SZ + sizeof(msg_to_send)));
+    
+    CFE_SBN_Client_ReleaseBuffer(delivered);
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SendMsg_DeliversToOwnSubscriberAndSbn */
+
+void Test__wrap_CFE_SB_SendMsg_DeliversToLocalSubscriberOnly(void)
+{
+    /* Arrange */
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    unsigned char sent[1];
+    int32 result;
+    
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    CFE_SB_SubscribeLocal(0x1801, pipe_id, 1);
+    /* nobody on SBN's side subscribes to anything */
+    CFE_SBN_Client_AddRemoteInterest(NULL, 0);
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_id]) == 1, 
+      "The local subscriber's pipe should hold the message, it held %u", 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_id]));
+    UtAssert_True(recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT) < 0, 
+      "SBN should not be sent a message only the client subscribes to");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SendMsg_DeliversToLocalSubscriberOnly */
+
+void Test__wrap_CFE_SB_SendMsg_SendsToSbnWhenLocalCopyFails(void)
+{
+    /* Arrange */
+    int fds[2];
+    int pipe_id = rand() % CFE_PLATFORM_SBN_CLIENT_MAX_PIPES;
+    unsigned char sent[SBN_PACKED_HDR_SZ + sizeof(msg_to_send) + 1];
+    char sub_sent[SBN_PACKED_SUB_SZ];
+    uint32 errors_before = 0, errors_after = 0;
+    ssize_t sent_size;
+    int32 result;
+    int i;
+    
+    PipeTbl[pipe_id].InUse = CFE_SBN_CLIENT_IN_USE;
+    PipeTbl[pipe_id].PipeId = pipe_id;
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    CFE_SB_Subscribe(0x1801, pipe_id);
+    recv(fds[1], sub_sent, sizeof(sub_sent), MSG_DONTWAIT);
+    SBN_Client_GetLocalDeliveryErrors(&errors_before);
+    
+    /* no buffer left for the pipe's copy */
+    for(i = 0; i < CFE_SBN_CLIENT_MAX_BUFFERS; i++)
+    {
+        CFE_SBN_Client_GetBuffer(0x1800, 8);
+    }
+    
+    /* Act */ 
+    result = CFE_SB_SendMsg((CFE_SB_Msg_t *)msg_to_send);
+    
+    /* Assert */
+    sent_size = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    SBN_Client_GetLocalDeliveryErrors(&errors_after);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "__wrap_CFE_SB_SendMsg returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(sent_size == SBN_PACKED_HDR_SZ + sizeof(msg_to_send), 
+      "SBN received %d bytes and should have received %d", (int)sent_size, 
+      (int)(SBN_PACKED_HDR_SZ + sizeof(msg_to_send)));
+    UtAssert_True(CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_id]) == 0, 
+      "The pipe should not have the message, it held %u", 
+      CFE_SBN_Client_PipeMsgCount(&PipeTbl[pipe_id]));
+    UtAssert_True(errors_after == errors_before + 1, 
+      "The missed copy should be counted, the count went from %u to %u",
+      errors_before, errors_after);
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test__wrap_CFE_SB_SendMsg_SendsToSbnWhenLocalCopyFails */
+
+/* end __wrap_CFE_SB_SendMsg Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_SendMsgBatch Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_SendMsgBatch_SendsEveryMessageInOrder(void)
+{
+    /* Arrange */
+    int fds[2];
+    uint32 count = SBN_CLIENT_MAX_SEND_BATCH + 3;
+    size_t frame_size = SBN_PACKED_HDR_SZ + sizeof(msg_to_send);
+    unsigned char msgs[SBN_CLIENT_MAX_SEND_BATCH + 3][sizeof(msg_to_send)];
+    CFE_SB_Msg_t *msg_ptrs[SBN_CLIENT_MAX_SEND_BATCH + 3];
+    unsigned char sent[(SBN_CLIENT_MAX_SEND_BATCH + 3) * 
+                       (SBN_PACKED_HDR_SZ + sizeof(msg_to_send)) + 1];
+    ssize_t sent_size = 0, received;
+    boolean in_order = TRUE;
+    int32 result;
+    uint32 i;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    
+    for (i = 0; i < count; i++)
+    {
+        memcpy(msgs[i], msg_to_send, sizeof(msg_to_send));
+        msgs[i][sizeof(msg_to_send) - 1] = i;
+        msg_ptrs[i] = (CFE_SB_Msg_t *)msgs[i];
+    }
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = SBN_Client_SendMsgBatch(msg_ptrs, count);
+    
+    /* Assert */
+    while ((received = recv(fds[1], &sent[sent_size], 
+                            sizeof(sent) - sent_size, MSG_DONTWAIT)) > 0)
+    {
+        sent_size += received;
+    }
+    
+    for (i = 0; i < count; i++)
+    {
+        
+        if (memcmp(&sent[i * frame_size + SBN_PACKED_HDR_SZ], msgs[i], 
+                   sizeof(msg_to_send)) != 0)
+        {
+            in_order = FALSE;
+        }
+        
+    }
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "SBN_Client_SendMsgBatch returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(sent_size == count * frame_size, 
+      "SBN received %d bytes and should have received %d", (int)sent_size, 
+      (int)(count * frame_size));
+    UtAssert_True(in_order, 
+      "SBN should receive every message, framed and in order");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_SBN_Client_SendMsgBatch_SendsEveryMessageInOrder */
+
+void Test_SBN_Client_SendMsgBatch_SendsNothingWhenAMessageIsNull(void)
+{
+    /* Arrange */
+    int fds[2];
+    CFE_SB_Msg_t *msg_ptrs[2] = { (CFE_SB_Msg_t *)msg_to_send, NULL };
+    unsigned char sent[1];
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    
+    /* Act */ 
+    result = SBN_Client_SendMsgBatch(msg_ptrs, 2);
+    
+    /* Assert */
+    UtAssert_True(result == CFE_SBN_CLIENT_BAD_ARGUMENT, 
+      "SBN_Client_SendMsgBatch returned %d and should be %d", result, 
+      CFE_SBN_CLIENT_BAD_ARGUMENT);
+    UtAssert_True(recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT) < 0, 
+      "SBN should receive nothing");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_SBN_Client_SendMsgBatch_SendsNothingWhenAMessageIsNull */
+
+void Test_SBN_Client_SendMsgBatch_SendsOnlyWantedMessages(void)
+{
+    /* Arrange */
+    int fds[2];
+    unsigned char wanted_msg[sizeof(msg_to_send)];
+    CFE_SB_Msg_t *msg_ptrs[3];
+    CFE_SB_MsgId_t wanted = 0x1802;
+    unsigned char sent[2 * (SBN_PACKED_HDR_SZ + sizeof(msg_to_send))];
+    ssize_t sent_size;
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    memcpy(wanted_msg, msg_to_send, sizeof(msg_to_send));
+    wanted_msg[1] = 0x02;
+    msg_ptrs[0] = (CFE_SB_Msg_t *)msg_to_send;
+    msg_ptrs[1] = (CFE_SB_Msg_t *)wanted_msg;
+    msg_ptrs[2] = (CFE_SB_Msg_t *)msg_to_send;
+    CFE_SBN_Client_AddRemoteInterest(&wanted, 1);
+    
+    wrap_pthread_mutex_lock_should_be_called = TRUE;
+    wrap_pthread_mutex_unlock_should_be_called = TRUE;
+    
+    /* Act */ 
+    result = SBN_Client_SendMsgBatch(msg_ptrs, 3);
+    
+    /* Assert */
+    sent_size = recv(fds[1], sent, sizeof(sent), MSG_DONTWAIT);
+    
+    UtAssert_True(result == CFE_SUCCESS, 
+      "SBN_Client_SendMsgBatch returned %d and should be %d", result, 
+      CFE_SUCCESS);
+    UtAssert_True(sent_size == SBN_PACKED_HDR_SZ + sizeof(msg_to_send), 
+      "SBN received %d bytes and should have received one message of %d", 
+      (int)sent_size, (int)(SBN_PACKED_HDR_SZ + sizeof(msg_to_send)));
+    UtAssert_True(memcmp(&sent[SBN_PACKED_HDR_SZ], wanted_msg, 
+      sizeof(wanted_msg)) == 0, "SBN should receive the wanted message");
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_SBN_Client_SendMsgBatch_SendsOnlyWantedMessages */
+
+/* end SBN_Client_SendMsgBatch Tests */
+
+/*******************************************************************************
+**
+**  SBN_Client_Cork Tests
+**
+*******************************************************************************/
+
+void Test_SBN_Client_Cork_FailsWhenConnectionIsNotTcp(void)
+{
+    /* Arrange */
+    int fds[2];
+    int32 result;
+    
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    sbn_client_sockfd = fds[0];
+    
+    /* Act */ 
+    result = SBN_Client_Cork();
+    
+    /* Assert */
+    UtAssert_True(result == SERVER_SOCKET_ERROR, 
+      "SBN_Client_Cork returned %d and should be %d", result, 
+      SERVER_SOCKET_ERROR);
+    
+    close(fds[0]);
+    close(fds[1]);
+} /* end Test_SBN_Client_Cork_FailsWhenConnectionIsNotTcp */
+
+/* end SBN_Client_Cork Tests */
+
 /*******************************************************************************
 **
 **  add test group functions
@@ -1058,20 +2303,107 @@ void add__wrap_CFE_SB_CreatePipe_tests(void)
       Test__wrap_CFE_SB_CreatePipe_InitializesPipeCorrectly, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
       "Test__wrap_CFE_SB_CreatePipe_InitializesPipeCorrectly");
+    UtTest_Add(
+      Test__wrap_CFE_SB_CreatePipe_AllocatesRingForDepth, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_CreatePipe_AllocatesRingForDepth");
     UtTest_Add(
       Test__wrap_CFE_SB_CreatePipe_SendsMaxPipesErrorWhenPipesAreFull, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
       "Test__wrap_CFE_SB_CreatePipe_SendsMaxPipesErrorWhenPipesAreFull");
+    UtTest_Add(
+      Test__wrap_CFE_SB_CreatePipe_DefaultsToDropNewest, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_CreatePipe_DefaultsToDropNewest");
+    UtTest_Add(
+      Test__wrap_CFE_SB_CreatePipe_DoesNotTakeClosingPipe, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_CreatePipe_DoesNotTakeClosingPipe");
 } /* end add__wrap_CFE_SB_CreatePipe_tests */
 
+void add_SBN_Client_CreatePipeEx_tests(void)
+{
+    UtTest_Add(
+      Test_SBN_Client_CreatePipeEx_SetsOverflowPolicy, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_CreatePipeEx_SetsOverflowPolicy");
+    UtTest_Add(
+      Test_SBN_Client_CreatePipeEx_FailsWithUnknownOverflowPolicy, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_CreatePipeEx_FailsWithUnknownOverflowPolicy");
+} /* end add_SBN_Client_CreatePipeEx_tests */
+
+void add_SBN_Client_GetPipeDropCounts_tests(void)
+{
+    UtTest_Add(
+      Test_SBN_Client_GetPipeDropCounts_ReturnsPipeCounters, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_GetPipeDropCounts_ReturnsPipeCounters");
+    UtTest_Add(
+      Test_SBN_Client_GetPipeDropCounts_FailsInvalidPipe, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_GetPipeDropCounts_FailsInvalidPipe");
+    UtTest_Add(
+      Test_SBN_Client_GetPipeDropCounts_FailsNullCounter, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_GetPipeDropCounts_FailsNullCounter");
+} /* end add_SBN_Client_GetPipeDropCounts_tests */
+
+void add_SBN_Client_GetSubscriptionCounts_tests(void)
+{
+    UtTest_Add(
+      Test_SBN_Client_GetSubscriptionCounts_ReturnsSubscriptionCounters, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_GetSubscriptionCounts_ReturnsSubscriptionCounters");
+    UtTest_Add(
+      Test_SBN_Client_GetSubscriptionCounts_FailsWhenNotSubscribed, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_GetSubscriptionCounts_FailsWhenNotSubscribed");
+} /* end add_SBN_Client_GetSubscriptionCounts_tests */
+
 void add__wrap_CFE_SB_DeletePipe_tests(void)
 {
     UtTest_Add(
       Test__wrap_CFE_SB_DeletePipeSuccessWhenPipeIdIsCorrectAndInUse, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
       "Test__wrap_CFE_SB_DeletePipeSuccessWhenPipeIdIsCorrectAndInUse");
+    UtTest_Add(
+      Test__wrap_CFE_SB_DeletePipeRemovesPipeFromMsgIdRoutes, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_DeletePipeRemovesPipeFromMsgIdRoutes");
+    UtTest_Add(
+      Test__wrap_CFE_SB_DeletePipeReleasesMessagesHeldByPipe, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_DeletePipeReleasesMessagesHeldByPipe");
+    UtTest_Add(
+      Test__wrap_CFE_SB_DeletePipeFreesRing, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_DeletePipeFreesRing");
+    UtTest_Add(
+      Test__wrap_CFE_SB_DeletePipeFreesSlotForNextGeneration, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_DeletePipeFreesSlotForNextGeneration");
+    UtTest_Add(
+      Test__wrap_CFE_SB_DeletePipeFailsWhenPipeIsClosing, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_DeletePipeFailsWhenPipeIsClosing");
+    UtTest_Add(
+      Test__wrap_CFE_SB_DeletePipeTellsSbnOfLastSubscription, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_DeletePipeTellsSbnOfLastSubscription");
 } /* end add__wrap_CFE_SB_DeletePipe_tests */
 
+void add_CFE_SBN_Client_ResendSubscriptions_tests(void)
+{
+    UtTest_Add(Test_CFE_SBN_Client_ResendSubscriptions_SendsEachMsgIdOnce, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_CFE_SBN_Client_ResendSubscriptions_SendsEachMsgIdOnce");
+    UtTest_Add(
+      Test_CFE_SBN_Client_ResendSubscriptions_SendsNothingWithoutSubscriptions, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_CFE_SBN_Client_ResendSubscriptions_SendsNothingWithoutSubscriptions");
+} /* end add_CFE_SBN_Client_ResendSubscriptions_tests */
+
 void add__wrap_CFE_SB_Subscribe(void)
 {
     UtTest_Add(
@@ -1082,10 +2414,22 @@ void add__wrap_CFE_SB_Subscribe(void)
       Test__wrap_CFE_SB_SubscribeFailsWhenPipeIsInvalid, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
       "Test__wrap_CFE_SB_SubscribeFailsWhenPipeIsInvalid");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SubscribeAddsPipeToMsgIdRoutes, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SubscribeAddsPipeToMsgIdRoutes");
     UtTest_Add(
       Test__wrap_CFE_SB_SubscribeFailsWhenNumberOfMessagesForPipeIsExceeded, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
       "Test__wrap_CFE_SB_SubscribeFailsWhenNumberOfMessagesForPipeIsExceeded");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SubscribeTellsSbnOnlyForFirstPipe, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SubscribeTellsSbnOnlyForFirstPipe");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SubscribeDuplicateKeepsOneSubscription, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SubscribeDuplicateKeepsOneSubscription");
 } /* end add__wrap_CFE_SB_Subscribe */
 
 void add__wrap_CFE_SB_RcvMsg_tests(void)
@@ -1142,6 +2486,14 @@ void add__wrap_CFE_SB_RcvMsg_tests(void)
       Test__wrap_CFE_SB_RcvMsg_FailsPthreadMutexUnlockFailure, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
       "Test__wrap_CFE_SB_RcvMsg_FailsPthreadMutexUnlockFailure");
+    UtTest_Add(
+      Test__wrap_CFE_SB_RcvMsg_ReleasesPreviouslyReceivedMessage, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_RcvMsg_ReleasesPreviouslyReceivedMessage");
+    UtTest_Add(
+      Test__wrap_CFE_SB_RcvMsg_WakesProducerWaitingForSpace, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_RcvMsg_WakesProducerWaitingForSpace");
     // UtTest_Add(
     //   Test__wrap_CFE_SB_RcvMsg_SuccessPipeIsFull, 
     //   SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
@@ -1163,43 +2515,163 @@ void add__wrap_CFE_SB_RcvMsg_tests(void)
 void add__wrap_CFE_SB_SubscribeEx_tests(void)
 {
     UtTest_Add(
-      Test__wrap_CFE_SB_SubscribeEx_AlwaysFails, 
+      Test__wrap_CFE_SB_SubscribeEx_SetsMsgLimOfSubscription, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
-      "Test__wrap_CFE_SB_SubscribeEx_AlwaysFails");
+      "Test__wrap_CFE_SB_SubscribeEx_SetsMsgLimOfSubscription");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SubscribeEx_FailsWhenPipeIsInvalid, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SubscribeEx_FailsWhenPipeIsInvalid");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SubscribeEx_MsgLimDoesNotStarveOtherMsgIds, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SubscribeEx_MsgLimDoesNotStarveOtherMsgIds");
 } /* end add__wrap_CFE_SB_SubscribeEx_tests */
 
 void add__wrap_CFE_SB_SubscribeLocal_tests(void)
 {
     UtTest_Add(
-      Test__wrap_CFE_SB_SubscribeLocal_AlwaysFails, 
+      Test__wrap_CFE_SB_SubscribeLocal_DoesNotTellSbn, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
-      "Test__wrap_CFE_SB_SubscribeLocal_AlwaysFails");
+      "Test__wrap_CFE_SB_SubscribeLocal_DoesNotTellSbn");
 } /* end add__wrap_CFE_SB_SubscribeLocal_tests */
 
+void add_SBN_Client_SubscribeBatch_tests(void)
+{
+    UtTest_Add(
+      Test_SBN_Client_SubscribeBatch_TellsSbnInOneFrame, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_SubscribeBatch_TellsSbnInOneFrame");
+    UtTest_Add(
+      Test_SBN_Client_SubscribeBatch_KeepsGoingPastFailedEntry, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_SubscribeBatch_KeepsGoingPastFailedEntry");
+    UtTest_Add(
+      Test_SBN_Client_SubscribeBatch_FailsWithNullSubs, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_SubscribeBatch_FailsWithNullSubs");
+} /* end add_SBN_Client_SubscribeBatch_tests */
+
 void add__wrap_CFE_SB_Unsubscribe_tests(void)
 {
     UtTest_Add(
-      Test__wrap_CFE_SB_Unsubscribe_AlwaysFails, 
+      Test__wrap_CFE_SB_Unsubscribe_FailsWhenPipeIsInvalid, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_Unsubscribe_FailsWhenPipeIsInvalid");
+    UtTest_Add(
+      Test__wrap_CFE_SB_Unsubscribe_RemovesMsgIdAndRoute, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
-      "Test__wrap_CFE_SB_Unsubscribe_AlwaysFails");
+      "Test__wrap_CFE_SB_Unsubscribe_RemovesMsgIdAndRoute");
+    UtTest_Add(
+      Test__wrap_CFE_SB_Unsubscribe_TellsSbnAfterLastPipe, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_Unsubscribe_TellsSbnAfterLastPipe");
 } /* end add__wrap_CFE_SB_Unsubscribe_tests */
 
 void add__wrap_CFE_SB_UnsubscribeLocal_tests(void)
 {
     UtTest_Add(
-      Test__wrap_CFE_SB_UnsubscribeLocal_AlwaysFails,
+      Test__wrap_CFE_SB_UnsubscribeLocal_RemovesMsgIdAndRoute,
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
-      "Test__wrap_CFE_SB_UnsubscribeLocal_AlwaysFails");
+      "Test__wrap_CFE_SB_UnsubscribeLocal_RemovesMsgIdAndRoute");
 } /* end add__wrap_CFE_SB_UnsubscribeLocal_tests */
 
+void add__wrap_CFE_SB_ZeroCopyGetPtr_tests(void)
+{
+    UtTest_Add(
+      Test__wrap_CFE_SB_ZeroCopyGetPtr_LeavesRoomForSbnHeader, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_ZeroCopyGetPtr_LeavesRoomForSbnHeader");
+    UtTest_Add(
+      Test__wrap_CFE_SB_ZeroCopyGetPtr_FailsWhenAppHoldsMaxBuffers, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_ZeroCopyGetPtr_FailsWhenAppHoldsMaxBuffers");
+} /* end add__wrap_CFE_SB_ZeroCopyGetPtr_tests */
+
+void add__wrap_CFE_SB_ZeroCopyReleasePtr_tests(void)
+{
+    UtTest_Add(
+      Test__wrap_CFE_SB_ZeroCopyReleasePtr_ReturnsBufferToPool, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_ZeroCopyReleasePtr_ReturnsBufferToPool");
+    UtTest_Add(
+      Test__wrap_CFE_SB_ZeroCopyReleasePtr_FailsWithPointerNotFromHandle, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_ZeroCopyReleasePtr_FailsWithPointerNotFromHandle");
+} /* end add__wrap_CFE_SB_ZeroCopyReleasePtr_tests */
+
 void add__wrap_CFE_SB_ZeroCopySend_tests(void)
 {
     UtTest_Add(
-      Test__wrap_CFE_SB_ZeroCopySend_AlwaysFails, 
+      Test__wrap_CFE_SB_ZeroCopySend_FailsWithInvalidHandle, 
       SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
-      "Test__wrap_CFE_SB_ZeroCopySend_AlwaysFails");
+      "Test__wrap_CFE_SB_ZeroCopySend_FailsWithInvalidHandle");
+    UtTest_Add(
+      Test__wrap_CFE_SB_ZeroCopySend_SendsBufferAndReturnsItToPool, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_ZeroCopySend_SendsBufferAndReturnsItToPool");
+    UtTest_Add(
+      Test__wrap_CFE_SB_ZeroCopySend_FailsWhenMessageOutgrowsBuffer, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_ZeroCopySend_FailsWhenMessageOutgrowsBuffer");
 } /* end add__wrap_CFE_SB_ZeroCopySend_tests */
 
+void add__wrap_CFE_SB_SendMsg_tests(void)
+{
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_SendsHeaderAndMessageTogether, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_SendsHeaderAndMessageTogether");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_FailsWhenSbnHasClosedTheConnection, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_FailsWhenSbnHasClosedTheConnection");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_QueuesWhenSendQueueIsRunning, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_QueuesWhenSendQueueIsRunning");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_SkipsMsgIdNobodyWants, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_SkipsMsgIdNobodyWants");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_DeliversToOwnSubscriberAndSbn, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_DeliversToOwnSubscriberAndSbn");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_DeliversToLocalSubscriberOnly, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_DeliversToLocalSubscriberOnly");
+    UtTest_Add(
+      Test__wrap_CFE_SB_SendMsg_SendsToSbnWhenLocalCopyFails, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test__wrap_CFE_SB_SendMsg_SendsToSbnWhenLocalCopyFails");
+} /* end add__wrap_CFE_SB_SendMsg_tests */
+
+void add_SBN_Client_SendMsgBatch_tests(void)
+{
+    UtTest_Add(
+      Test_SBN_Client_SendMsgBatch_SendsEveryMessageInOrder, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_SendMsgBatch_SendsEveryMessageInOrder");
+    UtTest_Add(
+      Test_SBN_Client_SendMsgBatch_SendsNothingWhenAMessageIsNull, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_SendMsgBatch_SendsNothingWhenAMessageIsNull");
+    UtTest_Add(
+      Test_SBN_Client_SendMsgBatch_SendsOnlyWantedMessages, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_SendMsgBatch_SendsOnlyWantedMessages");
+} /* end add_SBN_Client_SendMsgBatch_tests */
+
+void add_SBN_Client_Cork_tests(void)
+{
+    UtTest_Add(
+      Test_SBN_Client_Cork_FailsWhenConnectionIsNotTcp, 
+      SBN_Client_Wrappers_Tests_Setup, SBN_Client_Wrappers_Tests_Teardown, 
+      "Test_SBN_Client_Cork_FailsWhenConnectionIsNotTcp");
+} /* end add_SBN_Client_Cork_tests */
+
 /* end add test group functions */
 
 /*******************************************************************************
@@ -1212,8 +2684,16 @@ void UtTest_Setup(void)
 {
     add__wrap_CFE_SB_CreatePipe_tests();
     
+    add_SBN_Client_CreatePipeEx_tests();
+    
+    add_SBN_Client_GetPipeDropCounts_tests();
+    
+    add_SBN_Client_GetSubscriptionCounts_tests();
+    
     add__wrap_CFE_SB_DeletePipe_tests();
     
+    add_CFE_SBN_Client_ResendSubscriptions_tests();
+    
     add__wrap_CFE_SB_Subscribe();
     
     add__wrap_CFE_SB_RcvMsg_tests();
@@ -1222,11 +2702,23 @@ void UtTest_Setup(void)
     
     add__wrap_CFE_SB_SubscribeLocal_tests();
     
+    add_SBN_Client_SubscribeBatch_tests();
+    
     add__wrap_CFE_SB_Unsubscribe_tests();
     
     add__wrap_CFE_SB_UnsubscribeLocal_tests();
     
+    add__wrap_CFE_SB_ZeroCopyGetPtr_tests();
+    
+    add__wrap_CFE_SB_ZeroCopyReleasePtr_tests();
+    
     add__wrap_CFE_SB_ZeroCopySend_tests();
+    
+    add__wrap_CFE_SB_SendMsg_tests();
+    
+    add_SBN_Client_SendMsgBatch_tests();
+    
+    add_SBN_Client_Cork_tests();
 } /* end UtTest_Setup */
 
 /* end Required UtTest_Setup function for ut-assert framework */